@@ -13,6 +13,10 @@ endif()
 dart_find_package(fmt)
 dart_check_required_package(fmt "libfmt")
 
+# Threads
+dart_find_package(Threads)
+dart_check_required_package(Threads "threads")
+
 # Eigen
 dart_find_package(Eigen3)
 dart_check_required_package(EIGEN3 "eigen3")
@@ -0,0 +1,9 @@
+# Copyright (c) 2011-2024, The DART development contributors
+# All rights reserved.
+#
+# The list of contributors can be found at:
+#   https://github.com/dartsim/dart/blob/main/LICENSE
+#
+# This file is provided under the "BSD-style" License
+
+find_package(Threads)
@@ -39,6 +39,7 @@
 #include "dart/dynamics/Skeleton.hpp"
 
 #include <algorithm>
+#include <thread>
 
 namespace dart {
 namespace collision {
@@ -69,6 +70,67 @@ bool CollisionDetector::raycast(
   return false;
 }
 
+//==============================================================================
+std::size_t CollisionDetector::raycastBatch(
+    CollisionGroup* group,
+    const Eigen::Ref<const Eigen::Matrix3Xd>& origins,
+    const Eigen::Ref<const Eigen::Matrix3Xd>& directions,
+    RaycastBatchResult& result)
+{
+  if (origins.cols() != directions.cols()) {
+    dterr << "[CollisionDetector::raycastBatch] The numbers of origins ("
+          << origins.cols() << ") and directions (" << directions.cols()
+          << ") differ.\n";
+    return 0u;
+  }
+
+  result.resize(static_cast<std::size_t>(origins.cols()));
+  result.clear();
+
+  const RaycastOption option;
+  RaycastResult rayResult;
+  auto numHits = 0u;
+
+  for (auto i = 0u; i < result.getNumRays(); ++i) {
+    const Eigen::Vector3d from = origins.col(i);
+    const Eigen::Vector3d to = from + directions.col(i);
+    if (!raycast(group, from, to, option, &rayResult))
+      continue;
+
+    const auto& rayHit = rayResult.mRayHits.front();
+    result.mDistances[i] = rayHit.mFraction * directions.col(i).norm();
+    result.mNormals.col(i) = rayHit.mNormal;
+    result.mCollisionObjects[i] = rayHit.mCollisionObject;
+    ++numHits;
+  }
+
+  return numHits;
+}
+
+//==============================================================================
+void CollisionDetector::setNumThreads(std::size_t numThreads)
+{
+  if (numThreads == 0u)
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+  // Waits for the batched query that uses the pool
+  std::lock_guard<std::mutex> lock(mThreadPoolMutex);
+
+  if (numThreads == getNumThreads())
+    return;
+
+  if (numThreads == 1u)
+    mThreadPool.reset();
+  else
+    mThreadPool = std::make_unique<common::ThreadPool>(numThreads);
+}
+
+//==============================================================================
+std::size_t CollisionDetector::getNumThreads() const
+{
+  return mThreadPool ? mThreadPool->getNumThreads() : 1u;
+}
+
 //==============================================================================
 std::shared_ptr<CollisionObject> CollisionDetector::claimCollisionObject(
     const dynamics::ShapeFrame* shapeFrame)
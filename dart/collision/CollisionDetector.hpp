@@ -45,10 +45,12 @@
 #include <dart/dynamics/SmartPointer.hpp>
 
 #include <dart/common/Factory.hpp>
+#include <dart/common/ThreadPool.hpp>
 
 #include <Eigen/Dense>
 
 #include <map>
+#include <mutex>
 #include <vector>
 
 namespace dart {
@@ -184,6 +186,42 @@ public:
       const RaycastOption& option = RaycastOption(),
       RaycastResult* result = nullptr);
 
+  /// Performs a batch of raycasts to a collision group, e.g., to simulate
+  /// lidars and depth cameras.
+  ///
+  /// Ray i starts at origins.col(i) and ends at origins.col(i) +
+  /// directions.col(i), so the norm of a direction is the range of its ray.
+  /// The closest hit of every ray is written to result, which is resized only
+  /// when its number of rays differs.
+  ///
+  /// The default implementation calls raycast() for each ray. Collision
+  /// detectors that override it update the group once for the whole batch
+  /// and may cast the rays on getNumThreads() threads.
+  ///
+  /// \param[in] group The collision group the rays will be casted onto.
+  /// \param[in] origins The start points of the rays in world coordinates.
+  /// \param[in] directions The directions of the rays scaled by their ranges.
+  /// \param[out] result The closest hits of the rays.
+  /// \return The number of rays that hit a collision object.
+  virtual std::size_t raycastBatch(
+      CollisionGroup* group,
+      const Eigen::Ref<const Eigen::Matrix3Xd>& origins,
+      const Eigen::Ref<const Eigen::Matrix3Xd>& directions,
+      RaycastBatchResult& result);
+
+  /// Sets the number of threads used by batched queries such as
+  /// raycastBatch(), including the calling thread. Zero means the number of
+  /// hardware threads. The default is 1.
+  ///
+  /// The pool runs one batched query at a time. A batched query that starts
+  /// while another one uses the pool, or from within a task of the pool, runs
+  /// on its calling thread only. Batched queries that run concurrently must
+  /// use different collision groups.
+  void setNumThreads(std::size_t numThreads);
+
+  /// Returns the number of threads used by batched queries.
+  std::size_t getNumThreads() const;
+
 protected:
   class CollisionObjectManager;
   class ManagerForUnsharableCollisionObjects;
@@ -210,6 +248,14 @@ protected:
 
 protected:
   std::unique_ptr<CollisionObjectManager> mCollisionObjectManager;
+
+  /// Pool running batched queries, or nullptr when they run on the calling
+  /// thread only
+  std::unique_ptr<common::ThreadPool> mThreadPool;
+
+  /// Held by the batched query that uses mThreadPool, since
+  /// ThreadPool::parallelFor() is not reentrant
+  std::mutex mThreadPoolMutex;
 };
 
 //==============================================================================
@@ -106,6 +106,13 @@ void BodyNodeCollisionFilter::removeAllBodyNodePairsFromBlackList()
   mBodyNodeBlackList.removeAllPairs();
 }
 
+//==============================================================================
+std::vector<std::pair<const dynamics::BodyNode*, const dynamics::BodyNode*>>
+BodyNodeCollisionFilter::getBodyNodePairsInBlackList() const
+{
+  return mBodyNodeBlackList.getPairs();
+}
+
 //==============================================================================
 bool BodyNodeCollisionFilter::ignoresCollision(
     const collision::CollisionObject* object1,
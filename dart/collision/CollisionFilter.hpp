@@ -104,6 +104,10 @@ public:
   /// Remove all the BodyNode pairs from the blacklist.
   void removeAllBodyNodePairsFromBlackList();
 
+  /// Returns all the BodyNode pairs in the blacklist in no particular order.
+  std::vector<std::pair<const dynamics::BodyNode*, const dynamics::BodyNode*>>
+  getBodyNodePairsInBlackList() const;
+
   // Documentation inherited
   bool ignoresCollision(
       const CollisionObject* object1,
@@ -38,10 +38,27 @@
 #include "dart/dynamics/Skeleton.hpp"
 
 #include <cassert>
+#include <limits>
 
 namespace dart {
 namespace collision {
 
+namespace {
+
+/// Version that no ShapeFrame or Shape reports, used to force the first engine
+/// update of an object
+constexpr std::size_t kUnknownVersion
+    = std::numeric_limits<std::size_t>::max();
+
+//==============================================================================
+/// Returns true if the shape can change its geometry without a version bump
+bool isDeformable(const dynamics::Shape* shape)
+{
+  return shape && shape->getTypeId() == dynamics::Shape::TypeId::SoftMesh;
+}
+
+} // namespace
+
 //==============================================================================
 CollisionGroup::CollisionGroup(const CollisionDetectorPtr& collisionDetector)
   : mCollisionDetector(collisionDetector), mUpdateAutomatically(true)
@@ -248,6 +265,18 @@ bool CollisionGroup::raycast(
   return mCollisionDetector->raycast(this, from, to, option, result);
 }
 
+//==============================================================================
+std::size_t CollisionGroup::raycastBatch(
+    const Eigen::Ref<const Eigen::Matrix3Xd>& origins,
+    const Eigen::Ref<const Eigen::Matrix3Xd>& directions,
+    RaycastBatchResult& result)
+{
+  if (mUpdateAutomatically)
+    update();
+
+  return mCollisionDetector->raycastBatch(this, origins, directions, result);
+}
+
 //==============================================================================
 void CollisionGroup::setAutomaticUpdate(const bool automatic)
 {
@@ -315,8 +344,30 @@ void CollisionGroup::removeDeletedShapeFrames()
 //==============================================================================
 void CollisionGroup::updateEngineData()
 {
-  for (const auto& info : mObjectInfoList)
+  mUpdatedObjects.clear();
+
+  for (const auto& info : mObjectInfoList) {
+    const dynamics::ConstShapePtr& shape = info->mFrame->getShape();
+    const std::size_t transformVersion
+        = info->mFrame->getWorldTransformVersion();
+    const std::size_t shapeVersion = shape ? shape->getVersion() : 0;
+    const std::size_t frameVersion = info->mFrame->getVersion();
+
+    // Shapes that deform, such as soft meshes, change their geometry without
+    // moving the frame, so they are always updated
+    if (transformVersion == info->mLastUpdatedTransformVersion
+        && shapeVersion == info->mLastUpdatedShapeVersion
+        && frameVersion == info->mLastUpdatedFrameVersion
+        && !isDeformable(shape.get()))
+      continue;
+
     info->mObject->updateEngineData();
+    info->mObject->updateCollisionFilterData();
+    info->mLastUpdatedTransformVersion = transformVersion;
+    info->mLastUpdatedShapeVersion = shapeVersion;
+    info->mLastUpdatedFrameVersion = frameVersion;
+    mUpdatedObjects.push_back(info->mObject.get());
+  }
 
   updateCollisionGroupEngineData();
 }
@@ -383,6 +434,9 @@ auto CollisionGroup::addShapeFrameImpl(
         collObj,
         shape ? shape->getID() : 0,
         shape ? shape->getVersion() : 0,
+        kUnknownVersion,
+        kUnknownVersion,
+        kUnknownVersion,
         {}});
     mObserver.addShapeFrame(shapeFrame);
 
@@ -610,6 +664,7 @@ bool CollisionGroup::updateShapeFrame(ObjectInfo* object)
 
     object->mLastKnownShapeID = currentID;
     object->mLastKnownVersion = currentVersion;
+    object->mLastUpdatedTransformVersion = kUnknownVersion;
 
     return true;
   }
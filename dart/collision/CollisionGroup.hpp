@@ -299,6 +299,14 @@ public:
       const RaycastOption& option = RaycastOption(),
       RaycastResult* result = nullptr);
 
+  /// Performs a batch of raycasts to this collision group.
+  ///
+  /// \sa CollisionDetector::raycastBatch()
+  std::size_t raycastBatch(
+      const Eigen::Ref<const Eigen::Matrix3Xd>& origins,
+      const Eigen::Ref<const Eigen::Matrix3Xd>& directions,
+      RaycastBatchResult& result);
+
   /// Set whether this CollisionGroup will automatically check for updates.
   void setAutomaticUpdate(bool automatic = true);
 
@@ -326,6 +334,11 @@ public:
 protected:
   /// Update engine data. This function should be called before the collision
   /// detection is performed by the engine in most cases.
+  ///
+  /// Only the CollisionObjects whose ShapeFrame moved or whose Shape changed
+  /// since the previous call (or whose shape deforms, such as a
+  /// SoftMeshShape) are pushed to the engine. They are listed in
+  /// mUpdatedObjects while updateCollisionGroupEngineData() runs.
   void updateEngineData();
 
   /// Initialize the collision detection engine data such as broadphase
@@ -349,6 +362,7 @@ protected:
 
   /// Update the collision detection engine data such as broadphase algorithm.
   /// This function will be called ahead of every collision checking.
+  /// Implementations only need to refresh the objects in mUpdatedObjects.
   virtual void updateCollisionGroupEngineData() = 0;
 
 protected:
@@ -378,6 +392,18 @@ protected:
     /// shape frame
     std::size_t mLastKnownVersion;
 
+    /// The world transform version of the shape frame when the engine data of
+    /// this object was last updated by this group
+    std::size_t mLastUpdatedTransformVersion;
+
+    /// The version of the shape when the engine data of this object was last
+    /// updated by this group
+    std::size_t mLastUpdatedShapeVersion;
+
+    /// The version of the shape frame, which changes with its collision
+    /// categories and mask, when this object was last updated by this group
+    std::size_t mLastUpdatedFrameVersion;
+
     /// The set of all sources that indicate that this object should be in this
     /// group. In the current implementation, this may consist of:
     /// user (nullptr), Skeleton subscription, and/or BodyNode subscription.
@@ -405,6 +431,10 @@ protected:
   // original and copy are not guranteed to be the same as we copy std::map
   // (e.g., by world cloning).
 
+  /// CollisionObjects whose engine data was updated by the current call of
+  /// updateEngineData(), in the order of mObjectInfoList
+  std::vector<CollisionObject*> mUpdatedObjects;
+
 private:
   /// This class watches when ShapeFrames get deleted so that they can be safely
   /// removes from the CollisionGroup. We cannot have a weak_ptr to a ShapeFrame
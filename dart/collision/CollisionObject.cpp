@@ -33,7 +33,10 @@
 #include "dart/collision/CollisionObject.hpp"
 
 #include "dart/collision/CollisionDetector.hpp"
+#include "dart/collision/CollisionOption.hpp"
 #include "dart/dynamics/ShapeFrame.hpp"
+#include "dart/dynamics/ShapeNode.hpp"
+#include "dart/dynamics/Skeleton.hpp"
 
 namespace dart {
 namespace collision {
@@ -68,6 +71,64 @@ const Eigen::Isometry3d& CollisionObject::getTransform() const
   return mShapeFrame->getWorldTransform();
 }
 
+//==============================================================================
+std::uint32_t CollisionObject::getCollisionCategories() const
+{
+  return mCollisionCategories;
+}
+
+//==============================================================================
+std::uint32_t CollisionObject::getCollisionMask() const
+{
+  return mCollisionMask;
+}
+
+//==============================================================================
+bool CollisionObject::canCollide(
+    const CollisionObject* object1,
+    const CollisionObject* object2,
+    bool skipDisabledSelfCollisions,
+    bool skipSleepingPairs)
+{
+  if (!(object1->mCollisionCategories & object2->mCollisionMask)
+      || !(object2->mCollisionCategories & object1->mCollisionMask))
+    return false;
+
+  const auto* skel1 = object1->mSkeleton;
+  const auto* skel2 = object2->mSkeleton;
+
+  if (skipDisabledSelfCollisions && skel1 && skel1 == skel2
+      && !skel1->getSelfCollisionCheck())
+    return false;
+
+  // A sleeping skeleton is at rest until it is woken up, so it can't start
+  // touching another skeleton that can't move either
+  if (skipSleepingPairs && skel1 && skel2
+      && (skel1->isSleeping() || skel2->isSleeping())) {
+    const auto isAtRest = [](const dynamics::Skeleton* skel) {
+      return skel->isSleeping() || !skel->isMobile()
+             || skel->getNumDofs() == 0u;
+    };
+    if (isAtRest(skel1) && isAtRest(skel2))
+      return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+bool CollisionObject::canCollide(
+    const CollisionObject* object1,
+    const CollisionObject* object2,
+    const CollisionOption& option)
+{
+  return canCollide(
+      object1,
+      object2,
+      option.skipDisabledSelfCollisions,
+      option.skipSleepingPairs);
+}
+
 //==============================================================================
 CollisionObject::CollisionObject(
     CollisionDetector* collisionDetector,
@@ -76,6 +137,25 @@ CollisionObject::CollisionObject(
 {
   assert(mCollisionDetector);
   assert(mShapeFrame);
+
+  updateCollisionFilterData();
+}
+
+//==============================================================================
+void CollisionObject::updateCollisionFilterData()
+{
+  const auto* collisionAspect = mShapeFrame->getCollisionAspect();
+  if (collisionAspect) {
+    mCollisionCategories = collisionAspect->getCollisionCategories();
+    mCollisionMask = collisionAspect->getCollisionMask();
+  } else {
+    const dynamics::CollisionAspect::PropertiesData properties;
+    mCollisionCategories = properties.mCollisionCategories;
+    mCollisionMask = properties.mCollisionMask;
+  }
+
+  const auto* shapeNode = mShapeFrame->asShapeNode();
+  mSkeleton = shapeNode ? shapeNode->getSkeleton().get() : nullptr;
 }
 
 } // namespace collision
@@ -39,9 +39,13 @@
 
 #include <Eigen/Dense>
 
+#include <cstdint>
+
 namespace dart {
 namespace collision {
 
+struct CollisionOption;
+
 class CollisionObject
 {
 public:
@@ -65,6 +69,34 @@ public:
   /// Return the transformation of this CollisionObject in world coordinates
   const Eigen::Isometry3d& getTransform() const;
 
+  /// Return the collision categories of the ShapeFrame as of the last update
+  /// of this CollisionObject by a CollisionGroup
+  std::uint32_t getCollisionCategories() const;
+
+  /// Return the collision mask of the ShapeFrame as of the last update of this
+  /// CollisionObject by a CollisionGroup
+  std::uint32_t getCollisionMask() const;
+
+  /// Return true if the collision categories and masks of the two objects let
+  /// them collide, which is when each object belongs to a category of the
+  /// mask of the other. If skipDisabledSelfCollisions is true, two objects of
+  /// a Skeleton whose self collision checking is disabled can't collide
+  /// either. If skipSleepingPairs is true, neither can two objects of
+  /// Skeletons at rest when one of them is sleeping. The collision detectors
+  /// test this for the pairs reported by their broadphase, before the narrow
+  /// phase and the CollisionFilter.
+  static bool canCollide(
+      const CollisionObject* object1,
+      const CollisionObject* object2,
+      bool skipDisabledSelfCollisions,
+      bool skipSleepingPairs = false);
+
+  /// Same as above with the flags of the collision option
+  static bool canCollide(
+      const CollisionObject* object1,
+      const CollisionObject* object2,
+      const CollisionOption& option);
+
 protected:
   /// Contructor
   CollisionObject(
@@ -76,12 +108,25 @@ protected:
   /// CollisionGroup.
   virtual void updateEngineData() = 0;
 
+  /// Update the collision categories, mask, and Skeleton of this
+  /// CollisionObject from its ShapeFrame
+  void updateCollisionFilterData();
+
 protected:
   /// Collision detector
   CollisionDetector* mCollisionDetector;
 
   /// ShapeFrame
   const dynamics::ShapeFrame* mShapeFrame;
+
+  /// Collision categories of the ShapeFrame
+  std::uint32_t mCollisionCategories;
+
+  /// Collision mask of the ShapeFrame
+  std::uint32_t mCollisionMask;
+
+  /// Skeleton of the ShapeFrame, or nullptr if it isn't a ShapeNode
+  const dynamics::Skeleton* mSkeleton;
 };
 
 } // namespace collision
@@ -58,6 +58,18 @@ struct CollisionOption
   /// CollisionFilter
   std::shared_ptr<CollisionFilter> collisionFilter;
 
+  /// Flag whether to skip the pairs of collision objects of the same Skeleton
+  /// when self collision checking of the Skeleton is disabled. Like the
+  /// collision categories and masks of the objects, this is tested in the
+  /// broadphase of the collision detector, before collisionFilter.
+  bool skipDisabledSelfCollisions = false;
+
+  /// Flag whether to skip the pairs of collision objects of Skeletons that are
+  /// both at rest, when at least one of them is sleeping. A Skeleton is at
+  /// rest when it is sleeping, immobile, or has no degrees of freedom. This is
+  /// tested in the broadphase like skipDisabledSelfCollisions.
+  bool skipSleepingPairs = false;
+
   /// Constructor
   CollisionOption(
       bool enableContact = true,
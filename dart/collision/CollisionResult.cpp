@@ -44,8 +44,6 @@ namespace collision {
 void CollisionResult::addContact(const Contact& contact)
 {
   mContacts.push_back(contact);
-  addObject(contact.collisionObject1);
-  addObject(contact.collisionObject2);
 }
 
 //==============================================================================
@@ -80,6 +78,8 @@ const std::vector<Contact>& CollisionResult::getContacts() const
 const std::unordered_set<const dynamics::BodyNode*>&
 CollisionResult::getCollidingBodyNodes() const
 {
+  updateCollidingObjects();
+
   return mCollidingBodyNodes;
 }
 
@@ -87,18 +87,24 @@ CollisionResult::getCollidingBodyNodes() const
 const std::unordered_set<const dynamics::ShapeFrame*>&
 CollisionResult::getCollidingShapeFrames() const
 {
+  updateCollidingObjects();
+
   return mCollidingShapeFrames;
 }
 
 //==============================================================================
 bool CollisionResult::inCollision(const dynamics::BodyNode* bn) const
 {
+  updateCollidingObjects();
+
   return (mCollidingBodyNodes.find(bn) != mCollidingBodyNodes.end());
 }
 
 //==============================================================================
 bool CollisionResult::inCollision(const dynamics::ShapeFrame* frame) const
 {
+  updateCollidingObjects();
+
   return (mCollidingShapeFrames.find(frame) != mCollidingShapeFrames.end());
 }
 
@@ -118,12 +124,13 @@ CollisionResult::operator bool() const
 void CollisionResult::clear()
 {
   mContacts.clear();
+  mNumCollidingObjectContacts = 0u;
   mCollidingShapeFrames.clear();
   mCollidingBodyNodes.clear();
 }
 
 //==============================================================================
-void CollisionResult::addObject(CollisionObject* object)
+void CollisionResult::addObject(CollisionObject* object) const
 {
   if (!object) {
     dterr << "[CollisionResult::addObject] Attempting to add a collision with "
@@ -142,5 +149,16 @@ void CollisionResult::addObject(CollisionObject* object)
   }
 }
 
+//==============================================================================
+void CollisionResult::updateCollidingObjects() const
+{
+  for (; mNumCollidingObjectContacts < mContacts.size();
+       ++mNumCollidingObjectContacts) {
+    const auto& contact = mContacts[mNumCollidingObjectContacts];
+    addObject(contact.collisionObject1);
+    addObject(contact.collisionObject2);
+  }
+}
+
 } // namespace collision
 } // namespace dart
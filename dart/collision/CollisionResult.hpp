@@ -68,6 +68,10 @@ public:
   const std::vector<Contact>& getContacts() const;
 
   /// Return the set of BodyNodes that are in collision
+  ///
+  /// The sets of colliding BodyNodes and ShapeFrames are only built when they
+  /// are queried, so that adding contacts doesn't allocate memory once the
+  /// contact list has grown to its steady-state size.
   const std::unordered_set<const dynamics::BodyNode*>& getCollidingBodyNodes()
       const;
 
@@ -91,16 +95,24 @@ public:
   void clear();
 
 protected:
-  void addObject(CollisionObject* object);
+  void addObject(CollisionObject* object) const;
+
+  /// Adds the objects of the contacts that were added since the last call to
+  /// mCollidingBodyNodes and mCollidingShapeFrames
+  void updateCollidingObjects() const;
 
   /// List of contact information for each contact
   std::vector<Contact> mContacts;
 
+  /// Number of leading contacts in mContacts whose objects are already in
+  /// mCollidingBodyNodes and mCollidingShapeFrames
+  mutable std::size_t mNumCollidingObjectContacts{0u};
+
   /// Set of BodyNodes that are colliding
-  std::unordered_set<const dynamics::BodyNode*> mCollidingBodyNodes;
+  mutable std::unordered_set<const dynamics::BodyNode*> mCollidingBodyNodes;
 
   /// Set of ShapeFrames that are colliding
-  std::unordered_set<const dynamics::ShapeFrame*> mCollidingShapeFrames;
+  mutable std::unordered_set<const dynamics::ShapeFrame*> mCollidingShapeFrames;
 };
 
 } // namespace collision
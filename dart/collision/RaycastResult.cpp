@@ -32,6 +32,9 @@
 
 #include "dart/collision/RaycastResult.hpp"
 
+#include <algorithm>
+#include <limits>
+
 namespace dart {
 namespace collision {
 
@@ -63,5 +66,36 @@ bool RaycastResult::hasHit() const
   return !mRayHits.empty();
 }
 
+//==============================================================================
+RaycastBatchResult::RaycastBatchResult()
+{
+  // Do nothing
+}
+
+//==============================================================================
+void RaycastBatchResult::resize(std::size_t numRays)
+{
+  const auto size = static_cast<Eigen::Index>(numRays);
+  if (mDistances.size() != size)
+    mDistances.resize(size);
+  if (mNormals.cols() != size)
+    mNormals.resize(3, size);
+  mCollisionObjects.resize(numRays);
+}
+
+//==============================================================================
+std::size_t RaycastBatchResult::getNumRays() const
+{
+  return mCollisionObjects.size();
+}
+
+//==============================================================================
+void RaycastBatchResult::clear()
+{
+  mDistances.setConstant(std::numeric_limits<double>::infinity());
+  mNormals.setZero();
+  std::fill(mCollisionObjects.begin(), mCollisionObjects.end(), nullptr);
+}
+
 } // namespace collision
 } // namespace dart
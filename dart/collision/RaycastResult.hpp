@@ -74,6 +74,36 @@ struct RaycastResult
   RaycastResult();
 };
 
+/// Closest hits of a batch of rays, stored in buffers that are reused across
+/// batches. Entry i belongs to ray i.
+struct RaycastBatchResult
+{
+  /// Constructor
+  RaycastBatchResult();
+
+  /// Resizes the buffers for the given number of rays. Nothing is allocated
+  /// when the number of rays doesn't change.
+  void resize(std::size_t numRays);
+
+  /// Returns the number of rays the buffers are sized for
+  std::size_t getNumRays() const;
+
+  /// Marks every ray as having hit nothing
+  void clear();
+
+  /// Distance from the origin of each ray to its closest hit, or infinity if
+  /// the ray hit nothing
+  Eigen::VectorXd mDistances;
+
+  /// Normal at the closest hit of each ray in world coordinates, or zero if
+  /// the ray hit nothing
+  Eigen::Matrix3Xd mNormals;
+
+  /// Collision object of the closest hit of each ray, or nullptr if the ray
+  /// hit nothing
+  std::vector<const CollisionObject*> mCollisionObjects;
+};
+
 } // namespace collision
 } // namespace dart
 
@@ -62,6 +62,8 @@ namespace collision {
 
 namespace {
 
+void performDiscreteCollisionDetection(btCollisionWorld* collWorld);
+
 Contact convertContact(
     const btManifoldPoint& bulletManifoldPoint,
     BulletCollisionObject* collObj1,
@@ -72,6 +74,12 @@ void reportContacts(
     const CollisionOption& option,
     CollisionResult& result);
 
+RayHit convertRayHit(
+    const btCollisionObject* btCollObj,
+    btVector3 hitPointWorld,
+    btVector3 hitNormalWorld,
+    btScalar closestHitFraction);
+
 void reportRayHits(
     const btCollisionWorld::ClosestRayResultCallback callback,
     const RaycastOption& option,
@@ -191,8 +199,9 @@ void filterOutCollisions(btCollisionWorld* world)
   assert(dispatcher);
 
   const auto filter = dispatcher->getFilter();
-  if (!filter)
-    return;
+  const auto skipDisabledSelfCollisions
+      = dispatcher->getSkipDisabledSelfCollisions();
+  const auto skipSleepingPairs = dispatcher->getSkipSleepingPairs();
 
   const auto numManifolds = dispatcher->getNumManifolds();
 
@@ -210,7 +219,12 @@ void filterOutCollisions(btCollisionWorld* world)
     const auto collObj0 = static_cast<BulletCollisionObject*>(userPtr0);
     const auto collObj1 = static_cast<BulletCollisionObject*>(userPtr1);
 
-    if (filter->ignoresCollision(collObj0, collObj1))
+    if (!CollisionObject::canCollide(
+            collObj0,
+            collObj1,
+            skipDisabledSelfCollisions,
+            skipSleepingPairs)
+        || (filter && filter->ignoresCollision(collObj0, collObj1)))
       manifoldsToRelease.push_back(contactManifold);
   }
 
@@ -240,12 +254,15 @@ bool BulletCollisionDetector::collide(
   auto dispatcher = static_cast<detail::BulletCollisionDispatcher*>(
       collisionWorld->getDispatcher());
   dispatcher->setFilter(option.collisionFilter);
+  dispatcher->setSkipDisabledSelfCollisions(
+      option.skipDisabledSelfCollisions);
+  dispatcher->setSkipSleepingPairs(option.skipSleepingPairs);
 
-  // Filter out persistent contact pairs already existing in the world
-  filterOutCollisions(collisionWorld);
-
+  // Filter out persistent contact pairs already existing in the world. The
+  // collision categories of the objects are updated with the engine data.
   castedGroup->updateEngineData();
-  collisionWorld->performDiscreteCollisionDetection();
+  filterOutCollisions(collisionWorld);
+  performDiscreteCollisionDetection(collisionWorld);
 
   if (result) {
     reportContacts(collisionWorld, option, *result);
@@ -280,13 +297,17 @@ bool BulletCollisionDetector::collide(
   auto bulletCollisionWorld = mGroupForFiltering->getBulletCollisionWorld();
   auto bulletPairCache = bulletCollisionWorld->getPairCache();
   auto filterCallback = new detail::BulletOverlapFilterCallback(
-      option.collisionFilter, group1, group2);
+      option.collisionFilter,
+      group1,
+      group2,
+      option.skipDisabledSelfCollisions,
+      option.skipSleepingPairs);
   bulletPairCache->setOverlapFilterCallback(filterCallback);
 
   mGroupForFiltering->addShapeFramesOf(group1, group2);
   mGroupForFiltering->updateEngineData();
 
-  bulletCollisionWorld->performDiscreteCollisionDetection();
+  performDiscreteCollisionDetection(bulletCollisionWorld);
 
   if (result) {
     reportContacts(bulletCollisionWorld, option, *result);
@@ -384,6 +405,61 @@ bool BulletCollisionDetector::raycast(
   }
 }
 
+//==============================================================================
+std::size_t BulletCollisionDetector::raycastBatch(
+    CollisionGroup* group,
+    const Eigen::Ref<const Eigen::Matrix3Xd>& origins,
+    const Eigen::Ref<const Eigen::Matrix3Xd>& directions,
+    RaycastBatchResult& result)
+{
+  if (!checkGroupValidity(this, group))
+    return 0u;
+
+  if (origins.cols() != directions.cols()) {
+    dterr << "[BulletCollisionDetector::raycastBatch] The numbers of origins ("
+          << origins.cols() << ") and directions (" << directions.cols()
+          << ") differ.\n";
+    return 0u;
+  }
+
+  result.resize(static_cast<std::size_t>(origins.cols()));
+  result.clear();
+
+  auto castedGroup = static_cast<BulletCollisionGroup*>(group);
+  auto collisionWorld = castedGroup->getBulletCollisionWorld();
+
+  // The broadphase is updated once for the whole batch. The rays are cast on
+  // the calling thread because btCollisionWorld::rayTest() reuses traversal
+  // buffers of the broadphase that are shared between calls.
+  castedGroup->updateEngineData();
+
+  std::size_t numHits = 0u;
+  for (auto i = 0u; i < result.getNumRays(); ++i) {
+    const Eigen::Vector3d from = origins.col(i);
+    const Eigen::Vector3d to = from + directions.col(i);
+    const auto btFrom = convertVector3(from);
+    const auto btTo = convertVector3(to);
+
+    auto callback = btCollisionWorld::ClosestRayResultCallback(btFrom, btTo);
+    collisionWorld->rayTest(btFrom, btTo, callback);
+    if (!callback.hasHit())
+      continue;
+
+    const auto rayHit = convertRayHit(
+        callback.m_collisionObject,
+        callback.m_hitPointWorld,
+        callback.m_hitNormalWorld,
+        callback.m_closestHitFraction);
+
+    result.mDistances[i] = rayHit.mFraction * directions.col(i).norm();
+    result.mNormals.col(i) = rayHit.mNormal;
+    result.mCollisionObjects[i] = rayHit.mCollisionObject;
+    ++numHits;
+  }
+
+  return numHits;
+}
+
 //==============================================================================
 BulletCollisionDetector::BulletCollisionDetector() : CollisionDetector()
 {
@@ -476,126 +552,159 @@ BulletCollisionDetector::createBulletCollisionShape(
   using dynamics::SoftMeshShape;
   using dynamics::SphereShape;
 
-  if (const auto sphere = shape->as<SphereShape>()) {
-    const auto radius = sphere->getRadius();
-
-    auto bulletCollisionShape = std::make_unique<btSphereShape>(radius);
-
-    return std::make_unique<BulletCollisionShape>(
-        std::move(bulletCollisionShape));
-  } else if (const auto box = shape->as<BoxShape>()) {
-    const Eigen::Vector3d& size = box->getSize();
-
-    auto bulletCollisionShape
-        = std::make_unique<btBoxShape>(convertVector3(size * 0.5));
-
-    return std::make_unique<BulletCollisionShape>(
-        std::move(bulletCollisionShape));
-  } else if (const auto ellipsoid = shape->as<EllipsoidShape>()) {
-    const Eigen::Vector3d& radii = ellipsoid->getRadii();
-
-    auto bulletCollisionShape = createBulletEllipsoidMesh(
-        radii[0] * 2.0, radii[1] * 2.0, radii[2] * 2.0);
-
-    return std::make_unique<BulletCollisionShape>(
-        std::move(bulletCollisionShape));
-  } else if (const auto cylinder = shape->as<CylinderShape>()) {
-    const auto radius = cylinder->getRadius();
-    const auto height = cylinder->getHeight();
-    const auto size = btVector3(radius, radius, height * 0.5);
-
-    auto bulletCollisionShape = std::make_unique<btCylinderShapeZ>(size);
-
-    return std::make_unique<BulletCollisionShape>(
-        std::move(bulletCollisionShape));
-  } else if (const auto capsule = shape->as<CapsuleShape>()) {
-    const auto radius = capsule->getRadius();
-    const auto height = capsule->getHeight();
-
-    auto bulletCollisionShape
-        = std::make_unique<btCapsuleShapeZ>(radius, height);
-
-    return std::make_unique<BulletCollisionShape>(
-        std::move(bulletCollisionShape));
-  } else if (const auto cone = shape->as<ConeShape>()) {
-    const auto radius = cone->getRadius();
-    const auto height = cone->getHeight();
-
-    auto bulletCollisionShape = std::make_unique<btConeShapeZ>(radius, height);
-    bulletCollisionShape->setMargin(0.0);
-    // TODO(JS): Bullet seems to use constant margin 0.4, however this could be
-    // dangerous when the cone is sufficiently small. We use zero margin here
-    // until find better solution even using zero margin is not recommended:
-    // https://www.sjbaker.org/wiki/index.php?title=Physics_-_Bullet_Collected_random_advice#Minimum_object_sizes_-_by_Erwin
-
-    return std::make_unique<BulletCollisionShape>(
-        std::move(bulletCollisionShape));
-  } else if (const auto plane = shape->as<PlaneShape>()) {
-    const Eigen::Vector3d normal = plane->getNormal();
-    const double offset = plane->getOffset();
-
-    auto bulletCollisionShape
-        = std::make_unique<btStaticPlaneShape>(convertVector3(normal), offset);
-
-    return std::make_unique<BulletCollisionShape>(
-        std::move(bulletCollisionShape));
-  } else if (const auto multiSphere = shape->as<MultiSphereConvexHullShape>()) {
-    const auto numSpheres = multiSphere->getNumSpheres();
-    const auto& spheres = multiSphere->getSpheres();
-
-    std::vector<btVector3> bulletPositions(numSpheres);
-    std::vector<btScalar> bulletRadii(numSpheres);
-
-    for (auto i = 0u; i < numSpheres; ++i) {
-      bulletRadii[i] = static_cast<btScalar>(spheres[i].first);
-      bulletPositions[i] = convertVector3(spheres[i].second);
+  switch (shape->getTypeId()) {
+    case Shape::TypeId::Sphere: {
+      const auto* sphere = static_cast<const SphereShape*>(shape.get());
+      const auto radius = sphere->getRadius();
+
+      auto bulletCollisionShape = std::make_unique<btSphereShape>(radius);
+
+      return std::make_unique<BulletCollisionShape>(
+          std::move(bulletCollisionShape));
+    }
+    case Shape::TypeId::Box: {
+      const auto* box = static_cast<const BoxShape*>(shape.get());
+      const Eigen::Vector3d& size = box->getSize();
+
+      auto bulletCollisionShape
+          = std::make_unique<btBoxShape>(convertVector3(size * 0.5));
+
+      return std::make_unique<BulletCollisionShape>(
+          std::move(bulletCollisionShape));
+    }
+    case Shape::TypeId::Ellipsoid: {
+      const auto* ellipsoid
+          = static_cast<const EllipsoidShape*>(shape.get());
+      const Eigen::Vector3d& radii = ellipsoid->getRadii();
+
+      auto bulletCollisionShape = createBulletEllipsoidMesh(
+          radii[0] * 2.0, radii[1] * 2.0, radii[2] * 2.0);
+
+      return std::make_unique<BulletCollisionShape>(
+          std::move(bulletCollisionShape));
     }
+    case Shape::TypeId::Cylinder: {
+      const auto* cylinder = static_cast<const CylinderShape*>(shape.get());
+      const auto radius = cylinder->getRadius();
+      const auto height = cylinder->getHeight();
+      const auto size = btVector3(radius, radius, height * 0.5);
 
-    auto bulletCollisionShape = std::make_unique<btMultiSphereShape>(
-        bulletPositions.data(), bulletRadii.data(), numSpheres);
+      auto bulletCollisionShape = std::make_unique<btCylinderShapeZ>(size);
 
-    return std::make_unique<BulletCollisionShape>(
-        std::move(bulletCollisionShape));
-  } else if (const auto shapeMesh = shape->as<MeshShape>()) {
-    const auto scale = shapeMesh->getScale();
-    const auto mesh = shapeMesh->getMesh();
+      return std::make_unique<BulletCollisionShape>(
+          std::move(bulletCollisionShape));
+    }
+    case Shape::TypeId::Capsule: {
+      const auto* capsule = static_cast<const CapsuleShape*>(shape.get());
+      const auto radius = capsule->getRadius();
+      const auto height = capsule->getHeight();
 
-    auto bulletCollisionShape
-        = createBulletCollisionShapeFromAssimpScene(scale, mesh);
+      auto bulletCollisionShape
+          = std::make_unique<btCapsuleShapeZ>(radius, height);
 
-    return std::make_unique<BulletCollisionShape>(
-        std::move(bulletCollisionShape));
-  } else if (const auto softMeshShape = shape->as<SoftMeshShape>()) {
-    const auto mesh = softMeshShape->getAssimpMesh();
+      return std::make_unique<BulletCollisionShape>(
+          std::move(bulletCollisionShape));
+    }
+    case Shape::TypeId::Cone: {
+      const auto* cone = static_cast<const ConeShape*>(shape.get());
+      const auto radius = cone->getRadius();
+      const auto height = cone->getHeight();
+
+      auto bulletCollisionShape
+          = std::make_unique<btConeShapeZ>(radius, height);
+      bulletCollisionShape->setMargin(0.0);
+      // TODO(JS): Bullet seems to use constant margin 0.4, however this could
+      // be dangerous when the cone is sufficiently small. We use zero margin
+      // here until find better solution even using zero margin is not
+      // recommended:
+      // https://www.sjbaker.org/wiki/index.php?title=Physics_-_Bullet_Collected_random_advice#Minimum_object_sizes_-_by_Erwin
+
+      return std::make_unique<BulletCollisionShape>(
+          std::move(bulletCollisionShape));
+    }
+    case Shape::TypeId::Plane: {
+      const auto* plane = static_cast<const PlaneShape*>(shape.get());
+      const Eigen::Vector3d normal = plane->getNormal();
+      const double offset = plane->getOffset();
 
-    auto bulletCollisionShape = createBulletCollisionShapeFromAssimpMesh(mesh);
+      auto bulletCollisionShape = std::make_unique<btStaticPlaneShape>(
+          convertVector3(normal), offset);
 
-    return std::make_unique<BulletCollisionShape>(
-        std::move(bulletCollisionShape));
-  } else if (const auto heightMap = shape->as<HeightmapShapef>()) {
-    return createBulletCollisionShapeFromHeightmap(heightMap);
-  } else if (shape->is<HeightmapShaped>()) {
-    assert(dynamic_cast<const HeightmapShaped*>(shape.get()));
+      return std::make_unique<BulletCollisionShape>(
+          std::move(bulletCollisionShape));
+    }
+    case Shape::TypeId::MultiSphereConvexHull: {
+      const auto* multiSphere
+          = static_cast<const MultiSphereConvexHullShape*>(shape.get());
+      const auto numSpheres = multiSphere->getNumSpheres();
+      const auto& spheres = multiSphere->getSpheres();
+
+      std::vector<btVector3> bulletPositions(numSpheres);
+      std::vector<btScalar> bulletRadii(numSpheres);
+
+      for (auto i = 0u; i < numSpheres; ++i) {
+        bulletRadii[i] = static_cast<btScalar>(spheres[i].first);
+        bulletPositions[i] = convertVector3(spheres[i].second);
+      }
 
-    dterr << "[BulletCollisionDetector::createBulletCollisionShape] "
-          << "Bullet does not support double height fields (shape type ["
-          << shape->getType() << "]). Creating a sphere with 0.1 radius "
-          << "instead.\n";
+      auto bulletCollisionShape = std::make_unique<btMultiSphereShape>(
+          bulletPositions.data(), bulletRadii.data(), numSpheres);
 
-    return std::make_unique<BulletCollisionShape>(
-        std::make_unique<btSphereShape>(0.1));
+      return std::make_unique<BulletCollisionShape>(
+          std::move(bulletCollisionShape));
+    }
+    case Shape::TypeId::Mesh: {
+      const auto* shapeMesh = static_cast<const MeshShape*>(shape.get());
+      const auto scale = shapeMesh->getScale();
+      const auto mesh = shapeMesh->getMesh();
 
-    // take this back in as soon as bullet supports double in heightmaps
-    // const auto heightMap = static_cast<const HeightmapShaped*>(shape.get());
-    // return createBulletCollisionShapeFromHeightmap(heightMap);
-  } else {
-    dterr << "[BulletCollisionDetector::createBulletCollisionShape] "
-          << "Attempting to create an unsupported shape type ["
-          << shape->getType() << "] Creating a sphere with 0.1 radius "
-          << "instead.\n";
+      auto bulletCollisionShape
+          = createBulletCollisionShapeFromAssimpScene(scale, mesh);
 
-    return std::make_unique<BulletCollisionShape>(
-        std::make_unique<btSphereShape>(0.1));
+      return std::make_unique<BulletCollisionShape>(
+          std::move(bulletCollisionShape));
+    }
+    case Shape::TypeId::SoftMesh: {
+      const auto* softMeshShape
+          = static_cast<const SoftMeshShape*>(shape.get());
+      const auto mesh = softMeshShape->getAssimpMesh();
+
+      auto bulletCollisionShape
+          = createBulletCollisionShapeFromAssimpMesh(mesh);
+
+      return std::make_unique<BulletCollisionShape>(
+          std::move(bulletCollisionShape));
+    }
+    case Shape::TypeId::Heightmapf: {
+      const auto* heightMap
+          = static_cast<const HeightmapShapef*>(shape.get());
+      return createBulletCollisionShapeFromHeightmap(heightMap);
+    }
+    case Shape::TypeId::Heightmapd: {
+      assert(dynamic_cast<const HeightmapShaped*>(shape.get()));
+
+      dterr << "[BulletCollisionDetector::createBulletCollisionShape] "
+            << "Bullet does not support double height fields (shape type ["
+            << shape->getType() << "]). Creating a sphere with 0.1 radius "
+            << "instead.\n";
+
+      return std::make_unique<BulletCollisionShape>(
+          std::make_unique<btSphereShape>(0.1));
+
+      // take this back in as soon as bullet supports double in heightmaps
+      // const auto heightMap
+      //     = static_cast<const HeightmapShaped*>(shape.get());
+      // return createBulletCollisionShapeFromHeightmap(heightMap);
+    }
+    default: {
+      dterr << "[BulletCollisionDetector::createBulletCollisionShape] "
+            << "Attempting to create an unsupported shape type ["
+            << shape->getType() << "] Creating a sphere with 0.1 radius "
+            << "instead.\n";
+
+      return std::make_unique<BulletCollisionShape>(
+          std::make_unique<btSphereShape>(0.1));
+    }
   }
 }
 
@@ -619,6 +728,23 @@ void BulletCollisionDetector::BulletCollisionShapeDeleter ::operator()(
 
 namespace {
 
+//==============================================================================
+void performDiscreteCollisionDetection(btCollisionWorld* collWorld)
+{
+  // Same as btCollisionWorld::performDiscreteCollisionDetection() except that
+  // the AABBs are not recomputed for every object here. The collision group
+  // has already refreshed the AABBs of the objects that moved.
+  collWorld->computeOverlappingPairs();
+
+  btDispatcher* dispatcher = collWorld->getDispatcher();
+  if (dispatcher) {
+    dispatcher->dispatchAllCollisionPairs(
+        collWorld->getBroadphase()->getOverlappingPairCache(),
+        collWorld->getDispatchInfo(),
+        dispatcher);
+  }
+}
+
 //==============================================================================
 Contact convertContact(
     const btManifoldPoint& bulletManifoldPoint,
@@ -104,6 +104,13 @@ public:
       const RaycastOption& option = RaycastOption(),
       RaycastResult* result = nullptr) override;
 
+  // Documentation inherited
+  std::size_t raycastBatch(
+      CollisionGroup* group,
+      const Eigen::Ref<const Eigen::Matrix3Xd>& origins,
+      const Eigen::Ref<const Eigen::Matrix3Xd>& directions,
+      RaycastBatchResult& result) override;
+
 protected:
   /// Constructor
   BulletCollisionDetector();
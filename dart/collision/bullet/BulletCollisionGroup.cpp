@@ -109,7 +109,11 @@ void BulletCollisionGroup::removeAllCollisionObjectsFromEngine()
 //==============================================================================
 void BulletCollisionGroup::updateCollisionGroupEngineData()
 {
-  mBulletCollisionWorld->updateAabbs();
+  // Only the objects that moved need their broadphase proxies refreshed
+  for (auto object : mUpdatedObjects) {
+    auto casted = static_cast<BulletCollisionObject*>(object);
+    mBulletCollisionWorld->updateSingleAabb(casted->getBulletCollisionObject());
+  }
 }
 
 //==============================================================================
@@ -41,7 +41,11 @@ namespace detail {
 //==============================================================================
 BulletCollisionDispatcher::BulletCollisionDispatcher(
     btCollisionConfiguration* config)
-  : btCollisionDispatcher(config), mDone(false), mFilter(nullptr)
+  : btCollisionDispatcher(config),
+    mDone(false),
+    mFilter(nullptr),
+    mSkipDisabledSelfCollisions(false),
+    mSkipSleepingPairs(false)
 {
   // Do nothing
 }
@@ -66,6 +70,30 @@ auto BulletCollisionDispatcher::getFilter() const
   return mFilter;
 }
 
+//==============================================================================
+void BulletCollisionDispatcher::setSkipDisabledSelfCollisions(bool skip)
+{
+  mSkipDisabledSelfCollisions = skip;
+}
+
+//==============================================================================
+bool BulletCollisionDispatcher::getSkipDisabledSelfCollisions() const
+{
+  return mSkipDisabledSelfCollisions;
+}
+
+//==============================================================================
+void BulletCollisionDispatcher::setSkipSleepingPairs(bool skip)
+{
+  mSkipSleepingPairs = skip;
+}
+
+//==============================================================================
+bool BulletCollisionDispatcher::getSkipSleepingPairs() const
+{
+  return mSkipSleepingPairs;
+}
+
 //==============================================================================
 bool BulletCollisionDispatcher::needsCollision(
     const btCollisionObject* body0, const btCollisionObject* body1)
@@ -78,6 +106,13 @@ bool BulletCollisionDispatcher::needsCollision(
   const auto collObj1
       = static_cast<BulletCollisionObject*>(body1->getUserPointer());
 
+  if (!CollisionObject::canCollide(
+          collObj0,
+          collObj1,
+          mSkipDisabledSelfCollisions,
+          mSkipSleepingPairs))
+    return false;
+
   if (mFilter && mFilter->ignoresCollision(collObj0, collObj1))
     return false;
 
@@ -54,6 +54,14 @@ public:
 
   auto getFilter() const -> std::shared_ptr<CollisionFilter>;
 
+  void setSkipDisabledSelfCollisions(bool skip);
+
+  bool getSkipDisabledSelfCollisions() const;
+
+  void setSkipSleepingPairs(bool skip);
+
+  bool getSkipSleepingPairs() const;
+
   bool needsCollision(
       const btCollisionObject* body0, const btCollisionObject* body1) override;
 
@@ -61,6 +69,10 @@ protected:
   bool mDone;
 
   std::shared_ptr<CollisionFilter> mFilter;
+
+  bool mSkipDisabledSelfCollisions;
+
+  bool mSkipSleepingPairs;
 };
 
 } // namespace detail
@@ -44,12 +44,16 @@ namespace detail {
 BulletOverlapFilterCallback::BulletOverlapFilterCallback(
     const std::shared_ptr<CollisionFilter>& filter,
     CollisionGroup* group1,
-    CollisionGroup* group2)
+    CollisionGroup* group2,
+    bool skipDisabledSelfCollisions,
+    bool skipSleepingPairs)
   : foundCollision(false),
     done(false),
     filter(filter),
     group1(group1),
-    group2(group2)
+    group2(group2),
+    skipDisabledSelfCollisions(skipDisabledSelfCollisions),
+    skipSleepingPairs(skipSleepingPairs)
 {
   // Do nothing
 }
@@ -82,6 +86,13 @@ bool BulletOverlapFilterCallback::needBroadphaseCollision(
     const auto collObj0 = static_cast<BulletCollisionObject*>(userPtr0);
     const auto collObj1 = static_cast<BulletCollisionObject*>(userPtr1);
 
+    if (!CollisionObject::canCollide(
+            collObj0,
+            collObj1,
+            skipDisabledSelfCollisions,
+            skipSleepingPairs))
+      return false;
+
     // Filter out if the two ShapeFrames are in the same group
     if (group1 && group2) {
       const dynamics::ShapeFrame* shapeFrame0 = collObj0->getShapeFrame();
@@ -47,7 +47,9 @@ struct BulletOverlapFilterCallback : public btOverlapFilterCallback
   explicit BulletOverlapFilterCallback(
       const std::shared_ptr<CollisionFilter>& filter = nullptr,
       CollisionGroup* group1 = nullptr,
-      CollisionGroup* group2 = nullptr);
+      CollisionGroup* group2 = nullptr,
+      bool skipDisabledSelfCollisions = false,
+      bool skipSleepingPairs = false);
 
   /// Returns true when pairs need collision
   bool needBroadphaseCollision(
@@ -63,6 +65,12 @@ struct BulletOverlapFilterCallback : public btOverlapFilterCallback
   std::shared_ptr<CollisionFilter> filter;
   const CollisionGroup* group1;
   const CollisionGroup* group2;
+
+  /// Whether to skip the pairs of a Skeleton without self collision checking
+  bool skipDisabledSelfCollisions;
+
+  /// Whether to skip the pairs of Skeletons at rest with a sleeping one
+  bool skipSleepingPairs;
 };
 
 } // namespace detail
@@ -1403,104 +1403,78 @@ int collideCylinderPlane(
   return 0;
 }
 
+//==============================================================================
+/// Returns the radius of a sphere, or the first radius of an ellipsoid, which
+/// the DART collision detector treats as a sphere.
+static double getSphereRadius(const dynamics::Shape* shape)
+{
+  if (shape->getTypeId() == dynamics::Shape::TypeId::Sphere)
+    return static_cast<const dynamics::SphereShape*>(shape)->getRadius();
+
+  assert(shape->getTypeId() == dynamics::Shape::TypeId::Ellipsoid);
+  return static_cast<const dynamics::EllipsoidShape*>(shape)->getRadii()[0];
+}
+
 //==============================================================================
 int collide(CollisionObject* o1, CollisionObject* o2, CollisionResult& result)
 {
   // TODO(JS): We could make the contact point computation as optional for
   // the case that we want only binary check.
 
-  const auto& shape1 = o1->getShape();
-  const auto& shape2 = o2->getShape();
+  using TypeId = dynamics::Shape::TypeId;
 
-  const auto& shapeType1 = shape1->getType();
-  const auto& shapeType2 = shape2->getType();
+  const auto* shape1 = o1->getShape().get();
+  const auto* shape2 = o2->getShape().get();
 
   const Eigen::Isometry3d& T1 = o1->getTransform();
   const Eigen::Isometry3d& T2 = o2->getTransform();
 
-  if (dynamics::SphereShape::getStaticType() == shapeType1) {
-    const auto* sphere0
-        = static_cast<const dynamics::SphereShape*>(shape1.get());
-
-    if (dynamics::SphereShape::getStaticType() == shapeType2) {
-      const auto* sphere1
-          = static_cast<const dynamics::SphereShape*>(shape2.get());
-
-      return collideSphereSphere(
-          o1, o2, sphere0->getRadius(), T1, sphere1->getRadius(), T2, result);
-    } else if (dynamics::BoxShape::getStaticType() == shapeType2) {
-      const auto* box1 = static_cast<const dynamics::BoxShape*>(shape2.get());
-
-      return collideSphereBox(
-          o1, o2, sphere0->getRadius(), T1, box1->getSize(), T2, result);
-    } else if (dynamics::EllipsoidShape::getStaticType() == shapeType2) {
-      const auto* ellipsoid1
-          = static_cast<const dynamics::EllipsoidShape*>(shape2.get());
-
-      return collideSphereSphere(
-          o1,
-          o2,
-          sphere0->getRadius(),
-          T1,
-          ellipsoid1->getRadii()[0],
-          T2,
-          result);
-    }
-  } else if (dynamics::BoxShape::getStaticType() == shapeType1) {
-    const auto* box0 = static_cast<const dynamics::BoxShape*>(shape1.get());
-
-    if (dynamics::SphereShape::getStaticType() == shapeType2) {
-      const auto* sphere1
-          = static_cast<const dynamics::SphereShape*>(shape2.get());
-
-      return collideBoxSphere(
-          o1, o2, box0->getSize(), T1, sphere1->getRadius(), T2, result);
-    } else if (dynamics::BoxShape::getStaticType() == shapeType2) {
-      const auto* box1 = static_cast<const dynamics::BoxShape*>(shape2.get());
-
-      return collideBoxBox(
-          o1, o2, box0->getSize(), T1, box1->getSize(), T2, result);
-    } else if (dynamics::EllipsoidShape::getStaticType() == shapeType2) {
-      const auto* ellipsoid1
-          = static_cast<const dynamics::EllipsoidShape*>(shape2.get());
-
-      return collideBoxSphere(
-          o1, o2, box0->getSize(), T1, ellipsoid1->getRadii()[0], T2, result);
+  switch (shape1->getTypeId()) {
+    case TypeId::Sphere:
+    case TypeId::Ellipsoid: {
+      const double radius0 = getSphereRadius(shape1);
+
+      switch (shape2->getTypeId()) {
+        case TypeId::Sphere:
+        case TypeId::Ellipsoid:
+          return collideSphereSphere(
+              o1, o2, radius0, T1, getSphereRadius(shape2), T2, result);
+        case TypeId::Box: {
+          const auto* box1 = static_cast<const dynamics::BoxShape*>(shape2);
+          return collideSphereBox(
+              o1, o2, radius0, T1, box1->getSize(), T2, result);
+        }
+        default:
+          break;
+      }
+      break;
     }
-  } else if (dynamics::EllipsoidShape::getStaticType() == shapeType1) {
-    const auto* ellipsoid0
-        = static_cast<const dynamics::EllipsoidShape*>(shape1.get());
-
-    if (dynamics::SphereShape::getStaticType() == shapeType2) {
-      const auto* sphere1
-          = static_cast<const dynamics::SphereShape*>(shape2.get());
-
-      return collideSphereSphere(
-          o1,
-          o2,
-          ellipsoid0->getRadii()[0],
-          T1,
-          sphere1->getRadius(),
-          T2,
-          result);
-    } else if (dynamics::BoxShape::getStaticType() == shapeType2) {
-      const auto* box1 = static_cast<const dynamics::BoxShape*>(shape2.get());
-
-      return collideSphereBox(
-          o1, o2, ellipsoid0->getRadii()[0], T1, box1->getSize(), T2, result);
-    } else if (dynamics::EllipsoidShape::getStaticType() == shapeType2) {
-      const auto* ellipsoid1
-          = static_cast<const dynamics::EllipsoidShape*>(shape2.get());
-
-      return collideSphereSphere(
-          o1,
-          o2,
-          ellipsoid0->getRadii()[0],
-          T1,
-          ellipsoid1->getRadii()[0],
-          T2,
-          result);
+    case TypeId::Box: {
+      const auto* box0 = static_cast<const dynamics::BoxShape*>(shape1);
+
+      switch (shape2->getTypeId()) {
+        case TypeId::Sphere:
+        case TypeId::Ellipsoid:
+          return collideBoxSphere(
+              o1,
+              o2,
+              box0->getSize(),
+              T1,
+              getSphereRadius(shape2),
+              T2,
+              result);
+        case TypeId::Box: {
+          const auto* box1 = static_cast<const dynamics::BoxShape*>(shape2);
+          return collideBoxBox(
+              o1, o2, box0->getSize(), T1, box1->getSize(), T2, result);
+        }
+        default:
+          break;
+      }
+      break;
     }
+    default:
+      break;
   }
 
   dterr << "[DARTCollisionDetector] Attempting to check for an "
@@ -34,14 +34,26 @@
 
 #include "dart/collision/CollisionFilter.hpp"
 #include "dart/collision/CollisionObject.hpp"
+#include "dart/collision/DistanceFilter.hpp"
 #include "dart/collision/dart/DARTCollide.hpp"
 #include "dart/collision/dart/DARTCollisionGroup.hpp"
 #include "dart/collision/dart/DARTCollisionObject.hpp"
+#include "dart/collision/dart/DARTDistance.hpp"
+#include "dart/collision/dart/DARTRaycast.hpp"
 #include "dart/dynamics/BoxShape.hpp"
 #include "dart/dynamics/EllipsoidShape.hpp"
 #include "dart/dynamics/ShapeFrame.hpp"
 #include "dart/dynamics/SphereShape.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <vector>
+
 namespace dart {
 namespace collision {
 
@@ -51,17 +63,34 @@ bool checkPair(
     CollisionObject* o1,
     CollisionObject* o2,
     const CollisionOption& option,
+    CollisionResult& pairResult,
+    std::vector<std::size_t>& hash,
     CollisionResult* result = nullptr);
 
 bool isClose(
     const Eigen::Vector3d& pos1, const Eigen::Vector3d& pos2, double tol);
 
+void clearContactPointHash(std::vector<std::size_t>& hash);
+
 void postProcess(
     CollisionObject* o1,
     CollisionObject* o2,
     const CollisionOption& option,
     CollisionResult& totalResult,
-    const CollisionResult& pairResult);
+    const CollisionResult& pairResult,
+    std::vector<std::size_t>& hash);
+
+template <typename ComputePairs>
+double computeMinDistance(
+    const std::vector<CollisionObject*>& objects1,
+    const std::vector<CollisionObject*>& objects2,
+    std::vector<DARTCollisionGroup::DistancePair>& pairs,
+    ComputePairs computePairs,
+    const DistanceOption& option,
+    DistanceResult* result);
+
+/// Number of rays of a batch that a thread casts at once
+constexpr std::size_t raysPerTask = 256u;
 
 } // anonymous namespace
 
@@ -140,28 +169,45 @@ bool DARTCollisionDetector::collide(
   if (objects.empty())
     return false;
 
+  casted->updateEngineData();
+
+  // Broadphase: only the pairs whose bounding boxes overlap reach the narrow
+  // phase
+  auto& pairs = casted->mOverlappingPairs;
+  casted->computeOverlappingPairs(pairs);
+
+  if (result)
+    clearContactPointHash(casted->mContactPointHash);
+
   auto collisionFound = false;
   const auto& filter = option.collisionFilter;
 
-  for (auto i = 0u; i < objects.size() - 1; ++i) {
-    auto* collObj1 = objects[i];
-
-    for (auto j = i + 1u; j < objects.size(); ++j) {
-      auto* collObj2 = objects[j];
+  for (const auto& pair : pairs) {
+    auto* collObj1 = objects[pair.first];
+    auto* collObj2 = objects[pair.second];
 
-      if (filter && filter->ignoresCollision(collObj1, collObj2))
-        continue;
+    if (!CollisionObject::canCollide(collObj1, collObj2, option))
+      continue;
 
-      collisionFound = checkPair(collObj1, collObj2, option, result);
+    if (filter && filter->ignoresCollision(collObj1, collObj2))
+      continue;
 
-      if (result) {
-        if (result->getNumContacts() >= option.maxNumContacts)
-          return true;
-      } else {
-        // If no result is passed, stop checking when the first contact is found
-        if (collisionFound)
-          return true;
-      }
+    if (checkPair(
+            collObj1,
+            collObj2,
+            option,
+            casted->mPairResult,
+            casted->mContactPointHash,
+            result))
+      collisionFound = true;
+
+    if (result) {
+      if (result->getNumContacts() >= option.maxNumContacts)
+        return true;
+    } else {
+      // If no result is passed, stop checking when the first contact is found
+      if (collisionFound)
+        return true;
     }
   }
 
@@ -197,28 +243,44 @@ bool DARTCollisionDetector::collide(
   if (objects1.empty() || objects2.empty())
     return false;
 
+  casted1->updateEngineData();
+  casted2->updateEngineData();
+
+  auto& pairs = casted1->mOverlappingPairs;
+  casted1->computeOverlappingPairs(*casted2, pairs);
+
+  if (result)
+    clearContactPointHash(casted1->mContactPointHash);
+
   auto collisionFound = false;
   const auto& filter = option.collisionFilter;
 
-  for (auto i = 0u; i < objects1.size(); ++i) {
-    auto* collObj1 = objects1[i];
-
-    for (auto j = 0u; j < objects2.size(); ++j) {
-      auto* collObj2 = objects2[j];
+  for (const auto& pair : pairs) {
+    auto* collObj1 = objects1[pair.first];
+    auto* collObj2 = objects2[pair.second];
 
-      if (filter && filter->ignoresCollision(collObj1, collObj2))
-        continue;
+    if (!CollisionObject::canCollide(collObj1, collObj2, option))
+      continue;
 
-      collisionFound = checkPair(collObj1, collObj2, option, result);
+    if (filter && filter->ignoresCollision(collObj1, collObj2))
+      continue;
 
-      if (result) {
-        if (result->getNumContacts() >= option.maxNumContacts)
-          return true;
-      } else {
-        // If no result is passed, stop checking when the first contact is found
-        if (collisionFound)
-          return true;
-      }
+    if (checkPair(
+            collObj1,
+            collObj2,
+            option,
+            casted1->mPairResult,
+            casted1->mContactPointHash,
+            result))
+      collisionFound = true;
+
+    if (result) {
+      if (result->getNumContacts() >= option.maxNumContacts)
+        return true;
+    } else {
+      // If no result is passed, stop checking when the first contact is found
+      if (collisionFound)
+        return true;
     }
   }
 
@@ -228,27 +290,197 @@ bool DARTCollisionDetector::collide(
 
 //==============================================================================
 double DARTCollisionDetector::distance(
-    CollisionGroup* /*group*/,
-    const DistanceOption& /*option*/,
-    DistanceResult* /*result*/)
+    CollisionGroup* group, const DistanceOption& option, DistanceResult* result)
 {
-  dtwarn << "[DARTCollisionDetector::distance] This collision detector does "
-         << "not support (signed) distance queries. Returning 0.0.\n";
+  if (result)
+    result->clear();
+
+  if (!checkGroupValidity(this, group))
+    return 0.0;
+
+  auto casted = static_cast<DARTCollisionGroup*>(group);
+  const auto& objects = casted->mCollisionObjects;
 
-  return 0.0;
+  if (objects.size() < 2u)
+    return 0.0;
+
+  casted->updateEngineData();
+
+  auto& pairs = casted->mDistancePairs;
+  const auto computePairs = [&](double minGap, double maxGap) {
+    return casted->computeDistancePairs(minGap, maxGap, pairs);
+  };
+
+  return computeMinDistance(
+      objects, objects, pairs, computePairs, option, result);
 }
 
 //==============================================================================
 double DARTCollisionDetector::distance(
-    CollisionGroup* /*group1*/,
-    CollisionGroup* /*group2*/,
-    const DistanceOption& /*option*/,
-    DistanceResult* /*result*/)
+    CollisionGroup* group1,
+    CollisionGroup* group2,
+    const DistanceOption& option,
+    DistanceResult* result)
+{
+  if (result)
+    result->clear();
+
+  if (!checkGroupValidity(this, group1))
+    return 0.0;
+
+  if (!checkGroupValidity(this, group2))
+    return 0.0;
+
+  auto casted1 = static_cast<DARTCollisionGroup*>(group1);
+  auto casted2 = static_cast<DARTCollisionGroup*>(group2);
+
+  const auto& objects1 = casted1->mCollisionObjects;
+  const auto& objects2 = casted2->mCollisionObjects;
+
+  if (objects1.empty() || objects2.empty())
+    return 0.0;
+
+  casted1->updateEngineData();
+  casted2->updateEngineData();
+
+  auto& pairs = casted1->mDistancePairs;
+  const auto computePairs = [&](double minGap, double maxGap) {
+    return casted1->computeDistancePairs(*casted2, minGap, maxGap, pairs);
+  };
+
+  return computeMinDistance(
+      objects1, objects2, pairs, computePairs, option, result);
+}
+
+//==============================================================================
+bool DARTCollisionDetector::raycast(
+    CollisionGroup* group,
+    const Eigen::Vector3d& from,
+    const Eigen::Vector3d& to,
+    const RaycastOption& option,
+    RaycastResult* result)
+{
+  if (result)
+    result->clear();
+
+  if (!checkGroupValidity(this, group))
+    return false;
+
+  auto casted = static_cast<DARTCollisionGroup*>(group);
+  casted->updateEngineData();
+
+  const Eigen::Vector3d dir = to - from;
+  RayHit closest;
+  auto hit = false;
+
+  for (const auto* object : casted->mCollisionObjects) {
+    const auto* dartObject = static_cast<const DARTCollisionObject*>(object);
+    if (!intersectRayAabb(
+            from,
+            dir,
+            dartObject->getWorldAabbMin(),
+            dartObject->getWorldAabbMax(),
+            1.0))
+      continue;
+
+    RayHit rayHit;
+    if (!intersectRay(
+            object, from, dir, 1.0, rayHit.mFraction, rayHit.mNormal))
+      continue;
+
+    rayHit.mCollisionObject = object;
+    rayHit.mPoint = from + rayHit.mFraction * dir;
+
+    if (option.mEnableAllHits) {
+      if (!result)
+        return true;
+      result->mRayHits.push_back(rayHit);
+    } else if (!hit || rayHit.mFraction < closest.mFraction) {
+      closest = rayHit;
+    }
+
+    hit = true;
+  }
+
+  if (!result || !hit)
+    return hit;
+
+  if (!option.mEnableAllHits) {
+    result->mRayHits.push_back(closest);
+  } else if (option.mSortByClosest) {
+    std::sort(
+        result->mRayHits.begin(),
+        result->mRayHits.end(),
+        [](const RayHit& a, const RayHit& b) {
+          return a.mFraction < b.mFraction;
+        });
+  }
+
+  return true;
+}
+
+//==============================================================================
+std::size_t DARTCollisionDetector::raycastBatch(
+    CollisionGroup* group,
+    const Eigen::Ref<const Eigen::Matrix3Xd>& origins,
+    const Eigen::Ref<const Eigen::Matrix3Xd>& directions,
+    RaycastBatchResult& result)
 {
-  dtwarn << "[DARTCollisionDetector::distance] This collision detector does "
-         << "not support (signed) distance queries. Returning 0.0.\n";
+  if (!checkGroupValidity(this, group))
+    return 0u;
+
+  if (origins.cols() != directions.cols()) {
+    dterr << "[DARTCollisionDetector::raycastBatch] The numbers of origins ("
+          << origins.cols() << ") and directions (" << directions.cols()
+          << ") differ.\n";
+    return 0u;
+  }
+
+  const auto numRays = static_cast<std::size_t>(origins.cols());
+  result.resize(numRays);
 
-  return 0.0;
+  // The bounding boxes and the hierarchy over them are built once and then
+  // only read by the rays
+  auto casted = static_cast<DARTCollisionGroup*>(group);
+  casted->updateEngineData();
+  casted->buildRaycastTree();
+
+  const auto castRays = [&](std::size_t begin, std::size_t end) {
+    std::size_t numHits = 0u;
+    for (auto i = begin; i < end; ++i) {
+      double fraction;
+      Eigen::Vector3d normal;
+      const auto* object = casted->raycastClosest(
+          origins.col(i), directions.col(i), fraction, normal);
+
+      result.mCollisionObjects[i] = object;
+      if (!object) {
+        result.mDistances[i] = std::numeric_limits<double>::infinity();
+        result.mNormals.col(i).setZero();
+        continue;
+      }
+
+      result.mDistances[i] = fraction * directions.col(i).norm();
+      result.mNormals.col(i) = normal;
+      ++numHits;
+    }
+    return numHits;
+  };
+
+  // Another batched query that uses the pool, possibly the one whose task
+  // made this call, leaves this one to the calling thread
+  std::unique_lock<std::mutex> lock(mThreadPoolMutex, std::try_to_lock);
+  if (!lock.owns_lock() || !mThreadPool || numRays <= raysPerTask)
+    return castRays(0u, numRays);
+
+  std::atomic<std::size_t> numHits{0u};
+  const auto numTasks = (numRays + raysPerTask - 1u) / raysPerTask;
+  mThreadPool->parallelFor(numTasks, [&](std::size_t task, std::size_t) {
+    const auto begin = task * raysPerTask;
+    numHits += castRays(begin, std::min(begin + raysPerTask, numRays));
+  });
+
+  return numHits;
 }
 
 //==============================================================================
@@ -264,24 +496,22 @@ void warnUnsupportedShapeType(const dynamics::ShapeFrame* shapeFrame)
     return;
 
   const auto& shape = shapeFrame->getShape();
-  const auto& shapeType = shape->getType();
 
-  if (shapeType == dynamics::SphereShape::getStaticType())
-    return;
-
-  if (shapeType == dynamics::BoxShape::getStaticType())
-    return;
-
-  if (shapeType == dynamics::EllipsoidShape::getStaticType()) {
-    const auto& ellipsoid
-        = std::static_pointer_cast<const dynamics::EllipsoidShape>(shape);
-
-    if (ellipsoid->isSphere())
+  switch (shape->getTypeId()) {
+    case dynamics::Shape::TypeId::Sphere:
+    case dynamics::Shape::TypeId::Box:
       return;
+    case dynamics::Shape::TypeId::Ellipsoid:
+      if (static_cast<const dynamics::EllipsoidShape*>(shape.get())
+              ->isSphere())
+        return;
+      break;
+    default:
+      break;
   }
 
   dterr << "[DARTCollisionDetector] Attempting to create shape type ["
-        << shapeType << "] that is not supported "
+        << shape->getType() << "] that is not supported "
         << "by DARTCollisionDetector. Currently, only BoxShape and "
         << "EllipsoidShape (only when all the radii are equal) are "
         << "supported. This shape will always get penetrated by other "
@@ -311,9 +541,11 @@ bool checkPair(
     CollisionObject* o1,
     CollisionObject* o2,
     const CollisionOption& option,
+    CollisionResult& pairResult,
+    std::vector<std::size_t>& hash,
     CollisionResult* result)
 {
-  CollisionResult pairResult;
+  pairResult.clear();
 
   // Perform narrow-phase detection
   collide(o1, o2, pairResult);
@@ -322,7 +554,7 @@ bool checkPair(
   if (!result)
     return pairResult.isCollision();
 
-  postProcess(o1, o2, option, *result, pairResult);
+  postProcess(o1, o2, option, *result, pairResult, hash);
 
   return pairResult.isCollision();
 }
@@ -334,13 +566,122 @@ bool isClose(
   return (pos1 - pos2).norm() < tol;
 }
 
+//==============================================================================
+/// Returns the coordinates of the cell of the given edge length that contains
+/// the point, which must be finite
+Eigen::Matrix<std::int64_t, 3, 1> computeCell(
+    const Eigen::Vector3d& point, double cellSize)
+{
+  assert(point.allFinite());
+
+  // Clamp far away points to keep the conversion defined
+  constexpr double maxCoord = 1e18;
+  return (point / cellSize)
+      .array()
+      .floor()
+      .min(maxCoord)
+      .max(-maxCoord)
+      .cast<std::int64_t>()
+      .matrix();
+}
+
+//==============================================================================
+std::size_t hashCell(const Eigen::Matrix<std::int64_t, 3, 1>& cell)
+{
+  const auto x = static_cast<std::uint64_t>(cell[0]);
+  const auto y = static_cast<std::uint64_t>(cell[1]);
+  const auto z = static_cast<std::uint64_t>(cell[2]);
+
+  return static_cast<std::size_t>(
+      x * 73856093u ^ y * 19349663u ^ z * 83492791u);
+}
+
+//==============================================================================
+void clearContactPointHash(std::vector<std::size_t>& hash)
+{
+  std::fill(hash.begin(), hash.end(), 0u);
+}
+
+//==============================================================================
+/// Inserts the index-th contact of result into the hash without checking for
+/// repeated points. The hash must have a free slot.
+void insertContactPoint(
+    std::vector<std::size_t>& hash,
+    const CollisionResult& result,
+    std::size_t index,
+    double cellSize)
+{
+  const auto mask = hash.size() - 1u;
+  const auto cell = computeCell(result.getContact(index).point, cellSize);
+
+  auto slot = hashCell(cell) & mask;
+  while (hash[slot] != 0u)
+    slot = (slot + 1u) & mask;
+
+  hash[slot] = index + 1u;
+}
+
+//==============================================================================
+/// Makes sure the hash has room for one more contact of result, growing and
+/// refilling it when it is more than half full
+void reserveContactPoint(
+    std::vector<std::size_t>& hash,
+    const CollisionResult& result,
+    double cellSize)
+{
+  const auto numContacts = result.getNumContacts();
+  if (2u * (numContacts + 1u) <= hash.size())
+    return;
+
+  auto size = std::max<std::size_t>(hash.size(), 64u);
+  while (size < 2u * (numContacts + 1u))
+    size *= 2u;
+
+  hash.assign(size, 0u);
+  for (auto i = 0u; i < numContacts; ++i)
+    insertContactPoint(hash, result, i, cellSize);
+}
+
+//==============================================================================
+/// Returns true if result has a contact closer than tol to the point. Only
+/// the cells adjacent to the cell of the point, whose edge length is tol, can
+/// hold such a contact.
+bool hasCloseContactPoint(
+    const std::vector<std::size_t>& hash,
+    const CollisionResult& result,
+    const Eigen::Vector3d& point,
+    double tol)
+{
+  const auto mask = hash.size() - 1u;
+  const auto cell = computeCell(point, tol);
+
+  for (auto dx = -1; dx <= 1; ++dx) {
+    for (auto dy = -1; dy <= 1; ++dy) {
+      for (auto dz = -1; dz <= 1; ++dz) {
+        const Eigen::Matrix<std::int64_t, 3, 1> neighbor
+            = cell + Eigen::Matrix<std::int64_t, 3, 1>(dx, dy, dz);
+
+        for (auto slot = hashCell(neighbor) & mask; hash[slot] != 0u;
+             slot = (slot + 1u) & mask) {
+          const auto& contact = result.getContact(hash[slot] - 1u);
+          if (isClose(point, contact.point, tol))
+            return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
 //==============================================================================
 void postProcess(
     CollisionObject* o1,
     CollisionObject* o2,
     const CollisionOption& option,
     CollisionResult& totalResult,
-    const CollisionResult& pairResult)
+    const CollisionResult& pairResult,
+    std::vector<std::size_t>& hash)
 {
   if (!pairResult.isCollision())
     return;
@@ -348,29 +689,124 @@ void postProcess(
   // Don't add repeated points
   const auto tol = 3.0e-12;
 
-  for (auto pairContact : pairResult.getContacts()) {
-    auto foundClose = false;
+  for (const auto& pairContact : pairResult.getContacts()) {
+    // A degenerate contact without a finite point has no cell in the hash
+    if (!pairContact.point.allFinite())
+      continue;
 
-    for (auto totalContact : totalResult.getContacts()) {
-      if (isClose(pairContact.point, totalContact.point, tol)) {
-        foundClose = true;
-        break;
-      }
-    }
+    reserveContactPoint(hash, totalResult, tol);
 
-    if (foundClose)
+    if (hasCloseContactPoint(hash, totalResult, pairContact.point, tol))
       continue;
 
     auto contact = pairContact;
     contact.collisionObject1 = o1;
     contact.collisionObject2 = o2;
     totalResult.addContact(contact);
+    insertContactPoint(
+        hash, totalResult, totalResult.getNumContacts() - 1u, tol);
 
     if (totalResult.getNumContacts() >= option.maxNumContacts)
       break;
   }
 }
 
+//==============================================================================
+/// Runs the narrow phase on the candidate pairs, starting from the pairs with
+/// the nearest bounding boxes, and returns the minimum distance clamped by the
+/// lower bound of the option, or zero if no pair was checked.
+///
+/// computePairs(minGap, maxGap) collects the pairs whose bounding boxes are
+/// more than minGap and at most maxGap apart along the x-axis into pairs and
+/// returns the smallest gap beyond maxGap. The range starts with the pairs
+/// that overlap along the x-axis and is widened up to the minimum distance
+/// found, since no pair farther apart along the x-axis can be closer.
+template <typename ComputePairs>
+double computeMinDistance(
+    const std::vector<CollisionObject*>& objects1,
+    const std::vector<CollisionObject*>& objects2,
+    std::vector<DARTCollisionGroup::DistancePair>& pairs,
+    ComputePairs computePairs,
+    const DistanceOption& option,
+    DistanceResult* result)
+{
+  const auto& filter = option.distanceFilter;
+  const auto greater = std::greater<DARTCollisionGroup::DistancePair>();
+
+  auto found = false;
+  auto minDistance = 0.0;
+  Eigen::Vector3d point1;
+  Eigen::Vector3d point2;
+
+  auto minGap = -std::numeric_limits<double>::infinity();
+  auto maxGap = 0.0;
+
+  while (true) {
+    const double nextGap = computePairs(minGap, maxGap);
+
+    auto reachedLowerBound = false;
+    for (auto end = pairs.end(); end != pairs.begin(); --end) {
+      std::pop_heap(pairs.begin(), end, greater);
+      const auto& candidate = *(end - 1);
+
+      // The distance between the bounding boxes is a lower bound of the
+      // distance between the shapes only when the boxes are apart, and every
+      // remaining pair is at least as far.
+      const double aabbDistance = candidate.first;
+      if (found && aabbDistance > 0.0 && aabbDistance >= minDistance)
+        break;
+
+      auto* collObj1 = objects1[candidate.second.first];
+      auto* collObj2 = objects2[candidate.second.second];
+
+      if (filter && !filter->needDistance(collObj1, collObj2))
+        continue;
+
+      double distance;
+      if (!signedDistance(collObj1, collObj2, distance, point1, point2))
+        continue;
+
+      if (found && distance >= minDistance)
+        continue;
+
+      found = true;
+      minDistance = distance;
+
+      if (result) {
+        result->unclampedMinDistance = distance;
+        result->minDistance = std::max(distance, option.distanceLowerBound);
+        result->shapeFrame1 = collObj1->getShapeFrame();
+        result->shapeFrame2 = collObj2->getShapeFrame();
+
+        if (option.enableNearestPoints) {
+          result->nearestPoint1 = point1;
+          result->nearestPoint2 = point2;
+        }
+      }
+
+      if (distance <= option.distanceLowerBound) {
+        reachedLowerBound = true;
+        break;
+      }
+    }
+
+    // The remaining pairs are at least nextGap apart, which is positive
+    if (reachedLowerBound || std::isinf(nextGap)
+        || (found && nextGap >= minDistance))
+      break;
+
+    // Without a distance yet, the range at least doubles so that the number
+    // of sweeps stays logarithmic
+    minGap = maxGap;
+    maxGap = found ? minDistance : std::max(nextGap, 2.0 * maxGap);
+  }
+
+  if (!found)
+    return 0.0;
+
+  return std::max(minDistance, option.distanceLowerBound);
+}
+
 } // anonymous namespace
 
 } // namespace collision
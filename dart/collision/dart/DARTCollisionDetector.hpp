@@ -88,6 +88,21 @@ public:
       const DistanceOption& option = DistanceOption(false, 0.0, nullptr),
       DistanceResult* result = nullptr) override;
 
+  // Documentation inherited
+  bool raycast(
+      CollisionGroup* group,
+      const Eigen::Vector3d& from,
+      const Eigen::Vector3d& to,
+      const RaycastOption& option = RaycastOption(),
+      RaycastResult* result = nullptr) override;
+
+  // Documentation inherited
+  std::size_t raycastBatch(
+      CollisionGroup* group,
+      const Eigen::Ref<const Eigen::Matrix3Xd>& origins,
+      const Eigen::Ref<const Eigen::Matrix3Xd>& directions,
+      RaycastBatchResult& result) override;
+
 protected:
   /// Constructor
   DARTCollisionDetector();
@@ -33,14 +33,162 @@
 #include "dart/collision/dart/DARTCollisionGroup.hpp"
 
 #include "dart/collision/CollisionObject.hpp"
+#include "dart/collision/dart/DARTCollisionObject.hpp"
+#include "dart/collision/dart/DARTRaycast.hpp"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <limits>
+#include <numeric>
 
 namespace dart {
 namespace collision {
 
+namespace {
+
+//==============================================================================
+const DARTCollisionObject* toDARTObject(const CollisionObject* object)
+{
+  return static_cast<const DARTCollisionObject*>(object);
+}
+
+//==============================================================================
+bool overlapsInYZ(const DARTCollisionObject* o1, const DARTCollisionObject* o2)
+{
+  const Eigen::Vector3d& min1 = o1->getWorldAabbMin();
+  const Eigen::Vector3d& max1 = o1->getWorldAabbMax();
+  const Eigen::Vector3d& min2 = o2->getWorldAabbMin();
+  const Eigen::Vector3d& max2 = o2->getWorldAabbMax();
+
+  return min1[1] <= max2[1] && min2[1] <= max1[1] && min1[2] <= max2[2]
+         && min2[2] <= max1[2];
+}
+
+//==============================================================================
+/// Returns the distance between the bounding boxes of the objects, or zero if
+/// they overlap
+double computeAabbDistance(
+    const DARTCollisionObject* o1, const DARTCollisionObject* o2)
+{
+  const Eigen::Vector3d gap
+      = (o2->getWorldAabbMin() - o1->getWorldAabbMax())
+            .cwiseMax(o1->getWorldAabbMin() - o2->getWorldAabbMax())
+            .cwiseMax(0.0);
+
+  return gap.norm();
+}
+
+//==============================================================================
+/// Calls addPair for each object of sorted[begin, end) whose bounding box
+/// starts more than minGap and at most maxGap beyond maxX along the x-axis,
+/// and returns the gap of the first object beyond maxGap, or infinity if there
+/// is none. The objects at most minGap beyond maxX are skipped by binary
+/// search since sorted is ordered by the lower bounds of the bounding boxes.
+template <typename AddPair>
+double sweepDistancePairs(
+    const std::vector<CollisionObject*>& objects,
+    const std::vector<std::size_t>& sorted,
+    std::size_t begin,
+    double maxX,
+    double minGap,
+    double maxGap,
+    AddPair addPair)
+{
+  const auto gap = [&](std::size_t index) {
+    return toDARTObject(objects[index])->getWorldAabbMin()[0] - maxX;
+  };
+
+  auto it = std::upper_bound(
+      sorted.begin() + begin,
+      sorted.end(),
+      minGap,
+      [&](double value, std::size_t index) { return value < gap(index); });
+
+  for (; it != sorted.end(); ++it) {
+    const double objectGap = gap(*it);
+    if (objectGap > maxGap)
+      return objectGap;
+
+    addPair(*it);
+  }
+
+  return std::numeric_limits<double>::infinity();
+}
+
+//==============================================================================
+/// Maximum number of objects in a leaf of the raycast hierarchy
+constexpr std::size_t maxRaycastLeafSize = 4u;
+
+//==============================================================================
+/// Appends the node covering indices[begin, end) and its descendants to nodes
+void buildRaycastNode(
+    const std::vector<CollisionObject*>& objects,
+    std::vector<std::size_t>& indices,
+    std::vector<DARTCollisionGroup::RaycastNode>& nodes,
+    std::size_t begin,
+    std::size_t end)
+{
+  const auto nodeIndex = nodes.size();
+  nodes.emplace_back();
+
+  Eigen::Vector3d min = Eigen::Vector3d::Constant(
+      std::numeric_limits<double>::infinity());
+  Eigen::Vector3d max = -min;
+  Eigen::Vector3d centerMin = min;
+  Eigen::Vector3d centerMax = max;
+
+  for (auto i = begin; i < end; ++i) {
+    const auto* object = toDARTObject(objects[indices[i]]);
+    const Eigen::Vector3d& objectMin = object->getWorldAabbMin();
+    const Eigen::Vector3d& objectMax = object->getWorldAabbMax();
+    const Eigen::Vector3d center = 0.5 * (objectMin + objectMax);
+
+    min = min.cwiseMin(objectMin);
+    max = max.cwiseMax(objectMax);
+    centerMin = centerMin.cwiseMin(center);
+    centerMax = centerMax.cwiseMax(center);
+  }
+
+  std::size_t secondChild = 0u;
+
+  Eigen::Vector3d::Index axis;
+  const double extent = (centerMax - centerMin).maxCoeff(&axis);
+
+  if (end - begin > maxRaycastLeafSize && extent > 0.0) {
+    const auto middle = begin + (end - begin) / 2u;
+    std::nth_element(
+        indices.begin() + begin,
+        indices.begin() + middle,
+        indices.begin() + end,
+        [&](std::size_t a, std::size_t b) {
+          const auto* objectA = toDARTObject(objects[a]);
+          const auto* objectB = toDARTObject(objects[b]);
+          return objectA->getWorldAabbMin()[axis]
+                     + objectA->getWorldAabbMax()[axis]
+                 < objectB->getWorldAabbMin()[axis]
+                       + objectB->getWorldAabbMax()[axis];
+        });
+
+    buildRaycastNode(objects, indices, nodes, begin, middle);
+    secondChild = nodes.size();
+    buildRaycastNode(objects, indices, nodes, middle, end);
+  }
+
+  auto& node = nodes[nodeIndex];
+  node.mMin = min;
+  node.mMax = max;
+  node.mBegin = begin;
+  node.mEnd = end;
+  node.mSecondChild = secondChild;
+}
+
+} // anonymous namespace
+
 //==============================================================================
 DARTCollisionGroup::DARTCollisionGroup(
     const CollisionDetectorPtr& collisionDetector)
-  : CollisionGroup(collisionDetector)
+  : CollisionGroup(collisionDetector), mSortedIndicesDirty(true)
 {
   // Do nothing
 }
@@ -57,6 +205,7 @@ void DARTCollisionGroup::addCollisionObjectToEngine(CollisionObject* object)
   if (std::find(mCollisionObjects.begin(), mCollisionObjects.end(), object)
       == mCollisionObjects.end()) {
     mCollisionObjects.push_back(object);
+    mSortedIndicesDirty = true;
   }
 }
 
@@ -74,18 +223,311 @@ void DARTCollisionGroup::removeCollisionObjectFromEngine(
 {
   mCollisionObjects.erase(
       std::remove(mCollisionObjects.begin(), mCollisionObjects.end(), object));
+  mSortedIndicesDirty = true;
 }
 
 //==============================================================================
 void DARTCollisionGroup::removeAllCollisionObjectsFromEngine()
 {
   mCollisionObjects.clear();
+  mSortedIndicesDirty = true;
 }
 
 //==============================================================================
 void DARTCollisionGroup::updateCollisionGroupEngineData()
 {
-  // Do nothing
+  const auto minX = [this](std::size_t index) {
+    return toDARTObject(mCollisionObjects[index])->getWorldAabbMin()[0];
+  };
+
+  if (mSortedIndicesDirty) {
+    mSortedIndices.resize(mCollisionObjects.size());
+    std::iota(mSortedIndices.begin(), mSortedIndices.end(), 0u);
+    std::sort(
+        mSortedIndices.begin(),
+        mSortedIndices.end(),
+        [&](std::size_t a, std::size_t b) { return minX(a) < minX(b); });
+    mSortedIndicesDirty = false;
+    return;
+  }
+
+  // Nothing moved, so the previous order is still sorted
+  if (mUpdatedObjects.empty())
+    return;
+
+  // The objects only moved since the last update, so the previous order is
+  // nearly sorted and insertion sort repairs it in almost linear time.
+  for (auto i = 1u; i < mSortedIndices.size(); ++i) {
+    const std::size_t index = mSortedIndices[i];
+    const double key = minX(index);
+
+    auto j = i;
+    while (j > 0u && minX(mSortedIndices[j - 1u]) > key) {
+      mSortedIndices[j] = mSortedIndices[j - 1u];
+      --j;
+    }
+    mSortedIndices[j] = index;
+  }
+}
+
+//==============================================================================
+void DARTCollisionGroup::computeOverlappingPairs(
+    std::vector<IndexPair>& pairs) const
+{
+  pairs.clear();
+
+  const auto numObjects = mSortedIndices.size();
+  for (auto i = 0u; i < numObjects; ++i) {
+    const std::size_t index1 = mSortedIndices[i];
+    const auto* object1 = toDARTObject(mCollisionObjects[index1]);
+    const double maxX = object1->getWorldAabbMax()[0];
+
+    for (auto j = i + 1u; j < numObjects; ++j) {
+      const std::size_t index2 = mSortedIndices[j];
+      const auto* object2 = toDARTObject(mCollisionObjects[index2]);
+
+      // Every remaining object starts beyond the end of object1 along x
+      if (object2->getWorldAabbMin()[0] > maxX)
+        break;
+
+      if (!overlapsInYZ(object1, object2))
+        continue;
+
+      pairs.emplace_back(std::min(index1, index2), std::max(index1, index2));
+    }
+  }
+
+  std::sort(pairs.begin(), pairs.end());
+}
+
+//==============================================================================
+void DARTCollisionGroup::computeOverlappingPairs(
+    const DARTCollisionGroup& otherGroup, std::vector<IndexPair>& pairs) const
+{
+  pairs.clear();
+
+  const auto& sorted1 = mSortedIndices;
+  const auto& sorted2 = otherGroup.mSortedIndices;
+  const auto& objects1 = mCollisionObjects;
+  const auto& objects2 = otherGroup.mCollisionObjects;
+
+  // Walk the two sorted lists in merged order. Each object is tested against
+  // the not-yet-visited objects of the other list that start before it ends.
+  auto i = 0u;
+  auto j = 0u;
+  while (i < sorted1.size() && j < sorted2.size()) {
+    const auto* object1 = toDARTObject(objects1[sorted1[i]]);
+    const auto* object2 = toDARTObject(objects2[sorted2[j]]);
+
+    if (object1->getWorldAabbMin()[0] <= object2->getWorldAabbMin()[0]) {
+      const double maxX = object1->getWorldAabbMax()[0];
+      for (auto k = j; k < sorted2.size(); ++k) {
+        const auto* other = toDARTObject(objects2[sorted2[k]]);
+        if (other->getWorldAabbMin()[0] > maxX)
+          break;
+
+        if (overlapsInYZ(object1, other))
+          pairs.emplace_back(sorted1[i], sorted2[k]);
+      }
+      ++i;
+    } else {
+      const double maxX = object2->getWorldAabbMax()[0];
+      for (auto k = i; k < sorted1.size(); ++k) {
+        const auto* other = toDARTObject(objects1[sorted1[k]]);
+        if (other->getWorldAabbMin()[0] > maxX)
+          break;
+
+        if (overlapsInYZ(other, object2))
+          pairs.emplace_back(sorted1[k], sorted2[j]);
+      }
+      ++j;
+    }
+  }
+
+  std::sort(pairs.begin(), pairs.end());
+}
+
+//==============================================================================
+double DARTCollisionGroup::computeDistancePairs(
+    double minGap, double maxGap, std::vector<DistancePair>& pairs) const
+{
+  pairs.clear();
+
+  auto nextGap = std::numeric_limits<double>::infinity();
+
+  const auto numObjects = mSortedIndices.size();
+  for (auto i = 0u; i < numObjects; ++i) {
+    const std::size_t index1 = mSortedIndices[i];
+    const auto* object1 = toDARTObject(mCollisionObjects[index1]);
+
+    // Only the objects that start after object1 are swept, so that each pair
+    // is visited once
+    const double gap = sweepDistancePairs(
+        mCollisionObjects,
+        mSortedIndices,
+        i + 1u,
+        object1->getWorldAabbMax()[0],
+        minGap,
+        maxGap,
+        [&](std::size_t index2) {
+          const auto* object2 = toDARTObject(mCollisionObjects[index2]);
+          pairs.emplace_back(
+              computeAabbDistance(object1, object2),
+              IndexPair(std::min(index1, index2), std::max(index1, index2)));
+        });
+    nextGap = std::min(nextGap, gap);
+  }
+
+  // Building the heap is linear, while sorting would pay for the pairs that
+  // the query never visits
+  std::make_heap(pairs.begin(), pairs.end(), std::greater<DistancePair>());
+
+  return nextGap;
+}
+
+//==============================================================================
+double DARTCollisionGroup::computeDistancePairs(
+    const DARTCollisionGroup& otherGroup,
+    double minGap,
+    double maxGap,
+    std::vector<DistancePair>& pairs) const
+{
+  pairs.clear();
+
+  const auto& sorted1 = mSortedIndices;
+  const auto& sorted2 = otherGroup.mSortedIndices;
+  const auto& objects1 = mCollisionObjects;
+  const auto& objects2 = otherGroup.mCollisionObjects;
+
+  const auto minX = [](const CollisionObject* object) {
+    return toDARTObject(object)->getWorldAabbMin()[0];
+  };
+
+  auto nextGap = std::numeric_limits<double>::infinity();
+
+  // Each pair is swept from the object that starts first along the x-axis,
+  // and from the object of this group on ties as in computeOverlappingPairs()
+  for (const std::size_t index1 : sorted1) {
+    const auto* object1 = toDARTObject(objects1[index1]);
+    const auto begin = std::lower_bound(
+        sorted2.begin(),
+        sorted2.end(),
+        minX(object1),
+        [&](std::size_t index, double value) {
+          return minX(objects2[index]) < value;
+        });
+
+    const double gap = sweepDistancePairs(
+        objects2,
+        sorted2,
+        static_cast<std::size_t>(begin - sorted2.begin()),
+        object1->getWorldAabbMax()[0],
+        minGap,
+        maxGap,
+        [&](std::size_t index2) {
+          pairs.emplace_back(
+              computeAabbDistance(object1, toDARTObject(objects2[index2])),
+              IndexPair(index1, index2));
+        });
+    nextGap = std::min(nextGap, gap);
+  }
+
+  for (const std::size_t index2 : sorted2) {
+    const auto* object2 = toDARTObject(objects2[index2]);
+    const auto begin = std::upper_bound(
+        sorted1.begin(),
+        sorted1.end(),
+        minX(object2),
+        [&](double value, std::size_t index) {
+          return value < minX(objects1[index]);
+        });
+
+    const double gap = sweepDistancePairs(
+        objects1,
+        sorted1,
+        static_cast<std::size_t>(begin - sorted1.begin()),
+        object2->getWorldAabbMax()[0],
+        minGap,
+        maxGap,
+        [&](std::size_t index1) {
+          pairs.emplace_back(
+              computeAabbDistance(toDARTObject(objects1[index1]), object2),
+              IndexPair(index1, index2));
+        });
+    nextGap = std::min(nextGap, gap);
+  }
+
+  std::make_heap(pairs.begin(), pairs.end(), std::greater<DistancePair>());
+
+  return nextGap;
+}
+
+//==============================================================================
+void DARTCollisionGroup::buildRaycastTree()
+{
+  mRaycastNodes.clear();
+
+  mRaycastIndices.resize(mCollisionObjects.size());
+  std::iota(mRaycastIndices.begin(), mRaycastIndices.end(), 0u);
+
+  if (!mCollisionObjects.empty()) {
+    buildRaycastNode(
+        mCollisionObjects,
+        mRaycastIndices,
+        mRaycastNodes,
+        0u,
+        mRaycastIndices.size());
+  }
+}
+
+//==============================================================================
+const CollisionObject* DARTCollisionGroup::raycastClosest(
+    const Eigen::Vector3d& from,
+    const Eigen::Vector3d& dir,
+    double& fraction,
+    Eigen::Vector3d& normal) const
+{
+  const CollisionObject* closest = nullptr;
+  if (mRaycastNodes.empty())
+    return closest;
+
+  // Median splits keep the tree balanced, so its depth stays far below the
+  // size of the stack
+  std::array<std::size_t, 64> stack;
+  std::size_t stackSize = 0u;
+  stack[stackSize++] = 0u;
+
+  double maxFraction = 1.0;
+  double hitFraction;
+  Eigen::Vector3d hitNormal;
+
+  while (stackSize > 0u) {
+    const auto nodeIndex = stack[--stackSize];
+    const auto& node = mRaycastNodes[nodeIndex];
+
+    if (!intersectRayAabb(from, dir, node.mMin, node.mMax, maxFraction))
+      continue;
+
+    if (node.mSecondChild != 0u) {
+      stack[stackSize++] = node.mSecondChild;
+      stack[stackSize++] = nodeIndex + 1u;
+      continue;
+    }
+
+    for (auto i = node.mBegin; i < node.mEnd; ++i) {
+      const auto* object = mCollisionObjects[mRaycastIndices[i]];
+      if (!intersectRay(object, from, dir, maxFraction, hitFraction, hitNormal))
+        continue;
+
+      // Only hits closer than this one are searched from now on
+      maxFraction = hitFraction;
+      fraction = hitFraction;
+      normal = hitNormal;
+      closest = object;
+    }
+  }
+
+  return closest;
 }
 
 } // namespace collision
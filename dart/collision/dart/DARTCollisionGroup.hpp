@@ -34,6 +34,10 @@
 #define DART_COLLISION_DART_DARTCOLLISIONGROUP_HPP_
 
 #include <dart/collision/CollisionGroup.hpp>
+#include <dart/collision/CollisionResult.hpp>
+
+#include <utility>
+#include <vector>
 
 namespace dart {
 namespace collision {
@@ -51,7 +55,33 @@ public:
   /// Destructor
   virtual ~DARTCollisionGroup() = default;
 
+  /// Pair of indices into the collision objects of one or two groups
+  using IndexPair = std::pair<std::size_t, std::size_t>;
+
+  /// Pair of indices with the distance between the bounding boxes of the two
+  /// objects, which is a lower bound of the distance between their shapes
+  /// whenever it is positive
+  using DistancePair = std::pair<double, IndexPair>;
+
+  /// Node of the bounding volume hierarchy that raycasts traverse
+  struct RaycastNode
+  {
+    /// Bounding box of the objects under this node
+    Eigen::Vector3d mMin;
+    Eigen::Vector3d mMax;
+
+    /// Range of mRaycastIndices under this node
+    std::size_t mBegin;
+    std::size_t mEnd;
+
+    /// Index of the second child, or zero for a leaf. The first child directly
+    /// follows its parent.
+    std::size_t mSecondChild;
+  };
+
 protected:
+  using CollisionGroup::updateEngineData;
+
   // Documentation inherited
   void initializeEngineData() override;
 
@@ -71,9 +101,107 @@ protected:
   // Documentation inherited
   void updateCollisionGroupEngineData() override;
 
+  /// Find all the pairs of objects in this group whose world bounding boxes
+  /// overlap, using sweep-and-prune along the x-axis. The pairs are stored as
+  /// (i, j) with i < j, sorted lexicographically so that the narrow phase
+  /// visits them in the same order as an exhaustive double loop would.
+  ///
+  /// updateEngineData() must be called before this function.
+  void computeOverlappingPairs(std::vector<IndexPair>& pairs) const;
+
+  /// Find all the pairs of objects, one from this group and one from
+  /// otherGroup, whose world bounding boxes overlap. The pairs are stored as
+  /// (index in this group, index in otherGroup), sorted lexicographically.
+  ///
+  /// updateEngineData() must be called on both groups before this function.
+  void computeOverlappingPairs(
+      const DARTCollisionGroup& otherGroup,
+      std::vector<IndexPair>& pairs) const;
+
+  /// Collect the pairs of objects in this group whose bounding boxes are more
+  /// than minGap and at most maxGap apart along the x-axis as candidates of a
+  /// distance query. The gap is negative when the boxes overlap along the
+  /// x-axis. The pairs are found by sweeping the objects in the order of
+  /// computeOverlappingPairs() and are arranged as a min-heap on the distance
+  /// between their bounding boxes (see std::make_heap with std::greater) so
+  /// that the query can visit the nearest pairs first.
+  ///
+  /// Since the gap is a lower bound of the distance between the bounding
+  /// boxes, the query can widen the range until the gap exceeds the minimum
+  /// distance found instead of visiting every pair. Returns the smallest gap
+  /// beyond maxGap, or infinity if no pair is left beyond it.
+  ///
+  /// updateEngineData() must be called before this function.
+  double computeDistancePairs(
+      double minGap, double maxGap, std::vector<DistancePair>& pairs) const;
+
+  /// Collect the pairs of objects, one from this group and one from
+  /// otherGroup, whose bounding boxes are more than minGap and at most maxGap
+  /// apart along the x-axis as candidates of a distance query, arranged as a
+  /// min-heap on the distance between their bounding boxes. Returns the
+  /// smallest gap beyond maxGap, or infinity if no pair is left beyond it.
+  ///
+  /// updateEngineData() must be called on both groups before this function.
+  double computeDistancePairs(
+      const DARTCollisionGroup& otherGroup,
+      double minGap,
+      double maxGap,
+      std::vector<DistancePair>& pairs) const;
+
+  /// Build the bounding volume hierarchy over the bounding boxes of the
+  /// objects that raycastClosest() traverses. The tree is built by median
+  /// splits along the longest axis of the box centers.
+  ///
+  /// updateEngineData() must be called before this function.
+  void buildRaycastTree();
+
+  /// Find the closest object hit by the ray from + t * dir for t in [0, 1]
+  /// and set the fraction t and the normal of the hit. Returns nullptr if the
+  /// ray hit nothing. This function only reads the tree, so it can be called
+  /// from several threads at once.
+  ///
+  /// buildRaycastTree() must be called before this function.
+  const CollisionObject* raycastClosest(
+      const Eigen::Vector3d& from,
+      const Eigen::Vector3d& dir,
+      double& fraction,
+      Eigen::Vector3d& normal) const;
+
 protected:
   /// CollisionObjects added to this DARTCollisionGroup
   std::vector<CollisionObject*> mCollisionObjects;
+
+  /// Indices of mCollisionObjects sorted by the lower bound of their bounding
+  /// boxes along the x-axis. The order is kept between updates so that it can
+  /// be repaired incrementally, since objects rarely move far in a time step.
+  std::vector<std::size_t> mSortedIndices;
+
+  /// Whether mSortedIndices has to be rebuilt from scratch because objects were
+  /// added or removed since the last update
+  bool mSortedIndicesDirty;
+
+  /// Scratch buffer of candidate pairs, reused across collision queries
+  std::vector<IndexPair> mOverlappingPairs;
+
+  /// Scratch buffer of candidate pairs, reused across distance queries
+  std::vector<DistancePair> mDistancePairs;
+
+  /// Nodes of the bounding volume hierarchy for raycasts. The first node is
+  /// the root.
+  std::vector<RaycastNode> mRaycastNodes;
+
+  /// Indices of mCollisionObjects ordered so that each node of the hierarchy
+  /// covers a contiguous range
+  std::vector<std::size_t> mRaycastIndices;
+
+  /// Scratch result of the narrow phase of a single pair, reused across pairs
+  /// and collision queries
+  CollisionResult mPairResult;
+
+  /// Open-addressing spatial hash of the contact points found in the current
+  /// collision query, used to discard repeated points. Each slot holds one
+  /// plus the index of a contact, or zero when empty.
+  std::vector<std::size_t> mContactPointHash;
 };
 
 } // namespace collision
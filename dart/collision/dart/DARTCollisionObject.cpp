@@ -32,6 +32,9 @@
 
 #include "dart/collision/dart/DARTCollisionObject.hpp"
 
+#include "dart/dynamics/EllipsoidShape.hpp"
+#include "dart/dynamics/ShapeFrame.hpp"
+
 namespace dart {
 namespace collision {
 
@@ -39,15 +42,56 @@ namespace collision {
 DARTCollisionObject::DARTCollisionObject(
     CollisionDetector* collisionDetector,
     const dynamics::ShapeFrame* shapeFrame)
-  : CollisionObject(collisionDetector, shapeFrame)
+  : CollisionObject(collisionDetector, shapeFrame),
+    mWorldAabbMin(Eigen::Vector3d::Zero()),
+    mWorldAabbMax(Eigen::Vector3d::Zero())
 {
   // Do nothing
 }
 
+//==============================================================================
+const Eigen::Vector3d& DARTCollisionObject::getWorldAabbMin() const
+{
+  return mWorldAabbMin;
+}
+
+//==============================================================================
+const Eigen::Vector3d& DARTCollisionObject::getWorldAabbMax() const
+{
+  return mWorldAabbMax;
+}
+
 //==============================================================================
 void DARTCollisionObject::updateEngineData()
 {
-  // Do nothing
+  // Small padding so that touching shapes are never culled by the broadphase
+  constexpr double margin = 1e-6;
+
+  const auto& shape = mShapeFrame->getShape();
+  if (!shape) {
+    mWorldAabbMin = mWorldAabbMax = getTransform().translation();
+    return;
+  }
+
+  const math::BoundingBox& localBox = shape->getBoundingBox();
+  Eigen::Vector3d localCenter = localBox.computeCenter();
+  Eigen::Vector3d localHalfExtents = localBox.computeHalfExtents();
+
+  // The narrow phase treats an ellipsoid as a sphere of its first radius, so
+  // the bounding box must enclose that sphere as well.
+  if (const auto* ellipsoid = shape->as<dynamics::EllipsoidShape>()) {
+    localHalfExtents = localHalfExtents.cwiseMax(
+        Eigen::Vector3d::Constant(ellipsoid->getRadii()[0]));
+  }
+
+  const Eigen::Isometry3d& tf = getTransform();
+  const Eigen::Vector3d center = tf * localCenter;
+  const Eigen::Vector3d halfExtents
+      = tf.linear().cwiseAbs() * localHalfExtents
+        + Eigen::Vector3d::Constant(margin);
+
+  mWorldAabbMin = center - halfExtents;
+  mWorldAabbMax = center + halfExtents;
 }
 
 } // namespace collision
@@ -46,6 +46,15 @@ class DARTCollisionObject : public CollisionObject
 {
 public:
   friend class DARTCollisionDetector;
+  friend class DARTCollisionGroup;
+
+  /// Return the lower corner of the world-aligned bounding box of this object.
+  /// The bounding box is refreshed by updateEngineData().
+  const Eigen::Vector3d& getWorldAabbMin() const;
+
+  /// Return the upper corner of the world-aligned bounding box of this object.
+  /// The bounding box is refreshed by updateEngineData().
+  const Eigen::Vector3d& getWorldAabbMax() const;
 
 protected:
   /// Constructor
@@ -55,6 +64,13 @@ protected:
 
   // Documentation inherited
   void updateEngineData() override;
+
+protected:
+  /// Lower corner of the world-aligned bounding box
+  Eigen::Vector3d mWorldAabbMin;
+
+  /// Upper corner of the world-aligned bounding box
+  Eigen::Vector3d mWorldAabbMax;
 };
 
 } // namespace collision
@@ -0,0 +1,819 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/collision/dart/DARTDistance.hpp"
+
+#include "dart/common/Console.hpp"
+#include "dart/dynamics/BoxShape.hpp"
+#include "dart/dynamics/EllipsoidShape.hpp"
+#include "dart/dynamics/SphereShape.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace dart {
+namespace collision {
+
+namespace {
+
+/// Absolute tolerance of the GJK and EPA iterations
+constexpr double distanceTolerance = 1e-10;
+
+/// Maximum number of GJK and EPA iterations. Polytopes converge in a few
+/// iterations, while curved shapes converge gradually.
+constexpr std::size_t maxDistanceIterations = 128u;
+
+/// Convex shape in world coordinates described by its support mapping.
+/// Spheres are represented by their center and a margin of their radius so
+/// that GJK and EPA only deal with the core shape.
+struct ConvexShape
+{
+  enum class Type
+  {
+    Point,
+    Box,
+    Ellipsoid
+  };
+
+  Type mType;
+
+  /// Transform of the shape in world coordinates
+  Eigen::Isometry3d mTransform;
+
+  /// Half extents of a box or radii of an ellipsoid
+  Eigen::Vector3d mExtents;
+
+  /// Radius added around the core shape
+  double mMargin;
+
+  /// Returns the point of the core shape farthest along dir
+  Eigen::Vector3d support(const Eigen::Vector3d& dir) const;
+};
+
+/// Point of the Minkowski difference of two core shapes along with the points
+/// of the shapes it was made of
+struct SupportVertex
+{
+  /// mPoint0 - mPoint1
+  Eigen::Vector3d mPoint;
+
+  /// Support point of the first shape
+  Eigen::Vector3d mPoint0;
+
+  /// Support point of the second shape
+  Eigen::Vector3d mPoint1;
+};
+
+/// GJK simplex with the barycentric weights of the point closest to the origin
+struct Simplex
+{
+  std::array<SupportVertex, 4> mVertices;
+  std::array<double, 4> mWeights;
+  std::size_t mSize;
+};
+
+/// Vertices of a simplex, as indices, that support the point of the simplex
+/// closest to the origin, and their barycentric weights
+struct ClosestFeature
+{
+  std::array<std::size_t, 4> mIndices;
+  std::array<double, 4> mWeights;
+  std::size_t mSize;
+  Eigen::Vector3d mPoint;
+};
+
+/// Triangular face of the EPA polytope with its outward normal
+struct PolytopeFace
+{
+  std::array<std::size_t, 3> mIndices;
+  Eigen::Vector3d mNormal;
+  double mDistance;
+};
+
+//==============================================================================
+Eigen::Vector3d ConvexShape::support(const Eigen::Vector3d& dir) const
+{
+  const Eigen::Vector3d localDir = mTransform.linear().transpose() * dir;
+  Eigen::Vector3d localPoint = Eigen::Vector3d::Zero();
+
+  switch (mType) {
+    case Type::Point:
+      break;
+    case Type::Box:
+      for (auto i = 0u; i < 3u; ++i)
+        localPoint[i] = localDir[i] < 0.0 ? -mExtents[i] : mExtents[i];
+      break;
+    case Type::Ellipsoid: {
+      const Eigen::Vector3d scaledDir = mExtents.cwiseProduct(localDir);
+      const double norm = scaledDir.norm();
+      if (norm > 0.0)
+        localPoint = mExtents.cwiseProduct(scaledDir) / norm;
+      break;
+    }
+  }
+
+  return mTransform * localPoint;
+}
+
+//==============================================================================
+SupportVertex computeSupport(
+    const ConvexShape& shape0,
+    const ConvexShape& shape1,
+    const Eigen::Vector3d& dir)
+{
+  SupportVertex vertex;
+  vertex.mPoint0 = shape0.support(dir);
+  vertex.mPoint1 = shape1.support(-dir);
+  vertex.mPoint = vertex.mPoint0 - vertex.mPoint1;
+
+  return vertex;
+}
+
+//==============================================================================
+ClosestFeature makeFeature(const Simplex& simplex, std::size_t i)
+{
+  ClosestFeature feature;
+  feature.mIndices[0] = i;
+  feature.mWeights[0] = 1.0;
+  feature.mSize = 1u;
+  feature.mPoint = simplex.mVertices[i].mPoint;
+
+  return feature;
+}
+
+//==============================================================================
+ClosestFeature makeFeature(
+    const Simplex& simplex, std::size_t i, std::size_t j, double t)
+{
+  ClosestFeature feature;
+  feature.mIndices[0] = i;
+  feature.mIndices[1] = j;
+  feature.mWeights[0] = 1.0 - t;
+  feature.mWeights[1] = t;
+  feature.mSize = 2u;
+  feature.mPoint = (1.0 - t) * simplex.mVertices[i].mPoint
+                   + t * simplex.mVertices[j].mPoint;
+
+  return feature;
+}
+
+//==============================================================================
+/// Closest point to the origin on the segment (i, j) of the simplex
+ClosestFeature closestOnSegment(
+    const Simplex& simplex, std::size_t i, std::size_t j)
+{
+  const Eigen::Vector3d& a = simplex.mVertices[i].mPoint;
+  const Eigen::Vector3d ab = simplex.mVertices[j].mPoint - a;
+
+  const double denom = ab.squaredNorm();
+  const double t = denom > 0.0 ? -a.dot(ab) / denom : 0.0;
+
+  if (t <= 0.0)
+    return makeFeature(simplex, i);
+
+  if (t >= 1.0)
+    return makeFeature(simplex, j);
+
+  return makeFeature(simplex, i, j, t);
+}
+
+//==============================================================================
+/// Closest point to the origin on the triangle (i, j, k) of the simplex, which
+/// follows the Voronoi region tests of Ericson, "Real-Time Collision
+/// Detection", section 5.1.5.
+ClosestFeature closestOnTriangle(
+    const Simplex& simplex, std::size_t i, std::size_t j, std::size_t k)
+{
+  const Eigen::Vector3d& a = simplex.mVertices[i].mPoint;
+  const Eigen::Vector3d& b = simplex.mVertices[j].mPoint;
+  const Eigen::Vector3d& c = simplex.mVertices[k].mPoint;
+
+  const Eigen::Vector3d ab = b - a;
+  const Eigen::Vector3d ac = c - a;
+
+  const double d1 = -ab.dot(a);
+  const double d2 = -ac.dot(a);
+  if (d1 <= 0.0 && d2 <= 0.0)
+    return makeFeature(simplex, i);
+
+  const double d3 = -ab.dot(b);
+  const double d4 = -ac.dot(b);
+  if (d3 >= 0.0 && d4 <= d3)
+    return makeFeature(simplex, j);
+
+  const double vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+    return makeFeature(simplex, i, j, d1 / (d1 - d3));
+
+  const double d5 = -ab.dot(c);
+  const double d6 = -ac.dot(c);
+  if (d6 >= 0.0 && d5 <= d6)
+    return makeFeature(simplex, k);
+
+  const double vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+    return makeFeature(simplex, i, k, d2 / (d2 - d6));
+
+  const double va = d3 * d6 - d5 * d4;
+  if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+    return makeFeature(simplex, j, k, (d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+  const double sum = va + vb + vc;
+  if (sum <= 0.0) {
+    // Degenerate triangle; its closest point lies on one of the edges
+    ClosestFeature best = closestOnSegment(simplex, i, j);
+    for (const auto& edge : {closestOnSegment(simplex, j, k),
+                             closestOnSegment(simplex, i, k)}) {
+      if (edge.mPoint.squaredNorm() < best.mPoint.squaredNorm())
+        best = edge;
+    }
+    return best;
+  }
+
+  const double v = vb / sum;
+  const double w = vc / sum;
+
+  ClosestFeature feature;
+  feature.mIndices = {i, j, k, 0u};
+  feature.mWeights = {1.0 - v - w, v, w, 0.0};
+  feature.mSize = 3u;
+  feature.mPoint = a + v * ab + w * ac;
+
+  return feature;
+}
+
+//==============================================================================
+/// Closest point to the origin on the tetrahedron of the simplex. A feature of
+/// size 4 is returned if the origin is inside the tetrahedron.
+ClosestFeature closestOnTetrahedron(const Simplex& simplex)
+{
+  static const std::size_t faces[4][4]
+      = {{0u, 1u, 2u, 3u},
+         {0u, 1u, 3u, 2u},
+         {0u, 2u, 3u, 1u},
+         {1u, 2u, 3u, 0u}};
+
+  ClosestFeature best;
+  best.mSize = 0u;
+
+  for (const auto& face : faces) {
+    const Eigen::Vector3d& a = simplex.mVertices[face[0]].mPoint;
+    const Eigen::Vector3d& b = simplex.mVertices[face[1]].mPoint;
+    const Eigen::Vector3d& c = simplex.mVertices[face[2]].mPoint;
+    const Eigen::Vector3d& d = simplex.mVertices[face[3]].mPoint;
+
+    // Skip the faces that have the origin on the same side as the opposite
+    // vertex
+    const Eigen::Vector3d normal = (b - a).cross(c - a);
+    if (normal.dot(-a) * normal.dot(d - a) > 0.0)
+      continue;
+
+    const auto feature = closestOnTriangle(simplex, face[0], face[1], face[2]);
+    if (best.mSize == 0u
+        || feature.mPoint.squaredNorm() < best.mPoint.squaredNorm())
+      best = feature;
+  }
+
+  if (best.mSize == 0u) {
+    // The origin is inside the tetrahedron
+    best.mIndices = {0u, 1u, 2u, 3u};
+    best.mSize = 4u;
+    best.mPoint.setZero();
+  }
+
+  return best;
+}
+
+//==============================================================================
+ClosestFeature computeClosestFeature(const Simplex& simplex)
+{
+  switch (simplex.mSize) {
+    case 1u:
+      return makeFeature(simplex, 0u);
+    case 2u:
+      return closestOnSegment(simplex, 0u, 1u);
+    case 3u:
+      return closestOnTriangle(simplex, 0u, 1u, 2u);
+    default:
+      return closestOnTetrahedron(simplex);
+  }
+}
+
+//==============================================================================
+/// Keeps only the vertices of the feature in the simplex
+void reduceSimplex(Simplex& simplex, const ClosestFeature& feature)
+{
+  const auto vertices = simplex.mVertices;
+  for (auto i = 0u; i < feature.mSize; ++i) {
+    simplex.mVertices[i] = vertices[feature.mIndices[i]];
+    simplex.mWeights[i] = feature.mWeights[i];
+  }
+  simplex.mSize = feature.mSize;
+}
+
+//==============================================================================
+/// Runs GJK on the core shapes. Returns true if they are apart, in which case
+/// the distance and the nearest points are computed from the simplex.
+/// Otherwise, the simplex encloses the origin or touches it.
+bool runGjk(
+    const ConvexShape& shape0,
+    const ConvexShape& shape1,
+    Simplex& simplex,
+    double& distance,
+    Eigen::Vector3d& point0,
+    Eigen::Vector3d& point1)
+{
+  Eigen::Vector3d dir
+      = shape1.mTransform.translation() - shape0.mTransform.translation();
+  if (dir.squaredNorm() <= distanceTolerance * distanceTolerance)
+    dir = Eigen::Vector3d::UnitX();
+
+  simplex.mVertices[0] = computeSupport(shape0, shape1, dir);
+  simplex.mWeights[0] = 1.0;
+  simplex.mSize = 1u;
+  Eigen::Vector3d closest = simplex.mVertices[0].mPoint;
+
+  for (auto i = 0u; i < maxDistanceIterations; ++i) {
+    const double squaredDistance = closest.squaredNorm();
+    if (squaredDistance <= distanceTolerance * distanceTolerance)
+      return false;
+
+    // Stop when the support point in the direction of the origin gets no
+    // closer to it than the current point does
+    const auto vertex = computeSupport(shape0, shape1, -closest);
+    if (squaredDistance - closest.dot(vertex.mPoint)
+        <= distanceTolerance * squaredDistance)
+      break;
+
+    Simplex candidate = simplex;
+    candidate.mVertices[candidate.mSize++] = vertex;
+
+    const auto feature = computeClosestFeature(candidate);
+    if (feature.mSize == 4u) {
+      simplex = candidate;
+      return false;
+    }
+
+    // Numerical stagnation; keep the current point
+    if (feature.mPoint.squaredNorm() >= squaredDistance)
+      break;
+
+    reduceSimplex(candidate, feature);
+    simplex = candidate;
+    closest = feature.mPoint;
+  }
+
+  point0.setZero();
+  point1.setZero();
+  for (auto i = 0u; i < simplex.mSize; ++i) {
+    point0 += simplex.mWeights[i] * simplex.mVertices[i].mPoint0;
+    point1 += simplex.mWeights[i] * simplex.mVertices[i].mPoint1;
+  }
+  distance = closest.norm();
+
+  return true;
+}
+
+//==============================================================================
+/// Grows the simplex that touches or encloses the origin into a tetrahedron
+/// using support points along directions orthogonal to it. Returns false if
+/// the Minkowski difference is flat.
+bool completeTetrahedron(
+    const ConvexShape& shape0,
+    const ConvexShape& shape1,
+    std::vector<SupportVertex>& vertices)
+{
+  const auto tryDirections = [&](std::initializer_list<Eigen::Vector3d> dirs,
+                                 const auto& offset) {
+    double bestOffset = distanceTolerance;
+    SupportVertex best;
+    for (const auto& dir : dirs) {
+      const auto vertex = computeSupport(shape0, shape1, dir);
+      const double value = offset(vertex.mPoint);
+      if (value > bestOffset) {
+        bestOffset = value;
+        best = vertex;
+      }
+    }
+
+    if (bestOffset <= distanceTolerance)
+      return false;
+
+    vertices.push_back(best);
+    return true;
+  };
+
+  if (vertices.size() == 1u) {
+    const Eigen::Vector3d& p = vertices[0].mPoint;
+    const auto offset
+        = [&](const Eigen::Vector3d& q) { return (q - p).norm(); };
+    if (!tryDirections(
+            {Eigen::Vector3d::UnitX(),
+             -Eigen::Vector3d::UnitX(),
+             Eigen::Vector3d::UnitY(),
+             -Eigen::Vector3d::UnitY(),
+             Eigen::Vector3d::UnitZ(),
+             -Eigen::Vector3d::UnitZ()},
+            offset))
+      return false;
+  }
+
+  if (vertices.size() == 2u) {
+    const Eigen::Vector3d& p = vertices[0].mPoint;
+    const Eigen::Vector3d axis = (vertices[1].mPoint - p).normalized();
+
+    Eigen::Vector3d::Index minIndex;
+    axis.cwiseAbs().minCoeff(&minIndex);
+    const Eigen::Vector3d dir1
+        = axis.cross(Eigen::Vector3d::Unit(minIndex)).normalized();
+    const Eigen::Vector3d dir2 = axis.cross(dir1);
+
+    const auto offset = [&](const Eigen::Vector3d& q) {
+      return (q - p).cross(axis).norm();
+    };
+    if (!tryDirections({dir1, -dir1, dir2, -dir2}, offset))
+      return false;
+  }
+
+  if (vertices.size() == 3u) {
+    const Eigen::Vector3d& p = vertices[0].mPoint;
+    const Eigen::Vector3d normal
+        = (vertices[1].mPoint - p).cross(vertices[2].mPoint - p).normalized();
+
+    const auto offset
+        = [&](const Eigen::Vector3d& q) { return std::abs(normal.dot(q - p)); };
+    if (!tryDirections({normal, -normal}, offset))
+      return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+/// Runs EPA on the core shapes starting from the GJK simplex that touches or
+/// encloses the origin. Returns false if the polytope degenerates.
+bool runEpa(
+    const ConvexShape& shape0,
+    const ConvexShape& shape1,
+    const Simplex& simplex,
+    double& depth,
+    Eigen::Vector3d& point0,
+    Eigen::Vector3d& point1,
+    Eigen::Vector3d& normal)
+{
+  std::vector<SupportVertex> vertices(
+      simplex.mVertices.begin(), simplex.mVertices.begin() + simplex.mSize);
+  if (!completeTetrahedron(shape0, shape1, vertices))
+    return false;
+
+  // The polytope only grows, so the centroid of the initial tetrahedron stays
+  // inside and tells which side of each face is out
+  Eigen::Vector3d interior = Eigen::Vector3d::Zero();
+  for (const auto& vertex : vertices)
+    interior += 0.25 * vertex.mPoint;
+
+  std::vector<PolytopeFace> faces;
+  const auto addFace = [&](std::size_t i, std::size_t j, std::size_t k) {
+    const Eigen::Vector3d& a = vertices[i].mPoint;
+    Eigen::Vector3d n = (vertices[j].mPoint - a).cross(vertices[k].mPoint - a);
+    const double norm = n.norm();
+    if (norm <= distanceTolerance * distanceTolerance)
+      return;
+
+    n /= norm;
+    if (n.dot(a - interior) < 0.0) {
+      n = -n;
+      std::swap(j, k);
+    }
+    faces.push_back({{i, j, k}, n, n.dot(a)});
+  };
+
+  addFace(0u, 1u, 2u);
+  addFace(0u, 1u, 3u);
+  addFace(0u, 2u, 3u);
+  addFace(1u, 2u, 3u);
+
+  std::vector<std::pair<std::size_t, std::size_t>> horizon;
+  auto closest = faces.begin();
+
+  for (auto iteration = 0u; iteration < maxDistanceIterations; ++iteration) {
+    if (faces.empty())
+      return false;
+
+    closest = std::min_element(
+        faces.begin(),
+        faces.end(),
+        [](const PolytopeFace& a, const PolytopeFace& b) {
+          return a.mDistance < b.mDistance;
+        });
+
+    const auto vertex = computeSupport(shape0, shape1, closest->mNormal);
+    if (closest->mNormal.dot(vertex.mPoint) - closest->mDistance
+        <= distanceTolerance)
+      break;
+
+    // Replace the faces visible from the new vertex by a fan connecting it
+    // to the horizon
+    const auto newIndex = vertices.size();
+    vertices.push_back(vertex);
+
+    horizon.clear();
+    for (auto it = faces.begin(); it != faces.end();) {
+      if (it->mNormal.dot(vertex.mPoint - vertices[it->mIndices[0]].mPoint)
+          <= 0.0) {
+        ++it;
+        continue;
+      }
+
+      for (auto e = 0u; e < 3u; ++e) {
+        const std::pair<std::size_t, std::size_t> edge(
+            it->mIndices[e], it->mIndices[(e + 1u) % 3u]);
+        const auto twin = std::find(
+            horizon.begin(),
+            horizon.end(),
+            std::make_pair(edge.second, edge.first));
+        if (twin != horizon.end())
+          horizon.erase(twin);
+        else
+          horizon.push_back(edge);
+      }
+
+      it = faces.erase(it);
+    }
+
+    for (const auto& edge : horizon)
+      addFace(edge.first, edge.second, newIndex);
+
+    closest = faces.end();
+  }
+
+  if (closest == faces.end()) {
+    if (faces.empty())
+      return false;
+
+    closest = std::min_element(
+        faces.begin(),
+        faces.end(),
+        [](const PolytopeFace& a, const PolytopeFace& b) {
+          return a.mDistance < b.mDistance;
+        });
+  }
+
+  // Barycentric coordinates of the projection of the origin onto the face
+  const auto& a = vertices[closest->mIndices[0]];
+  const auto& b = vertices[closest->mIndices[1]];
+  const auto& c = vertices[closest->mIndices[2]];
+
+  const Eigen::Vector3d v0 = b.mPoint - a.mPoint;
+  const Eigen::Vector3d v1 = c.mPoint - a.mPoint;
+  const Eigen::Vector3d v2 = closest->mDistance * closest->mNormal - a.mPoint;
+
+  const double d00 = v0.dot(v0);
+  const double d01 = v0.dot(v1);
+  const double d11 = v1.dot(v1);
+  const double d20 = v2.dot(v0);
+  const double d21 = v2.dot(v1);
+  const double denom = d00 * d11 - d01 * d01;
+
+  double wb = 0.0;
+  double wc = 0.0;
+  if (denom > 0.0) {
+    wb = (d11 * d20 - d01 * d21) / denom;
+    wc = (d00 * d21 - d01 * d20) / denom;
+  }
+  const double wa = 1.0 - wb - wc;
+
+  point0 = wa * a.mPoint0 + wb * b.mPoint0 + wc * c.mPoint0;
+  point1 = wa * a.mPoint1 + wb * b.mPoint1 + wc * c.mPoint1;
+  depth = std::max(closest->mDistance, 0.0);
+  normal = closest->mNormal;
+
+  return true;
+}
+
+//==============================================================================
+/// Signed distance between two convex shapes, including their margins
+bool signedDistanceConvex(
+    const ConvexShape& shape0,
+    const ConvexShape& shape1,
+    double& distance,
+    Eigen::Vector3d& point0,
+    Eigen::Vector3d& point1)
+{
+  Simplex simplex;
+  Eigen::Vector3d normal;
+
+  if (runGjk(shape0, shape1, simplex, distance, point0, point1)) {
+    normal = (point1 - point0) / distance;
+  } else {
+    double depth;
+    if (!runEpa(shape0, shape1, simplex, depth, point0, point1, normal))
+      return false;
+
+    distance = -depth;
+  }
+
+  // The normal points from the first shape to the second one
+  distance -= shape0.mMargin + shape1.mMargin;
+  point0 += shape0.mMargin * normal;
+  point1 -= shape1.mMargin * normal;
+
+  return true;
+}
+
+//==============================================================================
+bool toConvexShape(const CollisionObject* object, ConvexShape& convex)
+{
+  using TypeId = dynamics::Shape::TypeId;
+
+  const auto* shape = object->getShape().get();
+
+  convex.mTransform = object->getTransform();
+  convex.mExtents.setZero();
+  convex.mMargin = 0.0;
+
+  switch (shape->getTypeId()) {
+    case TypeId::Sphere:
+      convex.mType = ConvexShape::Type::Point;
+      convex.mMargin
+          = static_cast<const dynamics::SphereShape*>(shape)->getRadius();
+      return true;
+    case TypeId::Ellipsoid: {
+      const auto* ellipsoid
+          = static_cast<const dynamics::EllipsoidShape*>(shape);
+      if (ellipsoid->isSphere()) {
+        convex.mType = ConvexShape::Type::Point;
+        convex.mMargin = ellipsoid->getRadii()[0];
+      } else {
+        convex.mType = ConvexShape::Type::Ellipsoid;
+        convex.mExtents = ellipsoid->getRadii();
+      }
+      return true;
+    }
+    case TypeId::Box:
+      convex.mType = ConvexShape::Type::Box;
+      convex.mExtents
+          = 0.5 * static_cast<const dynamics::BoxShape*>(shape)->getSize();
+      return true;
+    default:
+      return false;
+  }
+}
+
+} // anonymous namespace
+
+//==============================================================================
+double signedDistanceSphereSphere(
+    double r0,
+    const Eigen::Isometry3d& T0,
+    double r1,
+    const Eigen::Isometry3d& T1,
+    Eigen::Vector3d& point0,
+    Eigen::Vector3d& point1)
+{
+  const Eigen::Vector3d& c0 = T0.translation();
+  const Eigen::Vector3d& c1 = T1.translation();
+
+  const Eigen::Vector3d diff = c1 - c0;
+  const double length = diff.norm();
+
+  // Concentric spheres are pushed apart along an arbitrary axis
+  const Eigen::Vector3d normal
+      = length > 0.0 ? Eigen::Vector3d(diff / length)
+                     : Eigen::Vector3d::UnitX();
+
+  point0 = c0 + r0 * normal;
+  point1 = c1 - r1 * normal;
+
+  return length - r0 - r1;
+}
+
+//==============================================================================
+double signedDistanceSphereBox(
+    double r0,
+    const Eigen::Isometry3d& T0,
+    const Eigen::Vector3d& size1,
+    const Eigen::Isometry3d& T1,
+    Eigen::Vector3d& point0,
+    Eigen::Vector3d& point1)
+{
+  const Eigen::Vector3d halfSize = 0.5 * size1;
+  const Eigen::Vector3d center = T1.inverse() * T0.translation();
+
+  // Nearest point on the box and the normal pointing from the box to the
+  // center of the sphere, in the frame of the box
+  Eigen::Vector3d nearest = center.cwiseMax(-halfSize).cwiseMin(halfSize);
+  Eigen::Vector3d normal = center - nearest;
+  double coreDistance = normal.norm();
+
+  if (coreDistance > 0.0) {
+    normal /= coreDistance;
+  } else {
+    // The center is inside the box, so it is pushed out through the nearest
+    // face
+    Eigen::Vector3d::Index axis;
+    (halfSize - center.cwiseAbs()).minCoeff(&axis);
+
+    const double sign = center[axis] < 0.0 ? -1.0 : 1.0;
+    nearest[axis] = sign * halfSize[axis];
+    normal = sign * Eigen::Vector3d::Unit(axis);
+    coreDistance = -(halfSize[axis] - std::abs(center[axis]));
+  }
+
+  const Eigen::Vector3d worldNormal = T1.linear() * normal;
+  point0 = T0.translation() - r0 * worldNormal;
+  point1 = T1 * nearest;
+
+  return coreDistance - r0;
+}
+
+//==============================================================================
+bool signedDistance(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    double& distance,
+    Eigen::Vector3d& point1,
+    Eigen::Vector3d& point2)
+{
+  using Type = ConvexShape::Type;
+
+  ConvexShape shape1;
+  ConvexShape shape2;
+  if (!toConvexShape(o1, shape1) || !toConvexShape(o2, shape2)) {
+    dterr << "[DARTCollisionDetector] Attempting to compute the distance "
+          << "between an unsupported shape pair: ["
+          << o1->getShape()->getType() << "] - [" << o2->getShape()->getType()
+          << "]. Skipping this pair.\n";
+    return false;
+  }
+
+  if (shape1.mType == Type::Point && shape2.mType == Type::Point) {
+    distance = signedDistanceSphereSphere(
+        shape1.mMargin,
+        shape1.mTransform,
+        shape2.mMargin,
+        shape2.mTransform,
+        point1,
+        point2);
+    return true;
+  }
+
+  if (shape1.mType == Type::Point && shape2.mType == Type::Box) {
+    distance = signedDistanceSphereBox(
+        shape1.mMargin,
+        shape1.mTransform,
+        2.0 * shape2.mExtents,
+        shape2.mTransform,
+        point1,
+        point2);
+    return true;
+  }
+
+  if (shape1.mType == Type::Box && shape2.mType == Type::Point) {
+    distance = signedDistanceSphereBox(
+        shape2.mMargin,
+        shape2.mTransform,
+        2.0 * shape1.mExtents,
+        shape1.mTransform,
+        point2,
+        point1);
+    return true;
+  }
+
+  return signedDistanceConvex(shape1, shape2, distance, point1, point2);
+}
+
+} // namespace collision
+} // namespace dart
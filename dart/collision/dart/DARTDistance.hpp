@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COLLISION_DART_DARTDISTANCE_HPP_
+#define DART_COLLISION_DART_DARTDISTANCE_HPP_
+
+#include <dart/collision/CollisionObject.hpp>
+
+#include <Eigen/Dense>
+
+namespace dart {
+namespace collision {
+
+/// Computes the signed distance between the shapes of two collision objects.
+///
+/// A positive distance is the separation between the shapes and a negative
+/// distance is the negated penetration depth. point1 and point2 are set to the
+/// nearest points on the shapes of o1 and o2 in world coordinates. When the
+/// shapes penetrate, they are the deepest points of each shape inside the
+/// other, so that the distance between them is always |distance|.
+///
+/// Spheres (including ellipsoids with equal radii) are handled in closed form.
+/// The other pairs of boxes and ellipsoids are handled by GJK when they are
+/// apart and by EPA when they penetrate.
+///
+/// Returns false without modifying the outputs if the shape pair is not
+/// supported.
+bool signedDistance(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    double& distance,
+    Eigen::Vector3d& point1,
+    Eigen::Vector3d& point2);
+
+/// Signed distance between two spheres. The nearest points are returned in
+/// point0 and point1.
+double signedDistanceSphereSphere(
+    double r0,
+    const Eigen::Isometry3d& T0,
+    double r1,
+    const Eigen::Isometry3d& T1,
+    Eigen::Vector3d& point0,
+    Eigen::Vector3d& point1);
+
+/// Signed distance between a sphere and a box of the given size. The nearest
+/// points are returned in point0 and point1.
+double signedDistanceSphereBox(
+    double r0,
+    const Eigen::Isometry3d& T0,
+    const Eigen::Vector3d& size1,
+    const Eigen::Isometry3d& T1,
+    Eigen::Vector3d& point0,
+    Eigen::Vector3d& point1);
+
+} // namespace collision
+} // namespace dart
+
+#endif // DART_COLLISION_DART_DARTDISTANCE_HPP_
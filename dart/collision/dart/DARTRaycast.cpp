@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/collision/dart/DARTRaycast.hpp"
+
+#include "dart/dynamics/BoxShape.hpp"
+#include "dart/dynamics/EllipsoidShape.hpp"
+#include "dart/dynamics/SphereShape.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include <cmath>
+
+namespace dart {
+namespace collision {
+
+namespace {
+
+//==============================================================================
+/// Intersects the ray with the unit sphere at the origin
+bool intersectRayUnitSphere(
+    const Eigen::Vector3d& from,
+    const Eigen::Vector3d& dir,
+    double maxFraction,
+    double& fraction)
+{
+  const double a = dir.squaredNorm();
+  const double b = from.dot(dir);
+  const double c = from.squaredNorm() - 1.0;
+
+  // The ray starts inside the sphere or points away from it
+  if (c <= 0.0 || b >= 0.0 || a <= 0.0)
+    return false;
+
+  const double discriminant = b * b - a * c;
+  if (discriminant < 0.0)
+    return false;
+
+  fraction = (-b - std::sqrt(discriminant)) / a;
+
+  return fraction <= maxFraction;
+}
+
+//==============================================================================
+bool intersectRayBox(
+    const Eigen::Vector3d& halfSize,
+    const Eigen::Vector3d& from,
+    const Eigen::Vector3d& dir,
+    double maxFraction,
+    double& fraction,
+    Eigen::Vector3d& normal)
+{
+  // Slab test that remembers the axis through which the ray enters
+  double enter = -std::numeric_limits<double>::infinity();
+  double exit = std::numeric_limits<double>::infinity();
+  int enterAxis = -1;
+
+  for (auto i = 0; i < 3; ++i) {
+    if (dir[i] == 0.0) {
+      if (std::abs(from[i]) > halfSize[i])
+        return false;
+      continue;
+    }
+
+    const double inv = 1.0 / dir[i];
+    double near = (-halfSize[i] - from[i]) * inv;
+    double far = (halfSize[i] - from[i]) * inv;
+    if (near > far)
+      std::swap(near, far);
+
+    if (near > enter) {
+      enter = near;
+      enterAxis = i;
+    }
+    exit = std::min(exit, far);
+  }
+
+  // The ray starts inside the box, misses it, or stops before it
+  if (enterAxis < 0 || enter < 0.0 || enter > exit || enter > maxFraction)
+    return false;
+
+  fraction = enter;
+  normal = Eigen::Vector3d::Zero();
+  normal[enterAxis] = dir[enterAxis] < 0.0 ? 1.0 : -1.0;
+
+  return true;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+bool intersectRayAabb(
+    const Eigen::Vector3d& from,
+    const Eigen::Vector3d& dir,
+    const Eigen::Vector3d& min,
+    const Eigen::Vector3d& max,
+    double maxFraction)
+{
+  double enter = 0.0;
+  double exit = maxFraction;
+
+  for (auto i = 0; i < 3; ++i) {
+    if (dir[i] == 0.0) {
+      if (from[i] < min[i] || from[i] > max[i])
+        return false;
+      continue;
+    }
+
+    const double inv = 1.0 / dir[i];
+    double near = (min[i] - from[i]) * inv;
+    double far = (max[i] - from[i]) * inv;
+    if (near > far)
+      std::swap(near, far);
+
+    enter = std::max(enter, near);
+    exit = std::min(exit, far);
+    if (enter > exit)
+      return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+bool intersectRay(
+    const CollisionObject* object,
+    const Eigen::Vector3d& from,
+    const Eigen::Vector3d& dir,
+    double maxFraction,
+    double& fraction,
+    Eigen::Vector3d& normal)
+{
+  using TypeId = dynamics::Shape::TypeId;
+
+  const auto* shape = object->getShape().get();
+  const Eigen::Isometry3d& tf = object->getTransform();
+
+  // Ray in the frame of the shape
+  const Eigen::Vector3d localFrom = tf.inverse() * from;
+  const Eigen::Vector3d localDir = tf.linear().transpose() * dir;
+
+  Eigen::Vector3d localNormal;
+
+  switch (shape->getTypeId()) {
+    case TypeId::Sphere:
+    case TypeId::Ellipsoid: {
+      // Scale the shape to the unit sphere; the fraction is kept by the
+      // scaling
+      const Eigen::Vector3d radii
+          = shape->getTypeId() == TypeId::Sphere
+                ? Eigen::Vector3d::Constant(
+                    static_cast<const dynamics::SphereShape*>(shape)
+                        ->getRadius())
+                : static_cast<const dynamics::EllipsoidShape*>(shape)
+                      ->getRadii();
+
+      if (!intersectRayUnitSphere(
+              localFrom.cwiseQuotient(radii),
+              localDir.cwiseQuotient(radii),
+              maxFraction,
+              fraction))
+        return false;
+
+      const Eigen::Vector3d point = localFrom + fraction * localDir;
+      localNormal
+          = point.cwiseQuotient(radii.cwiseProduct(radii)).normalized();
+      break;
+    }
+    case TypeId::Box: {
+      const auto* box = static_cast<const dynamics::BoxShape*>(shape);
+      if (!intersectRayBox(
+              0.5 * box->getSize(),
+              localFrom,
+              localDir,
+              maxFraction,
+              fraction,
+              localNormal))
+        return false;
+      break;
+    }
+    default:
+      return false;
+  }
+
+  normal = tf.linear() * localNormal;
+
+  return true;
+}
+
+} // namespace collision
+} // namespace dart
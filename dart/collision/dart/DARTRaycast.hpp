@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COLLISION_DART_DARTRAYCAST_HPP_
+#define DART_COLLISION_DART_DARTRAYCAST_HPP_
+
+#include <dart/collision/CollisionObject.hpp>
+
+#include <Eigen/Dense>
+
+namespace dart {
+namespace collision {
+
+// The functions below take a ray as the points from + t * dir for t in
+// [0, maxFraction]. A shape that contains the start point of a ray is not hit
+// by it.
+
+/// Returns true if the ray passes through the axis-aligned box [min, max].
+bool intersectRayAabb(
+    const Eigen::Vector3d& from,
+    const Eigen::Vector3d& dir,
+    const Eigen::Vector3d& min,
+    const Eigen::Vector3d& max,
+    double maxFraction);
+
+/// Intersects the ray with the shape of a collision object. On a hit, returns
+/// true and sets the fraction t of the hit point and the unit normal of the
+/// shape at that point in world coordinates. Spheres, ellipsoids, and boxes
+/// are supported; the other shapes are never hit.
+bool intersectRay(
+    const CollisionObject* object,
+    const Eigen::Vector3d& from,
+    const Eigen::Vector3d& dir,
+    double maxFraction,
+    double& fraction,
+    Eigen::Vector3d& normal);
+
+} // namespace collision
+} // namespace dart
+
+#endif // DART_COLLISION_DART_DARTRAYCAST_HPP_
@@ -35,6 +35,8 @@
 
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace dart {
 namespace collision {
@@ -56,6 +58,9 @@ public:
   /// Returns true if this container contains the pair.
   bool contains(const T* left, const T* right) const;
 
+  /// Returns all the pairs in this container in no particular order.
+  std::vector<std::pair<const T*, const T*>> getPairs() const;
+
 private:
   /// The actual container to store pairs.
   ///
@@ -146,6 +151,19 @@ bool UnorderedPairs<T>::contains(const T* left, const T* right) const
   return false;
 }
 
+//==============================================================================
+template <class T>
+std::vector<std::pair<const T*, const T*>> UnorderedPairs<T>::getPairs() const
+{
+  std::vector<std::pair<const T*, const T*>> pairs;
+  for (const auto& entry : mList) {
+    for (const auto* right : entry.second)
+      pairs.emplace_back(entry.first, right);
+  }
+
+  return pairs;
+}
+
 } // namespace detail
 } // namespace collision
 } // namespace dart
@@ -35,6 +35,7 @@
 #include "dart/collision/CollisionFilter.hpp"
 #include "dart/collision/CollisionObject.hpp"
 #include "dart/collision/DistanceFilter.hpp"
+#include "dart/collision/dart/DARTCollide.hpp"
 #include "dart/collision/fcl/FCLCollisionGroup.hpp"
 #include "dart/collision/fcl/FCLCollisionObject.hpp"
 #include "dart/collision/fcl/FCLTypes.hpp"
@@ -55,6 +56,10 @@
 
 #include <assimp/scene.h>
 
+#include <map>
+#include <mutex>
+#include <tuple>
+
 namespace dart {
 namespace collision {
 
@@ -83,6 +88,13 @@ void postProcessDART(
     const CollisionOption& option,
     CollisionResult& result);
 
+void postProcessAnalytic(
+    const CollisionResult& pairResult,
+    const CollisionOption& option,
+    CollisionResult& result);
+
+bool isAnalyticShape(const dynamics::Shape& shape);
+
 void interpreteDistanceResult(
     const fcl::DistanceResult& fclResult,
     fcl::CollisionObject* o1,
@@ -159,6 +171,10 @@ struct FCLCollisionCallbackData
   /// Collision result of DART
   CollisionResult* result;
 
+  /// Scratch result of a single pair checked by DART's analytic contact
+  /// generators
+  CollisionResult pairResult;
+
   /// True if at least one contact is found. This flag is used only when
   /// mResult is nullptr; otherwise the actual collision result is in mResult.
   bool foundCollision;
@@ -578,6 +594,70 @@ template <class BV>
   return model;
 }
 
+//==============================================================================
+/// BVHs of meshes, shared by all the FCL collision detectors so that clones of
+/// a MeshShape, and the collision detectors of cloned worlds, do not build a
+/// BVH of the same mesh again.
+class SharedMeshGeometries final
+{
+public:
+  /// Returns the BVH of a mesh at a scale, building it if no shape uses it
+  std::shared_ptr<fcl::CollisionGeometry> claim(
+      std::shared_ptr<const aiScene> mesh, const Eigen::Vector3d& scale)
+  {
+    const Key key(mesh.get(), scale[0], scale[1], scale[2]);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    std::weak_ptr<fcl::CollisionGeometry>& entry = mGeometries[key];
+    if (auto geometry = entry.lock())
+      return geometry;
+
+    // The BVH keeps the mesh alive. MeshShape::getMutableMesh() then copies
+    // the mesh instead of modifying it, and its address is not reused by
+    // another mesh while the BVH exists.
+    std::shared_ptr<fcl::CollisionGeometry> geometry(
+        createMesh<fcl::OBBRSS>(scale[0], scale[1], scale[2], mesh.get()),
+        [this, key, mesh](fcl::CollisionGeometry* geom) {
+          release(key);
+          delete geom;
+        });
+    entry = geometry;
+
+    return geometry;
+  }
+
+private:
+  /// Mesh and scale of a BVH
+  using Key = std::tuple<const aiScene*, double, double, double>;
+
+  /// Removes the entry of a BVH that was deleted
+  void release(const Key& key)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // The entry may already hold a newer BVH of the same mesh
+    const auto it = mGeometries.find(key);
+    if (it != mGeometries.end() && it->second.expired())
+      mGeometries.erase(it);
+  }
+
+  /// Protects mGeometries, since worlds may be stepped in parallel
+  std::mutex mMutex;
+
+  /// BVHs that are in use
+  std::map<Key, std::weak_ptr<fcl::CollisionGeometry>> mGeometries;
+};
+
+//==============================================================================
+SharedMeshGeometries& getSharedMeshGeometries()
+{
+  // Never destroyed, so that BVHs released during static destruction can
+  // still remove their entries
+  static auto* geometries = new SharedMeshGeometries();
+  return *geometries;
+}
+
 } // anonymous namespace
 
 //==============================================================================
@@ -878,144 +958,167 @@ FCLCollisionDetector::createFCLCollisionGeometry(
 #endif // HAVE_OCTOMAP
 
   fcl::CollisionGeometry* geom = nullptr;
-  const auto& shapeType = shape->getType();
 
-  if (SphereShape::getStaticType() == shapeType) {
-    assert(dynamic_cast<const SphereShape*>(shape.get()));
+  switch (shape->getTypeId()) {
+    case Shape::TypeId::Sphere: {
+      assert(dynamic_cast<const SphereShape*>(shape.get()));
 
-    auto* sphere = static_cast<const SphereShape*>(shape.get());
-    const auto radius = sphere->getRadius();
+      auto* sphere = static_cast<const SphereShape*>(shape.get());
+      const auto radius = sphere->getRadius();
 
-    if (FCLCollisionDetector::PRIMITIVE == type)
-      geom = new fcl::Sphere(radius);
-    else
-      geom = createEllipsoid<fcl::OBBRSS>(
-          radius * 2.0, radius * 2.0, radius * 2.0);
-  } else if (BoxShape::getStaticType() == shapeType) {
-    assert(dynamic_cast<const BoxShape*>(shape.get()));
+      if (FCLCollisionDetector::PRIMITIVE == type)
+        geom = new fcl::Sphere(radius);
+      else
+        geom = createEllipsoid<fcl::OBBRSS>(
+            radius * 2.0, radius * 2.0, radius * 2.0);
+      break;
+    }
+    case Shape::TypeId::Box: {
+      assert(dynamic_cast<const BoxShape*>(shape.get()));
 
-    auto box = static_cast<const BoxShape*>(shape.get());
-    const Eigen::Vector3d& size = box->getSize();
+      auto box = static_cast<const BoxShape*>(shape.get());
+      const Eigen::Vector3d& size = box->getSize();
 
-    if (FCLCollisionDetector::PRIMITIVE == type)
-      geom = new fcl::Box(size[0], size[1], size[2]);
-    else
-      geom = createCube<fcl::OBBRSS>(size[0], size[1], size[2]);
-  } else if (EllipsoidShape::getStaticType() == shapeType) {
-    assert(dynamic_cast<const EllipsoidShape*>(shape.get()));
+      if (FCLCollisionDetector::PRIMITIVE == type)
+        geom = new fcl::Box(size[0], size[1], size[2]);
+      else
+        geom = createCube<fcl::OBBRSS>(size[0], size[1], size[2]);
+      break;
+    }
+    case Shape::TypeId::Ellipsoid: {
+      assert(dynamic_cast<const EllipsoidShape*>(shape.get()));
 
-    auto ellipsoid = static_cast<const EllipsoidShape*>(shape.get());
-    const Eigen::Vector3d& radii = ellipsoid->getRadii();
+      auto ellipsoid = static_cast<const EllipsoidShape*>(shape.get());
+      const Eigen::Vector3d& radii = ellipsoid->getRadii();
 
-    if (FCLCollisionDetector::PRIMITIVE == type) {
-      geom = new fcl::Ellipsoid(FCLTypes::convertVector3(radii));
-    } else {
-      geom = createEllipsoid<fcl::OBBRSS>(
-          radii[0] * 2.0, radii[1] * 2.0, radii[2] * 2.0);
-    }
-  } else if (CylinderShape::getStaticType() == shapeType) {
-    assert(dynamic_cast<const CylinderShape*>(shape.get()));
-
-    const auto cylinder = static_cast<const CylinderShape*>(shape.get());
-    const auto radius = cylinder->getRadius();
-    const auto height = cylinder->getHeight();
-
-    if (FCLCollisionDetector::PRIMITIVE == type) {
-      geom = createCylinder<fcl::OBBRSS>(radius, radius, height, 16, 16);
-      // TODO(JS): We still need to use mesh for cylinder because FCL 0.4.0
-      // returns single contact point for cylinder yet. Once FCL support
-      // multiple contact points then above code will be replaced by:
-      // fclCollGeom.reset(new fcl::Cylinder(radius, height));
-    } else {
-      geom = createCylinder<fcl::OBBRSS>(radius, radius, height, 16, 16);
+      if (FCLCollisionDetector::PRIMITIVE == type) {
+        geom = new fcl::Ellipsoid(FCLTypes::convertVector3(radii));
+      } else {
+        geom = createEllipsoid<fcl::OBBRSS>(
+            radii[0] * 2.0, radii[1] * 2.0, radii[2] * 2.0);
+      }
+      break;
     }
-  } else if (ConeShape::getStaticType() == shapeType) {
-    assert(dynamic_cast<const ConeShape*>(shape.get()));
-
-    const auto cone = std::static_pointer_cast<const ConeShape>(shape);
-    const auto radius = cone->getRadius();
-    const auto height = cone->getHeight();
-
-    if (FCLCollisionDetector::PRIMITIVE == type) {
-      // TODO(JS): We still need to use mesh for cone because FCL 0.4.0
-      // returns single contact point for cone yet. Once FCL support
-      // multiple contact points then above code will be replaced by:
-      // fclCollGeom.reset(new fcl::Cone(radius, height));
-      auto fclMesh = new ::fcl::BVHModel<fcl::OBBRSS>();
-      auto fclCone = fcl::Cone(radius, height);
-      ::fcl::generateBVHModel(
-          *fclMesh, fclCone, fcl::getTransform3Identity(), 16, 16);
-      geom = fclMesh;
-    } else {
-      auto fclMesh = new ::fcl::BVHModel<fcl::OBBRSS>();
-      auto fclCone = fcl::Cone(radius, height);
-      ::fcl::generateBVHModel(
-          *fclMesh, fclCone, fcl::getTransform3Identity(), 16, 16);
-      geom = fclMesh;
+    case Shape::TypeId::Cylinder: {
+      assert(dynamic_cast<const CylinderShape*>(shape.get()));
+
+      const auto cylinder = static_cast<const CylinderShape*>(shape.get());
+      const auto radius = cylinder->getRadius();
+      const auto height = cylinder->getHeight();
+
+      if (FCLCollisionDetector::PRIMITIVE == type) {
+        geom = createCylinder<fcl::OBBRSS>(radius, radius, height, 16, 16);
+        // TODO(JS): We still need to use mesh for cylinder because FCL 0.4.0
+        // returns single contact point for cylinder yet. Once FCL support
+        // multiple contact points then above code will be replaced by:
+        // fclCollGeom.reset(new fcl::Cylinder(radius, height));
+      } else {
+        geom = createCylinder<fcl::OBBRSS>(radius, radius, height, 16, 16);
+      }
+      break;
     }
-  } else if (PyramidShape::getStaticType() == shapeType) {
-    assert(dynamic_cast<const PyramidShape*>(shape.get()));
-
-    const auto pyramid = std::static_pointer_cast<const PyramidShape>(shape);
-    // Use mesh since FCL doesn't support pyramid shape.
-    geom = createPyramid<fcl::OBBRSS>(*pyramid, fcl::getTransform3Identity());
-  } else if (PlaneShape::getStaticType() == shapeType) {
-    if (FCLCollisionDetector::PRIMITIVE == type) {
-      assert(dynamic_cast<const PlaneShape*>(shape.get()));
-      auto plane = static_cast<const PlaneShape*>(shape.get());
-      const Eigen::Vector3d normal = plane->getNormal();
-      const double offset = plane->getOffset();
-
-      geom = new fcl::Halfspace(FCLTypes::convertVector3(normal), offset);
-    } else {
-      geom = createCube<fcl::OBBRSS>(1000.0, 0.0, 1000.0);
-      dtwarn
-          << "[FCLCollisionDetector] PlaneShape is not supported by "
-          << "FCLCollisionDetector. We create a thin box mesh instead, where "
-          << "the size is [1000 0 1000].\n";
+    case Shape::TypeId::Cone: {
+      assert(dynamic_cast<const ConeShape*>(shape.get()));
+
+      const auto cone = std::static_pointer_cast<const ConeShape>(shape);
+      const auto radius = cone->getRadius();
+      const auto height = cone->getHeight();
+
+      if (FCLCollisionDetector::PRIMITIVE == type) {
+        // TODO(JS): We still need to use mesh for cone because FCL 0.4.0
+        // returns single contact point for cone yet. Once FCL support
+        // multiple contact points then above code will be replaced by:
+        // fclCollGeom.reset(new fcl::Cone(radius, height));
+        auto fclMesh = new ::fcl::BVHModel<fcl::OBBRSS>();
+        auto fclCone = fcl::Cone(radius, height);
+        ::fcl::generateBVHModel(
+            *fclMesh, fclCone, fcl::getTransform3Identity(), 16, 16);
+        geom = fclMesh;
+      } else {
+        auto fclMesh = new ::fcl::BVHModel<fcl::OBBRSS>();
+        auto fclCone = fcl::Cone(radius, height);
+        ::fcl::generateBVHModel(
+            *fclMesh, fclCone, fcl::getTransform3Identity(), 16, 16);
+        geom = fclMesh;
+      }
+      break;
     }
-  } else if (MeshShape::getStaticType() == shapeType) {
-    assert(dynamic_cast<const MeshShape*>(shape.get()));
-
-    auto shapeMesh = static_cast<const MeshShape*>(shape.get());
-    const Eigen::Vector3d& scale = shapeMesh->getScale();
-    auto aiScene = shapeMesh->getMesh();
+    case Shape::TypeId::Pyramid: {
+      assert(dynamic_cast<const PyramidShape*>(shape.get()));
 
-    geom = createMesh<fcl::OBBRSS>(scale[0], scale[1], scale[2], aiScene);
-  } else if (SoftMeshShape::getStaticType() == shapeType) {
-    assert(dynamic_cast<const SoftMeshShape*>(shape.get()));
+      const auto pyramid = std::static_pointer_cast<const PyramidShape>(shape);
+      // Use mesh since FCL doesn't support pyramid shape.
+      geom = createPyramid<fcl::OBBRSS>(*pyramid, fcl::getTransform3Identity());
+      break;
+    }
+    case Shape::TypeId::Plane: {
+      if (FCLCollisionDetector::PRIMITIVE == type) {
+        assert(dynamic_cast<const PlaneShape*>(shape.get()));
+        auto plane = static_cast<const PlaneShape*>(shape.get());
+        const Eigen::Vector3d normal = plane->getNormal();
+        const double offset = plane->getOffset();
+
+        geom = new fcl::Halfspace(FCLTypes::convertVector3(normal), offset);
+      } else {
+        geom = createCube<fcl::OBBRSS>(1000.0, 0.0, 1000.0);
+        dtwarn
+            << "[FCLCollisionDetector] PlaneShape is not supported by "
+            << "FCLCollisionDetector. We create a thin box mesh instead, where "
+            << "the size is [1000 0 1000].\n";
+      }
+      break;
+    }
+    case Shape::TypeId::Mesh: {
+      assert(dynamic_cast<const MeshShape*>(shape.get()));
+
+      auto shapeMesh = static_cast<const MeshShape*>(shape.get());
+      const Eigen::Vector3d& scale = shapeMesh->getScale();
+      auto mesh = shapeMesh->getSharedMesh();
+
+      // Share the BVH with every shape that uses the same mesh
+      auto sharedGeom = getSharedMeshGeometries().claim(std::move(mesh), scale);
+      return std::shared_ptr<fcl::CollisionGeometry>(
+          sharedGeom.get(),
+          FCLCollisionGeometryDeleter(this, shape, sharedGeom));
+    }
+    case Shape::TypeId::SoftMesh: {
+      assert(dynamic_cast<const SoftMeshShape*>(shape.get()));
 
-    auto softMeshShape = static_cast<const SoftMeshShape*>(shape.get());
-    auto aiMesh = softMeshShape->getAssimpMesh();
+      auto softMeshShape = static_cast<const SoftMeshShape*>(shape.get());
+      auto aiMesh = softMeshShape->getAssimpMesh();
 
-    geom = createSoftMesh<fcl::OBBRSS>(aiMesh);
-  }
+      geom = createSoftMesh<fcl::OBBRSS>(aiMesh);
+      break;
+    }
 #if HAVE_OCTOMAP
-  else if (VoxelGridShape::getStaticType() == shapeType) {
+    case Shape::TypeId::VoxelGrid: {
   #if FCL_HAVE_OCTOMAP
-    assert(dynamic_cast<const VoxelGridShape*>(shape.get()));
+      assert(dynamic_cast<const VoxelGridShape*>(shape.get()));
 
-    auto octreeShape = static_cast<const VoxelGridShape*>(shape.get());
-    auto octree = octreeShape->getOctree();
+      auto octreeShape = static_cast<const VoxelGridShape*>(shape.get());
+      auto octree = octreeShape->getOctree();
 
-    geom = new fcl::OcTree(octree);
+      geom = new fcl::OcTree(octree);
   #else
-    dterr << "[FCLCollisionDetector::createFCLCollisionGeometry] "
-          << "Attempting to create an collision geometry for VoxelGridShape, "
-          << "but the installed FCL isn't built with Octomap support. "
-          << "Creating a sphere with 0.1 radius instead.\n";
+      dterr << "[FCLCollisionDetector::createFCLCollisionGeometry] "
+            << "Attempting to create an collision geometry for VoxelGridShape, "
+            << "but the installed FCL isn't built with Octomap support. "
+            << "Creating a sphere with 0.1 radius instead.\n";
 
-    geom = createEllipsoid<fcl::OBBRSS>(0.1, 0.1, 0.1);
+      geom = createEllipsoid<fcl::OBBRSS>(0.1, 0.1, 0.1);
   #endif // FCL_HAVE_OCTOMAP
-  }
+      break;
+    }
 #endif // HAVE_OCTOMAP
-  else {
-    dterr << "[FCLCollisionDetector::createFCLCollisionGeometry] "
-          << "Attempting to create an unsupported shape type [" << shapeType
-          << "]. Creating a sphere with 0.1 radius "
-          << "instead.\n";
+    default: {
+      dterr << "[FCLCollisionDetector::createFCLCollisionGeometry] "
+            << "Attempting to create an unsupported shape type ["
+            << shape->getType() << "]. Creating a sphere with 0.1 radius "
+            << "instead.\n";
 
-    geom = createEllipsoid<fcl::OBBRSS>(0.1, 0.1, 0.1);
+      geom = createEllipsoid<fcl::OBBRSS>(0.1, 0.1, 0.1);
+      break;
+    }
   }
 
   return std::shared_ptr<fcl::CollisionGeometry>(geom, deleter);
@@ -1023,8 +1126,12 @@ FCLCollisionDetector::createFCLCollisionGeometry(
 
 //==============================================================================
 FCLCollisionDetector::FCLCollisionGeometryDeleter::FCLCollisionGeometryDeleter(
-    FCLCollisionDetector* cd, const dynamics::ConstShapePtr& shape)
-  : mFCLCollisionDetector(cd), mShape(shape)
+    FCLCollisionDetector* cd,
+    const dynamics::ConstShapePtr& shape,
+    std::shared_ptr<fcl::CollisionGeometry> sharedGeometry)
+  : mFCLCollisionDetector(cd),
+    mShape(shape),
+    mSharedGeometry(std::move(sharedGeometry))
 {
   assert(cd);
   assert(shape);
@@ -1036,7 +1143,9 @@ void FCLCollisionDetector::FCLCollisionGeometryDeleter::operator()(
 {
   mFCLCollisionDetector->mShapeMap.erase(mShape);
 
-  delete geom;
+  // A shared geometry is deleted with its last owner
+  if (!mSharedGeometry)
+    delete geom;
 }
 
 namespace {
@@ -1060,14 +1169,38 @@ bool collisionCallback(
   const auto& filter = option.collisionFilter;
 
   // Filtering
-  if (filter) {
-    auto collisionObject1 = static_cast<FCLCollisionObject*>(o1->getUserData());
-    auto collisionObject2 = static_cast<FCLCollisionObject*>(o2->getUserData());
-    assert(collisionObject1);
-    assert(collisionObject2);
+  auto collisionObject1 = static_cast<FCLCollisionObject*>(o1->getUserData());
+  auto collisionObject2 = static_cast<FCLCollisionObject*>(o2->getUserData());
+  assert(collisionObject1);
+  assert(collisionObject2);
+
+  if (!CollisionObject::canCollide(collisionObject1, collisionObject2, option))
+    return collData->done;
+
+  if (filter && filter->ignoresCollision(collisionObject2, collisionObject1))
+    return collData->done;
+
+  if (FCLCollisionDetector::ANALYTIC == collData->primitiveShapeType
+      && isAnalyticShape(*collisionObject1->getShape())
+      && isAnalyticShape(*collisionObject2->getShape())) {
+    auto& pairResult = collData->pairResult;
+    pairResult.clear();
+
+    // Perform narrow-phase detection on the original primitives rather than on
+    // their mesh approximations
+    collide(collisionObject1, collisionObject2, pairResult);
 
-    if (filter->ignoresCollision(collisionObject2, collisionObject1))
-      return collData->done;
+    if (result) {
+      postProcessAnalytic(pairResult, option, *result);
+
+      if (result->getNumContacts() >= option.maxNumContacts)
+        collData->done = true;
+    } else if (pairResult.isCollision()) {
+      collData->foundCollision = true;
+      collData->done = true;
+    }
+
+    return collData->done;
   }
 
   // Clear previous results
@@ -1079,7 +1212,7 @@ bool collisionCallback(
   if (result) {
     // Post processing -- converting fcl contact information to ours if needed
     if (FCLCollisionDetector::DART == collData->contactPointComputationMethod
-        && FCLCollisionDetector::MESH == collData->primitiveShapeType) {
+        && FCLCollisionDetector::PRIMITIVE != collData->primitiveShapeType) {
       postProcessDART(fclResult, o1, o2, option, *result);
     } else {
       postProcessFCL(fclResult, o1, o2, option, *result);
@@ -1407,6 +1540,41 @@ void postProcessDART(
   }
 }
 
+//==============================================================================
+void postProcessAnalytic(
+    const CollisionResult& pairResult,
+    const CollisionOption& option,
+    CollisionResult& result)
+{
+  for (const auto& pairContact : pairResult.getContacts()) {
+    if (option.enableContact) {
+      result.addContact(pairContact);
+    } else {
+      Contact contact;
+      contact.collisionObject1 = pairContact.collisionObject1;
+      contact.collisionObject2 = pairContact.collisionObject2;
+      result.addContact(contact);
+    }
+
+    if (result.getNumContacts() >= option.maxNumContacts)
+      return;
+  }
+}
+
+//==============================================================================
+bool isAnalyticShape(const dynamics::Shape& shape)
+{
+  switch (shape.getTypeId()) {
+    case dynamics::Shape::TypeId::Sphere:
+    case dynamics::Shape::TypeId::Box:
+      return true;
+    case dynamics::Shape::TypeId::Ellipsoid:
+      return static_cast<const dynamics::EllipsoidShape&>(shape).isSphere();
+    default:
+      return false;
+  }
+}
+
 //==============================================================================
 void interpreteDistanceResult(
     const fcl::DistanceResult& fclResult,
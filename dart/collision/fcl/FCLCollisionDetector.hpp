@@ -56,15 +56,20 @@ public:
   /// MESH: Don't use it. Instead, use approximate mesh shapes for the primitive
   /// shapes. The contact result is probably less accurate than the analytic
   /// result.
+  /// ANALYTIC: Use approximate mesh shapes like MESH, but compute the contacts
+  /// of box, sphere, and spherical ellipsoid pairs with DART's analytic
+  /// contact generators after FCL's broadphase. Any other pair falls back to
+  /// the MESH behavior.
   ///
   /// Warning: FCL's primitive shape support is not complete. FCL 0.4.0 improved
   /// the support alot, but it still returns single contact point for a shape
   /// pair except for box-box collision. For this reason, we recommend using
-  /// MESH until FCL fully supports primitive shapes.
+  /// MESH or ANALYTIC until FCL fully supports primitive shapes.
   enum PrimitiveShape
   {
     PRIMITIVE = 0,
-    MESH
+    MESH,
+    ANALYTIC
   };
 
   /// Whether to use FCL's contact point computation.
@@ -161,8 +166,13 @@ private:
   class FCLCollisionGeometryDeleter final
   {
   public:
+    /// Constructor. If sharedGeometry is given, the deleted geometry is owned
+    /// by it, and the deleter only releases that ownership.
     FCLCollisionGeometryDeleter(
-        FCLCollisionDetector* cd, const dynamics::ConstShapePtr& shape);
+        FCLCollisionDetector* cd,
+        const dynamics::ConstShapePtr& shape,
+        std::shared_ptr<dart::collision::fcl::CollisionGeometry> sharedGeometry
+        = nullptr);
 
     void operator()(dart::collision::fcl::CollisionGeometry* geom) const;
 
@@ -170,6 +180,9 @@ private:
     FCLCollisionDetector* mFCLCollisionDetector;
 
     dynamics::ConstShapePtr mShape;
+
+    /// Geometry that is shared with other shapes and collision detectors
+    std::shared_ptr<dart::collision::fcl::CollisionGeometry> mSharedGeometry;
   };
 
   /// Information for a shape that was generated by this collision detector
@@ -96,7 +96,18 @@ void FCLCollisionGroup::removeAllCollisionObjectsFromEngine()
 //==============================================================================
 void FCLCollisionGroup::updateCollisionGroupEngineData()
 {
-  mBroadPhaseAlg->update();
+  if (mUpdatedObjects.empty())
+    return;
+
+  // Only refit the broadphase tree leaves of the objects that moved
+  mUpdatedFCLObjects.clear();
+  mUpdatedFCLObjects.reserve(mUpdatedObjects.size());
+  for (auto object : mUpdatedObjects) {
+    auto casted = static_cast<FCLCollisionObject*>(object);
+    mUpdatedFCLObjects.push_back(casted->getFCLCollisionObject());
+  }
+
+  mBroadPhaseAlg->update(mUpdatedFCLObjects);
 }
 
 //==============================================================================
@@ -87,6 +87,9 @@ protected:
 protected:
   /// FCL broad-phase algorithm
   std::unique_ptr<FCLCollisionManager> mBroadPhaseAlg;
+
+  /// Scratch buffer of the FCL objects to update in the broad-phase algorithm
+  std::vector<dart::collision::fcl::CollisionObject*> mUpdatedFCLObjects;
 };
 
 } // namespace collision
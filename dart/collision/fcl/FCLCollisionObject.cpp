@@ -74,7 +74,7 @@ void FCLCollisionObject::updateEngineData()
   auto shape = mShapeFrame->getShape().get();
 
   // Update soft-body's vertices
-  if (shape->getType() == dynamics::SoftMeshShape::getStaticType()) {
+  if (shape->getTypeId() == Shape::TypeId::SoftMesh) {
     assert(dynamic_cast<const SoftMeshShape*>(shape));
     auto softMeshShape = static_cast<const SoftMeshShape*>(shape);
 
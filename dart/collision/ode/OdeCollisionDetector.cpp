@@ -276,6 +276,9 @@ void CollisionCallback(void* data, dGeomID o1, dGeomID o2)
   assert(collObj1);
   assert(collObj2);
 
+  if (!CollisionObject::canCollide(collObj1, collObj2, option))
+    return;
+
   if (filter && filter->ignoresCollision(collObj1, collObj2))
     return;
 
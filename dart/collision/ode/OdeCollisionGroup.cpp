@@ -115,7 +115,9 @@ void OdeCollisionGroup::removeAllCollisionObjectsFromEngine()
 //==============================================================================
 void OdeCollisionGroup::updateCollisionGroupEngineData()
 {
-  // ODE requires nothing for this.
+  // ODE requires nothing for this. Setting the pose of a body in
+  // OdeCollisionObject::updateEngineData() marks its geoms dirty, so the hash
+  // space only re-hashes the geoms of the objects in mUpdatedObjects.
 }
 
 //==============================================================================
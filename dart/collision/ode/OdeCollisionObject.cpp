@@ -184,44 +184,71 @@ detail::OdeGeom* createOdeGeom(
   detail::OdeGeom* geom = nullptr;
   const auto shape = shapeFrame->getShape().get();
 
-  if (const auto sphere = shape->as<SphereShape>()) {
-    const auto radius = sphere->getRadius();
-
-    geom = new detail::OdeSphere(collObj, radius);
-  } else if (const auto box = shape->as<BoxShape>()) {
-    const Eigen::Vector3d& size = box->getSize();
-
-    geom = new detail::OdeBox(collObj, size);
-  } else if (const auto capsule = shape->as<CapsuleShape>()) {
-    const auto radius = capsule->getRadius();
-    const auto height = capsule->getHeight();
-
-    geom = new detail::OdeCapsule(collObj, radius, height);
-  } else if (const auto cylinder = shape->as<CylinderShape>()) {
-    const auto radius = cylinder->getRadius();
-    const auto height = cylinder->getHeight();
-
-    geom = new detail::OdeCylinder(collObj, radius, height);
-  } else if (const auto plane = shape->as<PlaneShape>()) {
-    const Eigen::Vector3d normal = plane->getNormal();
-    const double offset = plane->getOffset();
-
-    geom = new detail::OdePlane(collObj, normal, offset);
-  } else if (const auto shapeMesh = shape->as<MeshShape>()) {
-    const Eigen::Vector3d& scale = shapeMesh->getScale();
-    auto aiScene = shapeMesh->getMesh();
-
-    geom = new detail::OdeMesh(collObj, aiScene, scale);
-  } else if (const auto heightMap = shape->as<HeightmapShapef>()) {
-    geom = new detail::OdeHeightmapf(collObj, heightMap);
-  } else if (const auto heightMap = shape->as<HeightmapShaped>()) {
-    geom = new detail::OdeHeightmapd(collObj, heightMap);
-  } else {
-    dterr << "[OdeCollisionDetector] Attempting to create an unsupported shape "
-          << "type '" << shape->getType() << "'. Creating a sphere with 0.01 "
-          << "radius instead.\n";
-
-    geom = new detail::OdeSphere(collObj, 0.01);
+  switch (shape->getTypeId()) {
+    case Shape::TypeId::Sphere: {
+      const auto* sphere = static_cast<const SphereShape*>(shape);
+      const auto radius = sphere->getRadius();
+
+      geom = new detail::OdeSphere(collObj, radius);
+      break;
+    }
+    case Shape::TypeId::Box: {
+      const auto* box = static_cast<const BoxShape*>(shape);
+      const Eigen::Vector3d& size = box->getSize();
+
+      geom = new detail::OdeBox(collObj, size);
+      break;
+    }
+    case Shape::TypeId::Capsule: {
+      const auto* capsule = static_cast<const CapsuleShape*>(shape);
+      const auto radius = capsule->getRadius();
+      const auto height = capsule->getHeight();
+
+      geom = new detail::OdeCapsule(collObj, radius, height);
+      break;
+    }
+    case Shape::TypeId::Cylinder: {
+      const auto* cylinder = static_cast<const CylinderShape*>(shape);
+      const auto radius = cylinder->getRadius();
+      const auto height = cylinder->getHeight();
+
+      geom = new detail::OdeCylinder(collObj, radius, height);
+      break;
+    }
+    case Shape::TypeId::Plane: {
+      const auto* plane = static_cast<const PlaneShape*>(shape);
+      const Eigen::Vector3d normal = plane->getNormal();
+      const double offset = plane->getOffset();
+
+      geom = new detail::OdePlane(collObj, normal, offset);
+      break;
+    }
+    case Shape::TypeId::Mesh: {
+      const auto* shapeMesh = static_cast<const MeshShape*>(shape);
+      const Eigen::Vector3d& scale = shapeMesh->getScale();
+      auto aiScene = shapeMesh->getMesh();
+
+      geom = new detail::OdeMesh(collObj, aiScene, scale);
+      break;
+    }
+    case Shape::TypeId::Heightmapf: {
+      const auto* heightMap = static_cast<const HeightmapShapef*>(shape);
+      geom = new detail::OdeHeightmapf(collObj, heightMap);
+      break;
+    }
+    case Shape::TypeId::Heightmapd: {
+      const auto* heightMap = static_cast<const HeightmapShaped*>(shape);
+      geom = new detail::OdeHeightmapd(collObj, heightMap);
+      break;
+    }
+    default: {
+      dterr << "[OdeCollisionDetector] Attempting to create an unsupported "
+            << "shape type '" << shape->getType() << "'. Creating a sphere "
+            << "with 0.01 radius instead.\n";
+
+      geom = new detail::OdeSphere(collObj, 0.01);
+      break;
+    }
   }
   // TODO(JS): not implemented for EllipsoidShape, ConeShape, MultiSphereShape,
   // and SoftMeshShape.
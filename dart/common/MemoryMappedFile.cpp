@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "dart/common/MemoryMappedFile.hpp"
+
+#include "dart/common/Platform.hpp"
+
+#if DART_OS_WINDOWS
+  #include "dart/common/IncludeWindows.hpp"
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace dart::common {
+
+//==============================================================================
+MemoryMappedFile::MemoryMappedFile()
+  : mIsOpen(false),
+    mData(nullptr),
+    mSize(0u),
+    mFileHandle(nullptr),
+    mMappingHandle(nullptr)
+{
+  // Do nothing
+}
+
+//==============================================================================
+MemoryMappedFile::~MemoryMappedFile()
+{
+  close();
+}
+
+//==============================================================================
+bool MemoryMappedFile::open(const std::string& path)
+{
+  close();
+
+#if DART_OS_WINDOWS
+  // Share writing so that the file can still be appended to while it is mapped
+  HANDLE file = CreateFileA(
+      path.c_str(),
+      GENERIC_READ,
+      FILE_SHARE_READ | FILE_SHARE_WRITE,
+      nullptr,
+      OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL,
+      nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    return false;
+  }
+
+  mFileHandle = file;
+  mSize = static_cast<std::size_t>(size.QuadPart);
+  mIsOpen = true;
+
+  // Empty files cannot be mapped
+  if (mSize == 0u)
+    return true;
+
+  HANDLE mapping
+      = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr) {
+    close();
+    return false;
+  }
+  mMappingHandle = mapping;
+
+  mData = static_cast<const char*>(
+      MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if (mData == nullptr) {
+    close();
+    return false;
+  }
+#else
+  const int file = ::open(path.c_str(), O_RDONLY);
+  if (file < 0)
+    return false;
+
+  struct stat status;
+  if (fstat(file, &status) != 0) {
+    ::close(file);
+    return false;
+  }
+
+  mSize = static_cast<std::size_t>(status.st_size);
+  mIsOpen = true;
+
+  // Empty files cannot be mapped
+  if (mSize == 0u) {
+    ::close(file);
+    return true;
+  }
+
+  void* data = mmap(nullptr, mSize, PROT_READ, MAP_SHARED, file, 0);
+
+  // The mapping keeps the file open
+  ::close(file);
+
+  if (data == MAP_FAILED) {
+    mIsOpen = false;
+    mSize = 0u;
+    return false;
+  }
+  mData = static_cast<const char*>(data);
+#endif
+
+  return true;
+}
+
+//==============================================================================
+void MemoryMappedFile::close()
+{
+#if DART_OS_WINDOWS
+  if (mData != nullptr)
+    UnmapViewOfFile(mData);
+  if (mMappingHandle != nullptr)
+    CloseHandle(mMappingHandle);
+  if (mFileHandle != nullptr)
+    CloseHandle(mFileHandle);
+#else
+  if (mData != nullptr)
+    munmap(const_cast<char*>(mData), mSize);
+#endif
+
+  mIsOpen = false;
+  mData = nullptr;
+  mSize = 0u;
+  mFileHandle = nullptr;
+  mMappingHandle = nullptr;
+}
+
+//==============================================================================
+bool MemoryMappedFile::isOpen() const
+{
+  return mIsOpen;
+}
+
+//==============================================================================
+const char* MemoryMappedFile::getData() const
+{
+  return mData;
+}
+
+//==============================================================================
+std::size_t MemoryMappedFile::getSize() const
+{
+  return mSize;
+}
+
+} // namespace dart::common
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef DART_COMMON_MEMORYMAPPEDFILE_HPP_
+#define DART_COMMON_MEMORYMAPPEDFILE_HPP_
+
+#include <string>
+
+#include <cstddef>
+
+namespace dart::common {
+
+/// Read-only memory mapping of a whole file.
+///
+/// The operating system pages the contents in on demand, so random access to
+/// a large file does not read it into memory. The mapping covers the size of
+/// the file when it was opened; open() the file again to see data that was
+/// appended since.
+class MemoryMappedFile final
+{
+public:
+  /// Constructor. The file is not opened.
+  MemoryMappedFile();
+
+  /// Destructor. Unmaps the file.
+  ~MemoryMappedFile();
+
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+  /// Maps the file at path, replacing any file that is mapped. Returns false
+  /// if the file cannot be opened or mapped. An empty file is opened, but it
+  /// has no data.
+  bool open(const std::string& path);
+
+  /// Unmaps the file.
+  void close();
+
+  /// Returns true if a file is mapped.
+  [[nodiscard]] bool isOpen() const;
+
+  /// Returns the contents of the file, or nullptr if it is not open or empty.
+  [[nodiscard]] const char* getData() const;
+
+  /// Returns the size of the mapped file in bytes.
+  [[nodiscard]] std::size_t getSize() const;
+
+private:
+  /// Whether a file is mapped
+  bool mIsOpen;
+
+  /// Start of the mapping
+  const char* mData;
+
+  /// Size of the mapping in bytes
+  std::size_t mSize;
+
+  /// Handles of the file and of the mapping on Windows
+  void* mFileHandle;
+  void* mMappingHandle;
+};
+
+} // namespace dart::common
+
+#endif // DART_COMMON_MEMORYMAPPEDFILE_HPP_
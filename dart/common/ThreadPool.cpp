@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/common/ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace dart::common {
+
+//==============================================================================
+ThreadPool::ThreadPool(std::size_t numThreads)
+  : mTask(nullptr),
+    mCount(0),
+    mNextIndex(0),
+    mGeneration(0),
+    mNumBusyThreads(0),
+    mStop(false)
+{
+  if (numThreads == 0)
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+  mThreads.reserve(numThreads - 1);
+  for (std::size_t i = 1; i < numThreads; ++i)
+    mThreads.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+//==============================================================================
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStop = true;
+  }
+  mStartCondition.notify_all();
+
+  for (auto& thread : mThreads)
+    thread.join();
+}
+
+//==============================================================================
+std::size_t ThreadPool::getNumThreads() const
+{
+  return mThreads.size() + 1u;
+}
+
+//==============================================================================
+void ThreadPool::parallelFor(std::size_t count, const Task& task)
+{
+  if (count == 0u)
+    return;
+
+  if (mThreads.empty() || count == 1u) {
+    for (std::size_t i = 0u; i < count; ++i)
+      task(i, 0u);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mTask = &task;
+    mCount = count;
+    mNextIndex.store(0u, std::memory_order_relaxed);
+    mException = nullptr;
+    mNumBusyThreads = mThreads.size();
+    ++mGeneration;
+  }
+  mStartCondition.notify_all();
+
+  runTasks(0u);
+
+  std::exception_ptr exception;
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDoneCondition.wait(lock, [this] { return mNumBusyThreads == 0u; });
+    mTask = nullptr;
+    exception = mException;
+    mException = nullptr;
+  }
+
+  if (exception)
+    std::rethrow_exception(exception);
+}
+
+//==============================================================================
+void ThreadPool::workerLoop(std::size_t worker)
+{
+  std::size_t generation = 0u;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mStartCondition.wait(
+          lock, [&] { return mStop || mGeneration != generation; });
+
+      if (mStop)
+        return;
+
+      generation = mGeneration;
+    }
+
+    runTasks(worker);
+
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (--mNumBusyThreads == 0u)
+        mDoneCondition.notify_one();
+    }
+  }
+}
+
+//==============================================================================
+void ThreadPool::runTasks(std::size_t worker)
+{
+  while (true) {
+    const std::size_t index = mNextIndex.fetch_add(1u);
+    if (index >= mCount)
+      return;
+
+    try {
+      (*mTask)(index, worker);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (!mException)
+        mException = std::current_exception();
+    }
+  }
+}
+
+} // namespace dart::common
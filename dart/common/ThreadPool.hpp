@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COMMON_THREADPOOL_HPP_
+#define DART_COMMON_THREADPOOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <cstddef>
+
+namespace dart::common {
+
+/// Fixed-size pool of worker threads for data-parallel loops.
+///
+/// The thread that calls parallelFor() takes part in the loop as worker 0, so
+/// a pool of N threads spawns N - 1 background threads.
+class ThreadPool final
+{
+public:
+  /// Task called for each index of parallelFor(). The second argument is the
+  /// index of the worker running the task, which is less than getNumThreads()
+  /// and can be used to select per-worker scratch data.
+  using Task = std::function<void(std::size_t index, std::size_t worker)>;
+
+  /// Constructor
+  ///
+  /// \param[in] numThreads: Number of threads including the calling thread.
+  /// Zero means the number of hardware threads.
+  explicit ThreadPool(std::size_t numThreads = 0);
+
+  /// Destructor. Joins the background threads.
+  ~ThreadPool();
+
+  /// Returns the number of threads including the calling thread.
+  [[nodiscard]] std::size_t getNumThreads() const;
+
+  /// Calls task for every index in [0, count) and blocks until all calls
+  /// returned. Indices are handed out to the workers dynamically, so the
+  /// order and the worker of each call are unspecified. If a task throws, the
+  /// first exception is rethrown on the calling thread after the loop.
+  ///
+  /// This function is not reentrant; tasks must not call parallelFor() on the
+  /// same pool.
+  void parallelFor(std::size_t count, const Task& task);
+
+private:
+  // Deletes copy/move constructors and assign/move operators
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  /// Main loop of the background threads
+  void workerLoop(std::size_t worker);
+
+  /// Runs tasks of the current loop until no index is left
+  void runTasks(std::size_t worker);
+
+  /// Background threads
+  std::vector<std::thread> mThreads;
+
+  /// Mutex protecting the loop state below
+  std::mutex mMutex;
+
+  /// Notifies the background threads of a new loop or of shutdown
+  std::condition_variable mStartCondition;
+
+  /// Notifies the calling thread that the background threads are done
+  std::condition_variable mDoneCondition;
+
+  /// Task of the current loop
+  const Task* mTask;
+
+  /// Number of indices of the current loop
+  std::size_t mCount;
+
+  /// Next index to be handed out
+  std::atomic<std::size_t> mNextIndex;
+
+  /// Incremented for every loop so that the threads can detect a new one
+  std::size_t mGeneration;
+
+  /// Number of background threads still working on the current loop
+  std::size_t mNumBusyThreads;
+
+  /// First exception thrown by a task of the current loop
+  std::exception_ptr mException;
+
+  /// Whether the background threads should exit
+  bool mStop;
+};
+
+} // namespace dart::common
+
+#endif // DART_COMMON_THREADPOOL_HPP_
@@ -32,6 +32,7 @@
 
 #include "dart/constraint/BoxedLcpConstraintSolver.hpp"
 
+#include <algorithm>
 #include <cassert>
 #if DART_BUILD_MODE_DEBUG
   #include <iomanip>
@@ -49,6 +50,24 @@
 namespace dart {
 namespace constraint {
 
+namespace {
+
+//==============================================================================
+/// Returns a rows x cols view of the front of storage, which only grows.
+/// Unlike resizing the storage itself, this doesn't reallocate when the size
+/// of the constrained groups changes between solves.
+template <typename Matrix>
+Eigen::Map<Matrix> getCacheView(
+    Matrix& storage, std::size_t rows, std::size_t cols = 1u)
+{
+  if (static_cast<std::size_t>(storage.size()) < rows * cols)
+    storage.resize(rows, cols);
+
+  return Eigen::Map<Matrix>(storage.data(), rows, cols);
+}
+
+} // namespace
+
 //==============================================================================
 BoxedLcpConstraintSolver::BoxedLcpConstraintSolver(
     double timeStep,
@@ -79,7 +98,7 @@ BoxedLcpConstraintSolver::BoxedLcpConstraintSolver(
 //==============================================================================
 BoxedLcpConstraintSolver::BoxedLcpConstraintSolver(
     BoxedLcpSolverPtr boxedLcpSolver, BoxedLcpSolverPtr secondaryBoxedLcpSolver)
-  : ConstraintSolver()
+  : ConstraintSolver(), mWorkspaces(1), mBlockSparseAssembly(false)
 {
   if (boxedLcpSolver) {
     setBoxedLcpSolver(std::move(boxedLcpSolver));
@@ -109,6 +128,10 @@ void BoxedLcpConstraintSolver::setBoxedLcpSolver(BoxedLcpSolverPtr lcpSolver)
   }
 
   mBoxedLcpSolver = std::move(lcpSolver);
+
+  // The clones of the previous solver are stale
+  for (auto& workspace : mWorkspaces)
+    workspace.mBoxedLcpSolver = nullptr;
 }
 
 //==============================================================================
@@ -129,6 +152,10 @@ void BoxedLcpConstraintSolver::setSecondaryBoxedLcpSolver(
   }
 
   mSecondaryBoxedLcpSolver = std::move(lcpSolver);
+
+  // The clones of the previous solver are stale
+  for (auto& workspace : mWorkspaces)
+    workspace.mSecondaryBoxedLcpSolver = nullptr;
 }
 
 //==============================================================================
@@ -138,8 +165,111 @@ ConstBoxedLcpSolverPtr BoxedLcpConstraintSolver::getSecondaryBoxedLcpSolver()
   return mSecondaryBoxedLcpSolver;
 }
 
+//==============================================================================
+void BoxedLcpConstraintSolver::setBlockSparseAssembly(bool enabled)
+{
+  mBlockSparseAssembly = enabled;
+}
+
+//==============================================================================
+bool BoxedLcpConstraintSolver::isBlockSparseAssembly() const
+{
+  return mBlockSparseAssembly;
+}
+
 //==============================================================================
 void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
+{
+  assert(mBoxedLcpSolver);
+  solveConstrainedGroup(
+      group, mWorkspaces[0], *mBoxedLcpSolver, mSecondaryBoxedLcpSolver.get());
+}
+
+//==============================================================================
+bool BoxedLcpConstraintSolver::prepareParallelSolve(std::size_t numWorkers)
+{
+  if (mWorkspaces.size() < numWorkers)
+    mWorkspaces.resize(numWorkers);
+
+  // The first worker uses the solvers of this class. The others keep their
+  // clones until the solvers are replaced or their settings change.
+  for (std::size_t i = 1u; i < numWorkers; ++i) {
+    auto& workspace = mWorkspaces[i];
+
+    if (!workspace.mTerms)
+      workspace.mTerms = std::make_unique<LcpTerms>();
+
+    const auto version = mBoxedLcpSolver->getSettingsVersion();
+    if (!workspace.mBoxedLcpSolver
+        || workspace.mBoxedLcpSolverVersion != version) {
+      workspace.mBoxedLcpSolver = mBoxedLcpSolver->clone();
+      if (!workspace.mBoxedLcpSolver)
+        return false;
+      workspace.mBoxedLcpSolverVersion = version;
+    }
+
+    if (!mSecondaryBoxedLcpSolver) {
+      workspace.mSecondaryBoxedLcpSolver = nullptr;
+      continue;
+    }
+
+    const auto secondaryVersion
+        = mSecondaryBoxedLcpSolver->getSettingsVersion();
+    if (!workspace.mSecondaryBoxedLcpSolver
+        || workspace.mSecondaryBoxedLcpSolverVersion != secondaryVersion) {
+      workspace.mSecondaryBoxedLcpSolver = mSecondaryBoxedLcpSolver->clone();
+      if (!workspace.mSecondaryBoxedLcpSolver)
+        return false;
+      workspace.mSecondaryBoxedLcpSolverVersion = secondaryVersion;
+    }
+  }
+
+  return true;
+}
+
+//==============================================================================
+void BoxedLcpConstraintSolver::solveConstrainedGroupOnWorker(
+    ConstrainedGroup& group, std::size_t worker)
+{
+  if (worker == 0u) {
+    solveConstrainedGroup(group);
+    return;
+  }
+
+  auto& workspace = mWorkspaces[worker];
+  solveConstrainedGroup(
+      group,
+      workspace,
+      *workspace.mBoxedLcpSolver,
+      workspace.mSecondaryBoxedLcpSolver.get());
+}
+
+//==============================================================================
+void BoxedLcpConstraintSolver::collectStatistics(
+    ConstraintSolverStatistics& statistics)
+{
+  // Each worker counts into its own workspace while the groups are solved
+  for (auto& workspace : mWorkspaces) {
+    const auto& lcp = workspace.mStatistics;
+    statistics.mTotalLcpDimension += lcp.mTotalLcpDimension;
+    statistics.mMaxLcpDimension
+        = std::max(statistics.mMaxLcpDimension, lcp.mMaxLcpDimension);
+    statistics.mNumLcpSolves += lcp.mNumLcpSolves;
+    statistics.mNumLcpIterations += lcp.mNumLcpIterations;
+    statistics.mNumPrimaryLcpFailures += lcp.mNumPrimaryLcpFailures;
+    statistics.mNumSecondaryLcpSolves += lcp.mNumSecondaryLcpSolves;
+    statistics.mNumInvalidLcpSolutions += lcp.mNumInvalidLcpSolutions;
+
+    workspace.mStatistics = ConstraintSolverStatistics();
+  }
+}
+
+//==============================================================================
+void BoxedLcpConstraintSolver::solveConstrainedGroup(
+    ConstrainedGroup& group,
+    LcpWorkspace& workspace,
+    BoxedLcpSolver& boxedLcpSolver,
+    BoxedLcpSolver* secondaryBoxedLcpSolver)
 {
   DART_PROFILE_SCOPED;
 
@@ -151,26 +281,62 @@ void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
   if (0u == n)
     return;
 
+  const bool blockSparse
+      = mBlockSparseAssembly && boxedLcpSolver.canSolveSparse();
+
+  // The terms are views of the cache data so that steady-state solves don't
+  // allocate. The first workspace keeps them in the members of this class.
+  // The backups are only needed with a secondary solver.
+  auto* terms = workspace.mTerms.get();
+  assert(terms || &workspace == &mWorkspaces.front());
+  const auto cache = [terms](auto& member, auto LcpTerms::*own) -> auto& {
+    return terms ? terms->*own : member;
+  };
   const int nSkip = dPAD(n);
-#if DART_BUILD_MODE_RELEASE
-  mA.resize(n, nSkip);
-#else // debug
-  mA.setZero(n, nSkip);
+  const std::size_t nBackup = secondaryBoxedLcpSolver ? n : 0u;
+  auto A
+      = getCacheView(cache(mA, &LcpTerms::mA), blockSparse ? 0u : n, nSkip);
+  auto ABackup
+      = getCacheView(cache(mABackup, &LcpTerms::mABackup), nBackup, nSkip);
+  auto x = getCacheView(cache(mX, &LcpTerms::mX), n);
+  auto xBackup = getCacheView(cache(mXBackup, &LcpTerms::mXBackup), nBackup);
+  auto b = getCacheView(cache(mB, &LcpTerms::mB), n);
+  auto bBackup = getCacheView(cache(mBBackup, &LcpTerms::mBBackup), nBackup);
+  auto w = getCacheView(cache(mW, &LcpTerms::mW), n);
+  auto lo = getCacheView(cache(mLo, &LcpTerms::mLo), n);
+  auto loBackup
+      = getCacheView(cache(mLoBackup, &LcpTerms::mLoBackup), nBackup);
+  auto hi = getCacheView(cache(mHi, &LcpTerms::mHi), n);
+  auto hiBackup
+      = getCacheView(cache(mHiBackup, &LcpTerms::mHiBackup), nBackup);
+  auto findex = getCacheView(cache(mFIndex, &LcpTerms::mFIndex), n);
+  auto findexBackup = getCacheView(
+      cache(mFIndexBackup, &LcpTerms::mFIndexBackup), nBackup);
+  auto offset
+      = getCacheView(cache(mOffset, &LcpTerms::mOffset), numConstraints);
+  auto& sparseA = workspace.mSparseA;
+  auto& sparseABackup = workspace.mSparseABackup;
+  const auto& blocks = workspace.mBlocks;
+  const auto& blockStarts = workspace.mBlockStarts;
+  const auto& blockPositions = workspace.mBlockPositions;
+
+#if !DART_BUILD_MODE_RELEASE
+  A.setZero();
 #endif
-  mX.resize(n);
-  mB.resize(n);
-  mW.setZero(n); // set w to 0
-  mLo.resize(n);
-  mHi.resize(n);
-  mFIndex.setConstant(n, -1); // set findex to -1
+  w.setZero(); // set w to 0
+  findex.setConstant(-1); // set findex to -1
 
   // Compute offset indices
-  mOffset.resize(numConstraints);
-  mOffset[0] = 0;
+  offset[0] = 0;
   for (std::size_t i = 1; i < numConstraints; ++i) {
     const ConstraintBasePtr& constraint = group.getConstraint(i - 1);
     assert(constraint->getDimension() > 0);
-    mOffset[i] = mOffset[i - 1] + constraint->getDimension();
+    offset[i] = offset[i - 1] + constraint->getDimension();
+  }
+
+  if (blockSparse) {
+    DART_PROFILE_SCOPED_N("Build block sparsity");
+    buildBlockSparsity(group, offset, workspace);
   }
 
   // For each constraint
@@ -181,12 +347,12 @@ void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
     for (std::size_t i = 0; i < numConstraints; ++i) {
       const ConstraintBasePtr& constraint = group.getConstraint(i);
 
-      constInfo.x = mX.data() + mOffset[i];
-      constInfo.lo = mLo.data() + mOffset[i];
-      constInfo.hi = mHi.data() + mOffset[i];
-      constInfo.b = mB.data() + mOffset[i];
-      constInfo.findex = mFIndex.data() + mOffset[i];
-      constInfo.w = mW.data() + mOffset[i];
+      constInfo.x = x.data() + offset[i];
+      constInfo.lo = lo.data() + offset[i];
+      constInfo.hi = hi.data() + offset[i];
+      constInfo.b = b.data() + offset[i];
+      constInfo.findex = findex.data() + offset[i];
+      constInfo.w = w.data() + offset[i];
 
       // Fill vectors: lo, hi, b, w
       {
@@ -200,8 +366,8 @@ void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
         constraint->excite();
         for (std::size_t j = 0; j < constraint->getDimension(); ++j) {
           // Adjust findex for global index
-          if (mFIndex[mOffset[i] + j] >= 0)
-            mFIndex[mOffset[i] + j] += mOffset[i];
+          if (findex[offset[i] + j] >= 0)
+            findex[offset[i] + j] += offset[i];
 
           // Apply impulse for impulse test
           {
@@ -210,14 +376,26 @@ void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
           }
 
           // Fill upper triangle blocks of A matrix
-          {
+          if (blockSparse) {
             DART_PROFILE_SCOPED_N("Fill upper triangle of A");
-            int index = nSkip * (mOffset[i] + j) + mOffset[i];
-            constraint->getVelocityChange(mA.data() + index, true);
+            double* row = sparseA.valuePtr()
+                          + sparseA.outerIndexPtr()[offset[i] + j];
+            for (std::size_t p = blockStarts[i]; p < blockStarts[i + 1]; ++p) {
+              const std::size_t k = blocks[p].second;
+              if (k < i)
+                continue;
+
+              group.getConstraint(k)->getVelocityChange(
+                  row + blockPositions[p], k == i);
+            }
+          } else {
+            DART_PROFILE_SCOPED_N("Fill upper triangle of A");
+            int index = nSkip * (offset[i] + j) + offset[i];
+            constraint->getVelocityChange(A.data() + index, true);
             for (std::size_t k = i + 1; k < numConstraints; ++k) {
-              index = nSkip * (mOffset[i] + j) + mOffset[k];
+              index = nSkip * (offset[i] + j) + offset[k];
               group.getConstraint(k)->getVelocityChange(
-                  mA.data() + index, false);
+                  A.data() + index, false);
             }
           }
         }
@@ -229,15 +407,46 @@ void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
       }
     }
 
-    {
+    if (blockSparse) {
+      // Fill lower triangle blocks of A by copying the transposes of the
+      // upper triangle blocks, which are already computed
+      DART_PROFILE_SCOPED_N("Fill lower triangle of A");
+      const int* outer = sparseA.outerIndexPtr();
+      double* values = sparseA.valuePtr();
+      for (std::size_t i = 0; i < numConstraints; ++i) {
+        const std::size_t dimI = group.getConstraint(i)->getDimension();
+        for (std::size_t p = blockStarts[i]; p < blockStarts[i + 1]; ++p) {
+          const std::size_t k = blocks[p].second;
+          if (k > i)
+            break;
+
+          const auto q = std::lower_bound(
+                             blocks.begin() + blockStarts[k],
+                             blocks.begin() + blockStarts[k + 1],
+                             std::make_pair(k, i))
+                         - blocks.begin();
+          assert(blocks[q] == std::make_pair(k, i));
+
+          const std::size_t dimK = group.getConstraint(k)->getDimension();
+          for (std::size_t r = 0; r < dimI; ++r) {
+            // Only the strict lower triangle of a diagonal block
+            const std::size_t numCols = (k == i) ? r : dimK;
+            for (std::size_t c = 0; c < numCols; ++c) {
+              values[outer[offset[i] + r] + blockPositions[p] + c]
+                  = values[outer[offset[k] + c] + blockPositions[q] + r];
+            }
+          }
+        }
+      }
+    } else {
       // Fill lower triangle blocks of A matrix
       DART_PROFILE_SCOPED_N("Fill lower triangle of A");
-      mA.leftCols(n).triangularView<Eigen::Lower>()
-          = mA.leftCols(n).triangularView<Eigen::Upper>().transpose();
+      A.leftCols(n).triangularView<Eigen::Lower>()
+          = A.leftCols(n).triangularView<Eigen::Upper>().transpose();
     }
   }
 
-  assert(isSymmetric(n, mA.data()));
+  assert(blockSparse || isSymmetric(n, A.data()));
 
   // Print LCP formulation
   //  dtdbg << "Before solve:" << std::endl;
@@ -246,56 +455,109 @@ void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
 
   // Solve LCP using the primary solver and fallback to secondary solver when
   // the primary solver failed.
-  if (mSecondaryBoxedLcpSolver) {
+  if (secondaryBoxedLcpSolver) {
     // Make backups for the secondary LCP solver because the primary solver
     // modifies the original terms.
-    mABackup = mA;
-    mXBackup = mX;
-    mBBackup = mB;
-    mLoBackup = mLo;
-    mHiBackup = mHi;
-    mFIndexBackup = mFIndex;
+    if (blockSparse)
+      sparseABackup = sparseA;
+    else
+      ABackup = A;
+    xBackup = x;
+    bBackup = b;
+    loBackup = lo;
+    hiBackup = hi;
+    findexBackup = findex;
+  }
+  const bool earlyTermination = (secondaryBoxedLcpSolver != nullptr);
+  bool success;
+  if (blockSparse) {
+    success = boxedLcpSolver.solveSparse(
+        n,
+        sparseA,
+        x.data(),
+        b.data(),
+        0,
+        lo.data(),
+        hi.data(),
+        findex.data(),
+        earlyTermination);
+  } else {
+    success = boxedLcpSolver.solve(
+        n,
+        A.data(),
+        x.data(),
+        b.data(),
+        0,
+        lo.data(),
+        hi.data(),
+        findex.data(),
+        earlyTermination);
   }
-  const bool earlyTermination = (mSecondaryBoxedLcpSolver != nullptr);
-  assert(mBoxedLcpSolver);
-  bool success = mBoxedLcpSolver->solve(
-      n,
-      mA.data(),
-      mX.data(),
-      mB.data(),
-      0,
-      mLo.data(),
-      mHi.data(),
-      mFIndex.data(),
-      earlyTermination);
 
   // Sanity check. LCP solvers should not report success with nan values, but
   // it could happen. So we set the success to false for nan values.
-  if (success && mX.hasNaN())
+  if (success && x.hasNaN())
     success = false;
 
-  if (!success && mSecondaryBoxedLcpSolver) {
+  auto& statistics = workspace.mStatistics;
+  if (mStatisticsEnabled) {
+    statistics.mTotalLcpDimension += n;
+    statistics.mMaxLcpDimension = std::max(statistics.mMaxLcpDimension, n);
+    ++statistics.mNumLcpSolves;
+    statistics.mNumLcpIterations += boxedLcpSolver.getLastNumIterations();
+    if (!success)
+      ++statistics.mNumPrimaryLcpFailures;
+  }
+
+  if (!success && secondaryBoxedLcpSolver) {
     DART_PROFILE_SCOPED_N("Secondary LCP");
-    mSecondaryBoxedLcpSolver->solve(
-        n,
-        mABackup.data(),
-        mXBackup.data(),
-        mBBackup.data(),
-        0,
-        mLoBackup.data(),
-        mHiBackup.data(),
-        mFIndexBackup.data(),
-        false);
-    mX = mXBackup;
+    if (blockSparse && secondaryBoxedLcpSolver->canSolveSparse()) {
+      secondaryBoxedLcpSolver->solveSparse(
+          n,
+          sparseABackup,
+          xBackup.data(),
+          bBackup.data(),
+          0,
+          loBackup.data(),
+          hiBackup.data(),
+          findexBackup.data(),
+          false);
+    } else {
+      if (blockSparse) {
+        ABackup.setZero();
+        ABackup.leftCols(n) = sparseABackup;
+      }
+
+      secondaryBoxedLcpSolver->solve(
+          n,
+          ABackup.data(),
+          xBackup.data(),
+          bBackup.data(),
+          0,
+          loBackup.data(),
+          hiBackup.data(),
+          findexBackup.data(),
+          false);
+    }
+    x = xBackup;
+
+    if (mStatisticsEnabled) {
+      ++statistics.mNumSecondaryLcpSolves;
+      statistics.mNumLcpIterations
+          += secondaryBoxedLcpSolver->getLastNumIterations();
+    }
   }
 
-  if (mX.hasNaN()) {
+  if (x.hasNaN()) {
+    if (mStatisticsEnabled)
+      ++statistics.mNumInvalidLcpSolutions;
+
     dterr << "[BoxedLcpConstraintSolver] The solution of LCP includes NAN "
-          << "values: " << mX.transpose() << ". We're setting it zero for "
+          << "values: " << x.transpose() << ". We're setting it zero for "
           << "safety. Consider using more robust solver such as PGS as a "
           << "secondary solver. If this happens even with PGS solver, please "
           << "report this as a bug.\n";
-    mX.setZero();
+    x.setZero();
   }
 
   // Print LCP formulation
@@ -308,12 +570,107 @@ void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
     DART_PROFILE_SCOPED_N("Apply constraint impulses");
     for (std::size_t i = 0; i < numConstraints; ++i) {
       const ConstraintBasePtr& constraint = group.getConstraint(i);
-      constraint->applyImpulse(mX.data() + mOffset[i]);
+      constraint->applyImpulse(x.data() + offset[i]);
       constraint->excite();
     }
   }
 }
 
+//==============================================================================
+void BoxedLcpConstraintSolver::buildBlockSparsity(
+    const ConstrainedGroup& group,
+    const Eigen::Ref<const Eigen::VectorXi>& offset,
+    LcpWorkspace& workspace) const
+{
+  const std::size_t numConstraints = group.getNumConstraints();
+  auto& skeletons = workspace.mSkeletons;
+  auto& skeletonConstraints = workspace.mSkeletonConstraints;
+  auto& blocks = workspace.mBlocks;
+  auto& blockStarts = workspace.mBlockStarts;
+  auto& blockPositions = workspace.mBlockPositions;
+
+  // Every constraint couples with itself, and with the constraints that apply
+  // impulses to one of its skeletons
+  skeletonConstraints.clear();
+  blocks.clear();
+  for (std::size_t i = 0; i < numConstraints; ++i) {
+    skeletons.clear();
+    if (!group.getConstraint(i)->getReactiveSkeletons(skeletons)) {
+      for (std::size_t k = 0; k < numConstraints; ++k) {
+        blocks.emplace_back(i, k);
+        blocks.emplace_back(k, i);
+      }
+      continue;
+    }
+
+    blocks.emplace_back(i, i);
+    for (dynamics::Skeleton* skeleton : skeletons)
+      skeletonConstraints.emplace_back(skeleton, i);
+  }
+
+  std::sort(skeletonConstraints.begin(), skeletonConstraints.end());
+  for (std::size_t begin = 0; begin < skeletonConstraints.size();) {
+    std::size_t end = begin + 1;
+    while (end < skeletonConstraints.size()
+           && skeletonConstraints[end].first
+                  == skeletonConstraints[begin].first) {
+      ++end;
+    }
+
+    for (std::size_t a = begin; a < end; ++a) {
+      for (std::size_t b = begin; b < end; ++b) {
+        const std::size_t i = skeletonConstraints[a].second;
+        const std::size_t k = skeletonConstraints[b].second;
+        if (i != k)
+          blocks.emplace_back(i, k);
+      }
+    }
+
+    begin = end;
+  }
+
+  std::sort(blocks.begin(), blocks.end());
+  blocks.erase(std::unique(blocks.begin(), blocks.end()), blocks.end());
+
+  // Lay out the rows of A. The rows of a constraint share the same blocks, and
+  // the entries of a block are contiguous within each row.
+  blockStarts.assign(numConstraints + 1u, 0u);
+  blockPositions.resize(blocks.size());
+  std::size_t numNonZeros = 0u;
+  for (std::size_t i = 0, p = 0; i < numConstraints; ++i) {
+    blockStarts[i] = p;
+    int rowWidth = 0;
+    for (; p < blocks.size() && blocks[p].first == i; ++p) {
+      blockPositions[p] = rowWidth;
+      rowWidth += group.getConstraint(blocks[p].second)->getDimension();
+    }
+    numNonZeros += group.getConstraint(i)->getDimension() * rowWidth;
+  }
+  blockStarts[numConstraints] = blocks.size();
+
+  const std::size_t n = group.getTotalDimension();
+  auto& A = workspace.mSparseA;
+  A.resize(n, n);
+  A.resizeNonZeros(numNonZeros);
+
+  int* outer = A.outerIndexPtr();
+  int* inner = A.innerIndexPtr();
+  outer[0] = 0;
+  for (std::size_t i = 0; i < numConstraints; ++i) {
+    for (std::size_t r = 0; r < group.getConstraint(i)->getDimension(); ++r) {
+      const int row = offset[i] + r;
+      int index = outer[row];
+      for (std::size_t p = blockStarts[i]; p < blockStarts[i + 1]; ++p) {
+        const std::size_t k = blocks[p].second;
+        const std::size_t dimK = group.getConstraint(k)->getDimension();
+        for (std::size_t c = 0; c < dimK; ++c)
+          inner[index++] = offset[k] + c;
+      }
+      outer[row + 1] = index;
+    }
+  }
+}
+
 //==============================================================================
 #if DART_BUILD_MODE_DEBUG
 bool BoxedLcpConstraintSolver::isSymmetric(std::size_t n, double* A)
@@ -33,9 +33,14 @@
 #ifndef DART_CONSTRAINT_BOXEDLCPCONSTRAINTSOLVER_HPP_
 #define DART_CONSTRAINT_BOXEDLCPCONSTRAINTSOLVER_HPP_
 
+#include <dart/constraint/BoxedLcpSolver.hpp>
 #include <dart/constraint/ConstraintSolver.hpp>
 #include <dart/constraint/SmartPointer.hpp>
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 namespace dart {
 namespace constraint {
 
@@ -97,6 +102,20 @@ public:
   /// failed
   ConstBoxedLcpSolverPtr getSecondaryBoxedLcpSolver() const;
 
+  /// Sets whether to assemble the A term of the LCP block by block. In this
+  /// mode only the blocks of constraint pairs that share a reactive skeleton
+  /// are computed, and they are stored in a sparse matrix that is passed to
+  /// BoxedLcpSolver::solveSparse(). This saves memory and unit impulse
+  /// queries for large constrained groups where most constraints don't touch
+  /// each other.
+  ///
+  /// The mode only takes effect when the primary solver supports sparse
+  /// matrices (e.g., PgsBoxedLcpSolver). Disabled by default.
+  void setBlockSparseAssembly(bool enabled);
+
+  /// Returns whether block-sparse assembly is enabled.
+  bool isBlockSparseAssembly() const;
+
 protected:
   // Documentation inherited.
   void solveConstrainedGroup(ConstrainedGroup& group) override;
@@ -154,6 +173,137 @@ protected:
   /// Cache data for boxed LCP formulation
   Eigen::VectorXi mOffset;
 
+  /// LCP terms of a workspace that doesn't keep them in the cache data
+  /// members of this class above
+  struct LcpTerms
+  {
+    /// Cache data for boxed LCP formulation
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> mA;
+
+    /// Cache data for boxed LCP formulation
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        mABackup;
+
+    /// Cache data for boxed LCP formulation
+    Eigen::VectorXd mX;
+
+    /// Cache data for boxed LCP formulation
+    Eigen::VectorXd mXBackup;
+
+    /// Cache data for boxed LCP formulation
+    Eigen::VectorXd mB;
+
+    /// Cache data for boxed LCP formulation
+    Eigen::VectorXd mBBackup;
+
+    /// Cache data for boxed LCP formulation
+    Eigen::VectorXd mW;
+
+    /// Cache data for boxed LCP formulation
+    Eigen::VectorXd mLo;
+
+    /// Cache data for boxed LCP formulation
+    Eigen::VectorXd mLoBackup;
+
+    /// Cache data for boxed LCP formulation
+    Eigen::VectorXd mHi;
+
+    /// Cache data for boxed LCP formulation
+    Eigen::VectorXd mHiBackup;
+
+    /// Cache data for boxed LCP formulation
+    Eigen::VectorXi mFIndex;
+
+    /// Cache data for boxed LCP formulation
+    Eigen::VectorXi mFIndexBackup;
+
+    /// Cache data for boxed LCP formulation
+    Eigen::VectorXi mOffset;
+  };
+
+  /// Scratch data for the boxed LCP formulation of a constrained group. Each
+  /// thread that solves constrained groups owns one workspace.
+  struct LcpWorkspace
+  {
+    /// Clone of the primary boxed LCP solver. Unused by the first workspace,
+    /// which is solved with mBoxedLcpSolver.
+    BoxedLcpSolverPtr mBoxedLcpSolver;
+
+    /// Settings version of mBoxedLcpSolver when it was cloned
+    std::size_t mBoxedLcpSolverVersion = 0u;
+
+    /// Clone of the secondary boxed LCP solver. Unused by the first
+    /// workspace, which is solved with mSecondaryBoxedLcpSolver.
+    BoxedLcpSolverPtr mSecondaryBoxedLcpSolver;
+
+    /// Settings version of mSecondaryBoxedLcpSolver when it was cloned
+    std::size_t mSecondaryBoxedLcpSolverVersion = 0u;
+
+    /// LCP terms of this workspace, or nullptr for the first workspace, which
+    /// keeps its terms in the cache data members of this class
+    std::unique_ptr<LcpTerms> mTerms;
+
+    /// A term of the LCP formulation for block-sparse assembly
+    BoxedLcpSolver::SparseMatrix mSparseA;
+
+    /// Backup of mSparseA for the secondary solver
+    BoxedLcpSolver::SparseMatrix mSparseABackup;
+
+    /// Scratch for the reactive skeletons of a single constraint
+    std::vector<dynamics::Skeleton*> mSkeletons;
+
+    /// Pairs of a reactive skeleton and the index of a constraint that
+    /// applies impulses to it
+    std::vector<std::pair<dynamics::Skeleton*, std::size_t>>
+        mSkeletonConstraints;
+
+    /// Nonzero blocks of A as (row constraint, column constraint) pairs,
+    /// sorted by row and then by column
+    std::vector<std::pair<std::size_t, std::size_t>> mBlocks;
+
+    /// Index of the first block of each constraint in mBlocks
+    std::vector<std::size_t> mBlockStarts;
+
+    /// Offset of each block from the start of its rows in mSparseA
+    std::vector<int> mBlockPositions;
+
+    /// LCP statistics of the groups solved with this workspace since they
+    /// were last collected
+    ConstraintSolverStatistics mStatistics;
+  };
+
+  // Documentation inherited.
+  bool prepareParallelSolve(std::size_t numWorkers) override;
+
+  // Documentation inherited.
+  void solveConstrainedGroupOnWorker(
+      ConstrainedGroup& group, std::size_t worker) override;
+
+  // Documentation inherited.
+  void collectStatistics(ConstraintSolverStatistics& statistics) override;
+
+  /// Solves a constrained group with the given scratch data and LCP solvers.
+  void solveConstrainedGroup(
+      ConstrainedGroup& group,
+      LcpWorkspace& workspace,
+      BoxedLcpSolver& boxedLcpSolver,
+      BoxedLcpSolver* secondaryBoxedLcpSolver);
+
+  /// Finds the nonzero blocks of A for a constrained group and sets up the
+  /// sparsity pattern of workspace.mSparseA, given the offset of the rows of
+  /// each constraint.
+  void buildBlockSparsity(
+      const ConstrainedGroup& group,
+      const Eigen::Ref<const Eigen::VectorXi>& offset,
+      LcpWorkspace& workspace) const;
+
+  /// LCP workspaces, one for each thread. The first one is also used when the
+  /// constrained groups are solved serially.
+  std::vector<LcpWorkspace> mWorkspaces;
+
+  /// Whether to assemble A block by block for sparse solvers
+  bool mBlockSparseAssembly;
+
 #if DART_BUILD_MODE_DEBUG
 private:
   /// Return true if the matrix is symmetric
@@ -38,7 +38,10 @@
 #include <dart/common/Castable.hpp>
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
+#include <cstddef>
+#include <memory>
 #include <string>
 
 namespace dart {
@@ -47,6 +50,9 @@ namespace constraint {
 class BoxedLcpSolver : public common::Castable<BoxedLcpSolver>
 {
 public:
+  /// Sparse matrix type for the A term of the LCP formulation
+  using SparseMatrix = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
   /// Destructor
   virtual ~BoxedLcpSolver() = default;
 
@@ -90,6 +96,60 @@ public:
       bool earlyTermination = false)
       = 0;
 
+  /// Returns true if this solver implements solveSparse().
+  virtual bool canSolveSparse() const
+  {
+    return false;
+  }
+
+  /// Solves the same LCP as solve() but takes A as a compressed sparse matrix
+  /// that stores the nonzero entries of each row, including the diagonal, in
+  /// ascending column order. The solver may change the values of A but not
+  /// its sparsity pattern.
+  ///
+  /// The default implementation returns false without touching x.
+  ///
+  /// \return Success.
+  virtual bool solveSparse(
+      int /*n*/,
+      SparseMatrix& /*A*/,
+      double* /*x*/,
+      double* /*b*/,
+      int /*nub*/,
+      double* /*lo*/,
+      double* /*hi*/,
+      int* /*findex*/,
+      bool /*earlyTermination*/ = false)
+  {
+    return false;
+  }
+
+  /// Returns the number of iterations of the last call to solve() or
+  /// solveSparse(). Solvers that are not iterative return zero, which is what
+  /// the default implementation does.
+  virtual std::size_t getLastNumIterations() const
+  {
+    return 0u;
+  }
+
+  /// Returns a new solver with the same settings, or nullptr if this solver
+  /// cannot be cloned. Constraint solvers use the clones to solve constrained
+  /// groups on several threads at once, so a clone must not share mutable
+  /// state with the original.
+  virtual std::shared_ptr<BoxedLcpSolver> clone() const
+  {
+    return nullptr;
+  }
+
+  /// Returns a number that changes whenever the settings of this solver
+  /// change. Constraint solvers keep the clones of a solver until it changes,
+  /// so solvers with settings must override this. The default implementation
+  /// returns zero.
+  virtual std::size_t getSettingsVersion() const
+  {
+    return 0u;
+  }
+
 #if DART_BUILD_MODE_DEBUG
   virtual bool canSolve(int n, const double* A) = 0;
 #endif
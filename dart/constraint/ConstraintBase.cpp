@@ -66,6 +66,13 @@ std::size_t ConstraintBase::getDimension() const
   return mDim;
 }
 
+//==============================================================================
+bool ConstraintBase::getReactiveSkeletons(
+    std::vector<dynamics::Skeleton*>& /*skeletons*/) const
+{
+  return false;
+}
+
 //==============================================================================
 void ConstraintBase::uniteSkeletons()
 {
@@ -36,6 +36,7 @@
 #include <dart/dynamics/SmartPointer.hpp>
 
 #include <cstddef>
+#include <vector>
 
 namespace dart {
 
@@ -107,6 +108,16 @@ public:
   ///
   virtual dynamics::SkeletonPtr getRootSkeleton() const = 0;
 
+  /// Appends the skeletons that this constraint applies impulses to, which
+  /// are the skeletons flagged by excite(). Two constraints only couple in
+  /// the LCP when they share one of these skeletons.
+  ///
+  /// \return False if the constraint doesn't report its skeletons, in which
+  /// case it is treated as coupled with every other constraint in its group.
+  /// The default implementation returns false.
+  virtual bool getReactiveSkeletons(
+      std::vector<dynamics::Skeleton*>& skeletons) const;
+
   ///
   virtual void uniteSkeletons();
 
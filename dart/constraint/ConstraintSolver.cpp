@@ -41,6 +41,7 @@
 #include "dart/common/Console.hpp"
 #include "dart/common/Macros.hpp"
 #include "dart/common/Profile.hpp"
+#include "dart/common/Stopwatch.hpp"
 #include "dart/constraint/ConstrainedGroup.hpp"
 #include "dart/constraint/ContactConstraint.hpp"
 #include "dart/constraint/ContactSurface.hpp"
@@ -51,16 +52,119 @@
 #include "dart/constraint/SoftContactConstraint.hpp"
 #include "dart/dynamics/BodyNode.hpp"
 #include "dart/dynamics/Joint.hpp"
+#include "dart/dynamics/ShapeNode.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/dynamics/SoftBodyNode.hpp"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <thread>
 
 namespace dart {
 namespace constraint {
 
 using namespace dynamics;
 
+namespace {
+
+/// Number of bytes of a cached contact impulse in the buffers of
+/// ConstraintSolver::saveContactImpulseCache(): the skeleton and ShapeNode
+/// indices of the two shape frames, and the contact point and the impulse in
+/// each of the frames
+constexpr std::size_t cachedContactImpulseSize
+    = 4u * sizeof(std::uint64_t) + 12u * sizeof(double);
+
+//==============================================================================
+/// Moves the entry of [first, end) with the highest score of its contact
+/// point to first
+template <typename Iterator, typename Score>
+void selectBestContact(
+    Iterator first,
+    Iterator end,
+    const collision::CollisionResult& result,
+    Score score)
+{
+  auto best = first;
+  auto bestScore = -std::numeric_limits<double>::infinity();
+  for (auto it = first; it != end; ++it) {
+    const double value = score(result.getContact(it->mContactIndex).point);
+    if (value > bestScore) {
+      best = it;
+      bestScore = value;
+    }
+  }
+  std::iter_swap(first, best);
+}
+
+//==============================================================================
+/// Moves maxNumContacts representative contacts of a pair of collision objects
+/// to the front of [begin, end): the deepest contact, the contact farthest
+/// from it, and then the contacts that maximize the area of the triangle and
+/// of the quadrilateral they span. Any further contacts are chosen by farthest
+/// point sampling.
+template <typename Iterator>
+void selectRepresentativeContacts(
+    Iterator begin,
+    Iterator end,
+    std::size_t maxNumContacts,
+    const collision::CollisionResult& result)
+{
+  assert(maxNumContacts > 0u);
+  assert(static_cast<std::size_t>(end - begin) > maxNumContacts);
+
+  const auto point = [&](std::size_t i) -> Eigen::Vector3d {
+    return result.getContact(begin[i].mContactIndex).point;
+  };
+
+  std::iter_swap(
+      begin,
+      std::max_element(
+          begin, end, [&](const auto& entry1, const auto& entry2) {
+            return result.getContact(entry1.mContactIndex).penetrationDepth
+                   < result.getContact(entry2.mContactIndex).penetrationDepth;
+          }));
+  if (maxNumContacts == 1u)
+    return;
+
+  const Eigen::Vector3d a = point(0u);
+  selectBestContact(begin + 1, end, result, [&](const Eigen::Vector3d& p) {
+    return (p - a).squaredNorm();
+  });
+  if (maxNumContacts == 2u)
+    return;
+
+  const Eigen::Vector3d b = point(1u);
+  selectBestContact(begin + 2, end, result, [&](const Eigen::Vector3d& p) {
+    return (b - a).cross(p - a).squaredNorm();
+  });
+  if (maxNumContacts == 3u)
+    return;
+
+  // The area of a quadrilateral is half the norm of the cross product of its
+  // diagonals, so score the point by the largest quadrilateral it forms when
+  // inserted at any edge of the triangle
+  const Eigen::Vector3d c = point(2u);
+  selectBestContact(begin + 3, end, result, [&](const Eigen::Vector3d& p) {
+    return std::max(
+        {(b - a).cross(c - p).squaredNorm(),
+         (p - a).cross(c - b).squaredNorm(),
+         (c - a).cross(p - b).squaredNorm()});
+  });
+
+  for (auto i = 4u; i < maxNumContacts; ++i) {
+    selectBestContact(begin + i, end, result, [&](const Eigen::Vector3d& p) {
+      auto minDistance = std::numeric_limits<double>::infinity();
+      for (auto j = 0u; j < i; ++j)
+        minDistance = std::min(minDistance, (p - point(j)).squaredNorm());
+      return minDistance;
+    });
+  }
+}
+
+} // namespace
+
 //==============================================================================
 ConstraintSolver::ConstraintSolver(double timeStep)
   : mCollisionDetector(collision::FCLCollisionDetector::create()),
@@ -68,17 +172,30 @@ ConstraintSolver::ConstraintSolver(double timeStep)
     mCollisionOption(collision::CollisionOption(
         true, 1000u, std::make_shared<collision::BodyNodeCollisionFilter>())),
     mTimeStep(timeStep),
-    mContactSurfaceHandler(std::make_shared<DefaultContactSurfaceHandler>())
+    mContactSurfaceHandler(std::make_shared<DefaultContactSurfaceHandler>()),
+    mContactConstraintPool(std::make_shared<common::PoolAllocator>()),
+    mContactWarmStarting(false),
+    mContactWarmStartingDistance(1e-2),
+    mStatisticsEnabled(false)
 {
   assert(timeStep > 0.0);
 
   auto cd = std::static_pointer_cast<collision::FCLCollisionDetector>(
       mCollisionDetector);
 
-  cd->setPrimitiveShapeType(collision::FCLCollisionDetector::MESH);
+  cd->setPrimitiveShapeType(collision::FCLCollisionDetector::ANALYTIC);
+  // Boxes and spheres get DART's analytic contacts while the other shapes are
+  // still checked as meshes.
   // TODO(JS): Consider using FCL's primitive shapes once FCL addresses
   // incorrect contact point computation.
   // (see: https://github.com/flexible-collision-library/fcl/issues/106)
+
+  // BodyNodeCollisionFilter also skips these pairs, but the collision
+  // detector can drop them in the broadphase
+  mCollisionOption.skipDisabledSelfCollisions = true;
+
+  // Skeletons at rest can't start touching each other while asleep
+  mCollisionOption.skipSleepingPairs = true;
 }
 
 //==============================================================================
@@ -88,15 +205,28 @@ ConstraintSolver::ConstraintSolver()
     mCollisionOption(collision::CollisionOption(
         true, 1000u, std::make_shared<collision::BodyNodeCollisionFilter>())),
     mTimeStep(0.001),
-    mContactSurfaceHandler(std::make_shared<DefaultContactSurfaceHandler>())
+    mContactSurfaceHandler(std::make_shared<DefaultContactSurfaceHandler>()),
+    mContactConstraintPool(std::make_shared<common::PoolAllocator>()),
+    mContactWarmStarting(false),
+    mContactWarmStartingDistance(1e-2),
+    mStatisticsEnabled(false)
 {
   auto cd = std::static_pointer_cast<collision::FCLCollisionDetector>(
       mCollisionDetector);
 
-  cd->setPrimitiveShapeType(collision::FCLCollisionDetector::MESH);
+  cd->setPrimitiveShapeType(collision::FCLCollisionDetector::ANALYTIC);
+  // Boxes and spheres get DART's analytic contacts while the other shapes are
+  // still checked as meshes.
   // TODO(JS): Consider using FCL's primitive shapes once FCL addresses
   // incorrect contact point computation.
   // (see: https://github.com/flexible-collision-library/fcl/issues/106)
+
+  // BodyNodeCollisionFilter also skips these pairs, but the collision
+  // detector can drop them in the broadphase
+  mCollisionOption.skipDisabledSelfCollisions = true;
+
+  // Skeletons at rest can't start touching each other while asleep
+  mCollisionOption.skipSleepingPairs = true;
 }
 
 //==============================================================================
@@ -149,6 +279,11 @@ void ConstraintSolver::removeSkeleton(const SkeletonPtr& skeleton)
   mSkeletons.erase(
       remove(mSkeletons.begin(), mSkeletons.end(), skeleton), mSkeletons.end());
   mConstrainedGroups.reserve(mSkeletons.size());
+
+  // The collision objects of the skeleton may be destroyed, and their
+  // addresses reused by new ones. The same goes for the skeleton itself.
+  mContactImpulseCache.clear();
+  mSkeletonJointConstraints.clear();
 }
 
 //==============================================================================
@@ -164,6 +299,8 @@ void ConstraintSolver::removeAllSkeletons()
 {
   mCollisionGroup->removeAllShapeFrames();
   mSkeletons.clear();
+  mContactImpulseCache.clear();
+  mSkeletonJointConstraints.clear();
 }
 
 //==============================================================================
@@ -284,6 +421,7 @@ void ConstraintSolver::setCollisionDetector(
   mCollisionDetector = collisionDetector;
 
   mCollisionGroup = mCollisionDetector->createCollisionGroupAsSharedPtr();
+  mContactImpulseCache.clear();
 
   for (const auto& skeleton : mSkeletons)
     mCollisionGroup->addShapeFramesOf(skeleton.get());
@@ -371,14 +509,225 @@ void ConstraintSolver::solve()
     DART_SUPPRESS_DEPRECATED_END
   }
 
-  // Update constraints and collect active constraints
-  updateConstraints();
+  if (!mStatisticsEnabled) {
+    // Update constraints and collect active constraints
+    updateConstraints();
+
+    // Build constrained groups
+    buildConstrainedGroups();
+
+    // Solve constrained groups
+    solveConstrainedGroups();
+  } else {
+    // Same phases as above, but timed. updateConstraints() measures the
+    // collision detection itself.
+    mStatistics = ConstraintSolverStatistics();
+
+    common::StopwatchNS stopwatch;
+    updateConstraints();
+    mStatistics.mUpdateConstraintsTime
+        = stopwatch.elapsedS() - mStatistics.mCollisionTime;
+
+    stopwatch.reset();
+    buildConstrainedGroups();
+    mStatistics.mBuildConstrainedGroupsTime = stopwatch.elapsedS();
+
+    stopwatch.reset();
+    solveConstrainedGroups();
+    mStatistics.mSolveConstrainedGroupsTime = stopwatch.elapsedS();
+
+    mStatistics.mNumContacts = mCollisionResult.getNumContacts();
+    mStatistics.mNumActiveConstraints = mActiveConstraints.size();
+    mStatistics.mNumConstrainedGroups = mConstrainedGroups.size();
+    for (const auto& group : mConstrainedGroups) {
+      mStatistics.mMaxConstrainedGroupSize = std::max(
+          mStatistics.mMaxConstrainedGroupSize, group.getNumConstraints());
+    }
+
+    collectStatistics(mStatistics);
+  }
+
+  // Remember the contact impulses while the contacts still match the current
+  // body transforms
+  if (mContactWarmStarting)
+    cacheContactImpulses();
+}
+
+//==============================================================================
+void ConstraintSolver::setNumThreads(std::size_t numThreads)
+{
+  if (numThreads == 0u)
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+  if (numThreads == getNumThreads())
+    return;
+
+  if (numThreads == 1u)
+    mThreadPool.reset();
+  else
+    mThreadPool = std::make_unique<common::ThreadPool>(numThreads);
+}
+
+//==============================================================================
+std::size_t ConstraintSolver::getNumThreads() const
+{
+  return mThreadPool ? mThreadPool->getNumThreads() : 1u;
+}
+
+//==============================================================================
+void ConstraintSolver::setContactWarmStarting(bool enabled)
+{
+  mContactWarmStarting = enabled;
+
+  if (!mContactWarmStarting)
+    mContactImpulseCache.clear();
+}
+
+//==============================================================================
+bool ConstraintSolver::isContactWarmStarting() const
+{
+  return mContactWarmStarting;
+}
+
+//==============================================================================
+void ConstraintSolver::setContactWarmStartingDistance(double distance)
+{
+  assert(distance >= 0.0);
+  mContactWarmStartingDistance = distance;
+}
+
+//==============================================================================
+double ConstraintSolver::getContactWarmStartingDistance() const
+{
+  return mContactWarmStartingDistance;
+}
+
+//==============================================================================
+std::size_t ConstraintSolver::getContactImpulseCacheSize() const
+{
+  return mContactImpulseCache.size() * cachedContactImpulseSize;
+}
+
+//==============================================================================
+void ConstraintSolver::saveContactImpulseCache(char* buffer) const
+{
+  const auto write = [&](const void* data, std::size_t numBytes) {
+    std::memcpy(buffer, data, numBytes);
+    buffer += numBytes;
+  };
+
+  const auto writeIndices = [&](const dynamics::ShapeFrame* frame) {
+    // The collision group of this solver only holds ShapeNodes of its
+    // skeletons
+    const auto* shapeNode = frame->asShapeNode();
+    assert(shapeNode);
+    const auto it = std::find(
+        mSkeletons.begin(), mSkeletons.end(), shapeNode->getSkeleton());
+    assert(it != mSkeletons.end());
+
+    const std::uint64_t indices[2]
+        = {static_cast<std::uint64_t>(it - mSkeletons.begin()),
+           shapeNode->getIndexInSkeleton()};
+    write(indices, sizeof(indices));
+  };
+
+  for (const auto& cached : mContactImpulseCache) {
+    writeIndices(cached.mFrames.first);
+    writeIndices(cached.mFrames.second);
+    write(cached.mPoint.data(), 3 * sizeof(double));
+    write(cached.mImpulse.data(), 3 * sizeof(double));
+    write(cached.mOtherPoint.data(), 3 * sizeof(double));
+    write(cached.mOtherImpulse.data(), 3 * sizeof(double));
+  }
+}
+
+//==============================================================================
+void ConstraintSolver::restoreContactImpulseCache(
+    const char* buffer, std::size_t size)
+{
+  assert(size % cachedContactImpulseSize == 0u);
+
+  const auto read = [&](void* data, std::size_t numBytes) {
+    std::memcpy(data, buffer, numBytes);
+    buffer += numBytes;
+  };
+
+  // Returns the ShapeNode that the indices refer to, or nullptr
+  const auto readFrame = [&]() -> const dynamics::ShapeFrame* {
+    std::uint64_t indices[2];
+    read(indices, sizeof(indices));
+    if (indices[0] >= mSkeletons.size())
+      return nullptr;
+
+    const auto& skel = mSkeletons[indices[0]];
+    if (indices[1] >= skel->getNumShapeNodes())
+      return nullptr;
+
+    return skel->getShapeNode(indices[1]);
+  };
+
+  const std::size_t numEntries = size / cachedContactImpulseSize;
+  mContactImpulseCache.clear();
+  mContactImpulseCache.reserve(numEntries);
+  for (auto i = 0u; i < numEntries; ++i) {
+    CachedContactImpulse cached;
+    cached.mFrames.first = readFrame();
+    cached.mFrames.second = readFrame();
+    read(cached.mPoint.data(), 3 * sizeof(double));
+    read(cached.mImpulse.data(), 3 * sizeof(double));
+    read(cached.mOtherPoint.data(), 3 * sizeof(double));
+    read(cached.mOtherImpulse.data(), 3 * sizeof(double));
+
+    if (!cached.mFrames.first || !cached.mFrames.second)
+      continue;
+
+    if (cached.mFrames.second < cached.mFrames.first) {
+      std::swap(cached.mFrames.first, cached.mFrames.second);
+      std::swap(cached.mPoint, cached.mOtherPoint);
+      std::swap(cached.mImpulse, cached.mOtherImpulse);
+    }
+
+    mContactImpulseCache.push_back(cached);
+  }
+
+  std::sort(
+      mContactImpulseCache.begin(),
+      mContactImpulseCache.end(),
+      [](const CachedContactImpulse& a, const CachedContactImpulse& b) {
+        return a.mFrames < b.mFrames;
+      });
+}
+
+//==============================================================================
+void ConstraintSolver::setStatisticsEnabled(bool enabled)
+{
+  mStatisticsEnabled = enabled;
+  mStatistics = ConstraintSolverStatistics();
+}
+
+//==============================================================================
+bool ConstraintSolver::isStatisticsEnabled() const
+{
+  return mStatisticsEnabled;
+}
+
+//==============================================================================
+const ConstraintSolverStatistics& ConstraintSolver::getStatistics() const
+{
+  return mStatistics;
+}
 
-  // Build constrained groups
-  buildConstrainedGroups();
+//==============================================================================
+std::size_t ConstraintSolver::getNumConstrainedGroups() const
+{
+  return mConstrainedGroups.size();
+}
 
-  // Solve constrained groups
-  solveConstrainedGroups();
+//==============================================================================
+std::size_t ConstraintSolver::getConstrainedGroupIndex(
+    const dynamics::Skeleton& skeleton) const
+{
+  return skeleton.mUnionIndex;
 }
 
 //==============================================================================
@@ -392,6 +741,18 @@ void ConstraintSolver::setFromOtherConstraintSolver(
   mManualConstraints = other.mManualConstraints;
 
   mContactSurfaceHandler = other.mContactSurfaceHandler;
+
+  setNumThreads(other.getNumThreads());
+  mContactWarmStarting = other.mContactWarmStarting;
+  mContactWarmStartingDistance = other.mContactWarmStartingDistance;
+  setStatisticsEnabled(other.mStatisticsEnabled);
+}
+
+//==============================================================================
+void ConstraintSolver::collectStatistics(
+    ConstraintSolverStatistics& /*statistics*/)
+{
+  // Do nothing
 }
 
 //==============================================================================
@@ -477,7 +838,13 @@ void ConstraintSolver::updateConstraints()
   //----------------------------------------------------------------------------
   mCollisionResult.clear();
 
-  mCollisionGroup->collide(mCollisionOption, &mCollisionResult);
+  if (mStatisticsEnabled) {
+    common::StopwatchNS stopwatch;
+    mCollisionGroup->collide(mCollisionOption, &mCollisionResult);
+    mStatistics.mCollisionTime = stopwatch.elapsedS();
+  } else {
+    mCollisionGroup->collide(mCollisionOption, &mCollisionResult);
+  }
 
   // Destroy previous contact constraints
   mContactConstraints.clear();
@@ -485,29 +852,10 @@ void ConstraintSolver::updateConstraints()
   // Destroy previous soft contact constraints
   mSoftContactConstraints.clear();
 
-  // Create a mapping of contact pairs to the number of contacts between them
-  using ContactPair
-      = std::pair<collision::CollisionObject*, collision::CollisionObject*>;
-
-  // Compare contact pairs while ignoring their order in the pair.
-  struct ContactPairCompare
-  {
-    ContactPair getSortedPair(const ContactPair& a) const
-    {
-      if (a.first < a.second)
-        return std::make_pair(a.second, a.first);
-      return a;
-    }
-
-    bool operator()(const ContactPair& a, const ContactPair& b) const
-    {
-      // Sort each pair and then do a lexicographical comparison
-      return getSortedPair(a) < getSortedPair(b);
-    }
-  };
-
-  std::map<ContactPair, size_t, ContactPairCompare> contactPairMap;
-  std::vector<collision::Contact*> contacts;
+  // Collect the contacts to create contact constraints for, along with their
+  // colliding objects in a canonical order to count the contacts per pair
+  mContactPairEntries.clear();
+  mNumPairContacts.assign(mCollisionResult.getNumContacts(), 0u);
 
   // Create new contact constraints
   for (auto i = 0u; i < mCollisionResult.getNumContacts(); ++i) {
@@ -541,31 +889,70 @@ void ConstraintSolver::updateConstraints()
       mSoftContactConstraints.push_back(
           std::make_shared<SoftContactConstraint>(contact, mTimeStep));
     } else {
-      // Increment the count of contacts between the two collision objects
-      ++contactPairMap[std::make_pair(
-          contact.collisionObject1, contact.collisionObject2)];
+      const collision::CollisionObject* object1 = contact.collisionObject1;
+      const collision::CollisionObject* object2 = contact.collisionObject2;
+      if (object2 < object1)
+        std::swap(object1, object2);
 
-      contacts.push_back(&contact);
+      mContactPairEntries.push_back(
+          ContactPairEntry{std::make_pair(object1, object2), i});
     }
   }
 
-  // Add the new contact constraints to dynamic constraint list
-  for (auto* contact : contacts) {
-    std::size_t numContacts = 1;
-    auto it = contactPairMap.find(
-        std::make_pair(contact->collisionObject1, contact->collisionObject2));
-    if (it != contactPairMap.end())
-      numContacts = it->second;
+  // Count the contacts between each pair of collision objects by sorting the
+  // entries, which unlike a map doesn't allocate once the buffers are grown
+  std::sort(
+      mContactPairEntries.begin(),
+      mContactPairEntries.end(),
+      [](const ContactPairEntry& a, const ContactPairEntry& b) {
+        return a.mObjects < b.mObjects;
+      });
+  for (auto begin = mContactPairEntries.begin();
+       begin != mContactPairEntries.end();) {
+    auto end = std::find_if(
+        begin, mContactPairEntries.end(), [&](const ContactPairEntry& entry) {
+          return entry.mObjects != begin->mObjects;
+        });
+    auto numContacts = static_cast<std::size_t>(end - begin);
+
+    // Reduce the contacts of the pair to the representative ones, which leaves
+    // the other contacts without a contact constraint
+    const auto maxNumContacts
+        = mContactSurfaceHandler->getMaxNumContactsPerPair(
+            begin->mObjects.first, begin->mObjects.second);
+    if (maxNumContacts > 0u && numContacts > maxNumContacts) {
+      selectRepresentativeContacts(
+          begin, end, maxNumContacts, mCollisionResult);
+      numContacts = maxNumContacts;
+    }
+
+    for (auto it = begin; it != begin + numContacts; ++it)
+      mNumPairContacts[it->mContactIndex] = numContacts;
+    begin = end;
+  }
+
+  // Add the new contact constraints to dynamic constraint list in the order of
+  // the contacts
+  const auto* previousPool
+      = ContactSurfaceHandler::setConstraintPool(&mContactConstraintPool);
+  for (auto i = 0u; i < mCollisionResult.getNumContacts(); ++i) {
+    const auto numContacts = mNumPairContacts[i];
+    if (numContacts == 0u)
+      continue;
 
     auto contactConstraint = mContactSurfaceHandler->createConstraint(
-        *contact, numContacts, mTimeStep);
+        mCollisionResult.getContact(i), numContacts, mTimeStep);
     mContactConstraints.push_back(contactConstraint);
 
+    if (mContactWarmStarting)
+      warmStartContactConstraint(*contactConstraint);
+
     contactConstraint->update();
 
     if (contactConstraint->isActive())
       mActiveConstraints.push_back(contactConstraint);
   }
+  ContactSurfaceHandler::setConstraintPool(previousPool);
 
   // Add the new soft contact constraints to dynamic constraint list
   for (const auto& softContactConstraint : mSoftContactConstraints) {
@@ -578,62 +965,161 @@ void ConstraintSolver::updateConstraints()
   //----------------------------------------------------------------------------
   // Update automatic constraints: joint constraints
   //----------------------------------------------------------------------------
-  // Destroy previous joint constraints
-  mJointConstraints.clear();
-  mMimicMotorConstraints.clear();
-  mJointCoulombFrictionConstraints.clear();
-
-  // Create new joint constraints
-  for (const auto& skel : mSkeletons) {
-    const std::size_t numJoints = skel->getNumJoints();
-    for (std::size_t i = 0; i < numJoints; i++) {
-      dynamics::Joint* joint = skel->getJoint(i);
-
-      if (joint->isKinematic())
+  // The joint constraints are kept across steps, and recreated only for the
+  // skeletons whose joints changed. Sleeping skeletons are at rest, so their
+  // joints can't violate the limits.
+  mSkeletonJointConstraints.resize(mSkeletons.size());
+  for (auto i = 0u; i < mSkeletons.size(); ++i) {
+    dynamics::Skeleton& skel = *mSkeletons[i];
+    SkeletonJointConstraints& constraints = mSkeletonJointConstraints[i];
+
+    if (constraints.mSkeleton != &skel
+        || constraints.mVersion != skel.getVersion())
+      createJointConstraints(skel, constraints);
+  }
+
+  // Add active joint limit. Only the constraints with a violated limit and
+  // the servo motors are updated. They are reset first so that they behave
+  // like the newly created constraints of every step did.
+  for (auto i = 0u; i < mSkeletons.size(); ++i) {
+    if (mSkeletons[i]->isSleeping())
+      continue;
+
+    SkeletonJointConstraints& constraints = mSkeletonJointConstraints[i];
+    markViolatedJointLimits(*mSkeletons[i], constraints);
+
+    for (auto j = 0u; j < constraints.mJointConstraints.size(); ++j) {
+      if (!constraints.mIsServo[j] && !constraints.mIsViolated[j])
         continue;
 
-      const std::size_t dof = joint->getNumDofs();
-      for (std::size_t j = 0; j < dof; ++j) {
-        if (joint->getCoulombFriction(j) != 0.0) {
-          mJointCoulombFrictionConstraints.push_back(
-              std::make_shared<JointCoulombFrictionConstraint>(joint));
-          break;
-        }
-      }
+      constraints.mIsViolated[j] = false;
 
-      if (joint->areLimitsEnforced()
-          || joint->getActuatorType() == dynamics::Joint::SERVO) {
-        mJointConstraints.push_back(std::make_shared<JointConstraint>(joint));
-      }
+      const auto& jointLimitConstraint = constraints.mJointConstraints[j];
+      jointLimitConstraint->deactivate();
+      jointLimitConstraint->update();
 
-      if (joint->getActuatorType() == dynamics::Joint::MIMIC
-          && joint->getMimicJoint()) {
-        mMimicMotorConstraints.push_back(std::make_shared<MimicMotorConstraint>(
-            joint, joint->getMimicDofProperties()));
-      }
+      if (jointLimitConstraint->isActive())
+        mActiveConstraints.push_back(jointLimitConstraint);
     }
   }
 
-  // Add active joint limit
-  for (auto& jointLimitConstraint : mJointConstraints) {
-    jointLimitConstraint->update();
+  for (auto i = 0u; i < mSkeletons.size(); ++i) {
+    if (mSkeletons[i]->isSleeping())
+      continue;
+
+    for (auto& mimicMotorConstraint :
+         mSkeletonJointConstraints[i].mMimicMotorConstraints) {
+      mimicMotorConstraint->deactivate();
+      mimicMotorConstraint->update();
 
-    if (jointLimitConstraint->isActive())
-      mActiveConstraints.push_back(jointLimitConstraint);
+      if (mimicMotorConstraint->isActive())
+        mActiveConstraints.push_back(mimicMotorConstraint);
+    }
   }
 
-  for (auto& mimicMotorConstraint : mMimicMotorConstraints) {
-    mimicMotorConstraint->update();
+  for (auto i = 0u; i < mSkeletons.size(); ++i) {
+    if (mSkeletons[i]->isSleeping())
+      continue;
+
+    for (auto& jointFrictionConstraint :
+         mSkeletonJointConstraints[i].mJointCoulombFrictionConstraints) {
+      jointFrictionConstraint->deactivate();
+      jointFrictionConstraint->update();
+
+      if (jointFrictionConstraint->isActive())
+        mActiveConstraints.push_back(jointFrictionConstraint);
+    }
+  }
+}
+
+//==============================================================================
+void ConstraintSolver::createJointConstraints(
+    dynamics::Skeleton& skeleton, SkeletonJointConstraints& constraints) const
+{
+  constraints.mSkeleton = &skeleton;
+  constraints.mVersion = skeleton.getVersion();
+  constraints.mJointConstraints.clear();
+  constraints.mIsServo.clear();
+  constraints.mLimits.clear();
+  constraints.mMimicMotorConstraints.clear();
+  constraints.mJointCoulombFrictionConstraints.clear();
+
+  const std::size_t numJoints = skeleton.getNumJoints();
+  for (std::size_t i = 0; i < numJoints; i++) {
+    dynamics::Joint* joint = skeleton.getJoint(i);
+
+    if (joint->isKinematic())
+      continue;
+
+    const std::size_t dof = joint->getNumDofs();
+    for (std::size_t j = 0; j < dof; ++j) {
+      if (joint->getCoulombFriction(j) != 0.0) {
+        constraints.mJointCoulombFrictionConstraints.push_back(
+            std::make_shared<JointCoulombFrictionConstraint>(joint));
+        break;
+      }
+    }
 
-    if (mimicMotorConstraint->isActive())
-      mActiveConstraints.push_back(mimicMotorConstraint);
+    const bool isServo = joint->getActuatorType() == dynamics::Joint::SERVO;
+    if (joint->areLimitsEnforced() || isServo) {
+      const std::size_t constraintIndex = constraints.mJointConstraints.size();
+      constraints.mJointConstraints.push_back(
+          std::make_shared<JointConstraint>(joint));
+      constraints.mIsServo.push_back(isServo);
+
+      if (joint->areLimitsEnforced()) {
+        for (std::size_t j = 0; j < dof; ++j) {
+          constraints.mLimits.push_back(JointLimitEntry{
+              joint,
+              j,
+              constraintIndex,
+              joint->getPositionLowerLimit(j),
+              joint->getPositionUpperLimit(j),
+              joint->getVelocityLowerLimit(j),
+              joint->getVelocityUpperLimit(j)});
+        }
+      }
+    }
+
+    if (joint->getActuatorType() == dynamics::Joint::MIMIC
+        && joint->getMimicJoint()) {
+      constraints.mMimicMotorConstraints.push_back(
+          std::make_shared<MimicMotorConstraint>(
+              joint, joint->getMimicDofProperties()));
+    }
   }
 
-  for (auto& jointFrictionConstraint : mJointCoulombFrictionConstraints) {
-    jointFrictionConstraint->update();
+  constraints.mIsViolated.assign(constraints.mJointConstraints.size(), false);
+}
 
-    if (jointFrictionConstraint->isActive())
-      mActiveConstraints.push_back(jointFrictionConstraint);
+//==============================================================================
+void ConstraintSolver::markViolatedJointLimits(
+    const dynamics::Skeleton& skeleton,
+    SkeletonJointConstraints& constraints) const
+{
+  // Same conditions as in JointConstraint::update()
+  const double timeStep = skeleton.getTimeStep();
+  const double errorAllowance = JointConstraint::getErrorAllowance();
+  for (const auto& limit : constraints.mLimits) {
+    const double position = limit.mJoint->getPosition(limit.mDofIndex);
+    const double velocity = limit.mJoint->getVelocity(limit.mDofIndex);
+
+    const double lowerError
+        = position - limit.mPositionLowerLimit + errorAllowance;
+    const double upperError
+        = position - limit.mPositionUpperLimit - errorAllowance;
+    const double velocityLowerLimit = std::max(
+        limit.mVelocityLowerLimit,
+        (limit.mPositionLowerLimit - position) / timeStep);
+    const double velocityUpperLimit = std::min(
+        limit.mVelocityUpperLimit,
+        (limit.mPositionUpperLimit - position) / timeStep);
+
+    if (lowerError < 0.0 || 0.0 < upperError
+        || velocity - velocityLowerLimit < 0.0
+        || velocity - velocityUpperLimit > 0.0) {
+      constraints.mIsViolated[limit.mConstraintIndex] = true;
+    }
   }
 }
 
@@ -642,53 +1128,165 @@ void ConstraintSolver::buildConstrainedGroups()
 {
   DART_PROFILE_SCOPED;
 
-  // Clear constrained groups
-  mConstrainedGroups.clear();
+  constexpr auto noGroup = std::numeric_limits<std::size_t>::max();
 
   // Exit if there is no active constraint
-  if (mActiveConstraints.empty())
+  if (mActiveConstraints.empty()) {
+    mConstrainedGroups.clear();
+    for (auto& skeleton : mSkeletons)
+      skeleton->mUnionIndex = noGroup;
     return;
+  }
 
   //----------------------------------------------------------------------------
-  // Unite skeletons according to constraints's relationships
+  // Unite skeletons according to constraints's relationships. The nodes of the
+  // union-find are the skeletons of this solver followed by any other
+  // skeletons that the constraints refer to. Skeleton::mUnionIndex holds the
+  // node of each skeleton until the groups are built.
   //----------------------------------------------------------------------------
-  for (const auto& activeConstraint : mActiveConstraints)
-    activeConstraint->uniteSkeletons();
+  const auto numSkeletons = mSkeletons.size();
+  mUnionParents.resize(numSkeletons);
+  mUnionSizes.assign(numSkeletons, 1u);
+  mUnionSkeletons.clear();
+  for (auto i = 0u; i < numSkeletons; ++i) {
+    mUnionParents[i] = i;
+    mSkeletons[i]->mUnionIndex = i;
+  }
 
-  //----------------------------------------------------------------------------
-  // Build constraint groups
-  //----------------------------------------------------------------------------
-  for (const auto& activeConstraint : mActiveConstraints) {
-    bool found = false;
-    const auto& skel = activeConstraint->getRootSkeleton();
+  const auto getNode = [&](dynamics::Skeleton* skeleton) {
+    const auto node = skeleton->mUnionIndex;
+    if (node < numSkeletons) {
+      if (mSkeletons[node].get() == skeleton)
+        return node;
+    } else if (
+        node < mUnionParents.size()
+        && mUnionSkeletons[node - numSkeletons].get() == skeleton) {
+      return node;
+    }
 
-    for (const auto& constrainedGroup : mConstrainedGroups) {
-      if (constrainedGroup.mRootSkeleton == skel) {
-        found = true;
-        break;
-      }
+    const auto newNode = mUnionParents.size();
+    skeleton->mUnionIndex = newNode;
+    mUnionParents.push_back(newNode);
+    mUnionSizes.push_back(1u);
+    mUnionSkeletons.push_back(skeleton->getPtr());
+    return newNode;
+  };
+
+  // Constraints that don't report their skeletons unite them with the
+  // union-find of Skeleton through uniteSkeletons()
+  bool hasLegacyConstraints = false;
+
+  mActiveConstraintGroups.resize(mActiveConstraints.size());
+  for (auto i = 0u; i < mActiveConstraints.size(); ++i) {
+    const auto& activeConstraint = mActiveConstraints[i];
+
+    mReactiveSkeletons.clear();
+    if (!activeConstraint->getReactiveSkeletons(mReactiveSkeletons)) {
+      activeConstraint->uniteSkeletons();
+      hasLegacyConstraints = true;
     }
 
-    if (found)
+    if (mReactiveSkeletons.empty()) {
+      mActiveConstraintGroups[i]
+          = getNode(activeConstraint->getRootSkeleton().get());
       continue;
+    }
 
-    ConstrainedGroup newConstGroup;
-    newConstGroup.mRootSkeleton = skel;
-    skel->mUnionIndex = mConstrainedGroups.size();
-    mConstrainedGroups.push_back(newConstGroup);
+    const auto node = getNode(mReactiveSkeletons.front());
+    for (auto j = 1u; j < mReactiveSkeletons.size(); ++j)
+      uniteUnionNodes(node, getNode(mReactiveSkeletons[j]));
+    mActiveConstraintGroups[i] = node;
   }
 
-  // Add active constraints to constrained groups
-  for (const auto& activeConstraint : mActiveConstraints) {
-    const auto& skel = activeConstraint->getRootSkeleton();
-    mConstrainedGroups[skel->mUnionIndex].addConstraint(activeConstraint);
+  if (hasLegacyConstraints) {
+    // New nodes can be added while merging, but they are roots of the
+    // union-find of Skeleton
+    for (auto node = 0u; node < mUnionParents.size(); ++node) {
+      const auto& skeleton = node < numSkeletons
+                                 ? mSkeletons[node]
+                                 : mUnionSkeletons[node - numSkeletons];
+      const auto root = ConstraintBase::compressPath(skeleton);
+      if (root != skeleton)
+        uniteUnionNodes(node, getNode(root.get()));
+    }
+
+    for (auto& skeleton : mSkeletons)
+      skeleton->resetUnion();
+    for (auto& skeleton : mUnionSkeletons)
+      skeleton->resetUnion();
   }
 
   //----------------------------------------------------------------------------
-  // Reset union since we don't need union information anymore.
+  // Build constraint groups by counting sort. The groups are numbered in the
+  // order of their first constraint, and the constraints of each group keep
+  // their order in mActiveConstraints.
   //----------------------------------------------------------------------------
-  for (auto& skeleton : mSkeletons)
-    skeleton->resetUnion();
+  mUnionGroups.assign(mUnionParents.size(), noGroup);
+  mConstrainedGroupSizes.clear();
+  for (auto& group : mActiveConstraintGroups) {
+    auto& rootGroup = mUnionGroups[findUnionRoot(group)];
+    if (rootGroup == noGroup) {
+      rootGroup = mConstrainedGroupSizes.size();
+      mConstrainedGroupSizes.push_back(0u);
+    }
+    group = rootGroup;
+    ++mConstrainedGroupSizes[group];
+  }
+
+  // The groups are reused across steps to keep the memory of their lists
+  const auto numGroups = mConstrainedGroupSizes.size();
+  mConstrainedGroups.resize(numGroups);
+  for (auto i = 0u; i < numGroups; ++i) {
+    mConstrainedGroups[i].removeAllConstraints();
+    mConstrainedGroups[i].mConstraints.reserve(mConstrainedGroupSizes[i]);
+  }
+
+  for (auto i = 0u; i < mActiveConstraints.size(); ++i) {
+    mConstrainedGroups[mActiveConstraintGroups[i]].addConstraint(
+        mActiveConstraints[i]);
+  }
+
+  //----------------------------------------------------------------------------
+  // Record the constrained group of each skeleton
+  //----------------------------------------------------------------------------
+  for (auto node = 0u; node < mUnionParents.size(); ++node) {
+    const auto root = findUnionRoot(node);
+    const auto group = mUnionGroups[root];
+    const auto& skeleton = node < numSkeletons
+                               ? mSkeletons[node]
+                               : mUnionSkeletons[node - numSkeletons];
+    skeleton->mUnionIndex = group;
+    if (group != noGroup && node == root)
+      mConstrainedGroups[group].mRootSkeleton = skeleton;
+  }
+}
+
+//==============================================================================
+std::size_t ConstraintSolver::findUnionRoot(std::size_t node)
+{
+  // Path halving
+  while (mUnionParents[node] != node) {
+    mUnionParents[node] = mUnionParents[mUnionParents[node]];
+    node = mUnionParents[node];
+  }
+
+  return node;
+}
+
+//==============================================================================
+void ConstraintSolver::uniteUnionNodes(std::size_t node1, std::size_t node2)
+{
+  auto root1 = findUnionRoot(node1);
+  auto root2 = findUnionRoot(node2);
+  if (root1 == root2)
+    return;
+
+  // Union by size
+  if (mUnionSizes[root1] < mUnionSizes[root2])
+    std::swap(root1, root2);
+
+  mUnionParents[root2] = root1;
+  mUnionSizes[root1] += mUnionSizes[root2];
 }
 
 //==============================================================================
@@ -696,11 +1294,34 @@ void ConstraintSolver::solveConstrainedGroups()
 {
   DART_PROFILE_SCOPED;
 
+  if (mThreadPool && mConstrainedGroups.size() > 1u
+      && prepareParallelSolve(mThreadPool->getNumThreads())) {
+    mThreadPool->parallelFor(
+        mConstrainedGroups.size(),
+        [this](std::size_t index, std::size_t worker) {
+          solveConstrainedGroupOnWorker(mConstrainedGroups[index], worker);
+        });
+    return;
+  }
+
   for (auto& constraintGroup : mConstrainedGroups) {
     solveConstrainedGroup(constraintGroup);
   }
 }
 
+//==============================================================================
+bool ConstraintSolver::prepareParallelSolve(std::size_t /*numWorkers*/)
+{
+  return false;
+}
+
+//==============================================================================
+void ConstraintSolver::solveConstrainedGroupOnWorker(
+    ConstrainedGroup& group, std::size_t /*worker*/)
+{
+  solveConstrainedGroup(group);
+}
+
 //==============================================================================
 bool ConstraintSolver::isSoftContact(const collision::Contact& contact) const
 {
@@ -721,6 +1342,90 @@ bool ConstraintSolver::isSoftContact(const collision::Contact& contact) const
   return bodyNode1IsSoft || bodyNode2IsSoft;
 }
 
+//==============================================================================
+void ConstraintSolver::cacheContactImpulses()
+{
+  mContactImpulseCache.clear();
+
+  for (auto i = 0u; i < mCollisionResult.getNumContacts(); ++i) {
+    const auto& contact = mCollisionResult.getContact(i);
+
+    // Skip the contacts that didn't make it into a solved contact constraint
+    if (contact.force.isZero(0.0))
+      continue;
+
+    const auto* frame1 = contact.collisionObject1->getShapeFrame();
+    const auto* frame2 = contact.collisionObject2->getShapeFrame();
+    Eigen::Vector3d impulse = contact.force * mTimeStep;
+    if (frame2 < frame1) {
+      std::swap(frame1, frame2);
+      impulse = -impulse;
+    }
+
+    const Eigen::Isometry3d& tf1 = frame1->getWorldTransform();
+    const Eigen::Isometry3d& tf2 = frame2->getWorldTransform();
+
+    CachedContactImpulse cached;
+    cached.mFrames = std::make_pair(frame1, frame2);
+    cached.mPoint = tf1.inverse() * contact.point;
+    cached.mImpulse = tf1.linear().transpose() * impulse;
+    cached.mOtherPoint = tf2.inverse() * contact.point;
+    cached.mOtherImpulse = -(tf2.linear().transpose() * impulse);
+    mContactImpulseCache.push_back(cached);
+  }
+
+  std::sort(
+      mContactImpulseCache.begin(),
+      mContactImpulseCache.end(),
+      [](const CachedContactImpulse& a, const CachedContactImpulse& b) {
+        return a.mFrames < b.mFrames;
+      });
+}
+
+//==============================================================================
+void ConstraintSolver::warmStartContactConstraint(
+    ContactConstraint& constraint) const
+{
+  const collision::Contact& contact = constraint.getContact();
+
+  const auto* frame1 = contact.collisionObject1->getShapeFrame();
+  const auto* frame2 = contact.collisionObject2->getShapeFrame();
+  const bool swapped = frame2 < frame1;
+  if (swapped)
+    std::swap(frame1, frame2);
+
+  const auto range = std::equal_range(
+      mContactImpulseCache.begin(),
+      mContactImpulseCache.end(),
+      CachedContactImpulse{std::make_pair(frame1, frame2), {}, {}, {}, {}},
+      [](const CachedContactImpulse& a, const CachedContactImpulse& b) {
+        return a.mFrames < b.mFrames;
+      });
+  if (range.first == range.second)
+    return;
+
+  const Eigen::Isometry3d& tf = frame1->getWorldTransform();
+  const Eigen::Vector3d point = tf.inverse() * contact.point;
+
+  // Find the closest contact of the previous step
+  auto closest = range.second;
+  double minSquaredDistance
+      = mContactWarmStartingDistance * mContactWarmStartingDistance;
+  for (auto it = range.first; it != range.second; ++it) {
+    const double squaredDistance = (it->mPoint - point).squaredNorm();
+    if (squaredDistance < minSquaredDistance) {
+      minSquaredDistance = squaredDistance;
+      closest = it;
+    }
+  }
+
+  if (closest == range.second)
+    return;
+
+  const Eigen::Vector3d impulse = tf.linear() * closest->mImpulse;
+  constraint.setInitialImpulse(swapped ? Eigen::Vector3d(-impulse) : impulse);
+}
+
 //==============================================================================
 ContactSurfaceHandlerPtr ConstraintSolver::getLastContactSurfaceHandler() const
 {
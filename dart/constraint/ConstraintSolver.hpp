@@ -35,14 +35,18 @@
 
 #include <dart/constraint/ConstrainedGroup.hpp>
 #include <dart/constraint/ConstraintBase.hpp>
+#include <dart/constraint/ConstraintSolverStatistics.hpp>
 #include <dart/constraint/SmartPointer.hpp>
 
 #include <dart/collision/CollisionDetector.hpp>
 
 #include <dart/common/Deprecated.hpp>
+#include <dart/common/PoolAllocator.hpp>
+#include <dart/common/ThreadPool.hpp>
 
 #include <Eigen/Dense>
 
+#include <memory>
 #include <vector>
 
 namespace dart {
@@ -212,6 +216,78 @@ public:
   /// Solve constraint impulses and apply them to the skeletons
   void solve();
 
+  /// Sets the number of threads used to solve independent constrained groups.
+  /// The default is 1, which solves the groups one after another on the
+  /// calling thread. Zero means the number of hardware threads.
+  ///
+  /// The constrained groups are formed from disjoint sets of skeletons, so
+  /// solving them concurrently gives the same impulses as solving them
+  /// serially. Solvers that cannot solve groups concurrently (see
+  /// prepareParallelSolve()) keep solving them serially.
+  void setNumThreads(std::size_t numThreads);
+
+  /// Returns the number of threads used to solve constrained groups.
+  std::size_t getNumThreads() const;
+
+  /// Sets whether to warm start the contact constraints with the contact
+  /// impulses of the previous step. Each contact is matched to the closest
+  /// contact of the previous step between the same pair of collision objects,
+  /// where the contact points are compared in the frame of one of the objects.
+  /// Iterative LCP solvers such as PGS then start close to the solution for
+  /// resting contacts and need far fewer iterations. Disabled by default.
+  void setContactWarmStarting(bool enabled);
+
+  /// Returns whether the contact constraints are warm started.
+  bool isContactWarmStarting() const;
+
+  /// Sets the maximum distance between two contact points of consecutive
+  /// steps to be considered the same contact for warm starting. The default
+  /// is 0.01.
+  void setContactWarmStartingDistance(double distance);
+
+  /// Returns the maximum distance between two contact points of consecutive
+  /// steps to be considered the same contact for warm starting.
+  double getContactWarmStartingDistance() const;
+
+  /// Returns the number of bytes that saveContactImpulseCache() writes.
+  std::size_t getContactImpulseCacheSize() const;
+
+  /// Writes the contact impulses of the previous step, which warm start the
+  /// contact constraints, to buffer. The buffer must have room for
+  /// getContactImpulseCacheSize() bytes. The impulses are keyed by the indices
+  /// of the skeletons in this solver and of the ShapeNodes in the skeletons,
+  /// so they also warm start a solver with the same skeletons, e.g., the
+  /// solver of a cloned world.
+  void saveContactImpulseCache(char* buffer) const;
+
+  /// Replaces the contact impulses of the previous step with the size bytes
+  /// that saveContactImpulseCache() wrote to buffer. Impulses whose indices
+  /// do not refer to ShapeNodes of this solver are dropped.
+  void restoreContactImpulseCache(const char* buffer, std::size_t size);
+
+  /// Sets whether to collect the statistics of solve(), such as the time of
+  /// each phase, the number of contacts and the LCP dimensions. Collecting
+  /// them costs a few clock reads per step. Disabled by default.
+  void setStatisticsEnabled(bool enabled);
+
+  /// Returns whether the statistics of solve() are collected.
+  bool isStatisticsEnabled() const;
+
+  /// Returns the statistics of the last call to solve(). The statistics are
+  /// zero unless they are enabled with setStatisticsEnabled().
+  const ConstraintSolverStatistics& getStatistics() const;
+
+  /// Returns the number of constrained groups, or islands, of the last call
+  /// to solve(). The skeletons of different groups don't share any active
+  /// constraint, so the groups can be solved, or put to sleep, independently.
+  std::size_t getNumConstrainedGroups() const;
+
+  /// Returns the index of the constrained group of a skeleton of this solver
+  /// in the last call to solve(), or std::numeric_limits<std::size_t>::max()
+  /// if the skeleton had no active constraint.
+  std::size_t getConstrainedGroupIndex(
+      const dynamics::Skeleton& skeleton) const;
+
   /// Sets this constraint solver using other constraint solver. All the
   /// properties and registered skeletons and constraints will be copied over.
   virtual void setFromOtherConstraintSolver(const ConstraintSolver& other);
@@ -238,6 +314,23 @@ protected:
   // TODO(JS): Docstring
   virtual void solveConstrainedGroup(ConstrainedGroup& group) = 0;
 
+  /// Prepares per-worker resources to solve constrained groups on numWorkers
+  /// threads. Returns false if the groups can only be solved serially, which
+  /// is what the default implementation does.
+  virtual bool prepareParallelSolve(std::size_t numWorkers);
+
+  /// Solves a constrained group using the resources of the given worker. Only
+  /// called after prepareParallelSolve() returned true, and never
+  /// concurrently for the same worker.
+  virtual void solveConstrainedGroupOnWorker(
+      ConstrainedGroup& group, std::size_t worker);
+
+  /// Adds the statistics that only the concrete solver knows about, such as
+  /// those of the LCP solvers, to \c statistics. Called at the end of solve()
+  /// while the statistics are enabled. The default implementation does
+  /// nothing.
+  virtual void collectStatistics(ConstraintSolverStatistics& statistics);
+
   /// Checks if the skeleton is contained in this solver
   ///
   /// \deprecated Use hasSkeleton() instead.
@@ -262,12 +355,39 @@ protected:
   /// Build constrained groupsContact
   void buildConstrainedGroups();
 
+  /// Returns the root of a node of the union-find of buildConstrainedGroups()
+  std::size_t findUnionRoot(std::size_t node);
+
+  /// Merges the sets of two nodes of the union-find of
+  /// buildConstrainedGroups()
+  void uniteUnionNodes(std::size_t node1, std::size_t node2);
+
   /// Solve constrained groups
   void solveConstrainedGroups();
 
   /// Return true if at least one of colliding body is soft body
   bool isSoftContact(const collision::Contact& contact) const;
 
+  /// Stores the impulses of the contacts in the last collision result to warm
+  /// start the contact constraints of the next step
+  void cacheContactImpulses();
+
+  /// Sets the initial impulse of a contact constraint from the matching
+  /// contact of the previous step, if any
+  void warmStartContactConstraint(ContactConstraint& constraint) const;
+
+  struct SkeletonJointConstraints;
+
+  /// Recreates the joint constraints of a skeleton
+  void createJointConstraints(
+      dynamics::Skeleton& skeleton,
+      SkeletonJointConstraints& constraints) const;
+
+  /// Flags the joint constraints of a skeleton with a violated limit
+  void markViolatedJointLimits(
+      const dynamics::Skeleton& skeleton,
+      SkeletonJointConstraints& constraints) const;
+
   using CollisionDetector = collision::CollisionDetector;
 
   /// Collision detector
@@ -291,18 +411,86 @@ protected:
   /// Contact constraints those are automatically created
   std::vector<ContactConstraintPtr> mContactConstraints;
 
+  /// Contact of the last collision result that gets a contact constraint
+  struct ContactPairEntry
+  {
+    /// Colliding objects ordered by address
+    std::pair<
+        const collision::CollisionObject*,
+        const collision::CollisionObject*>
+        mObjects;
+
+    /// Index of the contact in mCollisionResult
+    std::size_t mContactIndex;
+  };
+
+  /// Contacts that get a contact constraint, reused across steps
+  std::vector<ContactPairEntry> mContactPairEntries;
+
+  /// Number of contacts between the colliding objects of each contact of
+  /// mCollisionResult, or zero if the contact gets no contact constraint.
+  /// Reused across steps.
+  std::vector<std::size_t> mNumPairContacts;
+
   /// Soft contact constraints those are automatically created
   std::vector<SoftContactConstraintPtr> mSoftContactConstraints;
 
-  /// Joint limit constraints those are automatically created
-  std::vector<JointConstraintPtr> mJointConstraints;
+  /// Limits of a DOF of a joint that enforces its limits. Checking these flat
+  /// entries finds the violated limits without updating every JointConstraint.
+  struct JointLimitEntry
+  {
+    /// Joint of the DOF
+    const dynamics::Joint* mJoint;
+
+    /// Index of the DOF in the joint
+    std::size_t mDofIndex;
+
+    /// Index of the constraint of the joint in
+    /// SkeletonJointConstraints::mJointConstraints
+    std::size_t mConstraintIndex;
+
+    /// Limits of the DOF
+    double mPositionLowerLimit;
+    double mPositionUpperLimit;
+    double mVelocityLowerLimit;
+    double mVelocityUpperLimit;
+  };
+
+  /// Joint constraints that are automatically created for the joints of a
+  /// skeleton. They are kept across steps and only recreated when the version
+  /// of the skeleton changes, e.g., when a joint limit or actuator type is
+  /// changed.
+  struct SkeletonJointConstraints
+  {
+    /// Skeleton the constraints were created for
+    const dynamics::Skeleton* mSkeleton = nullptr;
+
+    /// Version of the skeleton when the constraints were created
+    std::size_t mVersion = 0u;
+
+    /// Joint limit and servo motor constraints
+    std::vector<JointConstraintPtr> mJointConstraints;
+
+    /// Whether each of mJointConstraints is a servo motor, which needs to be
+    /// updated every step
+    std::vector<char> mIsServo;
 
-  /// Mimic motor constraints those are automatically created
-  std::vector<MimicMotorConstraintPtr> mMimicMotorConstraints;
+    /// Whether each of mJointConstraints has a violated limit in this step
+    std::vector<char> mIsViolated;
 
-  /// Joint Coulomb friction constraints those are automatically created
-  std::vector<JointCoulombFrictionConstraintPtr>
-      mJointCoulombFrictionConstraints;
+    /// Limits of every DOF of the joints that enforce their limits
+    std::vector<JointLimitEntry> mLimits;
+
+    /// Mimic motor constraints
+    std::vector<MimicMotorConstraintPtr> mMimicMotorConstraints;
+
+    /// Joint Coulomb friction constraints
+    std::vector<JointCoulombFrictionConstraintPtr>
+        mJointCoulombFrictionConstraints;
+  };
+
+  /// Joint constraints of each skeleton in mSkeletons
+  std::vector<SkeletonJointConstraints> mSkeletonJointConstraints;
 
   /// Constraints that manually added
   std::vector<ConstraintBasePtr> mManualConstraints;
@@ -313,8 +501,76 @@ protected:
   /// Constraint group list
   std::vector<ConstrainedGroup> mConstrainedGroups;
 
+  /// Parent of each node of the union-find that builds the constrained
+  /// groups. The nodes are the skeletons of mSkeletons followed by
+  /// mUnionSkeletons. Reused across steps.
+  std::vector<std::size_t> mUnionParents;
+
+  /// Number of nodes in the set of each root node of the union-find
+  std::vector<std::size_t> mUnionSizes;
+
+  /// Skeletons that the active constraints refer to but aren't in mSkeletons
+  std::vector<dynamics::SkeletonPtr> mUnionSkeletons;
+
+  /// Constrained group of each root node of the union-find
+  std::vector<std::size_t> mUnionGroups;
+
+  /// Constrained group of each of mActiveConstraints
+  std::vector<std::size_t> mActiveConstraintGroups;
+
+  /// Number of constraints of each constrained group
+  std::vector<std::size_t> mConstrainedGroupSizes;
+
+  /// Reactive skeletons of an active constraint
+  std::vector<dynamics::Skeleton*> mReactiveSkeletons;
+
+  /// Threads to solve constrained groups in parallel. Null when the groups
+  /// are solved serially.
+  std::unique_ptr<common::ThreadPool> mThreadPool;
+
   /// Factory for ContactSurfaceParams for each contact
   ContactSurfaceHandlerPtr mContactSurfaceHandler;
+
+  /// Pool that the contact constraints of this solver are allocated from. It
+  /// belongs to this solver alone, so that solvers stepping in parallel don't
+  /// contend on it, and its memory is released with the last constraint.
+  std::shared_ptr<common::PoolAllocator> mContactConstraintPool;
+
+  /// Impulse of a contact of the previous step
+  struct CachedContactImpulse
+  {
+    /// Colliding shape frames ordered by address
+    std::pair<const dynamics::ShapeFrame*, const dynamics::ShapeFrame*>
+        mFrames;
+
+    /// Contact point in the first frame
+    Eigen::Vector3d mPoint;
+
+    /// Impulse acting on the first frame, expressed in it
+    Eigen::Vector3d mImpulse;
+
+    /// Contact point in the second frame. Restoring the cache in another
+    /// solver may reverse the order of the frames.
+    Eigen::Vector3d mOtherPoint;
+
+    /// Impulse acting on the second frame, expressed in it
+    Eigen::Vector3d mOtherImpulse;
+  };
+
+  /// Whether to warm start the contact constraints
+  bool mContactWarmStarting;
+
+  /// Maximum distance between matching contact points of consecutive steps
+  double mContactWarmStartingDistance;
+
+  /// Contact impulses of the previous step sorted by the colliding objects
+  std::vector<CachedContactImpulse> mContactImpulseCache;
+
+  /// Whether to collect the statistics of solve()
+  bool mStatisticsEnabled;
+
+  /// Statistics of the last call to solve()
+  ConstraintSolverStatistics mStatistics;
 };
 
 } // namespace constraint
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_CONSTRAINT_CONSTRAINTSOLVERSTATISTICS_HPP_
+#define DART_CONSTRAINT_CONSTRAINTSOLVERSTATISTICS_HPP_
+
+#include <cstddef>
+
+namespace dart {
+namespace constraint {
+
+/// Statistics of the last call to ConstraintSolver::solve(). They are only
+/// collected while enabled with ConstraintSolver::setStatisticsEnabled().
+/// Times are wall-clock times in seconds.
+struct ConstraintSolverStatistics
+{
+  /// Time spent on collision detection
+  double mCollisionTime = 0.0;
+
+  /// Time spent on updating the constraints, excluding collision detection
+  double mUpdateConstraintsTime = 0.0;
+
+  /// Time spent on building the constrained groups
+  double mBuildConstrainedGroupsTime = 0.0;
+
+  /// Time spent on solving the constrained groups, including the assembly of
+  /// the LCPs and the application of the constraint impulses
+  double mSolveConstrainedGroupsTime = 0.0;
+
+  /// Number of contacts found by collision detection
+  std::size_t mNumContacts = 0u;
+
+  /// Number of active constraints, including the contact constraints
+  std::size_t mNumActiveConstraints = 0u;
+
+  /// Number of constrained groups
+  std::size_t mNumConstrainedGroups = 0u;
+
+  /// Number of constraints of the largest constrained group
+  std::size_t mMaxConstrainedGroupSize = 0u;
+
+  /// Sum of the LCP dimensions of all the constrained groups
+  std::size_t mTotalLcpDimension = 0u;
+
+  /// LCP dimension of the largest constrained group
+  std::size_t mMaxLcpDimension = 0u;
+
+  /// Number of LCPs solved by the primary LCP solver
+  std::size_t mNumLcpSolves = 0u;
+
+  /// Sum of the iterations reported by the LCP solvers. Solvers that are not
+  /// iterative report no iterations.
+  std::size_t mNumLcpIterations = 0u;
+
+  /// Number of LCPs for which the primary LCP solver failed
+  std::size_t mNumPrimaryLcpFailures = 0u;
+
+  /// Number of LCPs solved by the secondary LCP solver after the primary LCP
+  /// solver failed
+  std::size_t mNumSecondaryLcpSolves = 0u;
+
+  /// Number of LCP solutions that were set to zero because they contained NaN
+  std::size_t mNumInvalidLcpSolutions = 0u;
+};
+
+} // namespace constraint
+} // namespace dart
+
+#endif // DART_CONSTRAINT_CONSTRAINTSOLVERSTATISTICS_HPP_
@@ -39,6 +39,7 @@
 #include "dart/external/odelcpsolver/lcp.h"
 #include "dart/math/Helpers.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #define DART_EPSILON 1e-6
@@ -90,6 +91,7 @@ ContactConstraint::ContactConstraint(
     mSecondarySlipCompliance(DART_DEFAULT_SLIP_COMPLIANCE),
     mIsFrictionOn(true),
     mAppliedImpulseIndex(dynamics::INVALID_INDEX),
+    mOldX(Eigen::Vector3d::Zero()),
     mIsBounceOn(false),
     mActive(false)
 {
@@ -412,11 +414,10 @@ void ContactConstraint::getInformation(ConstraintInfo* info)
     info->b[1] += mContactSurfaceMotionVelocity.y();
     info->b[2] += mContactSurfaceMotionVelocity.z();
 
-    // TODO(JS): Initial guess
-    // x
-    info->x[0] = 0.0;
-    info->x[1] = 0.0;
-    info->x[2] = 0.0;
+    // Initial guess
+    info->x[0] = mOldX[0];
+    info->x[1] = mOldX[1];
+    info->x[2] = mOldX[2];
   }
   //----------------------------------------------------------------------------
   // Frictionless case
@@ -461,9 +462,8 @@ void ContactConstraint::getInformation(ConstraintInfo* info)
     info->b[0] += bouncingVelocity;
     info->b[0] += mContactSurfaceMotionVelocity.x();
 
-    // TODO(JS): Initial guess
-    // x
-    info->x[0] = 0.0;
+    // Initial guess
+    info->x[0] = mOldX[0];
   }
 }
 
@@ -599,7 +599,7 @@ void ContactConstraint::applyImpulse(double* lambda)
       mBodyNodeB->addConstraintImpulse(mSpatialNormalB.col(0) * lambda[0]);
 
     // Add contact impulse (force) toward the tangential w.r.t. world frame
-    const Eigen::MatrixXd D = getTangentBasisMatrixODE(mContact.normal);
+    const TangentBasisMatrix D = getTangentBasisMatrixODE(mContact.normal);
     mContact.force += D.col(0) * lambda[1] / mTimeStep;
 
     // Tangential direction-1 impulsive force
@@ -713,6 +713,19 @@ dynamics::SkeletonPtr ContactConstraint::getRootSkeleton() const
     return ConstraintBase::getRootSkeleton(mBodyNodeB->getSkeleton());
 }
 
+//==============================================================================
+bool ContactConstraint::getReactiveSkeletons(
+    std::vector<dynamics::Skeleton*>& skeletons) const
+{
+  if (mBodyNodeA->isReactive())
+    skeletons.push_back(mBodyNodeA->getSkeleton().get());
+
+  if (mBodyNodeB->isReactive())
+    skeletons.push_back(mBodyNodeB->getSkeleton().get());
+
+  return true;
+}
+
 //==============================================================================
 void ContactConstraint::updateFirstFrictionalDirection()
 {
@@ -840,5 +853,17 @@ const collision::Contact& ContactConstraint::getContact() const
   return mContact;
 }
 
+//==============================================================================
+void ContactConstraint::setInitialImpulse(const Eigen::Vector3d& impulse)
+{
+  mOldX[0] = std::max(mContact.normal.dot(impulse), 0.0);
+
+  if (mIsFrictionOn) {
+    const TangentBasisMatrix D = getTangentBasisMatrixODE(mContact.normal);
+    mOldX[1] = D.col(0).dot(impulse);
+    mOldX[2] = D.col(1).dot(impulse);
+  }
+}
+
 } // namespace constraint
 } // namespace dart
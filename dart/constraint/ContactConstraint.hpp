@@ -143,6 +143,10 @@ protected:
   // Documentation inherited
   dynamics::SkeletonPtr getRootSkeleton() const override;
 
+  // Documentation inherited
+  bool getReactiveSkeletons(
+      std::vector<dynamics::Skeleton*>& skeletons) const override;
+
   // Documentation inherited
   void uniteSkeletons() override;
 
@@ -205,6 +209,12 @@ private:
   /// Get contact object associated witht this constraint
   const collision::Contact& getContact() const;
 
+  /// Sets the initial guess of the constraint impulse for the LCP solver
+  ///
+  /// \param[in] impulse Impulse acting on the first body, expressed in the
+  /// world frame.
+  void setInitialImpulse(const Eigen::Vector3d& impulse);
+
 private:
   /// Time step
   double mTimeStep;
@@ -245,11 +255,22 @@ private:
   /// Whether this contact is self-collision.
   bool mIsSelfCollision;
 
+  /// Local body jacobians with one column per constraint dimension. They have
+  /// at most three columns, so they are stored inline, and they are unaligned
+  /// so that the constraint can be allocated from a pool allocator.
+  using SpatialNormalMatrix = Eigen::Matrix<
+      double,
+      6,
+      Eigen::Dynamic,
+      Eigen::ColMajor | Eigen::DontAlign,
+      6,
+      3>;
+
   /// Local body jacobians for mBodyNode1
-  Eigen::Matrix<double, 6, Eigen::Dynamic> mSpatialNormalA;
+  SpatialNormalMatrix mSpatialNormalA;
 
   /// Local body jacobians for mBodyNode2
-  Eigen::Matrix<double, 6, Eigen::Dynamic> mSpatialNormalB;
+  SpatialNormalMatrix mSpatialNormalB;
 
   ///
   bool mIsFrictionOn;
@@ -257,6 +278,10 @@ private:
   /// Index of applied impulse
   std::size_t mAppliedImpulseIndex;
 
+  /// Initial guess of the constraint impulse in the normal and the two
+  /// frictional directions
+  Eigen::Vector3d mOldX;
+
   ///
   bool mIsBounceOn;
 
@@ -37,11 +37,76 @@
 #include "dart/constraint/ContactConstraint.hpp"
 #include "dart/constraint/ContactSurface.hpp"
 
+#include <new>
 #include <utility>
 
 namespace dart {
 namespace constraint {
 
+namespace {
+
+/// Pool of the ConstraintSolver that is creating contact constraints on this
+/// thread
+thread_local const std::shared_ptr<common::PoolAllocator>* gConstraintPool
+    = nullptr;
+
+/// Allocator of std::allocate_shared that keeps the pool alive, since a
+/// constraint may outlive the solver that created it
+template <typename T>
+class SharedPoolAllocator
+{
+public:
+  using value_type = T;
+
+  explicit SharedPoolAllocator(
+      std::shared_ptr<common::PoolAllocator> pool) noexcept
+    : mPool(std::move(pool))
+  {
+    // Do nothing
+  }
+
+  template <typename U>
+  SharedPoolAllocator(const SharedPoolAllocator<U>& other) noexcept
+    : mPool(other.mPool)
+  {
+    // Do nothing
+  }
+
+  T* allocate(std::size_t n)
+  {
+    void* pointer = mPool->allocate(n * sizeof(T));
+    if (!pointer)
+      throw std::bad_alloc();
+
+    return static_cast<T*>(pointer);
+  }
+
+  void deallocate(T* pointer, std::size_t n) noexcept
+  {
+    mPool->deallocate(pointer, n * sizeof(T));
+  }
+
+  template <typename U>
+  bool operator==(const SharedPoolAllocator<U>& other) const noexcept
+  {
+    return mPool == other.mPool;
+  }
+
+  template <typename U>
+  bool operator!=(const SharedPoolAllocator<U>& other) const noexcept
+  {
+    return mPool != other.mPool;
+  }
+
+private:
+  template <typename U>
+  friend class SharedPoolAllocator;
+
+  std::shared_ptr<common::PoolAllocator> mPool;
+};
+
+} // anonymous namespace
+
 //==============================================================================
 ContactSurfaceHandler::ContactSurfaceHandler(ContactSurfaceHandlerPtr parent)
   : mParent(std::move(parent))
@@ -49,6 +114,24 @@ ContactSurfaceHandler::ContactSurfaceHandler(ContactSurfaceHandlerPtr parent)
   // Do nothing
 }
 
+//==============================================================================
+void ContactSurfaceHandler::setMaxNumContactsPerPair(std::size_t maxNumContacts)
+{
+  mMaxNumContactsPerPair = maxNumContacts;
+}
+
+//==============================================================================
+std::size_t ContactSurfaceHandler::getMaxNumContactsPerPair(
+    const collision::CollisionObject* object1,
+    const collision::CollisionObject* object2) const
+{
+  if (mMaxNumContactsPerPair)
+    return *mMaxNumContactsPerPair;
+  if (mParent != nullptr)
+    return mParent->getMaxNumContactsPerPair(object1, object2);
+  return 0u;
+}
+
 //==============================================================================
 ContactSurfaceHandlerPtr ContactSurfaceHandler::getParent()
 {
@@ -81,7 +164,28 @@ ContactConstraintPtr ContactSurfaceHandler::createConstraint(
     const double timeStep) const
 {
   auto params = createParams(contact, numContactsOnCollisionObject);
-  return std::make_shared<ContactConstraint>(contact, timeStep, params);
+
+  if (!gConstraintPool)
+    return std::make_shared<ContactConstraint>(contact, timeStep, params);
+
+  // Contact constraints are recreated in every time step, so they are taken
+  // from the pool of the solver, which keeps the released memory for reuse
+  static_assert(
+      alignof(ContactConstraint) <= 8u,
+      "PoolAllocator only guarantees 8-byte alignment.");
+  return std::allocate_shared<ContactConstraint>(
+      SharedPoolAllocator<ContactConstraint>(*gConstraintPool),
+      contact,
+      timeStep,
+      params);
+}
+
+//==============================================================================
+const std::shared_ptr<common::PoolAllocator>*
+ContactSurfaceHandler::setConstraintPool(
+    const std::shared_ptr<common::PoolAllocator>* pool)
+{
+  return std::exchange(gConstraintPool, pool);
 }
 
 //==============================================================================
@@ -37,10 +37,15 @@
 
 #include <dart/collision/Contact.hpp>
 
+#include <dart/common/PoolAllocator.hpp>
+
 #include <dart/dynamics/ShapeNode.hpp>
 
 #include <Eigen/Core>
 
+#include <memory>
+#include <optional>
+
 #define DART_RESTITUTION_COEFF_THRESHOLD 1e-3
 #define DART_FRICTION_COEFF_THRESHOLD 1e-3
 #define DART_BOUNCING_VELOCITY_THRESHOLD 1e-1
@@ -128,12 +133,30 @@ public:
       size_t numContactsOnCollisionObject) const;
 
   /// Create the constraint that represents contact between two collision
-  /// objects.
+  /// objects. While a ConstraintSolver creates its contact constraints, this
+  /// allocates them from the pool of that solver.
   virtual ContactConstraintPtr createConstraint(
       collision::Contact& contact,
       size_t numContactsOnCollisionObject,
       double timeStep) const;
 
+  /// Set the maximum number of contacts that are kept between a pair of
+  /// collision objects. The contacts of a pair with more contacts are reduced
+  /// to the deepest contact and the contacts that span the largest area, so
+  /// that e.g. a box resting on a mesh is supported by its corners rather
+  /// than by dozens of nearly coplanar contacts. Four contacts are enough to
+  /// support a face; zero keeps all the contacts, which is the default.
+  void setMaxNumContactsPerPair(std::size_t maxNumContacts);
+
+  /// Return the maximum number of contacts that are kept between the two
+  /// collision objects, or zero to keep all of them. Unless
+  /// setMaxNumContactsPerPair() was called on this handler, the value of the
+  /// parent handler is returned. Override this to tune the reduction per
+  /// pair of collision objects.
+  virtual std::size_t getMaxNumContactsPerPair(
+      const collision::CollisionObject* object1,
+      const collision::CollisionObject* object2) const;
+
   /// Get the optional parent handler (nullptr if none is set)
   ContactSurfaceHandlerPtr getParent();
 
@@ -145,6 +168,18 @@ public:
 protected:
   /// The optional parent handler
   ContactSurfaceHandlerPtr mParent;
+
+  /// Maximum number of contacts per pair of collision objects, if set on
+  /// this handler
+  std::optional<std::size_t> mMaxNumContactsPerPair;
+
+private:
+  /// Set the pool that createConstraint() allocates from on the calling
+  /// thread, or nullptr to allocate from the heap, and return the previous
+  /// pool. Handlers are shared between the clones of a ConstraintSolver, so
+  /// each solver sets its own pool while it creates contact constraints.
+  static const std::shared_ptr<common::PoolAllocator>* setConstraintPool(
+      const std::shared_ptr<common::PoolAllocator>* pool);
 };
 
 /// Default contact surface handler. It chooses friction direction of the body
@@ -64,8 +64,28 @@ bool DantzigBoxedLcpSolver::solve(
     bool earlyTermination)
 {
   DART_PROFILE_SCOPED;
+
+  const std::size_t size = external::ode::dEstimateSolveLCPMemoryReq(n, false);
+  mWorkspace.resize((size + sizeof(double) - 1) / sizeof(double));
+
   return external::ode::dSolveLCP(
-      n, A, x, b, nullptr, 0, lo, hi, findex, earlyTermination);
+      n,
+      A,
+      x,
+      b,
+      nullptr,
+      0,
+      lo,
+      hi,
+      findex,
+      earlyTermination,
+      mWorkspace.data());
+}
+
+//==============================================================================
+std::shared_ptr<BoxedLcpSolver> DantzigBoxedLcpSolver::clone() const
+{
+  return std::make_shared<DantzigBoxedLcpSolver>();
 }
 
 #if DART_BUILD_MODE_DEBUG
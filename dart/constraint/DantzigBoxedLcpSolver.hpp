@@ -35,6 +35,8 @@
 
 #include <dart/constraint/BoxedLcpSolver.hpp>
 
+#include <vector>
+
 namespace dart {
 namespace constraint {
 
@@ -59,10 +61,19 @@ public:
       int* findex,
       bool earlyTermination) override;
 
+  // Documentation inherited.
+  std::shared_ptr<BoxedLcpSolver> clone() const override;
+
 #if DART_BUILD_MODE_DEBUG
   // Documentation inherited.
   bool canSolve(int n, const double* A) override;
 #endif
+
+protected:
+  /// Scratch memory of the Dantzig solver, kept between solves so that
+  /// solving problems that are not larger than the previous ones does not
+  /// allocate
+  std::vector<double> mWorkspace;
 };
 
 } // namespace constraint
@@ -33,6 +33,8 @@
 #include "dart/constraint/DynamicJointConstraint.hpp"
 
 #include "dart/common/Console.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/Skeleton.hpp"
 
 #include <cassert>
 
@@ -167,5 +169,18 @@ dynamics::BodyNode* DynamicJointConstraint::getBodyNode2() const
   return mBodyNode2;
 }
 
+//==============================================================================
+bool DynamicJointConstraint::getReactiveSkeletons(
+    std::vector<dynamics::Skeleton*>& skeletons) const
+{
+  if (mBodyNode1->isReactive())
+    skeletons.push_back(mBodyNode1->getSkeleton().get());
+
+  if (mBodyNode2 && mBodyNode2->isReactive())
+    skeletons.push_back(mBodyNode2->getSkeleton().get());
+
+  return true;
+}
+
 } // namespace constraint
 } // namespace dart
@@ -91,6 +91,10 @@ public:
   /// Get the second BodyNode that this constraint is associated with
   dynamics::BodyNode* getBodyNode2() const;
 
+  // Documentation inherited
+  bool getReactiveSkeletons(
+      std::vector<dynamics::Skeleton*>& skeletons) const override;
+
 protected:
   /// First body node
   dynamics::BodyNode* mBodyNode1;
@@ -500,11 +500,26 @@ dynamics::SkeletonPtr JointConstraint::getRootSkeleton() const
   return ConstraintBase::getRootSkeleton(mJoint->getSkeleton()->getSkeleton());
 }
 
+//==============================================================================
+bool JointConstraint::getReactiveSkeletons(
+    std::vector<dynamics::Skeleton*>& skeletons) const
+{
+  skeletons.push_back(mJoint->getSkeleton().get());
+
+  return true;
+}
+
 //==============================================================================
 bool JointConstraint::isActive() const
 {
   return mActive.array().any();
 }
 
+//==============================================================================
+void JointConstraint::deactivate()
+{
+  mActive.setConstant(false);
+}
+
 } // namespace constraint
 } // namespace dart
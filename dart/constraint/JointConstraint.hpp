@@ -129,9 +129,18 @@ protected:
   // Documentation inherited
   dynamics::SkeletonPtr getRootSkeleton() const override;
 
+  // Documentation inherited
+  bool getReactiveSkeletons(
+      std::vector<dynamics::Skeleton*>& skeletons) const override;
+
   // Documentation inherited
   bool isActive() const override;
 
+  /// Marks every DOF inactive so that the next update() starts over as it
+  /// would on a newly created constraint. ConstraintSolver keeps the joint
+  /// constraints across steps and calls this before updating them.
+  void deactivate();
+
 private:
   /// The Joint that this constraint is associated with.
   dynamics::Joint* mJoint;
@@ -265,6 +265,15 @@ dynamics::SkeletonPtr JointCoulombFrictionConstraint::getRootSkeleton() const
   return ConstraintBase::getRootSkeleton(mJoint->getSkeleton()->getSkeleton());
 }
 
+//==============================================================================
+bool JointCoulombFrictionConstraint::getReactiveSkeletons(
+    std::vector<dynamics::Skeleton*>& skeletons) const
+{
+  skeletons.push_back(mJoint->getSkeleton().get());
+
+  return true;
+}
+
 //==============================================================================
 bool JointCoulombFrictionConstraint::isActive() const
 {
@@ -276,5 +285,12 @@ bool JointCoulombFrictionConstraint::isActive() const
   return false;
 }
 
+//==============================================================================
+void JointCoulombFrictionConstraint::deactivate()
+{
+  for (std::size_t i = 0; i < 6; ++i)
+    mActive[i] = false;
+}
+
 } // namespace constraint
 } // namespace dart
@@ -425,6 +425,15 @@ dynamics::SkeletonPtr JointLimitConstraint::getRootSkeleton() const
   return ConstraintBase::getRootSkeleton(mJoint->getSkeleton()->getSkeleton());
 }
 
+//==============================================================================
+bool JointLimitConstraint::getReactiveSkeletons(
+    std::vector<dynamics::Skeleton*>& skeletons) const
+{
+  skeletons.push_back(mJoint->getSkeleton().get());
+
+  return true;
+}
+
 //==============================================================================
 bool JointLimitConstraint::isActive() const
 {
@@ -126,6 +126,10 @@ protected:
   // Documentation inherited
   dynamics::SkeletonPtr getRootSkeleton() const override;
 
+  // Documentation inherited
+  bool getReactiveSkeletons(
+      std::vector<dynamics::Skeleton*>& skeletons) const override;
+
   // Documentation inherited
   bool isActive() const override;
 
@@ -276,6 +276,15 @@ dynamics::SkeletonPtr MimicMotorConstraint::getRootSkeleton() const
   return ConstraintBase::getRootSkeleton(mJoint->getSkeleton()->getSkeleton());
 }
 
+//==============================================================================
+bool MimicMotorConstraint::getReactiveSkeletons(
+    std::vector<dynamics::Skeleton*>& skeletons) const
+{
+  skeletons.push_back(mJoint->getSkeleton().get());
+
+  return true;
+}
+
 //==============================================================================
 bool MimicMotorConstraint::isActive() const
 {
@@ -287,5 +296,12 @@ bool MimicMotorConstraint::isActive() const
   return false;
 }
 
+//==============================================================================
+void MimicMotorConstraint::deactivate()
+{
+  for (std::size_t i = 0; i < 6; ++i)
+    mActive[i] = false;
+}
+
 } // namespace constraint
 } // namespace dart
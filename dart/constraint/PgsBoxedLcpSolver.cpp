@@ -38,6 +38,8 @@
 
 #include <Eigen/Dense>
 
+#include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <cstring>
 
@@ -46,6 +48,37 @@
 namespace dart {
 namespace constraint {
 
+//==============================================================================
+/// Clamps the new value of x[index] to its bounds. Friction variables are
+/// bounded by their coefficient times the impulse of the normal variable.
+static double projectToBounds(
+    double new_x,
+    int index,
+    const double* x,
+    const double* lo,
+    const double* hi,
+    const int* findex)
+{
+  if (findex[index] >= 0) {
+    const double hi_tmp = hi[index] * x[findex[index]];
+    const double lo_tmp = -hi_tmp;
+
+    if (new_x > hi_tmp)
+      return hi_tmp;
+    else if (new_x < lo_tmp)
+      return lo_tmp;
+    else
+      return new_x;
+  }
+
+  if (new_x > hi[index])
+    return hi[index];
+  else if (new_x < lo[index])
+    return lo[index];
+  else
+    return new_x;
+}
+
 //==============================================================================
 PgsBoxedLcpSolver::Option::Option(
     int maxIteration,
@@ -98,6 +131,7 @@ bool PgsBoxedLcpSolver::solve(
     external::ode::dFactorLDLT(A, mCacheD.data(), n, nskip);
     external::ode::dSolveLDLT(A, mCacheD.data(), b, n, nskip);
     std::memcpy(x, b, n * sizeof(double));
+    mLastNumIterations = 0u;
 
     return true;
   }
@@ -105,6 +139,8 @@ bool PgsBoxedLcpSolver::solve(
   mCacheOrder.clear();
   mCacheOrder.reserve(n);
 
+  // The initial sweep counts as the first iteration
+  mLastNumIterations = 1u;
   bool possibleToTerminate = true;
   for (int i = 0; i < n; ++i) {
     // mOrderCacheing
@@ -181,6 +217,7 @@ bool PgsBoxedLcpSolver::solve(
     }
 
     possibleToTerminate = true;
+    ++mLastNumIterations;
 
     // Single loop
     for (const auto& index : mCacheOrder) {
@@ -228,6 +265,161 @@ bool PgsBoxedLcpSolver::solve(
   return possibleToTerminate;
 }
 
+//==============================================================================
+bool PgsBoxedLcpSolver::canSolveSparse() const
+{
+  return true;
+}
+
+//==============================================================================
+bool PgsBoxedLcpSolver::solveSparse(
+    int n,
+    SparseMatrix& A,
+    double* x,
+    double* b,
+    int nub,
+    double* lo,
+    double* hi,
+    int* findex,
+    bool earlyTermination)
+{
+  // The unbounded case is solved by factorization, which needs dense storage.
+  if (nub >= n) {
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        denseA = Eigen::MatrixXd::Zero(n, dPAD(n));
+    denseA.leftCols(n) = A;
+    return solve(n, denseA.data(), x, b, nub, lo, hi, findex, earlyTermination);
+  }
+
+  assert(A.isCompressed());
+  const int* outer = A.outerIndexPtr();
+  const int* inner = A.innerIndexPtr();
+  double* values = A.valuePtr();
+
+  // Locate the diagonal entries. A row without one is treated like a zero
+  // diagonal.
+  mCacheDiagonal.resize(n);
+  for (int i = 0; i < n; ++i) {
+    const int* begin = inner + outer[i];
+    const int* end = inner + outer[i + 1];
+    const int* diag = std::lower_bound(begin, end, i);
+    mCacheDiagonal[i] = (diag != end && *diag == i) ? diag - inner : -1;
+  }
+
+  // Same iterations as solve(), but each row only visits its nonzero entries.
+  // The entries are summed in the same order as the dense version, so both
+  // return identical results for the same matrix.
+  mCacheOrder.clear();
+  mCacheOrder.reserve(n);
+
+  // The initial sweep counts as the first iteration
+  mLastNumIterations = 1u;
+  bool possibleToTerminate = true;
+  for (int i = 0; i < n; ++i) {
+    const double diag
+        = (mCacheDiagonal[i] < 0) ? 0.0 : values[mCacheDiagonal[i]];
+    if (diag < mOption.mEpsilonForDivision) {
+      x[i] = 0.0;
+      continue;
+    }
+
+    mCacheOrder.push_back(i);
+
+    const double old_x = x[i];
+
+    double new_x = b[i];
+
+    for (int k = outer[i]; k < outer[i + 1]; ++k) {
+      if (inner[k] != i)
+        new_x -= values[k] * x[inner[k]];
+    }
+
+    new_x /= diag;
+
+    x[i] = projectToBounds(new_x, i, x, lo, hi, findex);
+
+    // Test
+    if (possibleToTerminate) {
+      const double deltaX = std::abs(x[i] - old_x);
+      if (deltaX > mOption.mDeltaXThreshold)
+        possibleToTerminate = false;
+    }
+  }
+
+  if (possibleToTerminate) {
+    return true;
+  }
+
+  // Normalizing
+  for (const auto& index : mCacheOrder) {
+    const double dummy = 1.0 / values[mCacheDiagonal[index]];
+    b[index] *= dummy;
+    for (int k = outer[index]; k < outer[index + 1]; ++k)
+      values[k] *= dummy;
+  }
+
+  for (int iter = 1; iter < mOption.mMaxIteration; ++iter) {
+    if (mOption.mRandomizeConstraintOrder) {
+      if ((iter & 7) == 0) {
+        for (std::size_t i = 1; i < mCacheOrder.size(); ++i) {
+          const int tmp = mCacheOrder[i];
+          const int swapi = external::ode::dRandInt(i + 1);
+          mCacheOrder[i] = mCacheOrder[swapi];
+          mCacheOrder[swapi] = tmp;
+        }
+      }
+    }
+
+    possibleToTerminate = true;
+    ++mLastNumIterations;
+
+    // Single loop
+    for (const auto& index : mCacheOrder) {
+      double new_x = b[index];
+      const double old_x = x[index];
+
+      for (int k = outer[index]; k < outer[index + 1]; ++k) {
+        if (inner[k] != index)
+          new_x -= values[k] * x[inner[k]];
+      }
+
+      x[index] = projectToBounds(new_x, index, x, lo, hi, findex);
+
+      if (possibleToTerminate
+          && std::abs(x[index]) > mOption.mEpsilonForDivision) {
+        const double relativeDeltaX = std::abs((x[index] - old_x) / x[index]);
+        if (relativeDeltaX > mOption.mRelativeDeltaXTolerance)
+          possibleToTerminate = false;
+      }
+    }
+
+    if (possibleToTerminate)
+      break;
+  }
+
+  return possibleToTerminate;
+}
+
+//==============================================================================
+std::size_t PgsBoxedLcpSolver::getLastNumIterations() const
+{
+  return mLastNumIterations;
+}
+
+//==============================================================================
+std::shared_ptr<BoxedLcpSolver> PgsBoxedLcpSolver::clone() const
+{
+  // The randomized constraint order is drawn from a process-wide random
+  // number generator, so clones running on other threads would change the
+  // sequence of the serial solver.
+  if (mOption.mRandomizeConstraintOrder)
+    return nullptr;
+
+  auto solver = std::make_shared<PgsBoxedLcpSolver>();
+  solver->setOption(mOption);
+  return solver;
+}
+
 #if DART_BUILD_MODE_DEBUG
 //==============================================================================
 bool PgsBoxedLcpSolver::canSolve(int n, const double* A)
@@ -249,10 +441,17 @@ bool PgsBoxedLcpSolver::canSolve(int n, const double* A)
 }
 #endif
 
+//==============================================================================
+std::size_t PgsBoxedLcpSolver::getSettingsVersion() const
+{
+  return mOptionVersion;
+}
+
 //==============================================================================
 void PgsBoxedLcpSolver::setOption(const PgsBoxedLcpSolver::Option& option)
 {
   mOption = option;
+  ++mOptionVersion;
 }
 
 //==============================================================================
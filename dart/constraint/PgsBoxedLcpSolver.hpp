@@ -78,11 +78,35 @@ public:
       int* findex,
       bool earlyTermination) override;
 
+  // Documentation inherited.
+  bool canSolveSparse() const override;
+
+  // Documentation inherited.
+  bool solveSparse(
+      int n,
+      SparseMatrix& A,
+      double* x,
+      double* b,
+      int nub,
+      double* lo,
+      double* hi,
+      int* findex,
+      bool earlyTermination) override;
+
+  // Documentation inherited.
+  std::size_t getLastNumIterations() const override;
+
+  // Documentation inherited.
+  std::shared_ptr<BoxedLcpSolver> clone() const override;
+
 #if DART_BUILD_MODE_DEBUG
   // Documentation inherited.
   bool canSolve(int n, const double* A) override;
 #endif
 
+  // Documentation inherited.
+  std::size_t getSettingsVersion() const override;
+
   /// Sets options
   void setOption(const Option& option);
 
@@ -92,8 +116,15 @@ public:
 protected:
   Option mOption;
 
+  /// Number of calls to setOption()
+  std::size_t mOptionVersion = 0u;
+
+  /// Number of Gauss-Seidel sweeps of the last solve
+  std::size_t mLastNumIterations = 0u;
+
   mutable std::vector<int> mCacheOrder;
   mutable std::vector<double> mCacheD;
+  mutable std::vector<int> mCacheDiagonal;
   mutable Eigen::VectorXd mCachedNormalizedA;
   mutable Eigen::MatrixXd mCachedNormalizedB;
   mutable Eigen::VectorXd mCacheZ;
@@ -266,6 +266,15 @@ dynamics::SkeletonPtr ServoMotorConstraint::getRootSkeleton() const
   return ConstraintBase::getRootSkeleton(mJoint->getSkeleton()->getSkeleton());
 }
 
+//==============================================================================
+bool ServoMotorConstraint::getReactiveSkeletons(
+    std::vector<dynamics::Skeleton*>& skeletons) const
+{
+  skeletons.push_back(mJoint->getSkeleton().get());
+
+  return true;
+}
+
 //==============================================================================
 bool ServoMotorConstraint::isActive() const
 {
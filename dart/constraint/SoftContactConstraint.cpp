@@ -892,6 +892,19 @@ dynamics::SkeletonPtr SoftContactConstraint::getRootSkeleton() const
         mBodyNode2->getSkeleton()->getSkeleton());
 }
 
+//==============================================================================
+bool SoftContactConstraint::getReactiveSkeletons(
+    std::vector<dynamics::Skeleton*>& skeletons) const
+{
+  if (mBodyNode1->isReactive())
+    skeletons.push_back(mBodyNode1->getSkeleton().get());
+
+  if (mBodyNode2->isReactive())
+    skeletons.push_back(mBodyNode2->getSkeleton().get());
+
+  return true;
+}
+
 //==============================================================================
 void SoftContactConstraint::uniteSkeletons()
 {
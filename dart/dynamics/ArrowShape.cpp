@@ -103,8 +103,9 @@ void ArrowShape::setProperties(const Properties& _properties)
 //==============================================================================
 void ArrowShape::notifyColorUpdated(const Eigen::Vector4d& _color)
 {
-  for (std::size_t i = 0; i < mMesh->mNumMeshes; ++i) {
-    aiMesh* mesh = mMesh->mMeshes[i];
+  aiScene* scene = getMutableMesh();
+  for (std::size_t i = 0; i < scene->mNumMeshes; ++i) {
+    aiMesh* mesh = scene->mMeshes[i];
     for (std::size_t j = 0; j < mesh->mNumVertices; ++j) {
       mesh->mColors[0][j]
           = aiColor4D(_color[0], _color[1], _color[2], _color[3]);
@@ -198,24 +199,26 @@ void ArrowShape::configureArrow(
   double headLength = mProperties.mHeadLengthScale * length;
   headLength = std::min(maxHeadLength, std::max(minHeadLength, headLength));
 
+  aiScene* scene = getMutableMesh();
+
   // construct the tail
   if (mProperties.mDoubleArrow) {
-    constructArrowTip(mMesh->mMeshes[0], headLength, 0, mProperties);
+    constructArrowTip(scene->mMeshes[0], headLength, 0, mProperties);
   } else {
-    constructArrowTip(mMesh->mMeshes[0], 0, 0, mProperties);
+    constructArrowTip(scene->mMeshes[0], 0, 0, mProperties);
   }
 
   // construct the main body
   if (mProperties.mDoubleArrow) {
     constructArrowBody(
-        mMesh->mMeshes[1], headLength, length - headLength, mProperties);
+        scene->mMeshes[1], headLength, length - headLength, mProperties);
   } else {
-    constructArrowBody(mMesh->mMeshes[1], 0, length - headLength, mProperties);
+    constructArrowBody(scene->mMeshes[1], 0, length - headLength, mProperties);
   }
 
   // construct the head
   constructArrowTip(
-      mMesh->mMeshes[2], length - headLength, length, mProperties);
+      scene->mMeshes[2], length - headLength, length, mProperties);
 
   Eigen::Isometry3d tf(Eigen::Isometry3d::Identity());
   tf.translation() = mTail;
@@ -233,7 +236,7 @@ void ArrowShape::configureArrow(
     tf.rotate(Eigen::AngleAxisd(acos(z.dot(v)), axis));
   }
 
-  aiNode* node = mMesh->mRootNode;
+  aiNode* node = scene->mRootNode;
   for (std::size_t i = 0; i < 4; ++i)
     for (std::size_t j = 0; j < 4; ++j)
       node->mTransformation[i][j] = tf(i, j);
@@ -247,14 +250,14 @@ void ArrowShape::configureArrow(
 //==============================================================================
 ShapePtr ArrowShape::clone() const
 {
-  aiScene* new_scene = cloneMesh();
   auto new_shape = std::make_shared<ArrowShape>();
 
   new_shape->mTail = mTail;
   new_shape->mHead = mHead;
   new_shape->mProperties = mProperties;
 
-  new_shape->mMesh = new_scene;
+  new_shape->mSharedMesh = mSharedMesh;
+  new_shape->mMesh = mMesh;
   new_shape->mMeshUri = mMeshUri;
   new_shape->mMeshPath = mMeshPath;
   new_shape->mResourceRetriever = mResourceRetriever;
@@ -392,7 +395,7 @@ void ArrowShape::instantiate(std::size_t resolution)
     face->mIndices[2] = 2 * resolution;
   }
 
-  mMesh = scene;
+  setMesh(scene);
 
   // setColor(mColor);
   // TODO(JS)
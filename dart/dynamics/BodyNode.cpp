@@ -2374,12 +2374,16 @@ void BodyNode::updateBodyJacobian() const
         == static_cast<std::size_t>(mBodyJacobian.cols()));
 
     assert(mParentJoint);
-    mBodyJacobian.leftCols(ascendantDof) = math::AdInvTJac(
-        mParentJoint->getRelativeTransform(), mParentBodyNode->getJacobian());
+    // Transform the columns in place rather than with math::AdInvTJac() to
+    // avoid allocating a temporary Jacobian
+    const math::Jacobian& J_parent = mParentBodyNode->getJacobian();
+    const Eigen::Isometry3d& T = mParentJoint->getRelativeTransform();
+    for (std::size_t i = 0; i < ascendantDof; ++i)
+      mBodyJacobian.col(i) = math::AdInvT(T, J_parent.col(i));
   }
 
   // Local Jacobian
-  mBodyJacobian.rightCols(localDof) = mParentJoint->getRelativeJacobian();
+  mParentJoint->setRelativeJacobianTo(mBodyJacobian.rightCols(localDof));
 
   mIsBodyJacobianDirty = false;
 }
@@ -2387,7 +2391,11 @@ void BodyNode::updateBodyJacobian() const
 //==============================================================================
 void BodyNode::updateWorldJacobian() const
 {
-  mWorldJacobian = math::AdRJac(getWorldTransform(), getJacobian());
+  const Eigen::Matrix3d& R = getWorldTransform().linear();
+  const math::Jacobian& J = getJacobian();
+
+  mWorldJacobian.topRows<3>().noalias() = R * J.topRows<3>();
+  mWorldJacobian.bottomRows<3>().noalias() = R * J.bottomRows<3>();
 
   mIsWorldJacobianDirty = false;
 }
@@ -2425,14 +2433,25 @@ void BodyNode::updateBodyJacobianSpatialDeriv() const
         static_cast<std::size_t>(dJ_parent.cols()) + mParentJoint->getNumDofs()
         == static_cast<std::size_t>(mBodyJacobianSpatialDeriv.cols()));
 
-    mBodyJacobianSpatialDeriv.leftCols(numParentDOFs)
-        = math::AdInvTJac(mParentJoint->getRelativeTransform(), dJ_parent);
+    const Eigen::Isometry3d& T = mParentJoint->getRelativeTransform();
+    for (std::size_t i = 0; i < numParentDOFs; ++i)
+      mBodyJacobianSpatialDeriv.col(i) = math::AdInvT(T, dJ_parent.col(i));
   }
 
   // Local Jacobian: ad(V(i), S(i)) + dS(i)
-  mBodyJacobianSpatialDeriv.rightCols(numLocalDOFs)
-      = math::adJac(getSpatialVelocity(), mParentJoint->getRelativeJacobian())
-        + mParentJoint->getRelativeJacobianTimeDeriv();
+  //
+  // S(i) is the local part of the body Jacobian. dS(i) is written first, and
+  // ad(V(i), S(i)) is added column by column, so nothing is allocated.
+  const auto S = getJacobian().rightCols(numLocalDOFs);
+  const Eigen::Vector6d& V = getSpatialVelocity();
+  auto dJ_local = mBodyJacobianSpatialDeriv.rightCols(numLocalDOFs);
+  mParentJoint->setRelativeJacobianTimeDerivTo(dJ_local);
+  for (std::size_t i = 0; i < numLocalDOFs; ++i) {
+    const auto S_i = S.col(i);
+    dJ_local.col(i).head<3>() += -S_i.head<3>().cross(V.head<3>());
+    dJ_local.col(i).tail<3>() += -S_i.tail<3>().cross(V.head<3>())
+                                 - S_i.head<3>().cross(V.tail<3>());
+  }
 
   mIsBodyJacobianSpatialDerivDirty = false;
 }
@@ -2486,24 +2505,34 @@ void BodyNode::updateWorldJacobianClassicDeriv() const
     // dJr
     mWorldJacobianClassicDeriv.block(0, 0, 3, numParentDOFs)
         = dJ_parent.topRows<3>();
-    mWorldJacobianClassicDeriv.block(3, 0, 3, numParentDOFs)
-        = dJ_parent.bottomRows<3>()
-          + J_parent.topRows<3>().colwise().cross(v_local + w_parent.cross(p))
-          + dJ_parent.topRows<3>().colwise().cross(p);
+
+    // The columns are computed one by one because colwise().cross() would
+    // allocate a temporary
+    const Eigen::Vector3d v = v_local + w_parent.cross(p);
+    for (std::size_t i = 0; i < numParentDOFs; ++i) {
+      mWorldJacobianClassicDeriv.col(i).tail<3>()
+          = dJ_parent.col(i).tail<3>() + J_parent.col(i).head<3>().cross(v)
+            + dJ_parent.col(i).head<3>().cross(p);
+    }
   }
 
-  const math::Jacobian& dJ_local = mParentJoint->getRelativeJacobianTimeDeriv();
-  const math::Jacobian& J_local = mParentJoint->getRelativeJacobian();
-  const Eigen::Isometry3d& T = getWorldTransform();
+  // The relative Jacobian is the local part of the body Jacobian, and its time
+  // derivative is written into the output before being rotated in place.
+  const auto J_local = getJacobian().rightCols(numLocalDOFs);
+  auto dJ = mWorldJacobianClassicDeriv.rightCols(numLocalDOFs);
+  mParentJoint->setRelativeJacobianTimeDerivTo(dJ);
+
+  const Eigen::Matrix3d& R = getWorldTransform().linear();
   const Eigen::Vector3d& w = getAngularVelocity();
 
-  mWorldJacobianClassicDeriv.block(0, numParentDOFs, 3, numLocalDOFs)
-      = T.linear() * dJ_local.topRows<3>()
-        - (T.linear() * J_local.topRows<3>()).colwise().cross(w);
+  for (std::size_t i = 0; i < numLocalDOFs; ++i) {
+    const Eigen::Vector3d dJ_top = dJ.col(i).head<3>();
+    const Eigen::Vector3d dJ_bottom = dJ.col(i).tail<3>();
 
-  mWorldJacobianClassicDeriv.block(3, numParentDOFs, 3, numLocalDOFs)
-      = T.linear() * dJ_local.bottomRows<3>()
-        - (T.linear() * J_local.bottomRows<3>()).colwise().cross(w);
+    dJ.col(i).head<3>() = R * dJ_top - (R * J_local.col(i).head<3>()).cross(w);
+    dJ.col(i).tail<3>()
+        = R * dJ_bottom - (R * J_local.col(i).tail<3>()).cross(w);
+  }
 
   mIsWorldJacobianClassicDerivDirty = false;
 }
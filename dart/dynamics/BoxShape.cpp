@@ -64,6 +64,12 @@ const std::string& BoxShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId BoxShape::getTypeId() const
+{
+  return TypeId::Box;
+}
+
 //==============================================================================
 double BoxShape::computeVolume(const Eigen::Vector3d& size)
 {
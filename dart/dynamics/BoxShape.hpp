@@ -53,6 +53,9 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
   /// \brief Set size of this box.
   void setSize(const Eigen::Vector3d& _size);
 
@@ -62,6 +62,12 @@ const std::string& CapsuleShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId CapsuleShape::getTypeId() const
+{
+  return TypeId::Capsule;
+}
+
 //==============================================================================
 double CapsuleShape::getRadius() const
 {
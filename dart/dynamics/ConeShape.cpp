@@ -62,6 +62,12 @@ const std::string& ConeShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId ConeShape::getTypeId() const
+{
+  return TypeId::Cone;
+}
+
 //==============================================================================
 double ConeShape::getRadius() const
 {
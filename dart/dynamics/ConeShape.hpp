@@ -54,6 +54,9 @@ public:
   /// Get shape type string for this shape.
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
   /// Get the radius of the circular base.
   double getRadius() const;
 
@@ -60,6 +60,12 @@ const std::string& CylinderShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId CylinderShape::getTypeId() const
+{
+  return TypeId::Cylinder;
+}
+
 //==============================================================================
 double CylinderShape::getRadius() const
 {
@@ -50,6 +50,9 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
   /// \brief
   double getRadius() const;
 
@@ -63,6 +63,12 @@ const std::string& EllipsoidShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId EllipsoidShape::getTypeId() const
+{
+  return TypeId::Ellipsoid;
+}
+
 //==============================================================================
 void EllipsoidShape::setSize(const Eigen::Vector3d& diameters)
 {
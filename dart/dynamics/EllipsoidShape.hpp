@@ -55,6 +55,9 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
   /// \brief Set diameters of this ellipsoid.
   /// \deprecated Deprecated in 6.2. Please use setDiameters() instead.
   DART_DEPRECATED(6.2)
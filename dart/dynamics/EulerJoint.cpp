@@ -329,6 +329,89 @@ void EulerJoint::updateRelativeTransform() const
   assert(math::verifyTransform(mT));
 }
 
+//==============================================================================
+void EulerJoint::computeRelativeJacobianDerivatives(
+    std::vector<math::Jacobian>& dS, std::vector<math::Jacobian>& dSdot) const
+{
+  Joint::computeRelativeJacobianDerivatives(dS, dSdot);
+
+  const Eigen::Vector3d& positions = getPositionsStatic();
+  const double q1 = positions[1];
+  const double q2 = positions[2];
+
+  const Eigen::Vector3d& velocities = getVelocitiesStatic();
+  const double dq1 = velocities[1];
+  const double dq2 = velocities[2];
+
+  const double c1 = cos(q1);
+  const double c2 = cos(q2);
+  const double s1 = sin(q1);
+  const double s2 = sin(q2);
+
+  // Derivatives of the columns of S before the transform to the child body,
+  // where dJ0dq1 is the derivative of column 0 with respect to q1. The third
+  // column is constant, and the first one doesn't depend on q0.
+  Eigen::Vector6d dJ0dq1 = Eigen::Vector6d::Zero();
+  Eigen::Vector6d dJ0dq2 = Eigen::Vector6d::Zero();
+  Eigen::Vector6d dJ1dq2 = Eigen::Vector6d::Zero();
+  Eigen::Vector6d ddJ0dq1 = Eigen::Vector6d::Zero();
+  Eigen::Vector6d ddJ0dq2 = Eigen::Vector6d::Zero();
+  Eigen::Vector6d ddJ1dq2 = Eigen::Vector6d::Zero();
+
+  switch (getAxisOrder()) {
+    case AxisOrder::XYZ: {
+      //------------------------------------------------------------------------
+      // dS/dq1 = [ -s1*c2, 0, 0        dS/dq2 = [ -c1*s2,  c2, 0
+      //             s1*s2, 0, 0                   -c1*c2, -s2, 0
+      //                c1, 0, 0                        0,   0, 0
+      //                 0, 0, 0 ... ]                  0,   0, 0 ... ]
+      //------------------------------------------------------------------------
+      dJ0dq1.head<3>() << -s1 * c2, s1 * s2, c1;
+      dJ0dq2.head<3>() << -c1 * s2, -c1 * c2, 0.0;
+      dJ1dq2.head<3>() << c2, -s2, 0.0;
+
+      // Derivatives of dS/dt = dS/dq1 * dq1 + dS/dq2 * dq2
+      ddJ0dq1.head<3>() << -c1 * c2 * dq1 + s1 * s2 * dq2,
+          c1 * s2 * dq1 + s1 * c2 * dq2, -s1 * dq1;
+      ddJ0dq2.head<3>() << s1 * s2 * dq1 - c1 * c2 * dq2,
+          s1 * c2 * dq1 + c1 * s2 * dq2, 0.0;
+      ddJ1dq2.head<3>() << -s2 * dq2, -c2 * dq2, 0.0;
+      break;
+    }
+    case AxisOrder::ZYX: {
+      //------------------------------------------------------------------------
+      // dS/dq1 = [    -c1, 0, 0        dS/dq2 = [      0,   0, 0
+      //            -s2*s1, 0, 0                    c2*c1, -s2, 0
+      //            -s1*c2, 0, 0                   -c1*s2, -c2, 0
+      //                 0, 0, 0 ... ]                  0,   0, 0 ... ]
+      //------------------------------------------------------------------------
+      dJ0dq1.head<3>() << -c1, -s2 * s1, -s1 * c2;
+      dJ0dq2.head<3>() << 0.0, c2 * c1, -c1 * s2;
+      dJ1dq2.head<3>() << 0.0, -s2, -c2;
+
+      // Derivatives of dS/dt = dS/dq1 * dq1 + dS/dq2 * dq2
+      ddJ0dq1.head<3>() << s1 * dq1, -s2 * c1 * dq1 - c2 * s1 * dq2,
+          -c1 * c2 * dq1 + s1 * s2 * dq2;
+      ddJ0dq2.head<3>() << 0.0, -c2 * s1 * dq1 - s2 * c1 * dq2,
+          s1 * s2 * dq1 - c1 * c2 * dq2;
+      ddJ1dq2.head<3>() << 0.0, -c2 * dq2, s2 * dq2;
+      break;
+    }
+    default: {
+      dterr << "Undefined Euler axis order\n";
+      return;
+    }
+  }
+
+  const Eigen::Isometry3d& T = Joint::mAspectProperties.mT_ChildBodyToJoint;
+  dS[1].col(0) = math::AdT(T, dJ0dq1);
+  dS[2].col(0) = math::AdT(T, dJ0dq2);
+  dS[2].col(1) = math::AdT(T, dJ1dq2);
+  dSdot[1].col(0) = math::AdT(T, ddJ0dq1);
+  dSdot[2].col(0) = math::AdT(T, ddJ0dq2);
+  dSdot[2].col(1) = math::AdT(T, ddJ1dq2);
+}
+
 //==============================================================================
 void EulerJoint::updateRelativeJacobian(bool) const
 {
@@ -97,11 +97,19 @@ const Eigen::Isometry3d& Frame::getWorldTransform() const
     mWorldTransform
         = mParentFrame->getWorldTransform() * getRelativeTransform();
     mNeedTransformUpdate = false;
+    ++mWorldTransformVersion;
   }
 
   return mWorldTransform;
 }
 
+//==============================================================================
+std::size_t Frame::getWorldTransformVersion() const
+{
+  getWorldTransform();
+  return mWorldTransformVersion;
+}
+
 //==============================================================================
 Eigen::Isometry3d Frame::getTransform(const Frame* _withRespectTo) const
 {
@@ -526,6 +534,7 @@ void Frame::dirtyAcceleration()
 Frame::Frame(Frame* _refFrame)
   : Entity(ConstructFrame),
     mWorldTransform(Eigen::Isometry3d::Identity()),
+    mWorldTransformVersion(0u),
     mVelocity(Eigen::Vector6d::Zero()),
     mAcceleration(Eigen::Vector6d::Zero()),
     mAmWorld(false),
@@ -605,6 +614,7 @@ void Frame::processRemovedEntity(Entity*)
 Frame::Frame(ConstructWorldTag)
   : Entity(this, true),
     mWorldTransform(Eigen::Isometry3d::Identity()),
+    mWorldTransformVersion(0u),
     mVelocity(Eigen::Vector6d::Zero()),
     mAcceleration(Eigen::Vector6d::Zero()),
     mAmWorld(true),
@@ -87,6 +87,12 @@ public:
   /// Get the transform of this Frame with respect to the World Frame
   const Eigen::Isometry3d& getWorldTransform() const;
 
+  /// Get a counter that increases every time the world transform of this Frame
+  /// is recomputed. Two equal values mean the world transform has not changed
+  /// in between, which lets caches such as collision engines skip Frames that
+  /// did not move. This brings the world transform up to date first.
+  std::size_t getWorldTransformVersion() const;
+
   /// Get the transform of this Frame with respect to some other Frame
   Eigen::Isometry3d getTransform(
       const Frame* _withRespectTo = Frame::World()) const;
@@ -309,6 +315,9 @@ protected:
   /// Do not use directly! Use getWorldTransform() to access this quantity
   mutable Eigen::Isometry3d mWorldTransform;
 
+  /// Incremented each time mWorldTransform is recomputed
+  mutable std::size_t mWorldTransformVersion;
+
   /// Total velocity of this Frame, in the coordinates of this Frame
   ///
   /// Do not use directly! Use getSpatialVelocity() to access this quantity
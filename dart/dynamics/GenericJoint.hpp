@@ -542,6 +542,13 @@ protected:
   // Documentation inherited
   void updateRelativePrimaryAcceleration() const override;
 
+  // Documentation inherited
+  void setRelativeJacobianTo(Eigen::Ref<math::Jacobian> J) const override;
+
+  // Documentation inherited
+  void setRelativeJacobianTimeDerivTo(
+      Eigen::Ref<math::Jacobian> J) const override;
+
   // Documentation inherited
   void addVelocityTo(Eigen::Vector6d& vel) override;
 
@@ -64,6 +64,9 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
   /// \copydoc Shape::computeInertia()
   ///
   /// This base class computes the intertia based on the bounding box.
@@ -82,6 +82,107 @@ void JacobianNode::clearIK()
   mIK = nullptr;
 }
 
+//==============================================================================
+void JacobianNode::getJacobian(
+    const Frame* inCoordinatesOf, Eigen::Ref<math::Jacobian> J) const
+{
+  J = getJacobian(inCoordinatesOf);
+}
+
+//==============================================================================
+void JacobianNode::getJacobian(
+    const Eigen::Vector3d& offset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  J = getJacobian(offset, inCoordinatesOf);
+}
+
+//==============================================================================
+void JacobianNode::getWorldJacobian(
+    const Eigen::Vector3d& offset, Eigen::Ref<math::Jacobian> J) const
+{
+  J = getWorldJacobian(offset);
+}
+
+//==============================================================================
+void JacobianNode::getLinearJacobian(
+    const Frame* inCoordinatesOf, Eigen::Ref<math::LinearJacobian> J) const
+{
+  J = getLinearJacobian(inCoordinatesOf);
+}
+
+//==============================================================================
+void JacobianNode::getLinearJacobian(
+    const Eigen::Vector3d& offset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::LinearJacobian> J) const
+{
+  J = getLinearJacobian(offset, inCoordinatesOf);
+}
+
+//==============================================================================
+void JacobianNode::getAngularJacobian(
+    const Frame* inCoordinatesOf, Eigen::Ref<math::AngularJacobian> J) const
+{
+  J = getAngularJacobian(inCoordinatesOf);
+}
+
+//==============================================================================
+void JacobianNode::getJacobianSpatialDeriv(
+    const Frame* inCoordinatesOf, Eigen::Ref<math::Jacobian> J) const
+{
+  J = getJacobianSpatialDeriv(inCoordinatesOf);
+}
+
+//==============================================================================
+void JacobianNode::getJacobianSpatialDeriv(
+    const Eigen::Vector3d& offset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  J = getJacobianSpatialDeriv(offset, inCoordinatesOf);
+}
+
+//==============================================================================
+void JacobianNode::getJacobianClassicDeriv(
+    const Frame* inCoordinatesOf, Eigen::Ref<math::Jacobian> J) const
+{
+  J = getJacobianClassicDeriv(inCoordinatesOf);
+}
+
+//==============================================================================
+void JacobianNode::getJacobianClassicDeriv(
+    const Eigen::Vector3d& offset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  J = getJacobianClassicDeriv(offset, inCoordinatesOf);
+}
+
+//==============================================================================
+void JacobianNode::getLinearJacobianDeriv(
+    const Frame* inCoordinatesOf, Eigen::Ref<math::LinearJacobian> J) const
+{
+  J = getLinearJacobianDeriv(inCoordinatesOf);
+}
+
+//==============================================================================
+void JacobianNode::getLinearJacobianDeriv(
+    const Eigen::Vector3d& offset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::LinearJacobian> J) const
+{
+  J = getLinearJacobianDeriv(offset, inCoordinatesOf);
+}
+
+//==============================================================================
+void JacobianNode::getAngularJacobianDeriv(
+    const Frame* inCoordinatesOf, Eigen::Ref<math::AngularJacobian> J) const
+{
+  J = getAngularJacobianDeriv(inCoordinatesOf);
+}
+
 //==============================================================================
 JacobianNode::JacobianNode(BodyNode* bn)
   : Entity(Entity::ConstructAbstract),
@@ -264,6 +264,96 @@ public:
 
   /// \}
 
+  //----------------------------------------------------------------------------
+  /// \{ \name Jacobian Functions with Output Arguments
+  //----------------------------------------------------------------------------
+
+  // These versions write into a caller-provided matrix, which may be a block of
+  // a larger matrix, instead of returning a new one. The default
+  // implementations copy the result of the by-value versions, while the
+  // implementations in DART do not allocate.
+  // The output must have getNumDependentGenCoords() columns.
+
+  /// A version of getJacobian(const Frame*) that writes the Jacobian into J.
+  virtual void getJacobian(
+      const Frame* inCoordinatesOf, Eigen::Ref<math::Jacobian> J) const;
+
+  /// A version of getJacobian(const Eigen::Vector3d&, const Frame*) that writes
+  /// the Jacobian into J.
+  virtual void getJacobian(
+      const Eigen::Vector3d& offset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const;
+
+  /// A version of getWorldJacobian(const Eigen::Vector3d&) that writes the
+  /// Jacobian into J.
+  virtual void getWorldJacobian(
+      const Eigen::Vector3d& offset, Eigen::Ref<math::Jacobian> J) const;
+
+  /// A version of getLinearJacobian(const Frame*) that writes the Jacobian into
+  /// J.
+  virtual void getLinearJacobian(
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const;
+
+  /// A version of getLinearJacobian(const Eigen::Vector3d&, const Frame*) that
+  /// writes the Jacobian into J.
+  virtual void getLinearJacobian(
+      const Eigen::Vector3d& offset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const;
+
+  /// A version of getAngularJacobian(const Frame*) that writes the Jacobian
+  /// into J.
+  virtual void getAngularJacobian(
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::AngularJacobian> J) const;
+
+  /// A version of getJacobianSpatialDeriv(const Frame*) that writes the
+  /// Jacobian derivative into J.
+  virtual void getJacobianSpatialDeriv(
+      const Frame* inCoordinatesOf, Eigen::Ref<math::Jacobian> J) const;
+
+  /// A version of getJacobianSpatialDeriv(const Eigen::Vector3d&, const
+  /// Frame*) that writes the Jacobian derivative into J.
+  virtual void getJacobianSpatialDeriv(
+      const Eigen::Vector3d& offset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const;
+
+  /// A version of getJacobianClassicDeriv(const Frame*) that writes the
+  /// Jacobian derivative into J.
+  virtual void getJacobianClassicDeriv(
+      const Frame* inCoordinatesOf, Eigen::Ref<math::Jacobian> J) const;
+
+  /// A version of getJacobianClassicDeriv(const Eigen::Vector3d&, const
+  /// Frame*) that writes the Jacobian derivative into J.
+  virtual void getJacobianClassicDeriv(
+      const Eigen::Vector3d& offset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const;
+
+  /// A version of getLinearJacobianDeriv(const Frame*) that writes the
+  /// Jacobian derivative into J.
+  virtual void getLinearJacobianDeriv(
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const;
+
+  /// A version of getLinearJacobianDeriv(const Eigen::Vector3d&, const Frame*)
+  /// that writes the Jacobian derivative into J.
+  virtual void getLinearJacobianDeriv(
+      const Eigen::Vector3d& offset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const;
+
+  /// A version of getAngularJacobianDeriv(const Frame*) that writes the
+  /// Jacobian derivative into J.
+  virtual void getAngularJacobianDeriv(
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::AngularJacobian> J) const;
+
+  /// \}
+
   /// Notify this BodyNode and all its descendents that their Jacobians need to
   /// be updated.
   DART_DEPRECATED(6.2)
@@ -195,7 +195,11 @@ const std::string& Joint::getName() const
 //==============================================================================
 void Joint::setActuatorType(Joint::ActuatorType _actuatorType)
 {
+  if (_actuatorType == mAspectProperties.mActuatorType)
+    return;
+
   mAspectProperties.mActuatorType = _actuatorType;
+  incrementVersion();
 }
 
 //==============================================================================
@@ -226,12 +230,14 @@ void Joint::setMimicJointDof(
     std::size_t index, const MimicDofProperties& mimicProp)
 {
   mAspectProperties.mMimicDofProps[index] = mimicProp;
+  incrementVersion();
 }
 
 //==============================================================================
 void Joint::setMimicJointDofs(const std::vector<MimicDofProperties>& mimicProps)
 {
   mAspectProperties.mMimicDofProps = mimicProps;
+  incrementVersion();
 }
 
 //==============================================================================
@@ -467,7 +473,11 @@ void Joint::setPositionLimitEnforced(bool enforced)
 //==============================================================================
 void Joint::setLimitEnforcement(bool enforced)
 {
+  if (enforced == mAspectProperties.mIsPositionLimitEnforced)
+    return;
+
   mAspectProperties.mIsPositionLimitEnforced = enforced;
+  incrementVersion();
 }
 
 //==============================================================================
@@ -641,6 +651,33 @@ void Joint::updateArticulatedInertia() const
   mChildBodyNode->getArticulatedInertia();
 }
 
+//==============================================================================
+void Joint::computeRelativeJacobianDerivatives(
+    std::vector<math::Jacobian>& dS, std::vector<math::Jacobian>& dSdot) const
+{
+  const std::size_t numDofs = getNumDofs();
+
+  // Resetting the existing matrices keeps their storage
+  dS.resize(numDofs);
+  dSdot.resize(numDofs);
+  for (std::size_t k = 0u; k < numDofs; ++k) {
+    dS[k].setZero(6, numDofs);
+    dSdot[k].setZero(6, numDofs);
+  }
+}
+
+//==============================================================================
+void Joint::setRelativeJacobianTo(Eigen::Ref<math::Jacobian> _J) const
+{
+  _J = getRelativeJacobian();
+}
+
+//==============================================================================
+void Joint::setRelativeJacobianTimeDerivTo(Eigen::Ref<math::Jacobian> _J) const
+{
+  _J = getRelativeJacobianTimeDeriv();
+}
+
 //==============================================================================
 // Eigen::VectorXd Joint::getDampingForces() const
 //{
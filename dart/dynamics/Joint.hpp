@@ -718,6 +718,20 @@ public:
   /// the parent BodyNode expressed in the child BodyNode frame
   virtual const math::Jacobian getRelativeJacobianTimeDeriv() const = 0;
 
+  /// Computes the derivatives of the relative Jacobian, and of its time
+  /// derivative, with respect to each position of this Joint at the current
+  /// positions and velocities. dS[k] and dSdot[k] are the derivatives with
+  /// respect to position k; both vectors are resized to getNumDofs() matrices
+  /// with getNumDofs() columns, reusing their storage.
+  ///
+  /// The default implementation sets them to zero, which is exact for joints
+  /// whose relative Jacobian doesn't depend on their positions. Joints whose
+  /// relative Jacobian does, such as EulerJoint, UniversalJoint and
+  /// PlanarJoint, must override it.
+  virtual void computeRelativeJacobianDerivatives(
+      std::vector<math::Jacobian>& dS,
+      std::vector<math::Jacobian>& dSdot) const;
+
   /// Get constraint wrench expressed in body node frame
   virtual Eigen::Vector6d getBodyConstraintWrench() const = 0;
   // TODO: Need more informative name.
@@ -894,6 +908,17 @@ protected:
   /// Tells the Skeleton to update the articulated inertia if it needs updating
   void updateArticulatedInertia() const;
 
+  /// Set the relative Jacobian to _J, which has getNumDofs() columns. The
+  /// default implementation copies getRelativeJacobian(), while GenericJoint
+  /// does not allocate.
+  virtual void setRelativeJacobianTo(Eigen::Ref<math::Jacobian> _J) const;
+
+  /// Set the time derivative of the relative Jacobian to _J, which has
+  /// getNumDofs() columns. The default implementation copies
+  /// getRelativeJacobianTimeDeriv(), while GenericJoint does not allocate.
+  virtual void setRelativeJacobianTimeDerivTo(
+      Eigen::Ref<math::Jacobian> _J) const;
+
   /// Add joint velocity to _vel
   virtual void addVelocityTo(Eigen::Vector6d& _vel) = 0;
 
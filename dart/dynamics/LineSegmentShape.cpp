@@ -85,6 +85,12 @@ const std::string& LineSegmentShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId LineSegmentShape::getTypeId() const
+{
+  return TypeId::LineSegment;
+}
+
 //==============================================================================
 void LineSegmentShape::setThickness(float _thickness)
 {
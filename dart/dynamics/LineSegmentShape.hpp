@@ -60,6 +60,9 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
   /// Set the line thickness/width for rendering
   void setThickness(float _thickness);
 
@@ -126,6 +126,21 @@ aiMaterial::~aiMaterial()
 namespace dart {
 namespace dynamics {
 
+namespace {
+
+//==============================================================================
+/// Takes ownership of a mesh that is released with aiReleaseImport()
+std::shared_ptr<const aiScene> makeSharedMesh(const aiScene* mesh)
+{
+  if (!mesh)
+    return nullptr;
+
+  return std::shared_ptr<const aiScene>(
+      mesh, [](const aiScene* scene) { aiReleaseImport(scene); });
+}
+
+} // namespace
+
 //==============================================================================
 MeshShape::MeshShape(
     const Eigen::Vector3d& scale,
@@ -133,6 +148,7 @@ MeshShape::MeshShape(
     const common::Uri& path,
     common::ResourceRetrieverPtr resourceRetriever)
   : Shape(MESH),
+    mMesh(nullptr),
     mDisplayList(0),
     mColorMode(MATERIAL_COLOR),
     mAlphaMode(BLEND),
@@ -145,7 +161,7 @@ MeshShape::MeshShape(
 //==============================================================================
 MeshShape::~MeshShape()
 {
-  aiReleaseImport(mMesh);
+  // Do nothing
 }
 
 //==============================================================================
@@ -161,12 +177,44 @@ const std::string& MeshShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId MeshShape::getTypeId() const
+{
+  return TypeId::Mesh;
+}
+
 //==============================================================================
 const aiScene* MeshShape::getMesh() const
 {
   return mMesh;
 }
 
+//==============================================================================
+std::shared_ptr<const aiScene> MeshShape::getSharedMesh() const
+{
+  return mSharedMesh;
+}
+
+//==============================================================================
+aiScene* MeshShape::getMutableMesh()
+{
+  if (!mSharedMesh)
+    return nullptr;
+
+  if (mSharedMesh.use_count() > 1) {
+    mSharedMesh = makeSharedMesh(cloneMesh());
+    mMesh = mSharedMesh.get();
+  }
+
+  mIsBoundingBoxDirty = true;
+  mIsVolumeDirty = true;
+
+  incrementVersion();
+
+  // Nothing else refers to the mesh now, so it can be modified
+  return const_cast<aiScene*>(mMesh);
+}
+
 //==============================================================================
 std::string MeshShape::getMeshUri() const
 {
@@ -212,7 +260,23 @@ void MeshShape::setMesh(
     const common::Uri& uri,
     common::ResourceRetrieverPtr resourceRetriever)
 {
-  mMesh = mesh;
+  // Keep the ownership when the current mesh is set again
+  setSharedMesh(
+      mesh == mMesh ? mSharedMesh : makeSharedMesh(mesh),
+      uri,
+      std::move(resourceRetriever));
+}
+
+//==============================================================================
+void MeshShape::setSharedMesh(
+    std::shared_ptr<const aiScene> mesh,
+    const common::Uri& uri,
+    common::ResourceRetrieverPtr resourceRetriever)
+{
+  mSharedMesh = std::move(mesh);
+  mMesh = mSharedMesh.get();
+  mIsBoundingBoxDirty = true;
+  mIsVolumeDirty = true;
 
   if (!mMesh) {
     mMeshUri.clear();
@@ -313,10 +377,8 @@ Eigen::Matrix3d MeshShape::computeInertia(double _mass) const
 //==============================================================================
 ShapePtr MeshShape::clone() const
 {
-  aiScene* new_scene = cloneMesh();
-
-  auto new_shape = std::make_shared<MeshShape>(
-      mScale, new_scene, mMeshUri, mResourceRetriever);
+  auto new_shape = std::make_shared<MeshShape>(mScale, nullptr);
+  new_shape->setSharedMesh(mSharedMesh, mMeshUri, mResourceRetriever);
   new_shape->mMeshPath = mMeshPath;
   new_shape->mDisplayList = mDisplayList;
   new_shape->mColorMode = mColorMode;
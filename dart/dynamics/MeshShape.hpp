@@ -39,6 +39,7 @@
 
 #include <assimp/scene.h>
 
+#include <memory>
 #include <string>
 
 namespace dart {
@@ -93,14 +94,29 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
   const aiScene* getMesh() const;
 
+  /// Returns the mesh together with its ownership, so that other shapes can
+  /// share it through setSharedMesh() instead of copying it.
+  std::shared_ptr<const aiScene> getSharedMesh() const;
+
+  /// Returns the mesh for modification and increments the version of this
+  /// shape. If the mesh is shared with other shapes or with collision
+  /// geometries built from it, it is copied first so that they keep the
+  /// original (copy-on-write). Returns nullptr if there is no mesh.
+  aiScene* getMutableMesh();
+
   /// Updates positions of the vertices or the elements. By default, this does
   /// nothing; you must extend the MeshShape class and implement your own
   /// version of this function if you want the mesh data to get updated before
   /// rendering
   virtual void update();
 
+  /// Sets the mesh. The shape takes ownership of mesh and releases it once
+  /// neither this shape nor any of its clones uses it.
   void setMesh(
       const aiScene* mesh,
       const std::string& path = "",
@@ -111,6 +127,13 @@ public:
       const common::Uri& path,
       common::ResourceRetrieverPtr resourceRetriever = nullptr);
 
+  /// Sets a mesh that may be shared with other shapes. Shared meshes are
+  /// treated as immutable; use getMutableMesh() to modify them.
+  void setSharedMesh(
+      std::shared_ptr<const aiScene> mesh,
+      const common::Uri& uri = "",
+      common::ResourceRetrieverPtr resourceRetriever = nullptr);
+
   /// Returns URI to the mesh as std::string; an empty string if unavailable.
   std::string getMeshUri() const;
   // TODO(DART 7): Replace with getMeshUri2().
@@ -180,7 +203,8 @@ public:
   // Documentation inherited.
   Eigen::Matrix3d computeInertia(double mass) const override;
 
-  // Documentation inherited.
+  /// Returns a copy of this shape that shares the mesh with it. The mesh is
+  /// only copied when either shape modifies it through getMutableMesh().
   virtual ShapePtr clone() const override;
 
 protected:
@@ -192,6 +216,11 @@ protected:
 
   aiScene* cloneMesh() const;
 
+  /// Mesh, which is shared with the clones of this shape until it is modified
+  std::shared_ptr<const aiScene> mSharedMesh;
+
+  /// Raw pointer to the mesh held by mSharedMesh. Derived classes must modify
+  /// the mesh through getMutableMesh().
   const aiScene* mMesh;
 
   /// URI the mesh, if available).
@@ -1063,6 +1063,128 @@ math::Jacobian MetaSkeleton::getJacobianSpatialDeriv(
   return math::AdRJac(_node->getTransform(_inCoordinatesOf), result);
 }
 
+//==============================================================================
+void MetaSkeleton::getJacobian(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  J = getJacobian(node, inCoordinatesOf);
+}
+
+//==============================================================================
+void MetaSkeleton::getJacobian(
+    const JacobianNode* node,
+    const Eigen::Vector3d& localOffset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  J = getJacobian(node, localOffset, inCoordinatesOf);
+}
+
+//==============================================================================
+void MetaSkeleton::getWorldJacobian(
+    const JacobianNode* node,
+    const Eigen::Vector3d& localOffset,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  J = getWorldJacobian(node, localOffset);
+}
+
+//==============================================================================
+void MetaSkeleton::getLinearJacobian(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::LinearJacobian> J) const
+{
+  J = getLinearJacobian(node, inCoordinatesOf);
+}
+
+//==============================================================================
+void MetaSkeleton::getLinearJacobian(
+    const JacobianNode* node,
+    const Eigen::Vector3d& localOffset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::LinearJacobian> J) const
+{
+  J = getLinearJacobian(node, localOffset, inCoordinatesOf);
+}
+
+//==============================================================================
+void MetaSkeleton::getAngularJacobian(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::AngularJacobian> J) const
+{
+  J = getAngularJacobian(node, inCoordinatesOf);
+}
+
+//==============================================================================
+void MetaSkeleton::getJacobianSpatialDeriv(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  J = getJacobianSpatialDeriv(node, inCoordinatesOf);
+}
+
+//==============================================================================
+void MetaSkeleton::getJacobianSpatialDeriv(
+    const JacobianNode* node,
+    const Eigen::Vector3d& localOffset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  J = getJacobianSpatialDeriv(node, localOffset, inCoordinatesOf);
+}
+
+//==============================================================================
+void MetaSkeleton::getJacobianClassicDeriv(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  J = getJacobianClassicDeriv(node, inCoordinatesOf);
+}
+
+//==============================================================================
+void MetaSkeleton::getJacobianClassicDeriv(
+    const JacobianNode* node,
+    const Eigen::Vector3d& localOffset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  J = getJacobianClassicDeriv(node, localOffset, inCoordinatesOf);
+}
+
+//==============================================================================
+void MetaSkeleton::getLinearJacobianDeriv(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::LinearJacobian> J) const
+{
+  J = getLinearJacobianDeriv(node, inCoordinatesOf);
+}
+
+//==============================================================================
+void MetaSkeleton::getLinearJacobianDeriv(
+    const JacobianNode* node,
+    const Eigen::Vector3d& localOffset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::LinearJacobian> J) const
+{
+  J = getLinearJacobianDeriv(node, localOffset, inCoordinatesOf);
+}
+
+//==============================================================================
+void MetaSkeleton::getAngularJacobianDeriv(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::AngularJacobian> J) const
+{
+  J = getAngularJacobianDeriv(node, inCoordinatesOf);
+}
+
 //==============================================================================
 double MetaSkeleton::computeLagrangian() const
 {
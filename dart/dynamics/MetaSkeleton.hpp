@@ -773,6 +773,117 @@ public:
 
   /// \}
 
+  //----------------------------------------------------------------------------
+  /// \{ \name Jacobians with output arguments
+  //----------------------------------------------------------------------------
+
+  // These versions write into a caller-provided matrix, which may be a block of
+  // a larger matrix, instead of returning a new one. The default
+  // implementations copy the result of the by-value versions, while the
+  // implementations in DART do not allocate.
+  // The output must have getNumDofs() columns.
+
+  /// A version of getJacobian(const JacobianNode*, const Frame*) that writes
+  /// the Jacobian into J.
+  virtual void getJacobian(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const;
+
+  /// A version of getJacobian(const JacobianNode*, const Eigen::Vector3d&,
+  /// const Frame*) that writes the Jacobian into J.
+  virtual void getJacobian(
+      const JacobianNode* node,
+      const Eigen::Vector3d& localOffset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const;
+
+  /// A version of getWorldJacobian(const JacobianNode*, const
+  /// Eigen::Vector3d&) that writes the Jacobian into J.
+  virtual void getWorldJacobian(
+      const JacobianNode* node,
+      const Eigen::Vector3d& localOffset,
+      Eigen::Ref<math::Jacobian> J) const;
+
+  /// A version of getLinearJacobian(const JacobianNode*, const Frame*) that
+  /// writes the Jacobian into J.
+  virtual void getLinearJacobian(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const;
+
+  /// A version of getLinearJacobian(const JacobianNode*, const
+  /// Eigen::Vector3d&, const Frame*) that writes the Jacobian into J.
+  virtual void getLinearJacobian(
+      const JacobianNode* node,
+      const Eigen::Vector3d& localOffset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const;
+
+  /// A version of getAngularJacobian(const JacobianNode*, const Frame*) that
+  /// writes the Jacobian into J.
+  virtual void getAngularJacobian(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::AngularJacobian> J) const;
+
+  /// A version of getJacobianSpatialDeriv(const JacobianNode*, const Frame*)
+  /// that writes the Jacobian derivative into J.
+  virtual void getJacobianSpatialDeriv(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const;
+
+  /// A version of getJacobianSpatialDeriv(const JacobianNode*, const
+  /// Eigen::Vector3d&, const Frame*) that writes the Jacobian derivative into
+  /// J.
+  virtual void getJacobianSpatialDeriv(
+      const JacobianNode* node,
+      const Eigen::Vector3d& localOffset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const;
+
+  /// A version of getJacobianClassicDeriv(const JacobianNode*, const Frame*)
+  /// that writes the Jacobian derivative into J.
+  virtual void getJacobianClassicDeriv(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const;
+
+  /// A version of getJacobianClassicDeriv(const JacobianNode*, const
+  /// Eigen::Vector3d&, const Frame*) that writes the Jacobian derivative into
+  /// J.
+  virtual void getJacobianClassicDeriv(
+      const JacobianNode* node,
+      const Eigen::Vector3d& localOffset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const;
+
+  /// A version of getLinearJacobianDeriv(const JacobianNode*, const Frame*)
+  /// that writes the Jacobian derivative into J.
+  virtual void getLinearJacobianDeriv(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const;
+
+  /// A version of getLinearJacobianDeriv(const JacobianNode*, const
+  /// Eigen::Vector3d&, const Frame*) that writes the Jacobian derivative into
+  /// J.
+  virtual void getLinearJacobianDeriv(
+      const JacobianNode* node,
+      const Eigen::Vector3d& localOffset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const;
+
+  /// A version of getAngularJacobianDeriv(const JacobianNode*, const Frame*)
+  /// that writes the Jacobian derivative into J.
+  virtual void getAngularJacobianDeriv(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::AngularJacobian> J) const;
+
+  /// \}
+
   //----------------------------------------------------------------------------
   /// \{ \name Equations of Motion
   //----------------------------------------------------------------------------
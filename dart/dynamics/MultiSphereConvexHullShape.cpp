@@ -65,6 +65,12 @@ const std::string& MultiSphereConvexHullShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId MultiSphereConvexHullShape::getTypeId() const
+{
+  return TypeId::MultiSphereConvexHull;
+}
+
 //==============================================================================
 void MultiSphereConvexHullShape::addSpheres(
     const MultiSphereConvexHullShape::Spheres& spheres)
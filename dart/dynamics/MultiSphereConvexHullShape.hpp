@@ -60,6 +60,9 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
   /// Add a list of spheres
   void addSpheres(const Spheres& spheres);
 
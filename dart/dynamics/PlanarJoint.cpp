@@ -209,6 +209,22 @@ Eigen::Matrix<double, 6, 3> PlanarJoint::getRelativeJacobianStatic(
   return J;
 }
 
+//==============================================================================
+void PlanarJoint::computeRelativeJacobianDerivatives(
+    std::vector<math::Jacobian>& dS, std::vector<math::Jacobian>& dSdot) const
+{
+  Joint::computeRelativeJacobianDerivatives(dS, dSdot);
+
+  // Only the translational columns depend on the rotation about the plane
+  // normal, so dSi/dq2 = -ad(S2, Si) for i = 0, 1
+  const Eigen::Matrix<double, 6, 3>& J = getRelativeJacobianStatic();
+  const double dq2 = getVelocitiesStatic()[2];
+  for (int i = 0; i < 2; ++i) {
+    dS[2].col(i) = -math::ad(J.col(2), J.col(i));
+    dSdot[2].col(i) = -math::ad(J.col(2), dS[2].col(i)) * dq2;
+  }
+}
+
 //==============================================================================
 PlanarJoint::PlanarJoint(const Properties& properties)
   : detail::PlanarJointBase(properties)
@@ -132,6 +132,11 @@ public:
   Eigen::Matrix<double, 6, 3> getRelativeJacobianStatic(
       const Eigen::Vector3d& _positions) const override;
 
+  // Documentation inherited
+  void computeRelativeJacobianDerivatives(
+      std::vector<math::Jacobian>& dS,
+      std::vector<math::Jacobian>& dSdot) const override;
+
 protected:
   /// Constructor called by Skeleton class
   PlanarJoint(const Properties& properties);
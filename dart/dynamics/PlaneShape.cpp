@@ -61,6 +61,12 @@ const std::string& PlaneShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId PlaneShape::getTypeId() const
+{
+  return TypeId::Plane;
+}
+
 //==============================================================================
 Eigen::Matrix3d PlaneShape::computeInertia(double /*mass*/) const
 {
@@ -54,6 +54,9 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
   // Documentation inherited.
   Eigen::Matrix3d computeInertia(double mass) const override;
 
@@ -80,6 +80,12 @@ const std::string& PointCloudShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId PointCloudShape::getTypeId() const
+{
+  return TypeId::PointCloud;
+}
+
 //==============================================================================
 void PointCloudShape::reserve(std::size_t size)
 {
@@ -83,6 +83,9 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
   /// Reserves the point list by \c size.
   void reserve(std::size_t size);
 
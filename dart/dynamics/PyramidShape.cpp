@@ -67,6 +67,12 @@ const std::string& PyramidShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId PyramidShape::getTypeId() const
+{
+  return TypeId::Pyramid;
+}
+
 //==============================================================================
 double PyramidShape::getBaseWidth() const
 {
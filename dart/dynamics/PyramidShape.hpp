@@ -64,6 +64,9 @@ public:
   /// Returns shape type string for this shape.
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
   /// Returns the lateral length (algon X-axis) of the base.
   double getBaseWidth() const;
 
@@ -430,7 +430,7 @@ std::size_t ReferentialSkeleton::getIndexOf(
 static bool isValidBodyNode(
     const ReferentialSkeleton* /*_refSkel*/,
     const JacobianNode* _node,
-    const std::string& _fname)
+    const char* _fname)
 {
   if (nullptr == _node) {
     dtwarn << "[ReferentialSkeleton::" << _fname << "] Invalid BodyNode "
@@ -447,62 +447,70 @@ static bool isValidBodyNode(
 }
 
 //==============================================================================
-template <typename JacobianType>
+/// Writes the Jacobian of a JacobianNode into the Jacobian of the whole
+/// ReferentialSkeleton. The JacobianNode first writes into _buffer, which is
+/// only resized when it is too narrow, and then each of its columns is copied
+/// to the index of its DOF if that DOF is in the ReferentialSkeleton.
+template <typename JacobianType, typename NodeJacobianFunction>
 void assignJacobian(
-    JacobianType& _J,
     const ReferentialSkeleton* _refSkel,
     const JacobianNode* _node,
-    const JacobianType& _JBodyNode)
+    const char* _fname,
+    math::Jacobian& _buffer,
+    Eigen::Ref<JacobianType> _J,
+    NodeJacobianFunction getNodeJacobian)
 {
+  assert(static_cast<std::size_t>(_J.cols()) == _refSkel->getNumDofs());
+
+  _J.setZero();
+
+  if (!isValidBodyNode(_refSkel, _node, _fname))
+    return;
+
   const std::vector<const DegreeOfFreedom*>& bn_dofs
       = _node->getDependentDofs();
-  std::size_t nDofs = bn_dofs.size();
+  const std::size_t nDofs = bn_dofs.size();
+  if (static_cast<std::size_t>(_buffer.cols()) < nDofs)
+    _buffer.resize(6, nDofs);
+
+  auto JBodyNode
+      = _buffer.template topRows<JacobianType::RowsAtCompileTime>().leftCols(
+          nDofs);
+  getNodeJacobian(JBodyNode);
+
   for (std::size_t i = 0; i < nDofs; ++i) {
     std::size_t refIndex = _refSkel->getIndexOf(bn_dofs[i], false);
     if (INVALID_INDEX == refIndex)
       continue;
 
-    _J.col(refIndex) = _JBodyNode.col(i);
+    _J.col(refIndex) = JBodyNode.col(i);
   }
 }
 
-//==============================================================================
-template <typename... Args>
-math::Jacobian variadicGetJacobian(
-    const ReferentialSkeleton* _refSkel,
-    const JacobianNode* _node,
-    Args... args)
-{
-  math::Jacobian J = math::Jacobian::Zero(6, _refSkel->getNumDofs());
-
-  if (!isValidBodyNode(_refSkel, _node, "getJacobian"))
-    return J;
-
-  const math::Jacobian JBodyNode = _node->getJacobian(args...);
-
-  assignJacobian(J, _refSkel, _node, JBodyNode);
-
-  return J;
-}
-
 //==============================================================================
 math::Jacobian ReferentialSkeleton::getJacobian(const JacobianNode* _node) const
 {
-  return variadicGetJacobian(this, _node);
+  math::Jacobian J(6, getNumDofs());
+  getJacobian(_node, _node, J);
+  return J;
 }
 
 //==============================================================================
 math::Jacobian ReferentialSkeleton::getJacobian(
     const JacobianNode* _node, const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobian(this, _node, _inCoordinatesOf);
+  math::Jacobian J(6, getNumDofs());
+  getJacobian(_node, _inCoordinatesOf, J);
+  return J;
 }
 
 //==============================================================================
 math::Jacobian ReferentialSkeleton::getJacobian(
     const JacobianNode* _node, const Eigen::Vector3d& _localOffset) const
 {
-  return variadicGetJacobian(this, _node, _localOffset);
+  math::Jacobian J(6, getNumDofs());
+  getJacobian(_node, _localOffset, _node, J);
+  return J;
 }
 
 //==============================================================================
@@ -511,25 +519,8 @@ math::Jacobian ReferentialSkeleton::getJacobian(
     const Eigen::Vector3d& _localOffset,
     const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobian(this, _node, _localOffset, _inCoordinatesOf);
-}
-
-//==============================================================================
-template <typename... Args>
-math::Jacobian variadicGetWorldJacobian(
-    const ReferentialSkeleton* _refSkel,
-    const JacobianNode* _node,
-    Args... args)
-{
-  math::Jacobian J = math::Jacobian::Zero(6, _refSkel->getNumDofs());
-
-  if (!isValidBodyNode(_refSkel, _node, "getWorldJacobian"))
-    return J;
-
-  const math::Jacobian JBodyNode = _node->getWorldJacobian(args...);
-
-  assignJacobian(J, _refSkel, _node, JBodyNode);
-
+  math::Jacobian J(6, getNumDofs());
+  getJacobian(_node, _localOffset, _inCoordinatesOf, J);
   return J;
 }
 
@@ -537,33 +528,17 @@ math::Jacobian variadicGetWorldJacobian(
 math::Jacobian ReferentialSkeleton::getWorldJacobian(
     const JacobianNode* _node) const
 {
-  return variadicGetWorldJacobian(this, _node);
+  math::Jacobian J(6, getNumDofs());
+  getJacobian(_node, Frame::World(), J);
+  return J;
 }
 
 //==============================================================================
 math::Jacobian ReferentialSkeleton::getWorldJacobian(
     const JacobianNode* _node, const Eigen::Vector3d& _localOffset) const
 {
-  return variadicGetWorldJacobian(this, _node, _localOffset);
-}
-
-//==============================================================================
-template <typename... Args>
-math::LinearJacobian variadicGetLinearJacobian(
-    const ReferentialSkeleton* _refSkel,
-    const JacobianNode* _node,
-    Args... args)
-{
-  math::LinearJacobian J
-      = math::LinearJacobian::Zero(3, _refSkel->getNumDofs());
-
-  if (!isValidBodyNode(_refSkel, _node, "getLinearJacobian"))
-    return J;
-
-  const math::LinearJacobian JBodyNode = _node->getLinearJacobian(args...);
-
-  assignJacobian(J, _refSkel, _node, JBodyNode);
-
+  math::Jacobian J(6, getNumDofs());
+  getWorldJacobian(_node, _localOffset, J);
   return J;
 }
 
@@ -571,7 +546,9 @@ math::LinearJacobian variadicGetLinearJacobian(
 math::LinearJacobian ReferentialSkeleton::getLinearJacobian(
     const JacobianNode* _node, const Frame* _inCoordinatesOf) const
 {
-  return variadicGetLinearJacobian(this, _node, _inCoordinatesOf);
+  math::LinearJacobian J(3, getNumDofs());
+  getLinearJacobian(_node, _inCoordinatesOf, J);
+  return J;
 }
 
 //==============================================================================
@@ -580,26 +557,8 @@ math::LinearJacobian ReferentialSkeleton::getLinearJacobian(
     const Eigen::Vector3d& _localOffset,
     const Frame* _inCoordinatesOf) const
 {
-  return variadicGetLinearJacobian(this, _node, _localOffset, _inCoordinatesOf);
-}
-
-//==============================================================================
-template <typename... Args>
-math::AngularJacobian variadicGetAngularJacobian(
-    const ReferentialSkeleton* _refSkel,
-    const JacobianNode* _node,
-    Args... args)
-{
-  math::AngularJacobian J
-      = math::AngularJacobian::Zero(3, _refSkel->getNumDofs());
-
-  if (!isValidBodyNode(_refSkel, _node, "getAngularJacobian"))
-    return J;
-
-  const math::AngularJacobian JBodyNode = _node->getAngularJacobian(args...);
-
-  assignJacobian(J, _refSkel, _node, JBodyNode);
-
+  math::LinearJacobian J(3, getNumDofs());
+  getLinearJacobian(_node, _localOffset, _inCoordinatesOf, J);
   return J;
 }
 
@@ -607,47 +566,36 @@ math::AngularJacobian variadicGetAngularJacobian(
 math::AngularJacobian ReferentialSkeleton::getAngularJacobian(
     const JacobianNode* _node, const Frame* _inCoordinatesOf) const
 {
-  return variadicGetAngularJacobian(this, _node, _inCoordinatesOf);
-}
-
-//==============================================================================
-template <typename... Args>
-math::Jacobian variadicGetJacobianSpatialDeriv(
-    const ReferentialSkeleton* _refSkel,
-    const JacobianNode* _node,
-    Args... args)
-{
-  math::Jacobian dJ = math::Jacobian::Zero(6, _refSkel->getNumDofs());
-
-  if (!isValidBodyNode(_refSkel, _node, "getJacobianSpatialDeriv"))
-    return dJ;
-
-  const math::Jacobian dJBodyNode = _node->getJacobianSpatialDeriv(args...);
-
-  assignJacobian(dJ, _refSkel, _node, dJBodyNode);
-
-  return dJ;
+  math::AngularJacobian J(3, getNumDofs());
+  getAngularJacobian(_node, _inCoordinatesOf, J);
+  return J;
 }
 
 //==============================================================================
 math::Jacobian ReferentialSkeleton::getJacobianSpatialDeriv(
     const JacobianNode* _node) const
 {
-  return variadicGetJacobianSpatialDeriv(this, _node);
+  math::Jacobian dJ(6, getNumDofs());
+  getJacobianSpatialDeriv(_node, _node, dJ);
+  return dJ;
 }
 
 //==============================================================================
 math::Jacobian ReferentialSkeleton::getJacobianSpatialDeriv(
     const JacobianNode* _node, const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobianSpatialDeriv(this, _node, _inCoordinatesOf);
+  math::Jacobian dJ(6, getNumDofs());
+  getJacobianSpatialDeriv(_node, _inCoordinatesOf, dJ);
+  return dJ;
 }
 
 //==============================================================================
 math::Jacobian ReferentialSkeleton::getJacobianSpatialDeriv(
     const JacobianNode* _node, const Eigen::Vector3d& _localOffset) const
 {
-  return variadicGetJacobianSpatialDeriv(this, _node, _localOffset);
+  math::Jacobian dJ(6, getNumDofs());
+  getJacobianSpatialDeriv(_node, _localOffset, _node, dJ);
+  return dJ;
 }
 
 //==============================================================================
@@ -656,26 +604,8 @@ math::Jacobian ReferentialSkeleton::getJacobianSpatialDeriv(
     const Eigen::Vector3d& _localOffset,
     const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobianSpatialDeriv(
-      this, _node, _localOffset, _inCoordinatesOf);
-}
-
-//==============================================================================
-template <typename... Args>
-math::Jacobian variadicGetJacobianClassicDeriv(
-    const ReferentialSkeleton* _refSkel,
-    const JacobianNode* _node,
-    Args... args)
-{
-  math::Jacobian dJ = math::Jacobian::Zero(6, _refSkel->getNumDofs());
-
-  if (!isValidBodyNode(_refSkel, _node, "getJacobianClassicDeriv"))
-    return dJ;
-
-  const math::Jacobian dJBodyNode = _node->getJacobianClassicDeriv(args...);
-
-  assignJacobian(dJ, _refSkel, _node, dJBodyNode);
-
+  math::Jacobian dJ(6, getNumDofs());
+  getJacobianSpatialDeriv(_node, _localOffset, _inCoordinatesOf, dJ);
   return dJ;
 }
 
@@ -683,14 +613,18 @@ math::Jacobian variadicGetJacobianClassicDeriv(
 math::Jacobian ReferentialSkeleton::getJacobianClassicDeriv(
     const JacobianNode* _node) const
 {
-  return variadicGetJacobianClassicDeriv(this, _node);
+  math::Jacobian dJ(6, getNumDofs());
+  getJacobianClassicDeriv(_node, Frame::World(), dJ);
+  return dJ;
 }
 
 //==============================================================================
 math::Jacobian ReferentialSkeleton::getJacobianClassicDeriv(
     const JacobianNode* _node, const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobianClassicDeriv(this, _node, _inCoordinatesOf);
+  math::Jacobian dJ(6, getNumDofs());
+  getJacobianClassicDeriv(_node, _inCoordinatesOf, dJ);
+  return dJ;
 }
 
 //==============================================================================
@@ -699,36 +633,18 @@ math::Jacobian ReferentialSkeleton::getJacobianClassicDeriv(
     const Eigen::Vector3d& _localOffset,
     const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobianClassicDeriv(
-      this, _node, _localOffset, _inCoordinatesOf);
-}
-
-//==============================================================================
-template <typename... Args>
-math::LinearJacobian variadicGetLinearJacobianDeriv(
-    const ReferentialSkeleton* _refSkel,
-    const JacobianNode* _node,
-    Args... args)
-{
-  math::LinearJacobian dJv
-      = math::LinearJacobian::Zero(3, _refSkel->getNumDofs());
-
-  if (!isValidBodyNode(_refSkel, _node, "getLinearJacobianDeriv"))
-    return dJv;
-
-  const math::LinearJacobian dJvBodyNode
-      = _node->getLinearJacobianDeriv(args...);
-
-  assignJacobian(dJv, _refSkel, _node, dJvBodyNode);
-
-  return dJv;
+  math::Jacobian dJ(6, getNumDofs());
+  getJacobianClassicDeriv(_node, _localOffset, _inCoordinatesOf, dJ);
+  return dJ;
 }
 
 //==============================================================================
 math::LinearJacobian ReferentialSkeleton::getLinearJacobianDeriv(
     const JacobianNode* _node, const Frame* _inCoordinatesOf) const
 {
-  return variadicGetLinearJacobianDeriv(this, _node, _inCoordinatesOf);
+  math::LinearJacobian dJv(3, getNumDofs());
+  getLinearJacobianDeriv(_node, _inCoordinatesOf, dJv);
+  return dJv;
 }
 
 //==============================================================================
@@ -737,36 +653,244 @@ math::LinearJacobian ReferentialSkeleton::getLinearJacobianDeriv(
     const Eigen::Vector3d& _localOffset,
     const Frame* _inCoordinatesOf) const
 {
-  return variadicGetLinearJacobianDeriv(
-      this, _node, _localOffset, _inCoordinatesOf);
+  math::LinearJacobian dJv(3, getNumDofs());
+  getLinearJacobianDeriv(_node, _localOffset, _inCoordinatesOf, dJv);
+  return dJv;
 }
 
 //==============================================================================
-template <typename... Args>
-math::AngularJacobian variadicGetAngularJacobianDeriv(
-    const ReferentialSkeleton* _refSkel,
-    const JacobianNode* _node,
-    Args... args)
+math::AngularJacobian ReferentialSkeleton::getAngularJacobianDeriv(
+    const JacobianNode* _node, const Frame* _inCoordinatesOf) const
 {
-  math::AngularJacobian dJw
-      = math::AngularJacobian::Zero(3, _refSkel->getNumDofs());
-
-  if (!isValidBodyNode(_refSkel, _node, "getAngularJacobianDeriv"))
-    return dJw;
-
-  const math::AngularJacobian dJwBodyNode
-      = _node->getAngularJacobianDeriv(args...);
-
-  assignJacobian(dJw, _refSkel, _node, dJwBodyNode);
-
+  math::AngularJacobian dJw(3, getNumDofs());
+  getAngularJacobianDeriv(_node, _inCoordinatesOf, dJw);
   return dJw;
 }
 
 //==============================================================================
-math::AngularJacobian ReferentialSkeleton::getAngularJacobianDeriv(
-    const JacobianNode* _node, const Frame* _inCoordinatesOf) const
+void ReferentialSkeleton::getJacobian(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  assignJacobian<math::Jacobian>(
+      this,
+      node,
+      "getJacobian",
+      mJacobianBuffer,
+      J,
+      [&](Eigen::Ref<math::Jacobian> JNode) {
+        node->getJacobian(inCoordinatesOf, JNode);
+      });
+}
+
+//==============================================================================
+void ReferentialSkeleton::getJacobian(
+    const JacobianNode* node,
+    const Eigen::Vector3d& localOffset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  assignJacobian<math::Jacobian>(
+      this,
+      node,
+      "getJacobian",
+      mJacobianBuffer,
+      J,
+      [&](Eigen::Ref<math::Jacobian> JNode) {
+        node->getJacobian(localOffset, inCoordinatesOf, JNode);
+      });
+}
+
+//==============================================================================
+void ReferentialSkeleton::getWorldJacobian(
+    const JacobianNode* node,
+    const Eigen::Vector3d& localOffset,
+    Eigen::Ref<math::Jacobian> J) const
 {
-  return variadicGetAngularJacobianDeriv(this, _node, _inCoordinatesOf);
+  assignJacobian<math::Jacobian>(
+      this,
+      node,
+      "getWorldJacobian",
+      mJacobianBuffer,
+      J,
+      [&](Eigen::Ref<math::Jacobian> JNode) {
+        node->getWorldJacobian(localOffset, JNode);
+      });
+}
+
+//==============================================================================
+void ReferentialSkeleton::getLinearJacobian(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::LinearJacobian> J) const
+{
+  assignJacobian<math::LinearJacobian>(
+      this,
+      node,
+      "getLinearJacobian",
+      mJacobianBuffer,
+      J,
+      [&](Eigen::Ref<math::LinearJacobian> JNode) {
+        node->getLinearJacobian(inCoordinatesOf, JNode);
+      });
+}
+
+//==============================================================================
+void ReferentialSkeleton::getLinearJacobian(
+    const JacobianNode* node,
+    const Eigen::Vector3d& localOffset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::LinearJacobian> J) const
+{
+  assignJacobian<math::LinearJacobian>(
+      this,
+      node,
+      "getLinearJacobian",
+      mJacobianBuffer,
+      J,
+      [&](Eigen::Ref<math::LinearJacobian> JNode) {
+        node->getLinearJacobian(localOffset, inCoordinatesOf, JNode);
+      });
+}
+
+//==============================================================================
+void ReferentialSkeleton::getAngularJacobian(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::AngularJacobian> J) const
+{
+  assignJacobian<math::AngularJacobian>(
+      this,
+      node,
+      "getAngularJacobian",
+      mJacobianBuffer,
+      J,
+      [&](Eigen::Ref<math::AngularJacobian> JNode) {
+        node->getAngularJacobian(inCoordinatesOf, JNode);
+      });
+}
+
+//==============================================================================
+void ReferentialSkeleton::getJacobianSpatialDeriv(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  assignJacobian<math::Jacobian>(
+      this,
+      node,
+      "getJacobianSpatialDeriv",
+      mJacobianBuffer,
+      J,
+      [&](Eigen::Ref<math::Jacobian> JNode) {
+        node->getJacobianSpatialDeriv(inCoordinatesOf, JNode);
+      });
+}
+
+//==============================================================================
+void ReferentialSkeleton::getJacobianSpatialDeriv(
+    const JacobianNode* node,
+    const Eigen::Vector3d& localOffset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  assignJacobian<math::Jacobian>(
+      this,
+      node,
+      "getJacobianSpatialDeriv",
+      mJacobianBuffer,
+      J,
+      [&](Eigen::Ref<math::Jacobian> JNode) {
+        node->getJacobianSpatialDeriv(localOffset, inCoordinatesOf, JNode);
+      });
+}
+
+//==============================================================================
+void ReferentialSkeleton::getJacobianClassicDeriv(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  assignJacobian<math::Jacobian>(
+      this,
+      node,
+      "getJacobianClassicDeriv",
+      mJacobianBuffer,
+      J,
+      [&](Eigen::Ref<math::Jacobian> JNode) {
+        node->getJacobianClassicDeriv(inCoordinatesOf, JNode);
+      });
+}
+
+//==============================================================================
+void ReferentialSkeleton::getJacobianClassicDeriv(
+    const JacobianNode* node,
+    const Eigen::Vector3d& localOffset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  assignJacobian<math::Jacobian>(
+      this,
+      node,
+      "getJacobianClassicDeriv",
+      mJacobianBuffer,
+      J,
+      [&](Eigen::Ref<math::Jacobian> JNode) {
+        node->getJacobianClassicDeriv(localOffset, inCoordinatesOf, JNode);
+      });
+}
+
+//==============================================================================
+void ReferentialSkeleton::getLinearJacobianDeriv(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::LinearJacobian> J) const
+{
+  assignJacobian<math::LinearJacobian>(
+      this,
+      node,
+      "getLinearJacobianDeriv",
+      mJacobianBuffer,
+      J,
+      [&](Eigen::Ref<math::LinearJacobian> JNode) {
+        node->getLinearJacobianDeriv(inCoordinatesOf, JNode);
+      });
+}
+
+//==============================================================================
+void ReferentialSkeleton::getLinearJacobianDeriv(
+    const JacobianNode* node,
+    const Eigen::Vector3d& localOffset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::LinearJacobian> J) const
+{
+  assignJacobian<math::LinearJacobian>(
+      this,
+      node,
+      "getLinearJacobianDeriv",
+      mJacobianBuffer,
+      J,
+      [&](Eigen::Ref<math::LinearJacobian> JNode) {
+        node->getLinearJacobianDeriv(localOffset, inCoordinatesOf, JNode);
+      });
+}
+
+//==============================================================================
+void ReferentialSkeleton::getAngularJacobianDeriv(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::AngularJacobian> J) const
+{
+  assignJacobian<math::AngularJacobian>(
+      this,
+      node,
+      "getAngularJacobianDeriv",
+      mJacobianBuffer,
+      J,
+      [&](Eigen::Ref<math::AngularJacobian> JNode) {
+        node->getAngularJacobianDeriv(inCoordinatesOf, JNode);
+      });
 }
 
 //==============================================================================
@@ -300,6 +300,95 @@ public:
 
   /// \}
 
+  //----------------------------------------------------------------------------
+  /// \{ \name Jacobians with output arguments
+  //----------------------------------------------------------------------------
+
+  // Documentation inherited
+  void getJacobian(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const override;
+
+  // Documentation inherited
+  void getJacobian(
+      const JacobianNode* node,
+      const Eigen::Vector3d& localOffset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const override;
+
+  // Documentation inherited
+  void getWorldJacobian(
+      const JacobianNode* node,
+      const Eigen::Vector3d& localOffset,
+      Eigen::Ref<math::Jacobian> J) const override;
+
+  // Documentation inherited
+  void getLinearJacobian(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const override;
+
+  // Documentation inherited
+  void getLinearJacobian(
+      const JacobianNode* node,
+      const Eigen::Vector3d& localOffset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const override;
+
+  // Documentation inherited
+  void getAngularJacobian(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::AngularJacobian> J) const override;
+
+  // Documentation inherited
+  void getJacobianSpatialDeriv(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const override;
+
+  // Documentation inherited
+  void getJacobianSpatialDeriv(
+      const JacobianNode* node,
+      const Eigen::Vector3d& localOffset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const override;
+
+  // Documentation inherited
+  void getJacobianClassicDeriv(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const override;
+
+  // Documentation inherited
+  void getJacobianClassicDeriv(
+      const JacobianNode* node,
+      const Eigen::Vector3d& localOffset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const override;
+
+  // Documentation inherited
+  void getLinearJacobianDeriv(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const override;
+
+  // Documentation inherited
+  void getLinearJacobianDeriv(
+      const JacobianNode* node,
+      const Eigen::Vector3d& localOffset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const override;
+
+  // Documentation inherited
+  void getAngularJacobianDeriv(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::AngularJacobian> J) const override;
+
+  /// \}
+
   //----------------------------------------------------------------------------
   /// \{ \name Equations of Motion
   //----------------------------------------------------------------------------
@@ -534,6 +623,11 @@ protected:
   /// Cache for constraint force vector
   mutable Eigen::VectorXd mFc;
 
+  /// Scratch space for the Jacobians of JacobianNodes. It only grows, so the
+  /// Jacobian functions with output arguments do not allocate once it is as
+  /// wide as the largest number of dependent DOFs that was requested.
+  mutable math::Jacobian mJacobianBuffer;
+
 private:
   /// Add a Skeleton to this ReferentialSkeleton, ignoring its Joint and
   /// DegreesOfFreedom. This can only be used by this class.
@@ -71,6 +71,12 @@ Shape::~Shape()
   // Do nothing
 }
 
+//==============================================================================
+Shape::TypeId Shape::getTypeId() const
+{
+  return TypeId::Other;
+}
+
 //==============================================================================
 const math::BoundingBox& Shape::getBoundingBox() const
 {
@@ -48,6 +48,8 @@
 
 #include <memory>
 
+#include <cstdint>
+
 namespace dart {
 namespace dynamics {
 
@@ -80,6 +82,35 @@ public:
     UNSUPPORTED
   };
 
+  /// Compact integral identifier of the shape types that are part of DART.
+  /// Unlike the strings of getType(), the IDs can be used in switch
+  /// statements and lookup tables, e.g., to dispatch collision routines for a
+  /// pair of shapes.
+  enum class TypeId : std::uint8_t
+  {
+    Box,
+    Capsule,
+    Cone,
+    Cylinder,
+    Ellipsoid,
+    Heightmapf,
+    Heightmapd,
+    LineSegment,
+    Mesh,
+    MultiSphereConvexHull,
+    Plane,
+    PointCloud,
+    Pyramid,
+    SoftMesh,
+    Sphere,
+    VoxelGrid,
+    Other, ///< Shapes that are not part of DART
+  };
+
+  /// Number of TypeId values, for sizing lookup tables
+  static constexpr std::size_t NumTypeIds
+      = static_cast<std::size_t>(TypeId::Other) + 1u;
+
   /// DataVariance can be used by renderers to determine whether it should
   /// expect data for this shape to change during each update.
   enum DataVariance
@@ -116,6 +147,11 @@ public:
   /// \sa is()
   virtual const std::string& getType() const = 0;
 
+  /// Returns the integral ID of the shape type. Subclasses of the shapes of
+  /// DART report the ID of the DART shape they derive from, and the other
+  /// shapes report TypeId::Other.
+  virtual TypeId getTypeId() const;
+
   /// \brief Get the bounding box of the shape in its local coordinate frame.
   ///        The dimension will be automatically determined by the sub-classes
   ///        such as BoxShape, EllipsoidShape, CylinderShape, and MeshShape.
@@ -46,8 +46,13 @@ VisualAspectProperties::VisualAspectProperties(
 }
 
 //==============================================================================
-CollisionAspectProperties::CollisionAspectProperties(const bool collidable)
-  : mCollidable(collidable)
+CollisionAspectProperties::CollisionAspectProperties(
+    const bool collidable,
+    const std::uint32_t collisionCategories,
+    const std::uint32_t collisionMask)
+  : mCollidable(collidable),
+    mCollisionCategories(collisionCategories),
+    mCollisionMask(collisionMask)
 {
   // Do nothing
 }
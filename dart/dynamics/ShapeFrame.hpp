@@ -126,6 +126,14 @@ public:
 
   /// Return true if this body can collide with others bodies
   bool isCollidable() const;
+
+  DART_COMMON_SET_GET_ASPECT_PROPERTY(std::uint32_t, CollisionCategories)
+  // void setCollisionCategories(const std::uint32_t& value);
+  // const std::uint32_t& getCollisionCategories() const;
+
+  DART_COMMON_SET_GET_ASPECT_PROPERTY(std::uint32_t, CollisionMask)
+  // void setCollisionMask(const std::uint32_t& value);
+  // const std::uint32_t& getCollisionMask() const;
 };
 
 //==============================================================================
@@ -34,6 +34,7 @@
 
 #include "dart/common/Console.hpp"
 #include "dart/common/Deprecated.hpp"
+#include "dart/common/Memory.hpp"
 #include "dart/common/StlHelpers.hpp"
 #include "dart/dynamics/BodyNode.hpp"
 #include "dart/dynamics/DegreeOfFreedom.hpp"
@@ -48,6 +49,7 @@
 #include "dart/math/Helpers.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <queue>
 #include <string>
 #include <vector>
@@ -294,6 +296,38 @@ BodyNodePropertiesVector getAllJointProperties(const Skeleton* skel)
 
 } // namespace detail
 
+namespace {
+
+//==============================================================================
+/// Computes the derivatives of the position coordinates of a joint along its
+/// tangent space. They are the identity for joints whose configuration space
+/// is a vector space; for the others (e.g., BallJoint and FreeJoint) they are
+/// the inverse of the derivatives of Joint::getPositionDifferences().
+Eigen::MatrixXd computePositionTangentDerivatives(const Joint* joint)
+{
+  const std::size_t numDofs = joint->getNumDofs();
+  if (numDofs < 2u)
+    return Eigen::MatrixXd::Identity(numDofs, numDofs);
+
+  const double h = 1e-6;
+  const Eigen::VectorXd q = joint->getPositions();
+  Eigen::MatrixXd tangentDq(numDofs, numDofs);
+  Eigen::VectorXd qk = q;
+  for (std::size_t k = 0u; k < numDofs; ++k) {
+    qk[k] = q[k] + h;
+    const Eigen::VectorXd plus = joint->getPositionDifferences(qk, q);
+    qk[k] = q[k] - h;
+    const Eigen::VectorXd minus = joint->getPositionDifferences(qk, q);
+    qk[k] = q[k];
+
+    tangentDq.col(k) = (plus - minus) / (2.0 * h);
+  }
+
+  return tangentDq.inverse();
+}
+
+} // namespace
+
 //==============================================================================
 Skeleton::Configuration::Configuration(
     const Eigen::VectorXd& positions,
@@ -796,6 +830,25 @@ bool Skeleton::isMobile() const
   return mAspectProperties.mIsMobile;
 }
 
+//==============================================================================
+void Skeleton::setSleeping(bool sleeping)
+{
+  mIsSleeping = sleeping;
+
+  if (mIsSleeping) {
+    for (auto* dof : getDofs()) {
+      dof->setVelocity(0.0);
+      dof->setAcceleration(0.0);
+    }
+  }
+}
+
+//==============================================================================
+bool Skeleton::isSleeping() const
+{
+  return mIsSleeping;
+}
+
 //==============================================================================
 void Skeleton::setTimeStep(double _timeStep)
 {
@@ -1572,9 +1625,7 @@ Eigen::VectorXd Skeleton::getVelocityDifferences(
 
 //==============================================================================
 static bool isValidBodyNode(
-    const Skeleton* _skeleton,
-    const JacobianNode* _node,
-    const std::string& _fname)
+    const Skeleton* _skeleton, const JacobianNode* _node, const char* _fname)
 {
   if (nullptr == _node) {
     dtwarn << "[Skeleton::" << _fname << "] Invalid BodyNode pointer: "
@@ -1599,56 +1650,68 @@ static bool isValidBodyNode(
 }
 
 //==============================================================================
-template <typename JacobianType>
+/// Writes the Jacobian of a JacobianNode, which only has the columns of its
+/// dependent DOFs, into the Jacobian of the whole Skeleton without a temporary
+/// matrix. The JacobianNode writes into the leading columns of _J, and these
+/// columns are then moved to the indices of their DOFs. The indices are sorted
+/// and none is smaller than its position, so moving from the last column never
+/// overwrites a column that has not been moved yet.
+template <typename JacobianType, typename NodeJacobianFunction>
 void assignJacobian(
-    JacobianType& _J, const JacobianNode* _node, const JacobianType& _JBodyNode)
+    const Skeleton* _skel,
+    const JacobianNode* _node,
+    const char* _fname,
+    Eigen::Ref<JacobianType> _J,
+    NodeJacobianFunction getNodeJacobian)
 {
-  // Assign the BodyNode's Jacobian to the result Jacobian.
-  std::size_t localIndex = 0;
-  const auto& indices = _node->getDependentGenCoordIndices();
-  for (const auto& index : indices) {
-    // Each index should be less than the number of dofs of this Skeleton.
-    assert(index < _node->getSkeleton()->getNumDofs());
+  assert(static_cast<std::size_t>(_J.cols()) == _skel->getNumDofs());
 
-    _J.col(index) = _JBodyNode.col(localIndex++);
+  if (!isValidBodyNode(_skel, _node, _fname)) {
+    _J.setZero();
+    return;
   }
-}
 
-//==============================================================================
-template <typename... Args>
-math::Jacobian variadicGetJacobian(
-    const Skeleton* _skel, const JacobianNode* _node, Args... args)
-{
-  math::Jacobian J = math::Jacobian::Zero(6, _skel->getNumDofs());
-
-  if (!isValidBodyNode(_skel, _node, "getJacobian"))
-    return J;
+  const auto& indices = _node->getDependentGenCoordIndices();
+  getNodeJacobian(_J.leftCols(indices.size()));
 
-  const math::Jacobian JBodyNode = _node->getJacobian(args...);
+  Eigen::Index next = _J.cols();
+  for (std::size_t i = indices.size(); i-- > 0u;) {
+    const Eigen::Index index = static_cast<Eigen::Index>(indices[i]);
+    assert(static_cast<std::size_t>(index) >= i && index < next);
 
-  assignJacobian<math::Jacobian>(J, _node, JBodyNode);
+    _J.middleCols(index + 1, next - index - 1).setZero();
+    if (index != static_cast<Eigen::Index>(i))
+      _J.col(index) = _J.col(i);
 
-  return J;
+    next = index;
+  }
+  _J.leftCols(next).setZero();
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getJacobian(const JacobianNode* _node) const
 {
-  return variadicGetJacobian(this, _node);
+  math::Jacobian J(6, getNumDofs());
+  getJacobian(_node, _node, J);
+  return J;
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getJacobian(
     const JacobianNode* _node, const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobian(this, _node, _inCoordinatesOf);
+  math::Jacobian J(6, getNumDofs());
+  getJacobian(_node, _inCoordinatesOf, J);
+  return J;
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getJacobian(
     const JacobianNode* _node, const Eigen::Vector3d& _localOffset) const
 {
-  return variadicGetJacobian(this, _node, _localOffset);
+  math::Jacobian J(6, getNumDofs());
+  getJacobian(_node, _localOffset, _node, J);
+  return J;
 }
 
 //==============================================================================
@@ -1657,53 +1720,25 @@ math::Jacobian Skeleton::getJacobian(
     const Eigen::Vector3d& _localOffset,
     const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobian(this, _node, _localOffset, _inCoordinatesOf);
-}
-
-//==============================================================================
-template <typename... Args>
-math::Jacobian variadicGetWorldJacobian(
-    const Skeleton* _skel, const JacobianNode* _node, Args... args)
-{
-  math::Jacobian J = math::Jacobian::Zero(6, _skel->getNumDofs());
-
-  if (!isValidBodyNode(_skel, _node, "getWorldJacobian"))
-    return J;
-
-  const math::Jacobian JBodyNode = _node->getWorldJacobian(args...);
-
-  assignJacobian<math::Jacobian>(J, _node, JBodyNode);
-
+  math::Jacobian J(6, getNumDofs());
+  getJacobian(_node, _localOffset, _inCoordinatesOf, J);
   return J;
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getWorldJacobian(const JacobianNode* _node) const
 {
-  return variadicGetWorldJacobian(this, _node);
+  math::Jacobian J(6, getNumDofs());
+  getJacobian(_node, Frame::World(), J);
+  return J;
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getWorldJacobian(
     const JacobianNode* _node, const Eigen::Vector3d& _localOffset) const
 {
-  return variadicGetWorldJacobian(this, _node, _localOffset);
-}
-
-//==============================================================================
-template <typename... Args>
-math::LinearJacobian variadicGetLinearJacobian(
-    const Skeleton* _skel, const JacobianNode* _node, Args... args)
-{
-  math::LinearJacobian J = math::LinearJacobian::Zero(3, _skel->getNumDofs());
-
-  if (!isValidBodyNode(_skel, _node, "getLinearJacobian"))
-    return J;
-
-  const math::LinearJacobian JBodyNode = _node->getLinearJacobian(args...);
-
-  assignJacobian<math::LinearJacobian>(J, _node, JBodyNode);
-
+  math::Jacobian J(6, getNumDofs());
+  getWorldJacobian(_node, _localOffset, J);
   return J;
 }
 
@@ -1711,7 +1746,9 @@ math::LinearJacobian variadicGetLinearJacobian(
 math::LinearJacobian Skeleton::getLinearJacobian(
     const JacobianNode* _node, const Frame* _inCoordinatesOf) const
 {
-  return variadicGetLinearJacobian(this, _node, _inCoordinatesOf);
+  math::LinearJacobian J(3, getNumDofs());
+  getLinearJacobian(_node, _inCoordinatesOf, J);
+  return J;
 }
 
 //==============================================================================
@@ -1720,23 +1757,8 @@ math::LinearJacobian Skeleton::getLinearJacobian(
     const Eigen::Vector3d& _localOffset,
     const Frame* _inCoordinatesOf) const
 {
-  return variadicGetLinearJacobian(this, _node, _localOffset, _inCoordinatesOf);
-}
-
-//==============================================================================
-template <typename... Args>
-math::AngularJacobian variadicGetAngularJacobian(
-    const Skeleton* _skel, const JacobianNode* _node, Args... args)
-{
-  math::AngularJacobian J = math::AngularJacobian::Zero(3, _skel->getNumDofs());
-
-  if (!isValidBodyNode(_skel, _node, "getAngularJacobian"))
-    return J;
-
-  const math::AngularJacobian JBodyNode = _node->getAngularJacobian(args...);
-
-  assignJacobian<math::AngularJacobian>(J, _node, JBodyNode);
-
+  math::LinearJacobian J(3, getNumDofs());
+  getLinearJacobian(_node, _localOffset, _inCoordinatesOf, J);
   return J;
 }
 
@@ -1744,45 +1766,36 @@ math::AngularJacobian variadicGetAngularJacobian(
 math::AngularJacobian Skeleton::getAngularJacobian(
     const JacobianNode* _node, const Frame* _inCoordinatesOf) const
 {
-  return variadicGetAngularJacobian(this, _node, _inCoordinatesOf);
-}
-
-//==============================================================================
-template <typename... Args>
-math::Jacobian variadicGetJacobianSpatialDeriv(
-    const Skeleton* _skel, const JacobianNode* _node, Args... args)
-{
-  math::Jacobian dJ = math::Jacobian::Zero(6, _skel->getNumDofs());
-
-  if (!isValidBodyNode(_skel, _node, "getJacobianSpatialDeriv"))
-    return dJ;
-
-  const math::Jacobian dJBodyNode = _node->getJacobianSpatialDeriv(args...);
-
-  assignJacobian<math::Jacobian>(dJ, _node, dJBodyNode);
-
-  return dJ;
+  math::AngularJacobian J(3, getNumDofs());
+  getAngularJacobian(_node, _inCoordinatesOf, J);
+  return J;
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getJacobianSpatialDeriv(
     const JacobianNode* _node) const
 {
-  return variadicGetJacobianSpatialDeriv(this, _node);
+  math::Jacobian dJ(6, getNumDofs());
+  getJacobianSpatialDeriv(_node, _node, dJ);
+  return dJ;
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getJacobianSpatialDeriv(
     const JacobianNode* _node, const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobianSpatialDeriv(this, _node, _inCoordinatesOf);
+  math::Jacobian dJ(6, getNumDofs());
+  getJacobianSpatialDeriv(_node, _inCoordinatesOf, dJ);
+  return dJ;
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getJacobianSpatialDeriv(
     const JacobianNode* _node, const Eigen::Vector3d& _localOffset) const
 {
-  return variadicGetJacobianSpatialDeriv(this, _node, _localOffset);
+  math::Jacobian dJ(6, getNumDofs());
+  getJacobianSpatialDeriv(_node, _localOffset, _node, dJ);
+  return dJ;
 }
 
 //==============================================================================
@@ -1791,110 +1804,268 @@ math::Jacobian Skeleton::getJacobianSpatialDeriv(
     const Eigen::Vector3d& _localOffset,
     const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobianSpatialDeriv(
-      this, _node, _localOffset, _inCoordinatesOf);
+  math::Jacobian dJ(6, getNumDofs());
+  getJacobianSpatialDeriv(_node, _localOffset, _inCoordinatesOf, dJ);
+  return dJ;
 }
 
 //==============================================================================
-template <typename... Args>
-math::Jacobian variadicGetJacobianClassicDeriv(
-    const Skeleton* _skel, const JacobianNode* _node, Args... args)
+math::Jacobian Skeleton::getJacobianClassicDeriv(
+    const JacobianNode* _node) const
 {
-  math::Jacobian dJ = math::Jacobian::Zero(6, _skel->getNumDofs());
-
-  if (!isValidBodyNode(_skel, _node, "getJacobianClassicDeriv"))
-    return dJ;
-
-  const math::Jacobian dJBodyNode = _node->getJacobianClassicDeriv(args...);
-
-  assignJacobian<math::Jacobian>(dJ, _node, dJBodyNode);
-
+  math::Jacobian dJ(6, getNumDofs());
+  getJacobianClassicDeriv(_node, Frame::World(), dJ);
   return dJ;
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getJacobianClassicDeriv(
-    const JacobianNode* _node) const
+    const JacobianNode* _node, const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobianClassicDeriv(this, _node);
+  math::Jacobian dJ(6, getNumDofs());
+  getJacobianClassicDeriv(_node, _inCoordinatesOf, dJ);
+  return dJ;
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getJacobianClassicDeriv(
+    const JacobianNode* _node,
+    const Eigen::Vector3d& _localOffset,
+    const Frame* _inCoordinatesOf) const
+{
+  math::Jacobian dJ(6, getNumDofs());
+  getJacobianClassicDeriv(_node, _localOffset, _inCoordinatesOf, dJ);
+  return dJ;
+}
+
+//==============================================================================
+math::LinearJacobian Skeleton::getLinearJacobianDeriv(
     const JacobianNode* _node, const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobianClassicDeriv(this, _node, _inCoordinatesOf);
+  math::LinearJacobian dJv(3, getNumDofs());
+  getLinearJacobianDeriv(_node, _inCoordinatesOf, dJv);
+  return dJv;
 }
 
 //==============================================================================
-math::Jacobian Skeleton::getJacobianClassicDeriv(
+math::LinearJacobian Skeleton::getLinearJacobianDeriv(
     const JacobianNode* _node,
     const Eigen::Vector3d& _localOffset,
     const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobianClassicDeriv(
-      this, _node, _localOffset, _inCoordinatesOf);
+  math::LinearJacobian dJv(3, getNumDofs());
+  getLinearJacobianDeriv(_node, _localOffset, _inCoordinatesOf, dJv);
+  return dJv;
 }
 
 //==============================================================================
-template <typename... Args>
-math::LinearJacobian variadicGetLinearJacobianDeriv(
-    const Skeleton* _skel, const JacobianNode* _node, Args... args)
+math::AngularJacobian Skeleton::getAngularJacobianDeriv(
+    const JacobianNode* _node, const Frame* _inCoordinatesOf) const
 {
-  math::LinearJacobian dJv = math::LinearJacobian::Zero(3, _skel->getNumDofs());
+  math::AngularJacobian dJw(3, getNumDofs());
+  getAngularJacobianDeriv(_node, _inCoordinatesOf, dJw);
+  return dJw;
+}
 
-  if (!isValidBodyNode(_skel, _node, "getLinearJacobianDeriv"))
-    return dJv;
+//==============================================================================
+void Skeleton::getJacobian(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  assignJacobian<math::Jacobian>(
+      this, node, "getJacobian", J, [&](Eigen::Ref<math::Jacobian> JNode) {
+        node->getJacobian(inCoordinatesOf, JNode);
+      });
+}
 
-  const math::LinearJacobian dJvBodyNode
-      = _node->getLinearJacobianDeriv(args...);
+//==============================================================================
+void Skeleton::getJacobian(
+    const JacobianNode* node,
+    const Eigen::Vector3d& localOffset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  assignJacobian<math::Jacobian>(
+      this, node, "getJacobian", J, [&](Eigen::Ref<math::Jacobian> JNode) {
+        node->getJacobian(localOffset, inCoordinatesOf, JNode);
+      });
+}
 
-  assignJacobian<math::LinearJacobian>(dJv, _node, dJvBodyNode);
+//==============================================================================
+void Skeleton::getWorldJacobian(
+    const JacobianNode* node,
+    const Eigen::Vector3d& localOffset,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  assignJacobian<math::Jacobian>(
+      this, node, "getWorldJacobian", J, [&](Eigen::Ref<math::Jacobian> JNode) {
+        node->getWorldJacobian(localOffset, JNode);
+      });
+}
 
-  return dJv;
+//==============================================================================
+void Skeleton::getLinearJacobian(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::LinearJacobian> J) const
+{
+  assignJacobian<math::LinearJacobian>(
+      this,
+      node,
+      "getLinearJacobian",
+      J,
+      [&](Eigen::Ref<math::LinearJacobian> JNode) {
+        node->getLinearJacobian(inCoordinatesOf, JNode);
+      });
 }
 
 //==============================================================================
-math::LinearJacobian Skeleton::getLinearJacobianDeriv(
-    const JacobianNode* _node, const Frame* _inCoordinatesOf) const
+void Skeleton::getLinearJacobian(
+    const JacobianNode* node,
+    const Eigen::Vector3d& localOffset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::LinearJacobian> J) const
 {
-  return variadicGetLinearJacobianDeriv(this, _node, _inCoordinatesOf);
+  assignJacobian<math::LinearJacobian>(
+      this,
+      node,
+      "getLinearJacobian",
+      J,
+      [&](Eigen::Ref<math::LinearJacobian> JNode) {
+        node->getLinearJacobian(localOffset, inCoordinatesOf, JNode);
+      });
 }
 
 //==============================================================================
-math::LinearJacobian Skeleton::getLinearJacobianDeriv(
-    const JacobianNode* _node,
-    const Eigen::Vector3d& _localOffset,
-    const Frame* _inCoordinatesOf) const
+void Skeleton::getAngularJacobian(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::AngularJacobian> J) const
 {
-  return variadicGetLinearJacobianDeriv(
-      this, _node, _localOffset, _inCoordinatesOf);
+  assignJacobian<math::AngularJacobian>(
+      this,
+      node,
+      "getAngularJacobian",
+      J,
+      [&](Eigen::Ref<math::AngularJacobian> JNode) {
+        node->getAngularJacobian(inCoordinatesOf, JNode);
+      });
 }
 
 //==============================================================================
-template <typename... Args>
-math::AngularJacobian variadicGetAngularJacobianDeriv(
-    const Skeleton* _skel, const JacobianNode* _node, Args... args)
+void Skeleton::getJacobianSpatialDeriv(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
 {
-  math::AngularJacobian dJw
-      = math::AngularJacobian::Zero(3, _skel->getNumDofs());
+  assignJacobian<math::Jacobian>(
+      this,
+      node,
+      "getJacobianSpatialDeriv",
+      J,
+      [&](Eigen::Ref<math::Jacobian> JNode) {
+        node->getJacobianSpatialDeriv(inCoordinatesOf, JNode);
+      });
+}
 
-  if (!isValidBodyNode(_skel, _node, "getAngularJacobianDeriv"))
-    return dJw;
+//==============================================================================
+void Skeleton::getJacobianSpatialDeriv(
+    const JacobianNode* node,
+    const Eigen::Vector3d& localOffset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  assignJacobian<math::Jacobian>(
+      this,
+      node,
+      "getJacobianSpatialDeriv",
+      J,
+      [&](Eigen::Ref<math::Jacobian> JNode) {
+        node->getJacobianSpatialDeriv(localOffset, inCoordinatesOf, JNode);
+      });
+}
 
-  const math::AngularJacobian dJwBodyNode
-      = _node->getAngularJacobianDeriv(args...);
+//==============================================================================
+void Skeleton::getJacobianClassicDeriv(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  assignJacobian<math::Jacobian>(
+      this,
+      node,
+      "getJacobianClassicDeriv",
+      J,
+      [&](Eigen::Ref<math::Jacobian> JNode) {
+        node->getJacobianClassicDeriv(inCoordinatesOf, JNode);
+      });
+}
 
-  assignJacobian<math::AngularJacobian>(dJw, _node, dJwBodyNode);
+//==============================================================================
+void Skeleton::getJacobianClassicDeriv(
+    const JacobianNode* node,
+    const Eigen::Vector3d& localOffset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  assignJacobian<math::Jacobian>(
+      this,
+      node,
+      "getJacobianClassicDeriv",
+      J,
+      [&](Eigen::Ref<math::Jacobian> JNode) {
+        node->getJacobianClassicDeriv(localOffset, inCoordinatesOf, JNode);
+      });
+}
 
-  return dJw;
+//==============================================================================
+void Skeleton::getLinearJacobianDeriv(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::LinearJacobian> J) const
+{
+  assignJacobian<math::LinearJacobian>(
+      this,
+      node,
+      "getLinearJacobianDeriv",
+      J,
+      [&](Eigen::Ref<math::LinearJacobian> JNode) {
+        node->getLinearJacobianDeriv(inCoordinatesOf, JNode);
+      });
 }
 
 //==============================================================================
-math::AngularJacobian Skeleton::getAngularJacobianDeriv(
-    const JacobianNode* _node, const Frame* _inCoordinatesOf) const
+void Skeleton::getLinearJacobianDeriv(
+    const JacobianNode* node,
+    const Eigen::Vector3d& localOffset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::LinearJacobian> J) const
 {
-  return variadicGetAngularJacobianDeriv(this, _node, _inCoordinatesOf);
+  assignJacobian<math::LinearJacobian>(
+      this,
+      node,
+      "getLinearJacobianDeriv",
+      J,
+      [&](Eigen::Ref<math::LinearJacobian> JNode) {
+        node->getLinearJacobianDeriv(localOffset, inCoordinatesOf, JNode);
+      });
+}
+
+//==============================================================================
+void Skeleton::getAngularJacobianDeriv(
+    const JacobianNode* node,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::AngularJacobian> J) const
+{
+  assignJacobian<math::AngularJacobian>(
+      this,
+      node,
+      "getAngularJacobianDeriv",
+      J,
+      [&](Eigen::Ref<math::AngularJacobian> JNode) {
+        node->getAngularJacobianDeriv(inCoordinatesOf, JNode);
+      });
 }
 
 //==============================================================================
@@ -2067,7 +2238,11 @@ const Eigen::VectorXd& Skeleton::getConstraintForces() const
 
 //==============================================================================
 Skeleton::Skeleton(const AspectPropertiesData& properties)
-  : mTotalMass(0.0), mIsImpulseApplied(false), mUnionSize(1)
+  : mTotalMass(0.0),
+    mIsImpulseApplied(false),
+    mIsSleeping(false),
+    mUnionSize(1),
+    mUnionIndex(std::numeric_limits<std::size_t>::max())
 {
   createAspect<Aspect>(properties);
   createAspect<detail::BodyNodeVectorProxyAspect>();
@@ -2720,6 +2895,224 @@ void Skeleton::updateArticulatedInertia() const
   mSkelCache.mDirty.mArticulatedInertia = false;
 }
 
+//==============================================================================
+static bool hasSoftBodyNode(const std::vector<BodyNode*>& bodyNodes)
+{
+  for (const BodyNode* bodyNode : bodyNodes) {
+    if (bodyNode->asSoftBodyNode())
+      return true;
+  }
+
+  return false;
+}
+
+//==============================================================================
+static void computeParentDofs(
+    const std::vector<BodyNode*>& bodyNodes, std::vector<int>& parentDofs)
+{
+  for (const BodyNode* bodyNode : bodyNodes) {
+    const Joint* joint = bodyNode->getParentJoint();
+    const std::size_t numDofs = joint->getNumDofs();
+    if (numDofs == 0)
+      continue;
+
+    // Find the last DOF of the closest ancestor Joint that has DOFs
+    int parentDof = -1;
+    for (const BodyNode* ancestor = bodyNode->getParentBodyNode(); ancestor;
+         ancestor = ancestor->getParentBodyNode()) {
+      const Joint* ancestorJoint = ancestor->getParentJoint();
+      const std::size_t numAncestorDofs = ancestorJoint->getNumDofs();
+      if (numAncestorDofs > 0) {
+        parentDof = static_cast<int>(
+            ancestorJoint->getIndexInTree(numAncestorDofs - 1));
+        break;
+      }
+    }
+
+    for (std::size_t i = 0; i < numDofs; ++i) {
+      const std::size_t index = joint->getIndexInTree(i);
+      parentDofs[index] = parentDof;
+      parentDof = static_cast<int>(index);
+    }
+  }
+}
+
+//==============================================================================
+/// Factorize the symmetric positive definite matrix H into L^T L in place,
+/// where L is lower triangular with the sparsity pattern induced by the
+/// kinematic tree (Featherstone, "Efficient Factorization of the Joint-Space
+/// Inertia Matrix for Branched Kinematic Trees", 2005). Only the lower triangle
+/// of H is read and overwritten.
+static void factorizeLtl(const std::vector<int>& parentDofs, Eigen::MatrixXd& H)
+{
+  for (int k = static_cast<int>(H.rows()) - 1; k >= 0; --k) {
+    const double a = std::sqrt(H(k, k));
+    H(k, k) = a;
+
+    for (int i = parentDofs[k]; i != -1; i = parentDofs[i])
+      H(k, i) /= a;
+
+    for (int i = parentDofs[k]; i != -1; i = parentDofs[i]) {
+      for (int j = i; j != -1; j = parentDofs[j])
+        H(i, j) -= H(k, i) * H(k, j);
+    }
+  }
+}
+
+//==============================================================================
+/// Compute the inverse of L^T L given the sparse factor L
+static void invertLtl(
+    const std::vector<int>& parentDofs,
+    const Eigen::MatrixXd& L,
+    Eigen::MatrixXd& invM)
+{
+  const int n = static_cast<int>(L.rows());
+
+  for (int col = 0; col < n; ++col) {
+    auto x = invM.col(col);
+    x.setZero();
+    x[col] = 1.0;
+
+    // Solve L^T y = e_col. y is nonzero only for col and its ancestors.
+    for (int i = col; i != -1; i = parentDofs[i]) {
+      x[i] /= L(i, i);
+      for (int j = parentDofs[i]; j != -1; j = parentDofs[j])
+        x[j] -= L(i, j) * x[i];
+    }
+
+    // Solve L x = y
+    for (int i = 0; i < n; ++i) {
+      for (int j = parentDofs[i]; j != -1; j = parentDofs[j])
+        x[i] -= L(i, j) * x[j];
+      x[i] /= L(i, i);
+    }
+  }
+}
+
+//==============================================================================
+bool Skeleton::computeCompositeRigidBodyMassMatrix(
+    DataCache& _cache, Eigen::MatrixXd& _M) const
+{
+  const std::vector<BodyNode*>& bodyNodes = _cache.mBodyNodes;
+  if (hasSoftBodyNode(bodyNodes))
+    return false;
+
+  const std::size_t numBodyNodes = bodyNodes.size();
+  _cache.mCompositeInertias.resize(numBodyNodes);
+  _cache.mRelativeJacobians.resize(numBodyNodes);
+
+  // Backward pass: accumulate the inertia of each subtree in the frame of its
+  // root BodyNode. The BodyNodes of a tree are ordered parent-first.
+  for (std::size_t i = numBodyNodes; i-- > 0;) {
+    const BodyNode* bodyNode = bodyNodes[i];
+    Eigen::Matrix6d& compositeInertia = _cache.mCompositeInertias[i];
+    compositeInertia = bodyNode->getSpatialInertia();
+
+    for (const BodyNode* child : bodyNode->mChildBodyNodes) {
+      const Eigen::Matrix6d AdInvT = math::getAdTMatrix(
+          child->getParentJoint()->getRelativeTransform().inverse());
+      compositeInertia.noalias()
+          += AdInvT.transpose()
+             * _cache.mCompositeInertias[child->getIndexInTree()] * AdInvT;
+    }
+
+    const Joint* joint = bodyNode->getParentJoint();
+    if (joint->getNumDofs() > 0)
+      _cache.mRelativeJacobians[i] = joint->getRelativeJacobian();
+  }
+
+  // For each Joint, the force required to accelerate its subtree is propagated
+  // toward the root and projected onto the DOFs of every ancestor Joint.
+  _M.setZero();
+  Eigen::Matrix<double, 6, Eigen::Dynamic, 0, 6, 6> F;
+  for (std::size_t i = 0; i < numBodyNodes; ++i) {
+    const BodyNode* bodyNode = bodyNodes[i];
+    const Joint* joint = bodyNode->getParentJoint();
+    const std::size_t numDofs = joint->getNumDofs();
+    if (numDofs == 0)
+      continue;
+
+    const std::size_t iStart = joint->getIndexInTree(0);
+    const math::Jacobian& S = _cache.mRelativeJacobians[i];
+    F.noalias() = _cache.mCompositeInertias[i] * S;
+    _M.block(iStart, iStart, numDofs, numDofs).noalias() = S.transpose() * F;
+
+    const BodyNode* child = bodyNode;
+    for (const BodyNode* ancestor = bodyNode->getParentBodyNode(); ancestor;
+         ancestor = ancestor->getParentBodyNode()) {
+      F = math::getAdTMatrix(
+              child->getParentJoint()->getRelativeTransform().inverse())
+              .transpose()
+          * F;
+      child = ancestor;
+
+      const Joint* ancestorJoint = ancestor->getParentJoint();
+      const std::size_t numAncestorDofs = ancestorJoint->getNumDofs();
+      if (numAncestorDofs == 0)
+        continue;
+
+      const std::size_t jStart = ancestorJoint->getIndexInTree(0);
+      _M.block(jStart, iStart, numAncestorDofs, numDofs).noalias()
+          = _cache.mRelativeJacobians[ancestor->getIndexInTree()].transpose()
+            * F;
+      _M.block(iStart, jStart, numDofs, numAncestorDofs)
+          = _M.block(jStart, iStart, numAncestorDofs, numDofs).transpose();
+    }
+  }
+
+  return true;
+}
+
+//==============================================================================
+bool Skeleton::computeSparseInverseMassMatrix(
+    std::size_t _treeIdx, bool _augmented) const
+{
+  DataCache& cache = mTreeCache[_treeIdx];
+  if (hasSoftBodyNode(cache.mBodyNodes))
+    return false;
+
+  const std::size_t dof = cache.mDofs.size();
+  cache.mParentDofs.resize(dof);
+  computeParentDofs(cache.mBodyNodes, cache.mParentDofs);
+
+  Eigen::MatrixXd& H = cache.mMassMatrixFactor;
+  Eigen::MatrixXd& invM = _augmented ? cache.mInvAugM : cache.mInvM;
+  H = _augmented ? getAugMassMatrix(_treeIdx) : getMassMatrix(_treeIdx);
+
+  // The DOFs of kinematic Joints are not accelerated by forces, as in the
+  // forward dynamics, so they are decoupled from the rest of the tree before
+  // the factorization and their rows and columns of the inverse are zero.
+  for (const BodyNode* bodyNode : cache.mBodyNodes) {
+    const Joint* joint = bodyNode->getParentJoint();
+    if (!joint->isKinematic())
+      continue;
+
+    for (std::size_t i = 0; i < joint->getNumDofs(); ++i) {
+      const std::size_t index = joint->getIndexInTree(i);
+      H.row(index).setZero();
+      H.col(index).setZero();
+      H(index, index) = 1.0;
+    }
+  }
+
+  factorizeLtl(cache.mParentDofs, H);
+  invertLtl(cache.mParentDofs, H, invM);
+
+  for (const BodyNode* bodyNode : cache.mBodyNodes) {
+    const Joint* joint = bodyNode->getParentJoint();
+    if (!joint->isKinematic())
+      continue;
+
+    for (std::size_t i = 0; i < joint->getNumDofs(); ++i) {
+      const std::size_t index = joint->getIndexInTree(i);
+      invM.row(index).setZero();
+      invM.col(index).setZero();
+    }
+  }
+
+  return true;
+}
+
 //==============================================================================
 void Skeleton::updateMassMatrix(std::size_t _treeIdx) const
 {
@@ -2733,6 +3126,11 @@ void Skeleton::updateMassMatrix(std::size_t _treeIdx) const
     return;
   }
 
+  if (computeCompositeRigidBodyMassMatrix(cache, cache.mM)) {
+    cache.mDirty.mMassMatrix = false;
+    return;
+  }
+
   cache.mM.setZero();
 
   // Backup the original internal force
@@ -2824,6 +3222,19 @@ void Skeleton::updateAugMassMatrix(std::size_t _treeIdx) const
     return;
   }
 
+  if (computeCompositeRigidBodyMassMatrix(cache, cache.mAugM)) {
+    // Add the terms of the implicit joint damping and spring forces
+    const double timeStep = mAspectProperties.mTimeStep;
+    for (std::size_t i = 0; i < dof; ++i) {
+      cache.mAugM(i, i) += timeStep * cache.mDofs[i]->getDampingCoefficient()
+                           + timeStep * timeStep
+                                 * cache.mDofs[i]->getSpringStiffness();
+    }
+
+    cache.mDirty.mAugMassMatrix = false;
+    return;
+  }
+
   cache.mAugM.setZero();
 
   // Backup the origianl internal force
@@ -2916,6 +3327,11 @@ void Skeleton::updateInvMassMatrix(std::size_t _treeIdx) const
     return;
   }
 
+  if (computeSparseInverseMassMatrix(_treeIdx, false)) {
+    cache.mDirty.mInvMassMatrix = false;
+    return;
+  }
+
   // We don't need to set mInvM as zero matrix as long as the below is correct
   // cache.mInvM.setZero();
 
@@ -3008,6 +3424,11 @@ void Skeleton::updateInvAugMassMatrix(std::size_t _treeIdx) const
     return;
   }
 
+  if (computeSparseInverseMassMatrix(_treeIdx, true)) {
+    cache.mDirty.mInvAugMassMatrix = false;
+    return;
+  }
+
   // We don't need to set mInvM as zero matrix as long as the below is correct
   // mInvM.setZero();
 
@@ -3590,6 +4011,265 @@ void Skeleton::computeInverseDynamics(
   }
 }
 
+//==============================================================================
+void Skeleton::computeInverseDynamicsDerivatives(
+    Eigen::MatrixXd& tauDq,
+    Eigen::MatrixXd& tauDdq,
+    bool withExternalForces,
+    bool withDampingForces,
+    bool withSpringForces) const
+{
+  const std::size_t numDofs = getNumDofs();
+  tauDq.setZero(numDofs, numDofs);
+  tauDdq.setZero(numDofs, numDofs);
+
+  if (numDofs == 0u)
+    return;
+
+  const std::size_t numBodyNodes = mSkelCache.mBodyNodes.size();
+  Eigen::Vector6d worldGravity = Eigen::Vector6d::Zero();
+  worldGravity.tail<3>() = mAspectProperties.mGravity;
+
+  // Per-BodyNode quantities of the nominal recursion. The transforms,
+  // velocities, and accelerations are the ones cached by the BodyNodes; only
+  // the gravity and the body forces of inverse dynamics are recomputed. The
+  // buffers are kept in the cache so that repeated calls don't allocate.
+  auto& cache = mSkelCache.mInverseDynamicsDerivatives;
+  cache.mParents.assign(numBodyNodes, INVALID_INDEX);
+  cache.mDofStarts.assign(numBodyNodes, 0u);
+  cache.mS.resize(numBodyNodes);
+  cache.mDSdt.resize(numBodyNodes);
+  cache.mDq.resize(numBodyNodes);
+  cache.mDdq.resize(numBodyNodes);
+  cache.mDSdq.resize(numBodyNodes);
+  cache.mDSdotdq.resize(numBodyNodes);
+  cache.mParentV.resize(numBodyNodes);
+  cache.mParentA.resize(numBodyNodes);
+  cache.mParentG.resize(numBodyNodes);
+  cache.mG.resize(numBodyNodes);
+  cache.mF.assign(numBodyNodes, Eigen::Vector6d::Zero());
+  auto& parents = cache.mParents;
+  auto& dofStarts = cache.mDofStarts;
+  auto& S = cache.mS;
+  auto& dSdt = cache.mDSdt;
+  auto& dq = cache.mDq;
+  auto& ddq = cache.mDdq;
+  auto& dSdq = cache.mDSdq;
+  auto& dSdotdq = cache.mDSdotdq;
+  auto& parentV = cache.mParentV;
+  auto& parentA = cache.mParentA;
+  auto& parentG = cache.mParentG;
+  auto& G = cache.mG;
+  auto& F = cache.mF;
+
+  for (std::size_t i = 0u; i < numBodyNodes; ++i) {
+    const BodyNode* bodyNode = mSkelCache.mBodyNodes[i];
+    const Joint* joint = bodyNode->getParentJoint();
+    const Eigen::Isometry3d& T = joint->getRelativeTransform();
+    const BodyNode* parent = bodyNode->getParentBodyNode();
+
+    if (parent) {
+      parents[i] = parent->getIndexInSkeleton();
+      parentV[i] = math::AdInvT(T, parent->getSpatialVelocity());
+      parentA[i] = math::AdInvT(T, parent->getSpatialAcceleration());
+      parentG[i] = math::AdInvT(T, G[parents[i]]);
+    } else {
+      parentV[i].setZero();
+      parentA[i].setZero();
+      parentG[i] = math::AdInvT(T, worldGravity);
+    }
+    G[i] = parentG[i];
+
+    const std::size_t jointDofs = joint->getNumDofs();
+    if (jointDofs > 0u)
+      dofStarts[i] = joint->getIndexInSkeleton(0u);
+    S[i].resize(6, jointDofs);
+    joint->setRelativeJacobianTo(S[i]);
+    dSdt[i].resize(6, jointDofs);
+    joint->setRelativeJacobianTimeDerivTo(dSdt[i]);
+    dq[i].resize(jointDofs);
+    ddq[i].resize(jointDofs);
+    for (std::size_t j = 0u; j < jointDofs; ++j) {
+      dq[i][j] = joint->getVelocity(j);
+      ddq[i][j] = joint->getAcceleration(j);
+    }
+    joint->computeRelativeJacobianDerivatives(dSdq[i], dSdotdq[i]);
+  }
+
+  for (std::size_t i = numBodyNodes; i-- > 0u;) {
+    const BodyNode* bodyNode = mSkelCache.mBodyNodes[i];
+    const Eigen::Matrix6d& I = bodyNode->getSpatialInertia();
+    const Eigen::Vector6d& V = bodyNode->getSpatialVelocity();
+
+    F[i] += I * bodyNode->getSpatialAcceleration() - math::dad(V, I * V);
+    if (withExternalForces)
+      F[i] -= bodyNode->getExternalForceLocal();
+    if (bodyNode->getGravityMode())
+      F[i] -= I * G[i];
+
+    if (parents[i] != INVALID_INDEX) {
+      F[parents[i]] += math::dAdInvT(
+          bodyNode->getParentJoint()->getRelativeTransform(), F[i]);
+    }
+  }
+
+  // Directional derivatives of the recursion, one DOF at a time. Only the
+  // subtree of the BodyNode that the DOF moves has nonzero motion
+  // derivatives, while the force derivatives propagate to its ancestors.
+  cache.mInSubtree.resize(numBodyNodes);
+  cache.mDV.resize(numBodyNodes);
+  cache.mDA.resize(numBodyNodes);
+  cache.mDG.resize(numBodyNodes);
+  cache.mDF.assign(numBodyNodes, Eigen::Vector6d::Zero());
+  auto& inSubtree = cache.mInSubtree;
+  auto& dV = cache.mDV;
+  auto& dA = cache.mDA;
+  auto& dG = cache.mDG;
+  auto& dF = cache.mDF;
+
+  for (std::size_t b = 0u; b < numBodyNodes; ++b) {
+    for (std::size_t i = 0u; i < numBodyNodes; ++i) {
+      inSubtree[i] = (i == b)
+                     || (i > b && parents[i] != INVALID_INDEX
+                         && inSubtree[parents[i]]);
+    }
+
+    for (std::size_t k = 0u; k < static_cast<std::size_t>(S[b].cols()); ++k) {
+      const std::size_t column = dofStarts[b] + k;
+      const Eigen::Vector6d s = S[b].col(k);
+
+      for (int pass = 0; pass < 2; ++pass) {
+        const bool wrtPositions = (pass == 0);
+
+        // Forward recursion of the motion derivatives
+        for (std::size_t i = 0u; i < numBodyNodes; ++i) {
+          if (!inSubtree[i]) {
+            dV[i].setZero();
+            dA[i].setZero();
+            dG[i].setZero();
+            continue;
+          }
+
+          const BodyNode* bodyNode = mSkelCache.mBodyNodes[i];
+          const Eigen::Isometry3d& T
+              = bodyNode->getParentJoint()->getRelativeTransform();
+          const std::size_t p = parents[i];
+
+          if (i != b) {
+            dV[i] = math::AdInvT(T, dV[p]);
+            dA[i] = math::AdInvT(T, dA[p]);
+            dG[i] = math::AdInvT(T, dG[p]);
+          } else if (wrtPositions) {
+            // Moving the joint along s changes how the parent motion is
+            // seen from this BodyNode
+            const math::Jacobian& dSk = dSdq[b][k];
+            dV[i] = dSk * dq[b] - math::ad(s, parentV[i]);
+            dA[i] = math::ad(bodyNode->getSpatialVelocity(), dSk * dq[b])
+                    + dSdotdq[b][k] * dq[b] + dSk * ddq[b]
+                    - math::ad(s, parentA[i]);
+            dG[i] = -math::ad(s, parentG[i]);
+          } else {
+            dV[i] = s;
+            dA[i] = math::ad(bodyNode->getSpatialVelocity(), s)
+                    + dSdt[b].col(k) + dSdq[b][k] * dq[b];
+            dG[i].setZero();
+          }
+
+          if (S[i].cols() > 0)
+            dA[i] += math::ad(dV[i], S[i] * dq[i]);
+        }
+
+        // Backward recursion of the force derivatives
+        for (std::size_t i = numBodyNodes; i-- > 0u;) {
+          if (inSubtree[i]) {
+            const BodyNode* bodyNode = mSkelCache.mBodyNodes[i];
+            const Eigen::Matrix6d& I = bodyNode->getSpatialInertia();
+            const Eigen::Vector6d& V = bodyNode->getSpatialVelocity();
+
+            dF[i] += I * dA[i] - math::dad(dV[i], I * V)
+                     - math::dad(V, I * dV[i]);
+            if (bodyNode->getGravityMode())
+              dF[i] -= I * dG[i];
+          }
+
+          Eigen::MatrixXd& tauD = wrtPositions ? tauDq : tauDdq;
+          if (S[i].cols() > 0) {
+            tauD.block(dofStarts[i], column, S[i].cols(), 1).noalias()
+                = S[i].transpose() * dF[i];
+            if (wrtPositions && i == b) {
+              tauD.block(dofStarts[i], column, S[i].cols(), 1).noalias()
+                  += dSdq[b][k].transpose() * F[i];
+            }
+          }
+
+          const std::size_t p = parents[i];
+          if (p == INVALID_INDEX)
+            continue;
+
+          const Joint* joint = mSkelCache.mBodyNodes[i]->getParentJoint();
+          const Eigen::Isometry3d& T = joint->getRelativeTransform();
+          dF[p] += math::dAdInvT(T, dF[i]);
+          if (wrtPositions && i == b)
+            dF[p] -= math::dAdInvT(T, math::dad(s, F[i]));
+        }
+
+        for (auto& dFi : dF)
+          dFi.setZero();
+      }
+    }
+  }
+
+  // Implicit joint damping and spring forces
+  const double timeStep = mAspectProperties.mTimeStep;
+  for (std::size_t i = 0u; i < numBodyNodes; ++i) {
+    const Joint* joint = mSkelCache.mBodyNodes[i]->getParentJoint();
+    const std::size_t jointDofs = joint->getNumDofs();
+    const std::size_t start = dofStarts[i];
+
+    bool hasSprings = false;
+    for (std::size_t j = 0u; j < jointDofs; ++j) {
+      const double stiffness = joint->getSpringStiffness(j);
+      if (withDampingForces)
+        tauDdq(start + j, start + j) += joint->getDampingCoefficient(j);
+      if (withSpringForces && stiffness != 0.0) {
+        tauDdq(start + j, start + j) += timeStep * stiffness;
+        hasSprings = true;
+      }
+    }
+
+    if (!hasSprings)
+      continue;
+
+    if (jointDofs == 1u) {
+      tauDq(start, start) += joint->getSpringStiffness(0u);
+      continue;
+    }
+
+    const Eigen::MatrixXd tangentDq = computePositionTangentDerivatives(joint);
+    for (std::size_t j = 0u; j < jointDofs; ++j) {
+      tauDq.block(start + j, start, 1, jointDofs)
+          += joint->getSpringStiffness(j) * tangentDq.row(j);
+    }
+  }
+}
+
+//==============================================================================
+void Skeleton::computeForwardDynamicsDerivatives(
+    Eigen::MatrixXd& ddqDq, Eigen::MatrixXd& ddqDdq, Eigen::MatrixXd& ddqDtau)
+{
+  computeForwardDynamics();
+
+  // The accelerations satisfy tau = ID(q, dq, ddq) with the implicit damping
+  // and spring forces, whose derivative with respect to ddq is the augmented
+  // mass matrix.
+  computeInverseDynamicsDerivatives(ddqDq, ddqDdq, true, true, true);
+
+  const Eigen::MatrixXd& invAugM = getInvAugMassMatrix();
+  ddqDq = -invAugM * ddqDq;
+  ddqDdq = -invAugM * ddqDdq;
+  ddqDtau = invAugM;
+}
+
 //==============================================================================
 void Skeleton::clearExternalForces()
 {
@@ -305,6 +305,16 @@ public:
   /// \return True if this skeleton is mobile.
   bool isMobile() const;
 
+  /// Set whether this skeleton is sleeping. A sleeping skeleton is at rest:
+  /// putting it to sleep zeroes its velocities and accelerations, and
+  /// World::step() skips its dynamics and integration until it is woken up by
+  /// a constraint impulse, a force, a command or a velocity. See
+  /// World::setSleepingEnabled().
+  void setSleeping(bool sleeping);
+
+  /// Return true if this skeleton is sleeping
+  bool isSleeping() const;
+
   /// Set time step. This timestep is used for implicit joint damping
   /// force.
   void setTimeStep(double _timeStep);
@@ -680,6 +690,60 @@ public:
       bool _withDampingForces = false,
       bool _withSpringForces = false);
 
+  /// Computes the derivatives of the joint forces of inverse dynamics with
+  /// respect to the positions and the velocities of this Skeleton.
+  ///
+  /// The joint forces are the ones computeInverseDynamics() would compute
+  /// with the same flags at the current positions, velocities, and
+  /// accelerations. The derivatives with respect to the positions are taken
+  /// along the tangent space of each joint, i.e., in the direction that
+  /// integratePositions() moves the positions for a unit velocity.
+  ///
+  /// The derivatives are computed by differentiating the recursive
+  /// Newton-Euler algorithm, which costs O(n * N) for n DOFs and N BodyNodes.
+  /// The derivatives of the relative Jacobians of the joints are given by
+  /// Joint::computeRelativeJacobianDerivatives(); the point masses of
+  /// SoftBodyNodes are not taken into account.
+  ///
+  /// \param[out] tauDq Derivatives of the joint forces with respect to the
+  /// positions. Resized to getNumDofs() x getNumDofs() if needed.
+  /// \param[out] tauDdq Derivatives of the joint forces with respect to the
+  /// velocities. Resized to getNumDofs() x getNumDofs() if needed.
+  /// \param[in] withExternalForces Set \c true to take external forces into
+  /// account.
+  /// \param[in] withDampingForces Set \c true to take damping forces into
+  /// account.
+  /// \param[in] withSpringForces Set \c true to take spring forces into
+  /// account.
+  void computeInverseDynamicsDerivatives(
+      Eigen::MatrixXd& tauDq,
+      Eigen::MatrixXd& tauDdq,
+      bool withExternalForces = false,
+      bool withDampingForces = false,
+      bool withSpringForces = false) const;
+
+  /// Computes forward dynamics and the derivatives of the resulting joint
+  /// accelerations with respect to the positions, velocities, and joint
+  /// forces of this Skeleton.
+  ///
+  /// The accelerations are differentiated implicitly through the inverse
+  /// dynamics, \f$ \partial \ddot{q} / \partial x = -\hat{M}^{-1} \partial
+  /// \tau / \partial x \f$, where \f$ \hat{M} \f$ is the augmented mass matrix
+  /// that includes the implicit joint damping and spring terms. See
+  /// computeInverseDynamicsDerivatives() for the conventions used. All the
+  /// joints are assumed to be force-driven (FORCE or PASSIVE actuators).
+  ///
+  /// \param[out] ddqDq Derivatives of the accelerations with respect to the
+  /// positions. Resized to getNumDofs() x getNumDofs() if needed.
+  /// \param[out] ddqDdq Derivatives of the accelerations with respect to the
+  /// velocities. Resized to getNumDofs() x getNumDofs() if needed.
+  /// \param[out] ddqDtau Derivatives of the accelerations with respect to the
+  /// joint forces. Resized to getNumDofs() x getNumDofs() if needed.
+  void computeForwardDynamicsDerivatives(
+      Eigen::MatrixXd& ddqDq,
+      Eigen::MatrixXd& ddqDdq,
+      Eigen::MatrixXd& ddqDtau);
+
   //----------------------------------------------------------------------------
   // Impulse-based dynamics algorithms
   //----------------------------------------------------------------------------
@@ -826,6 +890,95 @@ public:
 
   /// \}
 
+  //----------------------------------------------------------------------------
+  /// \{ \name Jacobians with output arguments
+  //----------------------------------------------------------------------------
+
+  // Documentation inherited
+  void getJacobian(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const override;
+
+  // Documentation inherited
+  void getJacobian(
+      const JacobianNode* node,
+      const Eigen::Vector3d& localOffset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const override;
+
+  // Documentation inherited
+  void getWorldJacobian(
+      const JacobianNode* node,
+      const Eigen::Vector3d& localOffset,
+      Eigen::Ref<math::Jacobian> J) const override;
+
+  // Documentation inherited
+  void getLinearJacobian(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const override;
+
+  // Documentation inherited
+  void getLinearJacobian(
+      const JacobianNode* node,
+      const Eigen::Vector3d& localOffset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const override;
+
+  // Documentation inherited
+  void getAngularJacobian(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::AngularJacobian> J) const override;
+
+  // Documentation inherited
+  void getJacobianSpatialDeriv(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const override;
+
+  // Documentation inherited
+  void getJacobianSpatialDeriv(
+      const JacobianNode* node,
+      const Eigen::Vector3d& localOffset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const override;
+
+  // Documentation inherited
+  void getJacobianClassicDeriv(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const override;
+
+  // Documentation inherited
+  void getJacobianClassicDeriv(
+      const JacobianNode* node,
+      const Eigen::Vector3d& localOffset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const override;
+
+  // Documentation inherited
+  void getLinearJacobianDeriv(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const override;
+
+  // Documentation inherited
+  void getLinearJacobianDeriv(
+      const JacobianNode* node,
+      const Eigen::Vector3d& localOffset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const override;
+
+  // Documentation inherited
+  void getAngularJacobianDeriv(
+      const JacobianNode* node,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::AngularJacobian> J) const override;
+
+  /// \}
+
   //----------------------------------------------------------------------------
   /// \{ \name Equations of Motion
   //----------------------------------------------------------------------------
@@ -1129,6 +1282,21 @@ protected:
   /// Update inverse of augmented mass matrix of the skeleton.
   void updateInvAugMassMatrix() const;
 
+  /// Compute the mass matrix of a tree into _M using the composite rigid body
+  /// algorithm. Returns false if the tree contains SoftBodyNodes, which the
+  /// algorithm does not account for.
+  bool computeCompositeRigidBodyMassMatrix(
+      DataCache& _cache, Eigen::MatrixXd& _M) const;
+
+  /// Compute the inverse of the (augmented) mass matrix of a tree using the
+  /// branch-induced sparse L^T L factorization of the matrix computed by the
+  /// composite rigid body algorithm. The rows and columns of the DOFs of
+  /// kinematic Joints are zero. Returns false if the tree contains
+  /// SoftBodyNodes, whose inverse mass matrices are defined by the articulated
+  /// body algorithm instead.
+  bool computeSparseInverseMassMatrix(
+      std::size_t _treeIdx, bool _augmented) const;
+
   /// Update Coriolis force vector for a tree in the Skeleton
   void updateCoriolisForces(std::size_t _treeIdx) const;
 
@@ -1265,6 +1433,87 @@ protected:
     /// Inverse of augmented mass matrix for the skeleton.
     Eigen::MatrixXd mInvAugM;
 
+    /// Composite rigid body inertias of the BodyNodes in this tree, used by
+    /// the composite rigid body algorithm
+    common::aligned_vector<Eigen::Matrix6d> mCompositeInertias;
+
+    /// Relative Jacobians of the parent Joints of the BodyNodes in this tree,
+    /// used by the composite rigid body algorithm
+    std::vector<math::Jacobian> mRelativeJacobians;
+
+    /// Index of the parent of each DOF in this tree, which is the preceding DOF
+    /// of the same Joint or the last DOF of the closest ancestor Joint. -1 if
+    /// the DOF has no parent. The mass matrix of a tree only has nonzero
+    /// entries between a DOF and its ancestors.
+    std::vector<int> mParentDofs;
+
+    /// Scratch data of computeInverseDynamicsDerivatives() with one entry for
+    /// each BodyNode, kept so that repeated calls don't allocate
+    struct InverseDynamicsDerivatives
+    {
+      /// Index of the parent BodyNode, or INVALID_INDEX for a root
+      std::vector<std::size_t> mParents;
+
+      /// Index of the first DOF of the parent Joint
+      std::vector<std::size_t> mDofStarts;
+
+      /// Relative Jacobian of the parent Joint
+      std::vector<math::Jacobian> mS;
+
+      /// Time derivative of the relative Jacobian of the parent Joint
+      std::vector<math::Jacobian> mDSdt;
+
+      /// Velocities of the parent Joint
+      std::vector<Eigen::VectorXd> mDq;
+
+      /// Accelerations of the parent Joint
+      std::vector<Eigen::VectorXd> mDdq;
+
+      /// Derivatives of mS with respect to each position of the parent Joint
+      std::vector<std::vector<math::Jacobian>> mDSdq;
+
+      /// Derivatives of mDSdt with respect to each position of the parent
+      /// Joint
+      std::vector<std::vector<math::Jacobian>> mDSdotdq;
+
+      /// Spatial velocity of the parent BodyNode seen from the BodyNode
+      common::aligned_vector<Eigen::Vector6d> mParentV;
+
+      /// Spatial acceleration of the parent BodyNode seen from the BodyNode
+      common::aligned_vector<Eigen::Vector6d> mParentA;
+
+      /// Gravity of the parent BodyNode seen from the BodyNode
+      common::aligned_vector<Eigen::Vector6d> mParentG;
+
+      /// Gravity in the frame of the BodyNode
+      common::aligned_vector<Eigen::Vector6d> mG;
+
+      /// Body force of inverse dynamics
+      common::aligned_vector<Eigen::Vector6d> mF;
+
+      /// Whether the BodyNode moves with the DOF being differentiated
+      std::vector<bool> mInSubtree;
+
+      /// Directional derivative of the spatial velocity
+      common::aligned_vector<Eigen::Vector6d> mDV;
+
+      /// Directional derivative of the spatial acceleration
+      common::aligned_vector<Eigen::Vector6d> mDA;
+
+      /// Directional derivative of the gravity
+      common::aligned_vector<Eigen::Vector6d> mDG;
+
+      /// Directional derivative of the body force
+      common::aligned_vector<Eigen::Vector6d> mDF;
+    };
+
+    /// Scratch data of computeInverseDynamicsDerivatives(), only used by the
+    /// cache of the whole Skeleton
+    InverseDynamicsDerivatives mInverseDynamicsDerivatives;
+
+    /// Sparse L^T L factorization of the (augmented) mass matrix
+    Eigen::MatrixXd mMassMatrixFactor;
+
     /// Coriolis vector for the skeleton which is C(q,dq)*dq.
     Eigen::VectorXd mCvec;
 
@@ -1318,6 +1567,9 @@ protected:
   /// Flag for status of impulse testing.
   bool mIsImpulseApplied;
 
+  /// Whether this skeleton is sleeping
+  bool mIsSleeping;
+
   mutable std::mutex mMutex;
 
 public:
@@ -1337,7 +1589,9 @@ public:
   ///
   std::size_t mUnionSize;
 
-  ///
+  /// Index of the constrained group of this skeleton in the last
+  /// ConstraintSolver::solve(), or std::numeric_limits<std::size_t>::max() if
+  /// the skeleton had no active constraints
   std::size_t mUnionIndex;
 };
 DART_DECLARE_CLASS_WITH_VIRTUAL_BASE_END
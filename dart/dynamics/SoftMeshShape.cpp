@@ -67,6 +67,12 @@ const std::string& SoftMeshShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId SoftMeshShape::getTypeId() const
+{
+  return TypeId::SoftMesh;
+}
+
 //==============================================================================
 const aiMesh* SoftMeshShape::getAssimpMesh() const
 {
@@ -61,6 +61,9 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
   /// \brief
   const aiMesh* getAssimpMesh() const;
 
@@ -62,6 +62,12 @@ const std::string& SphereShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId SphereShape::getTypeId() const
+{
+  return TypeId::Sphere;
+}
+
 //==============================================================================
 void SphereShape::setRadius(double radius)
 {
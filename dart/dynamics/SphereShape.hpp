@@ -53,6 +53,9 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
   /// Set radius of this box.
   void setRadius(double radius);
 
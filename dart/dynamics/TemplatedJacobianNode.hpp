@@ -40,8 +40,8 @@ namespace dynamics {
 
 /// TemplatedJacobianNode provides a curiously recurring template pattern
 /// implementation of the various JacobianNode non-caching functions. These
-/// functions are easily distinguished because they return by value instead of
-/// returning by const reference.
+/// functions are easily distinguished because they return by value or write
+/// into an output argument instead of returning by const reference.
 ///
 /// This style of implementation allows BodyNode and EndEffector to share the
 /// implementations of these various auxiliary Jacobian functions without any
@@ -115,6 +115,75 @@ public:
   math::AngularJacobian getAngularJacobianDeriv(
       const Frame* _inCoordinatesOf = Frame::World()) const override final;
 
+  // Documentation inherited
+  void getJacobian(const Frame* inCoordinatesOf, Eigen::Ref<math::Jacobian> J)
+      const override final;
+
+  // Documentation inherited
+  void getJacobian(
+      const Eigen::Vector3d& offset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const override final;
+
+  // Documentation inherited
+  void getWorldJacobian(
+      const Eigen::Vector3d& offset,
+      Eigen::Ref<math::Jacobian> J) const override final;
+
+  // Documentation inherited
+  void getLinearJacobian(
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const override final;
+
+  // Documentation inherited
+  void getLinearJacobian(
+      const Eigen::Vector3d& offset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const override final;
+
+  // Documentation inherited
+  void getAngularJacobian(
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::AngularJacobian> J) const override final;
+
+  // Documentation inherited
+  void getJacobianSpatialDeriv(
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const override final;
+
+  // Documentation inherited
+  void getJacobianSpatialDeriv(
+      const Eigen::Vector3d& offset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const override final;
+
+  // Documentation inherited
+  void getJacobianClassicDeriv(
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const override final;
+
+  // Documentation inherited
+  void getJacobianClassicDeriv(
+      const Eigen::Vector3d& offset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::Jacobian> J) const override final;
+
+  // Documentation inherited
+  void getLinearJacobianDeriv(
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const override final;
+
+  // Documentation inherited
+  void getLinearJacobianDeriv(
+      const Eigen::Vector3d& offset,
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::LinearJacobian> J) const override final;
+
+  // Documentation inherited
+  void getAngularJacobianDeriv(
+      const Frame* inCoordinatesOf,
+      Eigen::Ref<math::AngularJacobian> J) const override final;
+
 protected:
   /// Constructor
   TemplatedJacobianNode(BodyNode* bn);
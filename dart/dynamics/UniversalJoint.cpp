@@ -160,6 +160,20 @@ Eigen::Matrix<double, 6, 2> UniversalJoint::getRelativeJacobianStatic(
   return J;
 }
 
+//==============================================================================
+void UniversalJoint::computeRelativeJacobianDerivatives(
+    std::vector<math::Jacobian>& dS, std::vector<math::Jacobian>& dSdot) const
+{
+  Joint::computeRelativeJacobianDerivatives(dS, dSdot);
+
+  // Only the first column depends on the second position, through the
+  // rotation about the second axis, so dS0/dq1 = -ad(S1, S0)
+  const Eigen::Matrix<double, 6, 2>& J = getRelativeJacobianStatic();
+  dS[1].col(0) = -math::ad(J.col(1), J.col(0));
+  dSdot[1].col(0)
+      = -math::ad(J.col(1), dS[1].col(0)) * getVelocitiesStatic()[1];
+}
+
 //==============================================================================
 UniversalJoint::UniversalJoint(const Properties& properties)
   : detail::UniversalJointBase(properties)
@@ -100,6 +100,11 @@ public:
   Eigen::Matrix<double, 6, 2> getRelativeJacobianStatic(
       const Eigen::Vector2d& _positions) const override;
 
+  // Documentation inherited
+  void computeRelativeJacobianDerivatives(
+      std::vector<math::Jacobian>& dS,
+      std::vector<math::Jacobian>& dSdot) const override;
+
 protected:
   /// Constructor called by Skeleton class
   UniversalJoint(const Properties& properties);
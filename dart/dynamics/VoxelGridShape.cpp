@@ -111,6 +111,12 @@ const std::string& VoxelGridShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId VoxelGridShape::getTypeId() const
+{
+  return TypeId::VoxelGrid;
+}
+
 //==============================================================================
 void VoxelGridShape::setOctree(std::shared_ptr<octomap::OcTree> octree)
 {
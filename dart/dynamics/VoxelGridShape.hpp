@@ -68,6 +68,9 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
   /// Sets octree.
   void setOctree(std::shared_ptr<octomap::OcTree> octree);
 
@@ -1609,6 +1609,22 @@ void GenericJoint<ConfigSpaceT>::addVelocityTo(Eigen::Vector6d& vel)
   assert(!math::isNan(vel));
 }
 
+//==============================================================================
+template <class ConfigSpaceT>
+void GenericJoint<ConfigSpaceT>::setRelativeJacobianTo(
+    Eigen::Ref<math::Jacobian> J) const
+{
+  J = getRelativeJacobianStatic();
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+void GenericJoint<ConfigSpaceT>::setRelativeJacobianTimeDerivTo(
+    Eigen::Ref<math::Jacobian> J) const
+{
+  J = getRelativeJacobianTimeDerivStatic();
+}
+
 //==============================================================================
 template <class ConfigSpaceT>
 void GenericJoint<ConfigSpaceT>::setPartialAccelerationTo(
@@ -37,6 +37,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <type_traits>
 
 #include <cmath>
 
@@ -68,6 +69,16 @@ const std::string& HeightmapShape<S>::getStaticType()
   return type;
 }
 
+//==============================================================================
+template <typename S>
+Shape::TypeId HeightmapShape<S>::getTypeId() const
+{
+  if constexpr (std::is_same_v<S, float>)
+    return TypeId::Heightmapf;
+  else
+    return TypeId::Heightmapd;
+}
+
 //==============================================================================
 template <typename S>
 void HeightmapShape<S>::setScale(const Vector3& scale)
@@ -39,6 +39,8 @@
 
 #include <Eigen/Core>
 
+#include <cstdint>
+
 namespace dart {
 namespace dynamics {
 
@@ -80,8 +82,19 @@ struct CollisionAspectProperties
   /// This object is collidable if true
   bool mCollidable;
 
+  /// Bits of the collision categories that this object belongs to
+  std::uint32_t mCollisionCategories;
+
+  /// Bits of the collision categories that this object collides with. Two
+  /// objects only collide if each of them belongs to a category of the mask
+  /// of the other.
+  std::uint32_t mCollisionMask;
+
   /// Constructor
-  CollisionAspectProperties(const bool collidable = true);
+  CollisionAspectProperties(
+      const bool collidable = true,
+      const std::uint32_t collisionCategories = 0x1u,
+      const std::uint32_t collisionMask = 0xFFFFFFFFu);
 
   /// Destructor
   virtual ~CollisionAspectProperties() = default;
@@ -43,14 +43,10 @@ template <class NodeType>
 math::Jacobian TemplatedJacobianNode<NodeType>::getJacobian(
     const Frame* _inCoordinatesOf) const
 {
-  if (this == _inCoordinatesOf)
-    return static_cast<const NodeType*>(this)->getJacobian();
-  else if (_inCoordinatesOf->isWorld())
-    return static_cast<const NodeType*>(this)->getWorldJacobian();
-
-  return math::AdRJac(
-      getTransform(_inCoordinatesOf),
-      static_cast<const NodeType*>(this)->getJacobian());
+  math::Jacobian J(6, getNumDependentGenCoords());
+  getJacobian(_inCoordinatesOf, J);
+
+  return J;
 }
 
 //==============================================================================
@@ -58,8 +54,8 @@ template <class NodeType>
 math::Jacobian TemplatedJacobianNode<NodeType>::getJacobian(
     const Eigen::Vector3d& _offset) const
 {
-  math::Jacobian J = static_cast<const NodeType*>(this)->getJacobian();
-  J.bottomRows<3>() += J.topRows<3>().colwise().cross(_offset);
+  math::Jacobian J(6, getNumDependentGenCoords());
+  getJacobian(_offset, this, J);
 
   return J;
 }
@@ -69,15 +65,10 @@ template <class NodeType>
 math::Jacobian TemplatedJacobianNode<NodeType>::getJacobian(
     const Eigen::Vector3d& _offset, const Frame* _inCoordinatesOf) const
 {
-  if (this == _inCoordinatesOf)
-    return getJacobian(_offset);
-  else if (_inCoordinatesOf->isWorld())
-    return getWorldJacobian(_offset);
-
-  Eigen::Isometry3d T = getTransform(_inCoordinatesOf);
-  T.translation() = -T.linear() * _offset;
+  math::Jacobian J(6, getNumDependentGenCoords());
+  getJacobian(_offset, _inCoordinatesOf, J);
 
-  return math::AdTJac(T, static_cast<const NodeType*>(this)->getJacobian());
+  return J;
 }
 
 //==============================================================================
@@ -85,9 +76,8 @@ template <class NodeType>
 math::Jacobian TemplatedJacobianNode<NodeType>::getWorldJacobian(
     const Eigen::Vector3d& _offset) const
 {
-  math::Jacobian J = static_cast<const NodeType*>(this)->getWorldJacobian();
-  J.bottomRows<3>()
-      += J.topRows<3>().colwise().cross(getWorldTransform().linear() * _offset);
+  math::Jacobian J(6, getNumDependentGenCoords());
+  getWorldJacobian(_offset, J);
 
   return J;
 }
@@ -97,20 +87,10 @@ template <class NodeType>
 math::LinearJacobian TemplatedJacobianNode<NodeType>::getLinearJacobian(
     const Frame* _inCoordinatesOf) const
 {
-  if (this == _inCoordinatesOf) {
-    const math::Jacobian& J = static_cast<const NodeType*>(this)->getJacobian();
-
-    return J.bottomRows<3>();
-  } else if (_inCoordinatesOf->isWorld()) {
-    const math::Jacobian& JWorld
-        = static_cast<const NodeType*>(this)->getWorldJacobian();
+  math::LinearJacobian J(3, getNumDependentGenCoords());
+  getLinearJacobian(_inCoordinatesOf, J);
 
-    return JWorld.bottomRows<3>();
-  }
-
-  const math::Jacobian& J = static_cast<const NodeType*>(this)->getJacobian();
-
-  return getTransform(_inCoordinatesOf).linear() * J.bottomRows<3>();
+  return J;
 }
 
 //==============================================================================
@@ -118,15 +98,10 @@ template <class NodeType>
 math::LinearJacobian TemplatedJacobianNode<NodeType>::getLinearJacobian(
     const Eigen::Vector3d& _offset, const Frame* _inCoordinatesOf) const
 {
-  const math::Jacobian& J = static_cast<const NodeType*>(this)->getJacobian();
-
-  math::LinearJacobian JLinear;
-  JLinear = J.bottomRows<3>() + J.topRows<3>().colwise().cross(_offset);
+  math::LinearJacobian J(3, getNumDependentGenCoords());
+  getLinearJacobian(_offset, _inCoordinatesOf, J);
 
-  if (this == _inCoordinatesOf)
-    return JLinear;
-
-  return getTransform(_inCoordinatesOf).linear() * JLinear;
+  return J;
 }
 
 //==============================================================================
@@ -134,18 +109,10 @@ template <class NodeType>
 math::AngularJacobian TemplatedJacobianNode<NodeType>::getAngularJacobian(
     const Frame* _inCoordinatesOf) const
 {
-  if (this == _inCoordinatesOf) {
-    const math::Jacobian& J = static_cast<const NodeType*>(this)->getJacobian();
-    return J.topRows<3>();
-  } else if (_inCoordinatesOf->isWorld()) {
-    const math::Jacobian& JWorld
-        = static_cast<const NodeType*>(this)->getWorldJacobian();
-    return JWorld.topRows<3>();
-  }
+  math::AngularJacobian J(3, getNumDependentGenCoords());
+  getAngularJacobian(_inCoordinatesOf, J);
 
-  const math::Jacobian& J = static_cast<const NodeType*>(this)->getJacobian();
-
-  return getTransform(_inCoordinatesOf).linear() * J.topRows<3>();
+  return J;
 }
 
 //==============================================================================
@@ -153,12 +120,10 @@ template <class NodeType>
 math::Jacobian TemplatedJacobianNode<NodeType>::getJacobianSpatialDeriv(
     const Frame* _inCoordinatesOf) const
 {
-  if (this == _inCoordinatesOf)
-    return static_cast<const NodeType*>(this)->getJacobianSpatialDeriv();
+  math::Jacobian J_d(6, getNumDependentGenCoords());
+  getJacobianSpatialDeriv(_inCoordinatesOf, J_d);
 
-  return math::AdRJac(
-      getTransform(_inCoordinatesOf),
-      static_cast<const NodeType*>(this)->getJacobianSpatialDeriv());
+  return J_d;
 }
 
 //==============================================================================
@@ -166,10 +131,8 @@ template <class NodeType>
 math::Jacobian TemplatedJacobianNode<NodeType>::getJacobianSpatialDeriv(
     const Eigen::Vector3d& _offset) const
 {
-  math::Jacobian J_d
-      = static_cast<const NodeType*>(this)->getJacobianSpatialDeriv();
-
-  J_d.bottomRows<3>() += J_d.topRows<3>().colwise().cross(_offset);
+  math::Jacobian J_d(6, getNumDependentGenCoords());
+  getJacobianSpatialDeriv(_offset, this, J_d);
 
   return J_d;
 }
@@ -179,14 +142,10 @@ template <class NodeType>
 math::Jacobian TemplatedJacobianNode<NodeType>::getJacobianSpatialDeriv(
     const Eigen::Vector3d& _offset, const Frame* _inCoordinatesOf) const
 {
-  if (this == _inCoordinatesOf)
-    return getJacobianSpatialDeriv(_offset);
-
-  Eigen::Isometry3d T = getTransform(_inCoordinatesOf);
-  T.translation() = T.linear() * -_offset;
+  math::Jacobian J_d(6, getNumDependentGenCoords());
+  getJacobianSpatialDeriv(_offset, _inCoordinatesOf, J_d);
 
-  return math::AdTJac(
-      T, static_cast<const NodeType*>(this)->getJacobianSpatialDeriv());
+  return J_d;
 }
 
 //==============================================================================
@@ -194,12 +153,10 @@ template <class NodeType>
 math::Jacobian TemplatedJacobianNode<NodeType>::getJacobianClassicDeriv(
     const Frame* _inCoordinatesOf) const
 {
-  if (_inCoordinatesOf->isWorld())
-    return static_cast<const NodeType*>(this)->getJacobianClassicDeriv();
+  math::Jacobian J_d(6, getNumDependentGenCoords());
+  getJacobianClassicDeriv(_inCoordinatesOf, J_d);
 
-  return math::AdRInvJac(
-      _inCoordinatesOf->getWorldTransform(),
-      static_cast<const NodeType*>(this)->getJacobianClassicDeriv());
+  return J_d;
 }
 
 //==============================================================================
@@ -207,75 +164,349 @@ template <class NodeType>
 math::Jacobian TemplatedJacobianNode<NodeType>::getJacobianClassicDeriv(
     const Eigen::Vector3d& _offset, const Frame* _inCoordinatesOf) const
 {
-  math::Jacobian J_d
-      = static_cast<const NodeType*>(this)->getJacobianClassicDeriv();
+  math::Jacobian J_d(6, getNumDependentGenCoords());
+  getJacobianClassicDeriv(_offset, _inCoordinatesOf, J_d);
 
-  const math::Jacobian& J
-      = static_cast<const NodeType*>(this)->getWorldJacobian();
+  return J_d;
+}
 
-  const Eigen::Vector3d& w = getAngularVelocity();
-  const Eigen::Vector3d& p = (getWorldTransform().linear() * _offset).eval();
+//==============================================================================
+template <class NodeType>
+math::LinearJacobian TemplatedJacobianNode<NodeType>::getLinearJacobianDeriv(
+    const Frame* _inCoordinatesOf) const
+{
+  math::LinearJacobian J_d(3, getNumDependentGenCoords());
+  getLinearJacobianDeriv(_inCoordinatesOf, J_d);
 
-  J_d.bottomRows<3>() += J_d.topRows<3>().colwise().cross(p)
-                         + J.topRows<3>().colwise().cross(w.cross(p));
+  return J_d;
+}
 
-  if (_inCoordinatesOf->isWorld())
-    return J_d;
+//==============================================================================
+template <class NodeType>
+math::LinearJacobian TemplatedJacobianNode<NodeType>::getLinearJacobianDeriv(
+    const Eigen::Vector3d& _offset, const Frame* _inCoordinatesOf) const
+{
+  math::LinearJacobian J_d(3, getNumDependentGenCoords());
+  getLinearJacobianDeriv(_offset, _inCoordinatesOf, J_d);
 
-  return math::AdRInvJac(_inCoordinatesOf->getWorldTransform(), J_d);
+  return J_d;
 }
 
 //==============================================================================
 template <class NodeType>
-math::LinearJacobian TemplatedJacobianNode<NodeType>::getLinearJacobianDeriv(
+math::AngularJacobian TemplatedJacobianNode<NodeType>::getAngularJacobianDeriv(
     const Frame* _inCoordinatesOf) const
+{
+  math::AngularJacobian J_d(3, getNumDependentGenCoords());
+  getAngularJacobianDeriv(_inCoordinatesOf, J_d);
+
+  return J_d;
+}
+
+//==============================================================================
+template <class NodeType>
+void TemplatedJacobianNode<NodeType>::getJacobian(
+    const Frame* inCoordinatesOf, Eigen::Ref<math::Jacobian> J) const
+{
+  const NodeType* node = static_cast<const NodeType*>(this);
+
+  if (this == inCoordinatesOf) {
+    J = node->getJacobian();
+    return;
+  } else if (inCoordinatesOf->isWorld()) {
+    J = node->getWorldJacobian();
+    return;
+  }
+
+  const math::Jacobian& JBody = node->getJacobian();
+  const Eigen::Isometry3d T = getTransform(inCoordinatesOf);
+
+  assert(J.cols() == JBody.cols());
+  for (Eigen::Index i = 0; i < JBody.cols(); ++i)
+    J.col(i) = math::AdR(T, JBody.col(i));
+}
+
+//==============================================================================
+template <class NodeType>
+void TemplatedJacobianNode<NodeType>::getJacobian(
+    const Eigen::Vector3d& offset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  const NodeType* node = static_cast<const NodeType*>(this);
+
+  if (this == inCoordinatesOf) {
+    J = node->getJacobian();
+    for (Eigen::Index i = 0; i < J.cols(); ++i)
+      J.col(i).tail<3>() += J.col(i).head<3>().cross(offset);
+    return;
+  } else if (inCoordinatesOf->isWorld()) {
+    getWorldJacobian(offset, J);
+    return;
+  }
+
+  const math::Jacobian& JBody = node->getJacobian();
+  Eigen::Isometry3d T = getTransform(inCoordinatesOf);
+  T.translation() = -T.linear() * offset;
+
+  assert(J.cols() == JBody.cols());
+  for (Eigen::Index i = 0; i < JBody.cols(); ++i)
+    J.col(i) = math::AdT(T, JBody.col(i));
+}
+
+//==============================================================================
+template <class NodeType>
+void TemplatedJacobianNode<NodeType>::getWorldJacobian(
+    const Eigen::Vector3d& offset, Eigen::Ref<math::Jacobian> J) const
+{
+  J = static_cast<const NodeType*>(this)->getWorldJacobian();
+
+  const Eigen::Vector3d p = getWorldTransform().linear() * offset;
+  for (Eigen::Index i = 0; i < J.cols(); ++i)
+    J.col(i).tail<3>() += J.col(i).head<3>().cross(p);
+}
+
+//==============================================================================
+template <class NodeType>
+void TemplatedJacobianNode<NodeType>::getLinearJacobian(
+    const Frame* inCoordinatesOf, Eigen::Ref<math::LinearJacobian> J) const
+{
+  const NodeType* node = static_cast<const NodeType*>(this);
+
+  if (this == inCoordinatesOf) {
+    J = node->getJacobian().template bottomRows<3>();
+    return;
+  } else if (inCoordinatesOf->isWorld()) {
+    J = node->getWorldJacobian().template bottomRows<3>();
+    return;
+  }
+
+  const math::Jacobian& JBody = node->getJacobian();
+  const Eigen::Matrix3d R = getTransform(inCoordinatesOf).linear();
+
+  assert(J.cols() == JBody.cols());
+  for (Eigen::Index i = 0; i < JBody.cols(); ++i)
+    J.col(i) = R * JBody.col(i).tail<3>();
+}
+
+//==============================================================================
+template <class NodeType>
+void TemplatedJacobianNode<NodeType>::getLinearJacobian(
+    const Eigen::Vector3d& offset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::LinearJacobian> J) const
+{
+  const math::Jacobian& JBody
+      = static_cast<const NodeType*>(this)->getJacobian();
+
+  assert(J.cols() == JBody.cols());
+  for (Eigen::Index i = 0; i < JBody.cols(); ++i) {
+    J.col(i) = JBody.col(i).tail<3>()
+               + JBody.col(i).head<3>().cross(offset);
+  }
+
+  if (this == inCoordinatesOf)
+    return;
+
+  const Eigen::Matrix3d R = getTransform(inCoordinatesOf).linear();
+  for (Eigen::Index i = 0; i < J.cols(); ++i)
+    J.col(i) = R * J.col(i);
+}
+
+//==============================================================================
+template <class NodeType>
+void TemplatedJacobianNode<NodeType>::getAngularJacobian(
+    const Frame* inCoordinatesOf, Eigen::Ref<math::AngularJacobian> J) const
+{
+  const NodeType* node = static_cast<const NodeType*>(this);
+
+  if (this == inCoordinatesOf) {
+    J = node->getJacobian().template topRows<3>();
+    return;
+  } else if (inCoordinatesOf->isWorld()) {
+    J = node->getWorldJacobian().template topRows<3>();
+    return;
+  }
+
+  const math::Jacobian& JBody = node->getJacobian();
+  const Eigen::Matrix3d R = getTransform(inCoordinatesOf).linear();
+
+  assert(J.cols() == JBody.cols());
+  for (Eigen::Index i = 0; i < JBody.cols(); ++i)
+    J.col(i) = R * JBody.col(i).head<3>();
+}
+
+//==============================================================================
+template <class NodeType>
+void TemplatedJacobianNode<NodeType>::getJacobianSpatialDeriv(
+    const Frame* inCoordinatesOf, Eigen::Ref<math::Jacobian> J) const
+{
+  const math::Jacobian& J_d
+      = static_cast<const NodeType*>(this)->getJacobianSpatialDeriv();
+
+  if (this == inCoordinatesOf) {
+    J = J_d;
+    return;
+  }
+
+  const Eigen::Isometry3d T = getTransform(inCoordinatesOf);
+
+  assert(J.cols() == J_d.cols());
+  for (Eigen::Index i = 0; i < J_d.cols(); ++i)
+    J.col(i) = math::AdR(T, J_d.col(i));
+}
+
+//==============================================================================
+template <class NodeType>
+void TemplatedJacobianNode<NodeType>::getJacobianSpatialDeriv(
+    const Eigen::Vector3d& offset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  const math::Jacobian& J_d
+      = static_cast<const NodeType*>(this)->getJacobianSpatialDeriv();
+
+  if (this == inCoordinatesOf) {
+    J = J_d;
+    for (Eigen::Index i = 0; i < J.cols(); ++i)
+      J.col(i).tail<3>() += J.col(i).head<3>().cross(offset);
+    return;
+  }
+
+  Eigen::Isometry3d T = getTransform(inCoordinatesOf);
+  T.translation() = T.linear() * -offset;
+
+  assert(J.cols() == J_d.cols());
+  for (Eigen::Index i = 0; i < J_d.cols(); ++i)
+    J.col(i) = math::AdT(T, J_d.col(i));
+}
+
+//==============================================================================
+template <class NodeType>
+void TemplatedJacobianNode<NodeType>::getJacobianClassicDeriv(
+    const Frame* inCoordinatesOf, Eigen::Ref<math::Jacobian> J) const
 {
   const math::Jacobian& J_d
       = static_cast<const NodeType*>(this)->getJacobianClassicDeriv();
 
-  if (_inCoordinatesOf->isWorld())
-    return J_d.bottomRows<3>();
+  if (inCoordinatesOf->isWorld()) {
+    J = J_d;
+    return;
+  }
+
+  const Eigen::Matrix3d RT
+      = inCoordinatesOf->getWorldTransform().linear().transpose();
 
-  return _inCoordinatesOf->getWorldTransform().linear().transpose()
-         * J_d.bottomRows<3>();
+  assert(J.cols() == J_d.cols());
+  for (Eigen::Index i = 0; i < J_d.cols(); ++i) {
+    J.col(i).head<3>() = RT * J_d.col(i).head<3>();
+    J.col(i).tail<3>() = RT * J_d.col(i).tail<3>();
+  }
 }
 
 //==============================================================================
 template <class NodeType>
-math::LinearJacobian TemplatedJacobianNode<NodeType>::getLinearJacobianDeriv(
-    const Eigen::Vector3d& _offset, const Frame* _inCoordinatesOf) const
+void TemplatedJacobianNode<NodeType>::getJacobianClassicDeriv(
+    const Eigen::Vector3d& offset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::Jacobian> J) const
+{
+  const NodeType* node = static_cast<const NodeType*>(this);
+  const math::Jacobian& J_d = node->getJacobianClassicDeriv();
+  const math::Jacobian& JWorld = node->getWorldJacobian();
+
+  const Eigen::Vector3d& w = getAngularVelocity();
+  const Eigen::Vector3d p = getWorldTransform().linear() * offset;
+  const Eigen::Vector3d wxp = w.cross(p);
+
+  J = J_d;
+  for (Eigen::Index i = 0; i < J.cols(); ++i) {
+    J.col(i).tail<3>() += J.col(i).head<3>().cross(p)
+                          + JWorld.col(i).head<3>().cross(wxp);
+  }
+
+  if (inCoordinatesOf->isWorld())
+    return;
+
+  const Eigen::Matrix3d RT
+      = inCoordinatesOf->getWorldTransform().linear().transpose();
+  for (Eigen::Index i = 0; i < J.cols(); ++i) {
+    J.col(i).head<3>() = RT * J.col(i).head<3>();
+    J.col(i).tail<3>() = RT * J.col(i).tail<3>();
+  }
+}
+
+//==============================================================================
+template <class NodeType>
+void TemplatedJacobianNode<NodeType>::getLinearJacobianDeriv(
+    const Frame* inCoordinatesOf, Eigen::Ref<math::LinearJacobian> J) const
 {
   const math::Jacobian& J_d
       = static_cast<const NodeType*>(this)->getJacobianClassicDeriv();
 
-  const math::Jacobian& J
-      = static_cast<const NodeType*>(this)->getWorldJacobian();
+  if (inCoordinatesOf->isWorld()) {
+    J = J_d.bottomRows<3>();
+    return;
+  }
+
+  const Eigen::Matrix3d RT
+      = inCoordinatesOf->getWorldTransform().linear().transpose();
+
+  assert(J.cols() == J_d.cols());
+  for (Eigen::Index i = 0; i < J_d.cols(); ++i)
+    J.col(i) = RT * J_d.col(i).tail<3>();
+}
+
+//==============================================================================
+template <class NodeType>
+void TemplatedJacobianNode<NodeType>::getLinearJacobianDeriv(
+    const Eigen::Vector3d& offset,
+    const Frame* inCoordinatesOf,
+    Eigen::Ref<math::LinearJacobian> J) const
+{
+  const NodeType* node = static_cast<const NodeType*>(this);
+  const math::Jacobian& J_d = node->getJacobianClassicDeriv();
+  const math::Jacobian& JWorld = node->getWorldJacobian();
 
   const Eigen::Vector3d& w = getAngularVelocity();
-  const Eigen::Vector3d& p = (getWorldTransform().linear() * _offset).eval();
+  const Eigen::Vector3d p = getWorldTransform().linear() * offset;
+  const Eigen::Vector3d wxp = w.cross(p);
+
+  assert(J.cols() == J_d.cols());
+  for (Eigen::Index i = 0; i < J_d.cols(); ++i) {
+    J.col(i) = J_d.col(i).tail<3>()
+               + J_d.col(i).head<3>().cross(p)
+               + JWorld.col(i).head<3>().cross(wxp);
+  }
 
-  if (_inCoordinatesOf->isWorld())
-    return J_d.bottomRows<3>() + J_d.topRows<3>().colwise().cross(p)
-           + J.topRows<3>().colwise().cross(w.cross(p));
+  if (inCoordinatesOf->isWorld())
+    return;
 
-  return _inCoordinatesOf->getWorldTransform().linear().transpose()
-         * (J_d.bottomRows<3>() + J_d.topRows<3>().colwise().cross(p)
-            + J.topRows<3>().colwise().cross(w.cross(p)));
+  const Eigen::Matrix3d RT
+      = inCoordinatesOf->getWorldTransform().linear().transpose();
+  for (Eigen::Index i = 0; i < J.cols(); ++i)
+    J.col(i) = RT * J.col(i);
 }
 
 //==============================================================================
 template <class NodeType>
-math::AngularJacobian TemplatedJacobianNode<NodeType>::getAngularJacobianDeriv(
-    const Frame* _inCoordinatesOf) const
+void TemplatedJacobianNode<NodeType>::getAngularJacobianDeriv(
+    const Frame* inCoordinatesOf, Eigen::Ref<math::AngularJacobian> J) const
 {
   const math::Jacobian& J_d
       = static_cast<const NodeType*>(this)->getJacobianClassicDeriv();
 
-  if (_inCoordinatesOf->isWorld())
-    return J_d.topRows<3>();
+  if (inCoordinatesOf->isWorld()) {
+    J = J_d.topRows<3>();
+    return;
+  }
+
+  const Eigen::Matrix3d RT
+      = inCoordinatesOf->getWorldTransform().linear().transpose();
 
-  return _inCoordinatesOf->getWorldTransform().linear().transpose()
-         * J_d.topRows<3>();
+  assert(J.cols() == J_d.cols());
+  for (Eigen::Index i = 0; i < J_d.cols(); ++i)
+    J.col(i) = RT * J_d.col(i).head<3>();
 }
 
 //==============================================================================
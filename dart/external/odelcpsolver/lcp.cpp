@@ -782,7 +782,8 @@ void dLCP::unpermute()
 // an optimized Dantzig LCP driver routine for the lo-hi LCP problem.
 
 bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
-                dReal *outer_w/*=nullptr*/, int nub, dReal *lo, dReal *hi, int *findex, bool earlyTermination)
+                dReal *outer_w/*=nullptr*/, int nub, dReal *lo, dReal *hi, int *findex, bool earlyTermination,
+                void *tmpbuf/*=nullptr*/)
 {
   dAASSERT (n>0 && A && x && b && lo && hi && nub >= 0 && nub <= n);
 # ifndef dNODEBUG
@@ -796,7 +797,7 @@ bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
   // if all the variables are unbounded then we can just factor, solve,
   // and return
   if (nub >= n) {
-    dReal *d = new dReal[n];
+    dReal *d = tmpbuf ? (dReal *)tmpbuf : new dReal[n];
     dSetZero (d, n);
 
     int nskip = dPAD(n);
@@ -804,28 +805,48 @@ bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
     dSolveLDLT (A, d, b, n, nskip);
     memcpy (x, b, n*sizeof(dReal));
 
-    delete[] d;
+    if (!tmpbuf)
+      delete[] d;
     return true;
   }
 
+  // tmpbuf, when given, holds at least dEstimateSolveLCPMemoryReq(n, outer_w
+  // != nullptr) bytes. it is carved up from the widest type to the narrowest
+  // one so that every array stays aligned for its type
+  char *buf = (char *)tmpbuf;
   const int nskip = dPAD(n);
-  dReal *L = new dReal[ (n*nskip)];
-  dReal *d = new dReal[ (n)];
-  dReal *w = outer_w ? outer_w : (new dReal[n]);
-  dReal *delta_w = new dReal[ (n)];
-  dReal *delta_x = new dReal[ (n)];
-  dReal *Dell = new dReal[ (n)];
-  dReal *ell = new dReal[ (n)];
+  dReal *L = buf ? (dReal *)buf : new dReal[ (n*nskip)];
+  if (buf) buf += sizeof(dReal) * (n * nskip);
+  dReal *d = buf ? (dReal *)buf : new dReal[ (n)];
+  if (buf) buf += sizeof(dReal) * n;
+  dReal *delta_w = buf ? (dReal *)buf : new dReal[ (n)];
+  if (buf) buf += sizeof(dReal) * n;
+  dReal *delta_x = buf ? (dReal *)buf : new dReal[ (n)];
+  if (buf) buf += sizeof(dReal) * n;
+  dReal *Dell = buf ? (dReal *)buf : new dReal[ (n)];
+  if (buf) buf += sizeof(dReal) * n;
+  dReal *ell = buf ? (dReal *)buf : new dReal[ (n)];
+  if (buf) buf += sizeof(dReal) * n;
+  dReal *w = outer_w ? outer_w : (buf ? (dReal *)buf : new dReal[n]);
+  if (buf && !outer_w) buf += sizeof(dReal) * n;
 #ifdef ROWPTRS
-  dReal **Arows = new dReal* [n];
+  dReal **Arows = buf ? (dReal **)buf : new dReal* [n];
+  if (buf) buf += sizeof(dReal *) * n;
 #else
   dReal **Arows = nullptr;
 #endif
-  int *p = new int[n];
-  int *C = new int[n];
+  int *p = buf ? (int *)buf : new int[n];
+  if (buf) buf += sizeof(int) * n;
+  int *C = buf ? (int *)buf : new int[n];
+  if (buf) buf += sizeof(int) * n;
+
+  // scratch memory of transfer_i_from_C_to_N, which falls back to the stack
+  // when tmpbuf is not given
+  void *transfer_tmpbuf = buf;
+  if (buf) buf += dLCP::estimate_transfer_i_from_C_to_N_mem_req(n, nskip);
 
   // for i in N, state[i] is 0 if x(i)==lo(i) or 1 if x(i)==hi(i)
-  bool *state = new bool[n];
+  bool *state = buf ? (bool *)buf : new bool[n];
 
   // create LCP object. note that tmp is set to delta_w to save space, this
   // optimization relies on knowledge of how tmp is used, so be careful!
@@ -1011,21 +1032,23 @@ bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
         if (s <= REAL(0.0)) {
 
           if (earlyTermination) {
-            if (!outer_w)
-              delete[] w;
-            delete[] L;
-            delete[] d;
-            delete[] delta_w;
-            delete[] delta_x;
-            delete[] Dell;
-            delete[] ell;
-          #ifdef ROWPTRS
-            delete[] Arows;
-          #endif
-            delete[] p;
-            delete[] C;
-
-            delete[] state;
+            if (!tmpbuf) {
+              if (!outer_w)
+                delete[] w;
+              delete[] L;
+              delete[] d;
+              delete[] delta_w;
+              delete[] delta_x;
+              delete[] Dell;
+              delete[] ell;
+            #ifdef ROWPTRS
+              delete[] Arows;
+            #endif
+              delete[] p;
+              delete[] C;
+
+              delete[] state;
+            }
 
             return false;
           }
@@ -1078,12 +1101,12 @@ bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
         case 5:		// keep going
           x[si] = lo[si];
           state[si] = false;
-          lcp.transfer_i_from_C_to_N (si, nullptr);
+          lcp.transfer_i_from_C_to_N (si, transfer_tmpbuf);
           break;
         case 6:		// keep going
           x[si] = hi[si];
           state[si] = true;
-          lcp.transfer_i_from_C_to_N (si, nullptr);
+          lcp.transfer_i_from_C_to_N (si, transfer_tmpbuf);
           break;
         }
 
@@ -1098,21 +1121,23 @@ bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
 
   lcp.unpermute();
 
-  if (!outer_w)
-	  delete[] w;
-  delete[] L;
-  delete[] d;
-  delete[] delta_w;
-  delete[] delta_x;
-  delete[] Dell;
-  delete[] ell;
-#ifdef ROWPTRS
-  delete[] Arows;
-#endif
-  delete[] p;
-  delete[] C;
-
-  delete[] state;
+  if (!tmpbuf) {
+    if (!outer_w)
+      delete[] w;
+    delete[] L;
+    delete[] d;
+    delete[] delta_w;
+    delete[] delta_x;
+    delete[] Dell;
+    delete[] ell;
+  #ifdef ROWPTRS
+    delete[] Arows;
+  #endif
+    delete[] p;
+    delete[] C;
+
+    delete[] state;
+  }
 
   return true;
 }
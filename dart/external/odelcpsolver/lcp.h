@@ -62,7 +62,8 @@ namespace external {
 namespace ode {
 
 bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b, dReal *w,
-  int nub, dReal *lo, dReal *hi, int *findex, bool earlyTermination = false);
+  int nub, dReal *lo, dReal *hi, int *findex, bool earlyTermination = false,
+  void *tmpbuf = nullptr);
 
 size_t dEstimateSolveLCPMemoryReq(int n, bool outer_w_avail);
 
@@ -1472,7 +1472,7 @@ bool verifyRotation(const Eigen::Matrix3d& _T)
 
 bool verifyTransform(const Eigen::Isometry3d& _T)
 {
-  return !isNan(_T.matrix().topRows<3>())
+  return !_T.matrix().topRows<3>().hasNaN()
          && std::abs(_T.linear().determinant() - 1.0) <= DART_EPSILON;
 }
 
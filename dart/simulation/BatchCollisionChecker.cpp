@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "dart/simulation/BatchCollisionChecker.hpp"
+
+#include "dart/collision/CollisionDetector.hpp"
+#include "dart/collision/CollisionFilter.hpp"
+#include "dart/collision/CollisionGroup.hpp"
+#include "dart/common/Console.hpp"
+#include "dart/common/Profile.hpp"
+#include "dart/common/ThreadPool.hpp"
+#include "dart/constraint/ConstraintSolver.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/simulation/World.hpp"
+
+#include <cassert>
+
+namespace dart {
+namespace simulation {
+
+//==============================================================================
+struct BatchCollisionChecker::Replica
+{
+  /// Returns true if the checked skeleton is free of collisions at mPositions
+  bool check();
+
+  /// Returns the replica of skeleton worldIndex of the world, where
+  /// skeletonIndex is the index of the checked skeleton
+  dynamics::Skeleton* getSkeleton(
+      std::size_t worldIndex, std::size_t skeletonIndex) const;
+
+  /// Copies the blacklist of filter, whose BodyNodes belong to world, onto
+  /// mFilter with the corresponding BodyNodes of the replicas
+  void copyBlackList(
+      const World& world,
+      std::size_t skeletonIndex,
+      const collision::BodyNodeCollisionFilter& filter);
+
+  /// Replica of the checked skeleton
+  dynamics::SkeletonPtr mSkeleton;
+
+  /// Replicas of the other skeletons of the world
+  std::vector<dynamics::SkeletonPtr> mEnvironment;
+
+  /// Collision detector that owns the collision objects of the replicas
+  collision::CollisionDetectorPtr mCollisionDetector;
+
+  /// Collision group of the checked skeleton
+  std::unique_ptr<collision::CollisionGroup> mSkeletonGroup;
+
+  /// Collision group of the other skeletons
+  std::unique_ptr<collision::CollisionGroup> mEnvironmentGroup;
+
+  /// Filter of mOption
+  std::shared_ptr<collision::BodyNodeCollisionFilter> mFilter;
+
+  /// Option that stops at the first contact
+  collision::CollisionOption mOption;
+
+  /// Configuration to check
+  Eigen::VectorXd mPositions;
+};
+
+//==============================================================================
+bool BatchCollisionChecker::Replica::check()
+{
+  mSkeleton->setPositions(mPositions);
+
+  if (mSkeletonGroup->collide(mEnvironmentGroup.get(), mOption))
+    return false;
+
+  if (mSkeleton->isEnabledSelfCollisionCheck()
+      && mSkeletonGroup->collide(mOption))
+    return false;
+
+  return true;
+}
+
+//==============================================================================
+dynamics::Skeleton* BatchCollisionChecker::Replica::getSkeleton(
+    std::size_t worldIndex, std::size_t skeletonIndex) const
+{
+  if (worldIndex == skeletonIndex)
+    return mSkeleton.get();
+
+  // The checked skeleton is left out of the environment
+  return mEnvironment[worldIndex < skeletonIndex ? worldIndex : worldIndex - 1u]
+      .get();
+}
+
+//==============================================================================
+void BatchCollisionChecker::Replica::copyBlackList(
+    const World& world,
+    std::size_t skeletonIndex,
+    const collision::BodyNodeCollisionFilter& filter)
+{
+  const auto getReplica
+      = [&](const dynamics::BodyNode* bodyNode) -> dynamics::BodyNode* {
+    for (std::size_t i = 0; i < world.getNumSkeletons(); ++i) {
+      if (world.getSkeleton(i) == bodyNode->getSkeleton()) {
+        return getSkeleton(i, skeletonIndex)
+            ->getBodyNode(bodyNode->getIndexInSkeleton());
+      }
+    }
+
+    return nullptr;
+  };
+
+  mFilter->removeAllBodyNodePairsFromBlackList();
+  for (const auto& pair : filter.getBodyNodePairsInBlackList()) {
+    // BodyNodes of skeletons that are not in the world have no replicas
+    const auto* bodyNode1 = getReplica(pair.first);
+    const auto* bodyNode2 = getReplica(pair.second);
+    if (bodyNode1 && bodyNode2)
+      mFilter->addBodyNodePairToBlackList(bodyNode1, bodyNode2);
+  }
+}
+
+namespace {
+
+//==============================================================================
+/// Returns the collision filter of the world if it is a
+/// BodyNodeCollisionFilter, whose blacklist the replicas copy
+const collision::BodyNodeCollisionFilter* getBodyNodeCollisionFilter(
+    const World& world)
+{
+  const auto& filter
+      = world.getConstraintSolver()->getCollisionOption().collisionFilter;
+  const auto* bodyNodeFilter
+      = dynamic_cast<const collision::BodyNodeCollisionFilter*>(filter.get());
+  if (filter && !bodyNodeFilter) {
+    dtwarn << "[BatchCollisionChecker] The collision filter of the world is "
+           << "not a BodyNodeCollisionFilter, so it is not replicated.\n";
+  }
+
+  return bodyNodeFilter;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+BatchCollisionChecker::BatchCollisionChecker(
+    const World& world, std::size_t skeletonIndex, std::size_t numThreads)
+  : mThreadPool(std::make_unique<common::ThreadPool>(numThreads)),
+    mSkeletonIndex(skeletonIndex),
+    mNumDofs(0)
+{
+  assert(skeletonIndex < world.getNumSkeletons());
+
+  const auto skeleton = world.getSkeleton(skeletonIndex);
+  const auto collisionDetector
+      = world.getConstraintSolver()->getCollisionDetector();
+  const auto* filter = getBodyNodeCollisionFilter(world);
+  mNumDofs = skeleton->getNumDofs();
+
+  mReplicas.reserve(mThreadPool->getNumThreads());
+  for (std::size_t i = 0; i < mThreadPool->getNumThreads(); ++i) {
+    auto replica = std::make_unique<Replica>();
+
+    replica->mCollisionDetector
+        = collisionDetector->cloneWithoutCollisionObjects();
+    replica->mSkeletonGroup
+        = replica->mCollisionDetector->createCollisionGroup();
+    replica->mEnvironmentGroup
+        = replica->mCollisionDetector->createCollisionGroup();
+
+    replica->mSkeleton = skeleton->cloneSkeleton();
+    replica->mSkeletonGroup->addShapeFramesOf(replica->mSkeleton.get());
+
+    for (std::size_t j = 0; j < world.getNumSkeletons(); ++j) {
+      if (j == skeletonIndex)
+        continue;
+
+      auto other = world.getSkeleton(j)->cloneSkeleton();
+      replica->mEnvironmentGroup->addShapeFramesOf(other.get());
+      replica->mEnvironment.push_back(std::move(other));
+    }
+
+    replica->mFilter = std::make_shared<collision::BodyNodeCollisionFilter>();
+    if (filter)
+      replica->copyBlackList(world, skeletonIndex, *filter);
+    replica->mOption = collision::CollisionOption(false, 1u, replica->mFilter);
+    replica->mPositions = skeleton->getPositions();
+
+    // The replicas share their shapes with the world. Checking once here
+    // computes the data that shapes cache lazily, such as bounding boxes, so
+    // that the threads only read it.
+    replica->check();
+
+    mReplicas.push_back(std::move(replica));
+  }
+}
+
+//==============================================================================
+BatchCollisionChecker::~BatchCollisionChecker()
+{
+  // Do nothing
+}
+
+//==============================================================================
+void BatchCollisionChecker::updateEnvironment(const World& world)
+{
+  assert(world.getNumSkeletons() == mReplicas[0]->mEnvironment.size() + 1u);
+
+  const auto* filter = getBodyNodeCollisionFilter(world);
+
+  for (auto& replica : mReplicas) {
+    for (std::size_t i = 0; i < world.getNumSkeletons(); ++i) {
+      if (i == mSkeletonIndex)
+        continue;
+
+      replica->getSkeleton(i, mSkeletonIndex)
+          ->setPositions(world.getSkeleton(i)->getPositions());
+    }
+
+    if (filter)
+      replica->copyBlackList(world, mSkeletonIndex, *filter);
+    else
+      replica->mFilter->removeAllBodyNodePairsFromBlackList();
+
+    // Computes the lazily cached data of shapes that changed, as in the
+    // constructor
+    replica->check();
+  }
+}
+
+//==============================================================================
+std::size_t BatchCollisionChecker::getNumDofs() const
+{
+  return mNumDofs;
+}
+
+//==============================================================================
+std::size_t BatchCollisionChecker::getNumThreads() const
+{
+  return mThreadPool->getNumThreads();
+}
+
+//==============================================================================
+bool BatchCollisionChecker::checkValidity(const Eigen::VectorXd& positions)
+{
+  assert(static_cast<std::size_t>(positions.size()) == mNumDofs);
+
+  Replica& replica = *mReplicas[0];
+  replica.mPositions = positions;
+  return replica.check();
+}
+
+//==============================================================================
+std::size_t BatchCollisionChecker::checkValidity(
+    const Eigen::Ref<const Matrix>& positions,
+    std::vector<std::uint64_t>& validity)
+{
+  DART_PROFILE_SCOPED;
+
+  assert(static_cast<std::size_t>(positions.cols()) == mNumDofs);
+
+  const auto numConfigs = static_cast<std::size_t>(positions.rows());
+  mResults.resize(numConfigs);
+
+  mThreadPool->parallelFor(
+      numConfigs, [&](std::size_t index, std::size_t worker) {
+        Replica& replica = *mReplicas[worker];
+        replica.mPositions = positions.row(index).transpose();
+        mResults[index] = replica.check();
+      });
+
+  validity.assign((numConfigs + 63u) / 64u, 0u);
+
+  std::size_t numValid = 0u;
+  for (std::size_t i = 0u; i < numConfigs; ++i) {
+    if (mResults[i]) {
+      validity[i / 64u] |= std::uint64_t(1u) << (i % 64u);
+      ++numValid;
+    }
+  }
+
+  return numValid;
+}
+
+//==============================================================================
+bool BatchCollisionChecker::isValid(
+    const std::vector<std::uint64_t>& validity, std::size_t index)
+{
+  assert(index / 64u < validity.size());
+
+  return (validity[index / 64u] >> (index % 64u)) & 1u;
+}
+
+} // namespace simulation
+} // namespace dart
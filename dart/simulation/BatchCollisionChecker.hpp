@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef DART_SIMULATION_BATCHCOLLISIONCHECKER_HPP_
+#define DART_SIMULATION_BATCHCOLLISIONCHECKER_HPP_
+
+#include <Eigen/Core>
+
+#include <memory>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dart {
+
+namespace common {
+class ThreadPool;
+} // namespace common
+
+namespace simulation {
+
+class World;
+
+/// BatchCollisionChecker checks many configurations of one skeleton of a
+/// world for collisions in parallel, e.g., to validate the samples and edges
+/// of sampling-based motion planners.
+///
+/// Every thread owns a replica of the skeletons of the world with its own
+/// collision detector and collision groups, which are created once and reused
+/// for every check. Checking a configuration only sets the positions of the
+/// replica of the checked skeleton, so the world is never modified and no
+/// lock is taken.
+///
+/// A configuration is valid if the checked skeleton does not collide with the
+/// other skeletons of the world, nor with itself when its self-collision
+/// check is enabled. Collisions among the other skeletons are ignored.
+/// Collisions are filtered by the self-collision and adjacent-body flags of
+/// the skeletons and by the blacklist of the world's collision filter when it
+/// is a BodyNodeCollisionFilter. Other collision filters are not replicated.
+///
+/// The replicas are a snapshot of the world when the checker was created.
+/// Call updateEnvironment() after the other skeletons of the world moved or
+/// the blacklist changed, and create a new checker after skeletons were added
+/// to or removed from the world.
+///
+/// The replicas share their shapes with the world, so the shapes must not be
+/// modified while configurations are being checked.
+class BatchCollisionChecker
+{
+public:
+  /// Matrix with one configuration in each row
+  using Matrix
+      = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+  /// Constructor
+  ///
+  /// \param[in] world: World whose skeletons and collision detector are
+  /// replicated. It is not modified.
+  /// \param[in] skeletonIndex: Index of the skeleton in the world whose
+  /// configurations are checked.
+  /// \param[in] numThreads: Number of threads including the calling thread.
+  /// Zero means the number of hardware threads.
+  BatchCollisionChecker(
+      const World& world,
+      std::size_t skeletonIndex,
+      std::size_t numThreads = 0);
+
+  /// Destructor
+  ~BatchCollisionChecker();
+
+  /// Copies the positions of the other skeletons of the world and the
+  /// blacklist of its collision filter onto the replicas. The world must have
+  /// the same skeletons as when the checker was created. This must not be
+  /// called while configurations are being checked.
+  void updateEnvironment(const World& world);
+
+  /// Returns the number of DOFs of the checked skeleton, which is the number
+  /// of columns of the configurations.
+  std::size_t getNumDofs() const;
+
+  /// Returns the number of threads including the calling thread.
+  std::size_t getNumThreads() const;
+
+  /// Returns true if a single configuration is free of collisions. This runs
+  /// on the calling thread.
+  bool checkValidity(const Eigen::VectorXd& positions);
+
+  /// Checks every row of positions and stores the results as a bitmask: bit
+  /// (i % 64) of validity[i / 64] is set if row i is free of collisions. The
+  /// bitmask is resized to hold one bit per row, and nothing is allocated if
+  /// its size doesn't change.
+  ///
+  /// \return The number of valid configurations.
+  std::size_t checkValidity(
+      const Eigen::Ref<const Matrix>& positions,
+      std::vector<std::uint64_t>& validity);
+
+  /// Returns bit index of a bitmask filled by checkValidity(), i.e., whether
+  /// configuration index is free of collisions.
+  static bool isValid(
+      const std::vector<std::uint64_t>& validity, std::size_t index);
+
+private:
+  /// Skeletons and collision groups of one thread
+  struct Replica;
+
+  // Deletes copy/move constructors and assign/move operators
+  BatchCollisionChecker(const BatchCollisionChecker&) = delete;
+  BatchCollisionChecker(BatchCollisionChecker&&) = delete;
+  BatchCollisionChecker& operator=(const BatchCollisionChecker&) = delete;
+  BatchCollisionChecker& operator=(BatchCollisionChecker&&) = delete;
+
+  /// Pool that checks the configurations
+  std::unique_ptr<common::ThreadPool> mThreadPool;
+
+  /// One replica for each thread of the pool
+  std::vector<std::unique_ptr<Replica>> mReplicas;
+
+  /// Index of the checked skeleton in the world
+  std::size_t mSkeletonIndex;
+
+  /// Number of DOFs of the checked skeleton
+  std::size_t mNumDofs;
+
+  /// Validity of each configuration of the last batch, one byte per
+  /// configuration so that the threads never write to the same word
+  std::vector<char> mResults;
+};
+
+} // namespace simulation
+} // namespace dart
+
+#endif // DART_SIMULATION_BATCHCOLLISIONCHECKER_HPP_
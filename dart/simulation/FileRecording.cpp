@@ -0,0 +1,519 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "dart/simulation/FileRecording.hpp"
+
+#include "dart/common/Console.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace dart {
+namespace simulation {
+
+namespace {
+
+/// Magic bytes at the start of a recording file
+constexpr char recordingMagic[8] = {'D', 'A', 'R', 'T', 'R', 'E', 'C', '1'};
+
+/// Version of the recording format
+constexpr std::uint32_t recordingVersion = 1u;
+
+/// Size of the magic bytes, the version and the number of frames per chunk
+constexpr std::size_t fileHeaderSize = 16u;
+
+/// Size of the number of frames, the number of skeletons and the chunk size
+constexpr std::size_t chunkHeaderSize = 3u * sizeof(std::uint64_t);
+
+//==============================================================================
+template <typename T>
+T readValue(const char* data)
+{
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+//==============================================================================
+template <typename T>
+void writeValue(std::ofstream& stream, T value)
+{
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+//==============================================================================
+/// Returns the size of the chunk that starts at data, or zero if the
+/// remaining size bytes do not hold a complete and consistent chunk.
+std::size_t getChunkSize(const char* data, std::size_t size)
+{
+  constexpr std::size_t word = sizeof(std::uint64_t);
+
+  if (size < chunkHeaderSize)
+    return 0u;
+
+  const auto numFrames = readValue<std::uint64_t>(data);
+  const auto numSkeletons = readValue<std::uint64_t>(data + word);
+  const auto chunkSize = readValue<std::uint64_t>(data + 2u * word);
+
+  if (numFrames == 0u || numFrames >= size / word
+      || numSkeletons >= size / word || chunkSize > size)
+    return 0u;
+
+  const std::size_t tableSize
+      = chunkHeaderSize + (numSkeletons + 1u + numFrames + 1u) * word;
+  if (chunkSize < tableSize)
+    return 0u;
+
+  const char* dofOffsets = data + chunkHeaderSize;
+  const char* frameOffsets = dofOffsets + (numSkeletons + 1u) * word;
+
+  if (readValue<std::uint64_t>(dofOffsets) != 0u)
+    return 0u;
+  for (std::size_t i = 0u; i < numSkeletons; ++i) {
+    if (readValue<std::uint64_t>(dofOffsets + (i + 1u) * word)
+        < readValue<std::uint64_t>(dofOffsets + i * word))
+      return 0u;
+  }
+  const auto numDofs
+      = readValue<std::uint64_t>(dofOffsets + numSkeletons * word);
+
+  // Every frame holds the coordinates followed by six values per contact
+  if (readValue<std::uint64_t>(frameOffsets) != 0u)
+    return 0u;
+  for (std::size_t i = 0u; i < numFrames; ++i) {
+    const auto begin = readValue<std::uint64_t>(frameOffsets + i * word);
+    const auto end = readValue<std::uint64_t>(frameOffsets + (i + 1u) * word);
+    if (end < begin + numDofs || (end - begin - numDofs) % 6u != 0u)
+      return 0u;
+  }
+
+  const auto numValues
+      = readValue<std::uint64_t>(frameOffsets + numFrames * word);
+  if (numValues > size / word || tableSize + numValues * word != chunkSize)
+    return 0u;
+
+  return chunkSize;
+}
+
+} // namespace
+
+//==============================================================================
+FileRecording::FileRecording(
+    const std::string& path,
+    const std::vector<dynamics::SkeletonPtr>& skeletons,
+    std::size_t numFramesPerChunk)
+  : Recording(skeletons),
+    mPath(path),
+    mReadOnly(false),
+    mNumFramesPerChunk(std::max<std::size_t>(numFramesPerChunk, 1u)),
+    mNumWrittenFrames(0u)
+{
+  writeHeader();
+  resetPendingChunk();
+}
+
+//==============================================================================
+FileRecording::FileRecording(const std::string& path)
+  : Recording(std::vector<int>()),
+    mPath(path),
+    mReadOnly(true),
+    mNumFramesPerChunk(1u),
+    mNumWrittenFrames(0u)
+{
+  resetPendingChunk();
+}
+
+//==============================================================================
+std::unique_ptr<FileRecording> FileRecording::open(const std::string& path)
+{
+  std::unique_ptr<FileRecording> recording(new FileRecording(path));
+
+  if (!recording->mFile.open(path)) {
+    dterr << "[FileRecording::open] Failed to open [" << path << "].\n";
+    return nullptr;
+  }
+
+  if (!recording->readChunks()) {
+    dterr << "[FileRecording::open] [" << path
+          << "] is not a recording file.\n";
+    return nullptr;
+  }
+
+  return recording;
+}
+
+//==============================================================================
+FileRecording::~FileRecording()
+{
+  flush();
+}
+
+//==============================================================================
+const std::string& FileRecording::getPath() const
+{
+  return mPath;
+}
+
+//==============================================================================
+bool FileRecording::isReadOnly() const
+{
+  return mReadOnly;
+}
+
+//==============================================================================
+void FileRecording::flush()
+{
+  if (!mReadOnly)
+    writeChunk();
+}
+
+//==============================================================================
+Eigen::Map<const Eigen::VectorXd> FileRecording::getConfigMap(
+    int frameIdx, int skelIdx) const
+{
+  const Frame frame = getFrame(frameIdx);
+  assert(0 <= skelIdx);
+  assert(static_cast<std::size_t>(skelIdx) < frame.mNumSkeletons);
+
+  const auto begin = frame.mDofOffsets[skelIdx];
+  const auto end = frame.mDofOffsets[skelIdx + 1];
+  return Eigen::Map<const Eigen::VectorXd>(
+      frame.mData + begin, static_cast<Eigen::Index>(end - begin));
+}
+
+//==============================================================================
+Eigen::Map<const Eigen::Matrix<double, 6, Eigen::Dynamic>>
+FileRecording::getContactsMap(int frameIdx) const
+{
+  const Frame frame = getFrame(frameIdx);
+  const auto numDofs = frame.mDofOffsets[frame.mNumSkeletons];
+
+  return Eigen::Map<const Eigen::Matrix<double, 6, Eigen::Dynamic>>(
+      frame.mData + numDofs,
+      6,
+      static_cast<Eigen::Index>((frame.mSize - numDofs) / 6u));
+}
+
+//==============================================================================
+int FileRecording::getNumFrames() const
+{
+  return static_cast<int>(
+      mNumWrittenFrames + mPendingFrameOffsets.size() - 1u);
+}
+
+//==============================================================================
+int FileRecording::getNumContacts(int frameIdx) const
+{
+  return static_cast<int>(getContactsMap(frameIdx).cols());
+}
+
+//==============================================================================
+Eigen::VectorXd FileRecording::getConfig(int frameIdx, int skelIdx) const
+{
+  return getConfigMap(frameIdx, skelIdx);
+}
+
+//==============================================================================
+double FileRecording::getGenCoord(int frameIdx, int skelIdx, int dofIdx) const
+{
+  return getConfigMap(frameIdx, skelIdx)[dofIdx];
+}
+
+//==============================================================================
+Eigen::Vector3d FileRecording::getContactPoint(
+    int frameIdx, int contactIdx) const
+{
+  return getContactsMap(frameIdx).col(contactIdx).head<3>();
+}
+
+//==============================================================================
+Eigen::Vector3d FileRecording::getContactForce(
+    int frameIdx, int contactIdx) const
+{
+  return getContactsMap(frameIdx).col(contactIdx).tail<3>();
+}
+
+//==============================================================================
+void FileRecording::clear()
+{
+  if (mReadOnly) {
+    dterr << "[FileRecording::clear] [" << mPath << "] is read-only.\n";
+    return;
+  }
+
+  mChunks.clear();
+  mNumWrittenFrames = 0u;
+  writeHeader();
+  resetPendingChunk();
+}
+
+//==============================================================================
+void FileRecording::addState(const Eigen::VectorXd& state)
+{
+  if (mReadOnly) {
+    dterr << "[FileRecording::addState] [" << mPath << "] is read-only.\n";
+    return;
+  }
+
+  assert(static_cast<std::uint64_t>(state.size()) >= mPendingDofOffsets.back());
+
+  mPendingData.insert(
+      mPendingData.end(), state.data(), state.data() + state.size());
+  mPendingFrameOffsets.push_back(mPendingData.size());
+
+  if (mPendingFrameOffsets.size() > mNumFramesPerChunk)
+    writeChunk();
+}
+
+//==============================================================================
+void FileRecording::updateNumGenCoords(
+    const std::vector<dynamics::SkeletonPtr>& skeletons)
+{
+  // The layout of a read-only recording is the one stored in its file
+  if (mReadOnly)
+    return;
+
+  std::vector<int> numDofs;
+  numDofs.reserve(skeletons.size());
+  for (const auto& skeleton : skeletons)
+    numDofs.push_back(static_cast<int>(skeleton->getNumDofs()));
+
+  if (numDofs == mNumGenCoordsForSkeletons)
+    return;
+
+  // Every chunk has a single layout
+  writeChunk();
+  mNumGenCoordsForSkeletons = std::move(numDofs);
+  resetPendingChunk();
+}
+
+//==============================================================================
+void FileRecording::writeHeader()
+{
+  mFile.close();
+  mStream.close();
+  mStream.clear();
+  mStream.open(mPath, std::ios::binary | std::ios::out | std::ios::trunc);
+  if (!mStream) {
+    dterr << "[FileRecording::writeHeader] Failed to create [" << mPath
+          << "].\n";
+    return;
+  }
+
+  mStream.write(recordingMagic, sizeof(recordingMagic));
+  writeValue(mStream, recordingVersion);
+  writeValue(mStream, static_cast<std::uint32_t>(mNumFramesPerChunk));
+  mStream.flush();
+}
+
+//==============================================================================
+void FileRecording::writeChunk()
+{
+  const std::size_t numFrames = mPendingFrameOffsets.size() - 1u;
+  if (numFrames == 0u)
+    return;
+
+  const std::size_t numSkeletons = mPendingDofOffsets.size() - 1u;
+  const std::size_t chunkSize
+      = chunkHeaderSize
+        + sizeof(std::uint64_t)
+              * (mPendingDofOffsets.size() + mPendingFrameOffsets.size())
+        + sizeof(double) * mPendingData.size();
+
+  Chunk chunk;
+  chunk.mFirstFrame = mNumWrittenFrames;
+  chunk.mNumFrames = numFrames;
+  chunk.mNumSkeletons = numSkeletons;
+  chunk.mOffset = static_cast<std::size_t>(mStream.tellp());
+
+  writeValue(mStream, static_cast<std::uint64_t>(numFrames));
+  writeValue(mStream, static_cast<std::uint64_t>(numSkeletons));
+  writeValue(mStream, static_cast<std::uint64_t>(chunkSize));
+  mStream.write(
+      reinterpret_cast<const char*>(mPendingDofOffsets.data()),
+      sizeof(std::uint64_t) * mPendingDofOffsets.size());
+  mStream.write(
+      reinterpret_cast<const char*>(mPendingFrameOffsets.data()),
+      sizeof(std::uint64_t) * mPendingFrameOffsets.size());
+  mStream.write(
+      reinterpret_cast<const char*>(mPendingData.data()),
+      sizeof(double) * mPendingData.size());
+  mStream.flush();
+
+  if (!mStream) {
+    dterr << "[FileRecording::writeChunk] Failed to write " << numFrames
+          << " frames to [" << mPath << "]. The frames are discarded.\n";
+    resetPendingChunk();
+    return;
+  }
+
+  mChunks.push_back(chunk);
+  mNumWrittenFrames += numFrames;
+  resetPendingChunk();
+
+  // Map the file again so that it covers the new chunk
+  if (!mFile.open(mPath) || mFile.getSize() < chunk.mOffset + chunkSize) {
+    dterr << "[FileRecording::writeChunk] Failed to map [" << mPath
+          << "].\n";
+  }
+}
+
+//==============================================================================
+void FileRecording::resetPendingChunk()
+{
+  mPendingDofOffsets.assign(1u, 0u);
+  for (const auto numDofs : mNumGenCoordsForSkeletons)
+    mPendingDofOffsets.push_back(mPendingDofOffsets.back() + numDofs);
+
+  mPendingFrameOffsets.assign(1u, 0u);
+  mPendingData.clear();
+}
+
+//==============================================================================
+bool FileRecording::readChunks()
+{
+  const char* data = mFile.getData();
+  const std::size_t size = mFile.getSize();
+
+  if (size < fileHeaderSize
+      || std::memcmp(data, recordingMagic, sizeof(recordingMagic)) != 0
+      || readValue<std::uint32_t>(data + 8) != recordingVersion) {
+    return false;
+  }
+
+  mNumFramesPerChunk
+      = std::max<std::size_t>(readValue<std::uint32_t>(data + 12), 1u);
+
+  std::size_t offset = fileHeaderSize;
+  while (true) {
+    const std::size_t chunkSize = getChunkSize(data + offset, size - offset);
+    if (chunkSize == 0u)
+      break;
+
+    Chunk chunk;
+    chunk.mFirstFrame = mNumWrittenFrames;
+    chunk.mNumFrames = readValue<std::uint64_t>(data + offset);
+    chunk.mNumSkeletons
+        = readValue<std::uint64_t>(data + offset + sizeof(std::uint64_t));
+    chunk.mOffset = offset;
+
+    mChunks.push_back(chunk);
+    mNumWrittenFrames += chunk.mNumFrames;
+    offset += chunkSize;
+  }
+
+  if (offset != size) {
+    dtwarn << "[FileRecording::readChunks] Ignoring " << size - offset
+           << " bytes at the end of [" << mPath << "] that do not hold a "
+           << "complete chunk.\n";
+  }
+
+  // Report the layout of the last chunk
+  mNumGenCoordsForSkeletons.clear();
+  if (!mChunks.empty()) {
+    const Frame frame = getFrame(static_cast<int>(mNumWrittenFrames - 1u));
+    for (std::size_t i = 0u; i < frame.mNumSkeletons; ++i) {
+      mNumGenCoordsForSkeletons.push_back(static_cast<int>(
+          frame.mDofOffsets[i + 1u] - frame.mDofOffsets[i]));
+    }
+  }
+
+  return true;
+}
+
+//==============================================================================
+const FileRecording::Chunk& FileRecording::findChunk(std::size_t frameIdx) const
+{
+  // Chunks are only cut short when the layout changes, so the chunk is
+  // usually found directly
+  const std::size_t guess = frameIdx / mNumFramesPerChunk;
+  if (guess < mChunks.size()) {
+    const Chunk& chunk = mChunks[guess];
+    if (chunk.mFirstFrame <= frameIdx
+        && frameIdx < chunk.mFirstFrame + chunk.mNumFrames)
+      return chunk;
+  }
+
+  const auto it = std::upper_bound(
+      mChunks.begin(),
+      mChunks.end(),
+      frameIdx,
+      [](std::size_t index, const Chunk& chunk) {
+        return index < chunk.mFirstFrame;
+      });
+  assert(it != mChunks.begin());
+
+  return *(it - 1);
+}
+
+//==============================================================================
+FileRecording::Frame FileRecording::getFrame(int frameIdx) const
+{
+  assert(0 <= frameIdx && frameIdx < getNumFrames());
+  const auto index = static_cast<std::size_t>(frameIdx);
+
+  Frame frame;
+
+  // Frames that are not written yet are read from memory
+  if (index >= mNumWrittenFrames) {
+    const std::size_t local = index - mNumWrittenFrames;
+    frame.mData = mPendingData.data() + mPendingFrameOffsets[local];
+    frame.mSize
+        = mPendingFrameOffsets[local + 1u] - mPendingFrameOffsets[local];
+    frame.mDofOffsets = mPendingDofOffsets.data();
+    frame.mNumSkeletons = mPendingDofOffsets.size() - 1u;
+    return frame;
+  }
+
+  const Chunk& chunk = findChunk(index);
+  const char* begin = mFile.getData() + chunk.mOffset + chunkHeaderSize;
+
+  // The file and every table in it are a multiple of eight bytes long, so
+  // the values are aligned within the page-aligned mapping
+  const auto dofOffsets = reinterpret_cast<const std::uint64_t*>(begin);
+  const auto frameOffsets = dofOffsets + chunk.mNumSkeletons + 1u;
+  const auto values
+      = reinterpret_cast<const double*>(frameOffsets + chunk.mNumFrames + 1u);
+
+  const std::size_t local = index - chunk.mFirstFrame;
+  frame.mData = values + frameOffsets[local];
+  frame.mSize = frameOffsets[local + 1u] - frameOffsets[local];
+  frame.mDofOffsets = dofOffsets;
+  frame.mNumSkeletons = chunk.mNumSkeletons;
+  return frame;
+}
+
+} // namespace simulation
+} // namespace dart
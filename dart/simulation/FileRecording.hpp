@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef DART_SIMULATION_FILERECORDING_HPP_
+#define DART_SIMULATION_FILERECORDING_HPP_
+
+#include <dart/simulation/Recording.hpp>
+
+#include <dart/common/MemoryMappedFile.hpp>
+
+#include <Eigen/Dense>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+namespace dart {
+namespace simulation {
+
+/// Recording that streams the baked frames to an append-only binary file.
+///
+/// Frames are buffered in memory until a chunk of frames is full, and then
+/// appended to the file, so the memory used does not grow with the length of
+/// the run. Finished chunks are read back through a memory mapping of the
+/// file, which gives constant time access to any frame, skeleton or contact.
+///
+/// The file starts with the magic bytes "DARTREC1", a 32-bit version and the
+/// 32-bit number of frames per chunk. Each chunk then holds, as 64-bit
+/// unsigned integers, its number of frames, its number of skeletons and its
+/// size in bytes, followed by the offsets of the first coordinate of each
+/// skeleton within a frame (numSkeletons + 1 entries), the offsets of each
+/// frame within the chunk data (numFrames + 1 entries, counted in doubles),
+/// and finally the data of the frames as doubles. A frame has the same layout
+/// as the states passed to addState(). All values use the byte order of the
+/// machine that wrote the file.
+///
+/// A chunk is also closed early when the number of skeletons or of their
+/// degrees of freedom changes, so every chunk has a single layout.
+class FileRecording : public Recording
+{
+public:
+  /// Creates the file at path, replacing any existing file, and records the
+  /// layout of the given skeletons.
+  FileRecording(
+      const std::string& path,
+      const std::vector<dynamics::SkeletonPtr>& skeletons,
+      std::size_t numFramesPerChunk = 1024u);
+
+  /// Opens a recording file for reading. Returns nullptr if the file cannot
+  /// be opened or is not a recording. A trailing chunk that was cut short,
+  /// for example because the writer crashed, is ignored.
+  static std::unique_ptr<FileRecording> open(const std::string& path);
+
+  /// Destructor. Writes the buffered frames to the file.
+  ~FileRecording() override;
+
+  /// Returns the path of the file
+  const std::string& getPath() const;
+
+  /// Returns true if the recording was opened with open() and cannot be
+  /// modified
+  bool isReadOnly() const;
+
+  /// Appends the buffered frames to the file, even if their chunk is not full
+  void flush();
+
+  /// Returns the configuration of a skeleton at a frame without copying it.
+  /// The map is valid until the recording is modified.
+  Eigen::Map<const Eigen::VectorXd> getConfigMap(
+      int frameIdx, int skelIdx) const;
+
+  /// Returns the contacts of a frame without copying them. Each column holds
+  /// the point of a contact followed by its force. The map is valid until the
+  /// recording is modified.
+  Eigen::Map<const Eigen::Matrix<double, 6, Eigen::Dynamic>> getContactsMap(
+      int frameIdx) const;
+
+  // Documentation inherited
+  int getNumFrames() const override;
+
+  // Documentation inherited
+  int getNumContacts(int frameIdx) const override;
+
+  // Documentation inherited
+  Eigen::VectorXd getConfig(int frameIdx, int skelIdx) const override;
+
+  // Documentation inherited
+  double getGenCoord(int frameIdx, int skelIdx, int dofIdx) const override;
+
+  // Documentation inherited
+  Eigen::Vector3d getContactPoint(int frameIdx, int contactIdx) const override;
+
+  // Documentation inherited
+  Eigen::Vector3d getContactForce(int frameIdx, int contactIdx) const override;
+
+  /// Discards all the frames and truncates the file
+  void clear() override;
+
+  // Documentation inherited
+  void addState(const Eigen::VectorXd& state) override;
+
+  /// Closes the current chunk if the layout of the skeletons changed
+  void updateNumGenCoords(
+      const std::vector<dynamics::SkeletonPtr>& skeletons) override;
+
+protected:
+  /// Location of a chunk that was written to the file
+  struct Chunk
+  {
+    /// Index of the first frame of the chunk
+    std::size_t mFirstFrame;
+
+    /// Number of frames in the chunk
+    std::size_t mNumFrames;
+
+    /// Number of skeletons in the chunk
+    std::size_t mNumSkeletons;
+
+    /// Offset of the chunk in the file, in bytes
+    std::size_t mOffset;
+  };
+
+  /// Data of a single frame
+  struct Frame
+  {
+    /// Values of the frame
+    const double* mData;
+
+    /// Number of values of the frame
+    std::size_t mSize;
+
+    /// Offsets of the coordinates of each skeleton, plus the total
+    const std::uint64_t* mDofOffsets;
+
+    /// Number of skeletons
+    std::size_t mNumSkeletons;
+  };
+
+  /// Constructor used by open()
+  explicit FileRecording(const std::string& path);
+
+  /// Writes the header of the file, truncating it
+  void writeHeader();
+
+  /// Appends the buffered frames to the file as a chunk
+  void writeChunk();
+
+  /// Resets the buffered chunk to the current layout
+  void resetPendingChunk();
+
+  /// Reads the chunk table from the mapped file. Returns false if the file
+  /// is not a recording.
+  bool readChunks();
+
+  /// Returns the chunk that contains a frame that was written to the file
+  const Chunk& findChunk(std::size_t frameIdx) const;
+
+  /// Returns the data of a frame
+  Frame getFrame(int frameIdx) const;
+
+  /// Path of the file
+  std::string mPath;
+
+  /// Whether the recording cannot be modified
+  bool mReadOnly;
+
+  /// Maximum number of frames per chunk
+  std::size_t mNumFramesPerChunk;
+
+  /// Stream that appends chunks to the file
+  std::ofstream mStream;
+
+  /// Mapping of the chunks that were written to the file
+  common::MemoryMappedFile mFile;
+
+  /// Chunks that were written to the file, in order
+  std::vector<Chunk> mChunks;
+
+  /// Number of frames that were written to the file
+  std::size_t mNumWrittenFrames;
+
+  /// Offsets of the coordinates of each skeleton in the buffered chunk
+  std::vector<std::uint64_t> mPendingDofOffsets;
+
+  /// Offsets of the frames in the buffered chunk
+  std::vector<std::uint64_t> mPendingFrameOffsets;
+
+  /// Values of the frames in the buffered chunk
+  std::vector<double> mPendingData;
+};
+
+} // namespace simulation
+} // namespace dart
+
+#endif // DART_SIMULATION_FILERECORDING_HPP_
@@ -54,6 +54,9 @@ class Skeleton;
 namespace simulation {
 
 /// \brief class Recording
+///
+/// Keeps every baked frame in memory. See FileRecording for a recording that
+/// streams the frames to a file.
 class Recording
 {
 public:
@@ -67,7 +70,7 @@ public:
   virtual ~Recording();
 
   /// \brief Get number of frames
-  int getNumFrames() const;
+  virtual int getNumFrames() const;
 
   /// \brief Get number of skeletons
   int getNumSkeletons() const;
@@ -77,39 +80,41 @@ public:
   int getNumDofs(int _skelIdx) const;
 
   /// \brief Get number of contacts at frame number _frameIdx
-  int getNumContacts(int _frameIdx) const;
+  virtual int getNumContacts(int _frameIdx) const;
 
   /// \brief Get skeleton configurations whose index is _skelIdx at frame number
   /// _frameIdx
-  Eigen::VectorXd getConfig(int _frameIdx, int _skelIdx) const;
+  virtual Eigen::VectorXd getConfig(int _frameIdx, int _skelIdx) const;
 
   /// \brief Get _dofIdx-th single configruation of a skeleton whose index is
   /// _skelIdx at frame number _frameIdx
-  double getGenCoord(int _frameIdx, int _skelIdx, int _dofIdx) const;
+  virtual double getGenCoord(int _frameIdx, int _skelIdx, int _dofIdx) const;
 
   /// \brief Get contact point whose index is _contactIdx at frame number
   /// _frameIdx
-  Eigen::Vector3d getContactPoint(int _frameIdx, int _contactIdx) const;
+  virtual Eigen::Vector3d getContactPoint(int _frameIdx, int _contactIdx) const;
 
   /// \brief Get contact force whose index is _contactIdx at frame number
   /// _frameIdx
-  Eigen::Vector3d getContactForce(int _frameIdx, int _contactIdx) const;
+  virtual Eigen::Vector3d getContactForce(int _frameIdx, int _contactIdx) const;
 
   /// \brief Clear the saved histories
-  void clear();
+  virtual void clear();
 
   /// \brief Add state
-  void addState(const Eigen::VectorXd& _state);
+  virtual void addState(const Eigen::VectorXd& _state);
 
   /// \brief Update list for number of generalized coordinates
-  void updateNumGenCoords(const std::vector<dynamics::SkeletonPtr>& _skeletons);
+  virtual void updateNumGenCoords(
+      const std::vector<dynamics::SkeletonPtr>& _skeletons);
+
+protected:
+  /// \brief Number of generalized coordinates for skeletons
+  std::vector<int> mNumGenCoordsForSkeletons;
 
 private:
   /// \brief Baked states
   std::vector<Eigen::VectorXd> mBakedStates;
-
-  /// \brief Number of generalized coordinates for skeletons
-  std::vector<int> mNumGenCoordsForSkeletons;
 };
 
 } // namespace simulation
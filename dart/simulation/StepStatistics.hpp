@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_SIMULATION_STEPSTATISTICS_HPP_
+#define DART_SIMULATION_STEPSTATISTICS_HPP_
+
+#include <dart/constraint/ConstraintSolverStatistics.hpp>
+
+namespace dart {
+namespace simulation {
+
+/// Statistics of the last call to World::step(). They are only collected
+/// while enabled with World::setStepStatisticsEnabled(). Times are wall-clock
+/// times in seconds.
+struct StepStatistics
+{
+  /// Time of the whole step
+  double mStepTime = 0.0;
+
+  /// Time spent on computing the forward dynamics and integrating the
+  /// velocities of the skeletons
+  double mIntegrateVelocitiesTime = 0.0;
+
+  /// Time spent in ConstraintSolver::solve(), which is broken down in
+  /// mConstraintSolver
+  double mSolveConstraintsTime = 0.0;
+
+  /// Time spent on applying the constraint impulses and integrating the
+  /// positions of the skeletons
+  double mIntegratePositionsTime = 0.0;
+
+  /// Statistics of the constraint solver for the step
+  constraint::ConstraintSolverStatistics mConstraintSolver;
+};
+
+} // namespace simulation
+} // namespace dart
+
+#endif // DART_SIMULATION_STEPSTATISTICS_HPP_
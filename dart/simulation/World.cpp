@@ -41,18 +41,85 @@
 #include "dart/collision/CollisionGroup.hpp"
 #include "dart/common/Console.hpp"
 #include "dart/common/Profile.hpp"
+#include "dart/common/Stopwatch.hpp"
 #include "dart/constraint/BoxedLcpConstraintSolver.hpp"
 #include "dart/constraint/ConstrainedGroup.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/DegreeOfFreedom.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/integration/SemiImplicitEulerIntegrator.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <vector>
 
 namespace dart {
 namespace simulation {
 
+namespace {
+
+/// Identifies the buffers of World::saveState()
+constexpr std::uint32_t stateFormat = 0x44534132u;
+
+/// Number of bytes of the header of the buffers of World::saveState(): the
+/// format, the number of skeletons, the time, the number of simulated frames
+/// and the label of the next sleeping island
+constexpr std::size_t stateHeaderSize = sizeof(std::uint32_t)
+                                        + 2u * sizeof(std::uint64_t)
+                                        + sizeof(double) + sizeof(std::int64_t);
+
+//==============================================================================
+/// Returns the number of bytes of a skeleton with numDofs DOFs in the buffers
+/// of World::saveState(): the number of DOFs, the sleeping state, and the
+/// position, velocity, acceleration, force and command of each DOF
+std::size_t getSkeletonStateSize(std::size_t numDofs)
+{
+  return 4u * sizeof(std::uint64_t) + 5u * numDofs * sizeof(double);
+}
+
+//==============================================================================
+template <typename T>
+void writeValue(char*& buffer, T value)
+{
+  std::memcpy(buffer, &value, sizeof(T));
+  buffer += sizeof(T);
+}
+
+//==============================================================================
+template <typename T>
+T readValue(const char*& buffer)
+{
+  T value;
+  std::memcpy(&value, buffer, sizeof(T));
+  buffer += sizeof(T);
+  return value;
+}
+
+//==============================================================================
+/// Returns true if a force, a command or a velocity is set on the skeleton
+bool isPushed(const dynamics::Skeleton& skel)
+{
+  for (auto i = 0u; i < skel.getNumDofs(); ++i) {
+    const auto* dof = skel.getDof(i);
+    if (dof->getVelocity() != 0.0 || dof->getForce() != 0.0
+        || dof->getCommand() != 0.0)
+      return true;
+  }
+
+  for (auto i = 0u; i < skel.getNumBodyNodes(); ++i) {
+    if (!skel.getBodyNode(i)->getExternalForceLocal().isZero(0.0))
+      return true;
+  }
+
+  return false;
+}
+
+} // namespace
+
 //==============================================================================
 std::shared_ptr<World> World::create(const std::string& name)
 {
@@ -69,6 +136,11 @@ World::World(const std::string& _name)
     mTime(0.0),
     mFrame(0),
     mRecording(new Recording(mSkeletons)),
+    mStepStatisticsEnabled(false),
+    mSleepingEnabled(false),
+    mSleepThreshold(1e-4),
+    mNumStepsToSleep(60u),
+    mNextSleepIsland(0u),
     onNameChanged(mNameChangedSignal)
 {
   mIndices.push_back(0);
@@ -96,6 +168,9 @@ WorldPtr World::clone() const
 
   worldClone->setGravity(mGravity);
   worldClone->setTimeStep(mTimeStep);
+  worldClone->setSleepingEnabled(mSleepingEnabled);
+  worldClone->setSleepThreshold(mSleepThreshold);
+  worldClone->setNumStepsToSleep(mNumStepsToSleep);
 
   auto cd = getConstraintSolver()->getCollisionDetector();
   worldClone->getConstraintSolver()->setCollisionDetector(
@@ -163,11 +238,27 @@ void World::reset()
 //==============================================================================
 void World::step(bool _resetCommand)
 {
+  // Times the phases of the step while the statistics are enabled
+  common::StopwatchNS stopwatch;
+  double lapStart = 0.0;
+  const auto lap = [&]() {
+    const double lapEnd = stopwatch.elapsedS();
+    const double lapTime = lapEnd - lapStart;
+    lapStart = lapEnd;
+    return lapTime;
+  };
+
+  // Wake up the sleeping skeletons that are pushed
+  for (auto i = 0u; i < mSkeletons.size(); ++i) {
+    if (mSkeletons[i]->isSleeping() && isPushed(*mSkeletons[i]))
+      wakeUpIsland(i);
+  }
+
   // Integrate velocity for unconstrained skeletons
   {
     DART_PROFILE_SCOPED_N("World::step - Integrate velocity");
     for (auto& skel : mSkeletons) {
-      if (!skel->isMobile())
+      if (!skel->isMobile() || skel->isSleeping())
         continue;
 
       skel->computeForwardDynamics();
@@ -175,15 +266,27 @@ void World::step(bool _resetCommand)
     }
   }
 
+  if (mStepStatisticsEnabled)
+    mStepStatistics.mIntegrateVelocitiesTime = lap();
+
   // Detect activated constraints and compute constraint impulses
   {
     DART_PROFILE_SCOPED_N("World::step - Solve constraints");
     mConstraintSolver->solve();
+
+    // The contacts of sleeping skeletons with other skeletons at rest were
+    // skipped, so solve again once the islands touched by constraints are
+    // awake. Every pass wakes up at least one island.
+    while (wakeUpTouchedIslands())
+      mConstraintSolver->solve();
   }
 
+  if (mStepStatisticsEnabled)
+    mStepStatistics.mSolveConstraintsTime = lap();
+
   // Compute velocity changes given constraint impulses
   for (auto& skel : mSkeletons) {
-    if (!skel->isMobile())
+    if (!skel->isMobile() || skel->isSleeping())
       continue;
 
     if (skel->isImpulseApplied()) {
@@ -200,11 +303,93 @@ void World::step(bool _resetCommand)
     }
   }
 
+  if (mSleepingEnabled)
+    updateSleepingIslands();
+
+  if (mStepStatisticsEnabled) {
+    mStepStatistics.mIntegratePositionsTime = lap();
+    mStepStatistics.mStepTime = lapStart;
+    mStepStatistics.mConstraintSolver = mConstraintSolver->getStatistics();
+  }
+
   mTime += mTimeStep;
   mFrame++;
   DART_PROFILE_FRAME;
 }
 
+//==============================================================================
+void World::setStepStatisticsEnabled(bool enabled)
+{
+  mStepStatisticsEnabled = enabled;
+  mStepStatistics = StepStatistics();
+  mConstraintSolver->setStatisticsEnabled(enabled);
+}
+
+//==============================================================================
+bool World::isStepStatisticsEnabled() const
+{
+  return mStepStatisticsEnabled;
+}
+
+//==============================================================================
+const StepStatistics& World::getStepStatistics() const
+{
+  return mStepStatistics;
+}
+
+//==============================================================================
+void World::setSleepingEnabled(bool enabled)
+{
+  mSleepingEnabled = enabled;
+
+  if (!mSleepingEnabled) {
+    for (auto i = 0u; i < mSkeletons.size(); ++i) {
+      mSkeletons[i]->setSleeping(false);
+      mSleepStates[i] = SleepState();
+    }
+  }
+}
+
+//==============================================================================
+bool World::isSleepingEnabled() const
+{
+  return mSleepingEnabled;
+}
+
+//==============================================================================
+void World::setSleepThreshold(double threshold)
+{
+  assert(threshold >= 0.0);
+  mSleepThreshold = threshold;
+}
+
+//==============================================================================
+double World::getSleepThreshold() const
+{
+  return mSleepThreshold;
+}
+
+//==============================================================================
+void World::setNumStepsToSleep(std::size_t numSteps)
+{
+  mNumStepsToSleep = numSteps;
+}
+
+//==============================================================================
+std::size_t World::getNumStepsToSleep() const
+{
+  return mNumStepsToSleep;
+}
+
+//==============================================================================
+std::size_t World::getNumSleepingSkeletons() const
+{
+  return static_cast<std::size_t>(std::count_if(
+      mSkeletons.begin(), mSkeletons.end(), [](const auto& skel) {
+        return skel->isSleeping();
+      }));
+}
+
 //==============================================================================
 void World::setTime(double _time)
 {
@@ -223,6 +408,125 @@ int World::getSimFrames() const
   return mFrame;
 }
 
+//==============================================================================
+std::size_t World::getStateSize() const
+{
+  std::size_t size = stateHeaderSize;
+  for (const auto& skel : mSkeletons)
+    size += getSkeletonStateSize(skel->getNumDofs());
+
+  return size + sizeof(std::uint64_t)
+         + mConstraintSolver->getContactImpulseCacheSize();
+}
+
+//==============================================================================
+void World::saveState(std::vector<char>& buffer) const
+{
+  buffer.resize(getStateSize());
+
+  char* out = buffer.data();
+  writeValue<std::uint32_t>(out, stateFormat);
+  writeValue<std::uint64_t>(out, mSkeletons.size());
+  writeValue<double>(out, mTime);
+  writeValue<std::int64_t>(out, mFrame);
+  writeValue<std::uint64_t>(out, mNextSleepIsland);
+
+  for (auto i = 0u; i < mSkeletons.size(); ++i) {
+    const auto& skel = mSkeletons[i];
+    const auto& sleepState = mSleepStates[i];
+
+    writeValue<std::uint64_t>(out, skel->getNumDofs());
+    writeValue<std::uint64_t>(out, skel->isSleeping());
+    writeValue<std::uint64_t>(out, sleepState.mNumRestingSteps);
+    writeValue<std::uint64_t>(out, sleepState.mIsland);
+
+    for (auto j = 0u; j < skel->getNumDofs(); ++j) {
+      const auto* dof = skel->getDof(j);
+      writeValue<double>(out, dof->getPosition());
+      writeValue<double>(out, dof->getVelocity());
+      writeValue<double>(out, dof->getAcceleration());
+      writeValue<double>(out, dof->getForce());
+      writeValue<double>(out, dof->getCommand());
+    }
+  }
+
+  const std::size_t cacheSize
+      = mConstraintSolver->getContactImpulseCacheSize();
+  writeValue<std::uint64_t>(out, cacheSize);
+  mConstraintSolver->saveContactImpulseCache(out);
+  assert(out + cacheSize == buffer.data() + buffer.size());
+}
+
+//==============================================================================
+bool World::restoreState(const std::vector<char>& buffer)
+{
+  // Check that the buffer matches the skeletons of this world before changing
+  // anything
+  const char* in = buffer.data();
+  const char* const end = buffer.data() + buffer.size();
+  const auto remaining = [&]() { return static_cast<std::size_t>(end - in); };
+
+  bool valid = buffer.size() >= stateHeaderSize
+               && readValue<std::uint32_t>(in) == stateFormat
+               && readValue<std::uint64_t>(in) == mSkeletons.size();
+  if (valid)
+    in = buffer.data() + stateHeaderSize;
+
+  for (auto i = 0u; valid && i < mSkeletons.size(); ++i) {
+    const std::size_t numDofs = mSkeletons[i]->getNumDofs();
+    const std::size_t size = getSkeletonStateSize(numDofs);
+    valid = remaining() >= size && readValue<std::uint64_t>(in) == numDofs;
+    if (valid)
+      in += size - sizeof(std::uint64_t);
+  }
+
+  if (valid && remaining() >= sizeof(std::uint64_t)) {
+    const std::size_t cacheSize = readValue<std::uint64_t>(in);
+    valid = cacheSize == remaining();
+  } else {
+    valid = false;
+  }
+
+  if (!valid) {
+    dterr << "[World::restoreState] The buffer does not hold a state of the "
+          << "skeletons of World [" << mName << "]. The state is not "
+          << "restored.\n";
+    return false;
+  }
+
+  in = buffer.data() + sizeof(std::uint32_t) + sizeof(std::uint64_t);
+  mTime = readValue<double>(in);
+  mFrame = static_cast<int>(readValue<std::int64_t>(in));
+  mNextSleepIsland = readValue<std::uint64_t>(in);
+
+  for (auto i = 0u; i < mSkeletons.size(); ++i) {
+    const auto& skel = mSkeletons[i];
+    auto& sleepState = mSleepStates[i];
+
+    in += sizeof(std::uint64_t);
+
+    // Putting a skeleton to sleep zeroes its velocities, so do it before
+    // restoring them
+    skel->setSleeping(readValue<std::uint64_t>(in) != 0u);
+    sleepState.mNumRestingSteps = readValue<std::uint64_t>(in);
+    sleepState.mIsland = readValue<std::uint64_t>(in);
+
+    for (auto j = 0u; j < skel->getNumDofs(); ++j) {
+      auto* dof = skel->getDof(j);
+      dof->setPosition(readValue<double>(in));
+      dof->setVelocity(readValue<double>(in));
+      dof->setAcceleration(readValue<double>(in));
+      dof->setForce(readValue<double>(in));
+      dof->setCommand(readValue<double>(in));
+    }
+  }
+
+  const std::size_t cacheSize = readValue<std::uint64_t>(in);
+  mConstraintSolver->restoreContactImpulseCache(in, cacheSize);
+
+  return true;
+}
+
 //==============================================================================
 const std::string& World::setName(const std::string& _newName)
 {
@@ -309,6 +613,7 @@ std::string World::addSkeleton(const dynamics::SkeletonPtr& _skeleton)
 
   mSkeletons.push_back(_skeleton);
   mMapForSkeletons[_skeleton] = _skeleton;
+  mSleepStates.emplace_back();
 
   mNameConnectionsForSkeletons.push_back(_skeleton->onNameChanged.connect(
       [=](dynamics::ConstMetaSkeletonPtr skel,
@@ -371,6 +676,8 @@ void World::removeSkeleton(const dynamics::SkeletonPtr& _skeleton)
       remove(mSkeletons.begin(), mSkeletons.end(), _skeleton),
       mSkeletons.end());
 
+  mSleepStates.erase(mSleepStates.begin() + index);
+
   // Disconnect the name change monitor
   mNameConnectionsForSkeletons[index].disconnect();
   mNameConnectionsForSkeletons.erase(
@@ -607,6 +914,19 @@ Recording* World::getRecording()
   return mRecording;
 }
 
+//==============================================================================
+void World::setRecording(std::unique_ptr<Recording> recording)
+{
+  delete mRecording;
+
+  if (recording)
+    mRecording = recording.release();
+  else
+    mRecording = new Recording(mSkeletons);
+
+  mRecording->updateNumGenCoords(mSkeletons);
+}
+
 //==============================================================================
 void World::handleSkeletonNameChange(
     const dynamics::ConstMetaSkeletonPtr& _skeleton)
@@ -652,6 +972,105 @@ void World::handleSkeletonNameChange(
   }
 }
 
+//==============================================================================
+void World::wakeUpIsland(std::size_t index, bool integrateVelocities)
+{
+  const auto island = mSleepStates[index].mIsland;
+  for (auto i = 0u; i < mSkeletons.size(); ++i) {
+    if (i != index
+        && (island == std::numeric_limits<std::size_t>::max()
+            || mSleepStates[i].mIsland != island
+            || !mSkeletons[i]->isSleeping()))
+      continue;
+
+    auto& skel = mSkeletons[i];
+    skel->setSleeping(false);
+    mSleepStates[i] = SleepState();
+
+    if (integrateVelocities) {
+      skel->computeForwardDynamics();
+      skel->integrateVelocities(mTimeStep);
+    }
+  }
+}
+
+//==============================================================================
+bool World::wakeUpTouchedIslands()
+{
+  bool wokeUp = false;
+  for (auto i = 0u; i < mSkeletons.size(); ++i) {
+    if (mSkeletons[i]->isSleeping() && mSkeletons[i]->isImpulseApplied()) {
+      wakeUpIsland(i, true);
+      wokeUp = true;
+    }
+  }
+
+  // The impulses of the last solve are discarded by the next one
+  if (wokeUp) {
+    for (auto& skel : mSkeletons)
+      skel->setImpulseApplied(false);
+  }
+
+  return wokeUp;
+}
+
+//==============================================================================
+void World::updateSleepingIslands()
+{
+  DART_PROFILE_SCOPED;
+
+  constexpr auto noGroup = std::numeric_limits<std::size_t>::max();
+
+  // Count the steps that each awake skeleton has been at rest. The skeletons
+  // of a constrained group can only fall asleep together.
+  const auto numSkeletons = mSkeletons.size();
+  mIslandCanSleep.assign(numSkeletons, true);
+  for (auto i = 0u; i < numSkeletons; ++i) {
+    const auto& skel = mSkeletons[i];
+    if (!skel->isMobile() || skel->isSleeping() || skel->getNumDofs() == 0u)
+      continue;
+
+    auto& state = mSleepStates[i];
+    const double mass = skel->getMass();
+    const double energy
+        = mass > 0.0 ? skel->computeKineticEnergy() / mass : 0.0;
+    if (energy < mSleepThreshold)
+      ++state.mNumRestingSteps;
+    else
+      state.mNumRestingSteps = 0u;
+
+    // The number of constrained groups is at most the number of skeletons
+    const auto group = mConstraintSolver->getConstrainedGroupIndex(*skel);
+    if (group != noGroup && state.mNumRestingSteps < mNumStepsToSleep)
+      mIslandCanSleep[group] = false;
+  }
+
+  // Put the islands to sleep. The label of an island is unique among the
+  // islands that fall asleep in this step.
+  for (auto i = 0u; i < numSkeletons; ++i) {
+    const auto& skel = mSkeletons[i];
+    if (!skel->isMobile() || skel->isSleeping() || skel->getNumDofs() == 0u)
+      continue;
+
+    auto& state = mSleepStates[i];
+    const auto group = mConstraintSolver->getConstrainedGroupIndex(*skel);
+    if (group == noGroup) {
+      if (state.mNumRestingSteps < mNumStepsToSleep)
+        continue;
+      state.mIsland = noGroup;
+    } else {
+      if (!mIslandCanSleep[group])
+        continue;
+      state.mIsland = mNextSleepIsland + group;
+    }
+
+    state.mNumRestingSteps = 0u;
+    skel->setSleeping(true);
+  }
+
+  mNextSleepIsland += numSkeletons;
+}
+
 //==============================================================================
 void World::handleSimpleFrameNameChange(const dynamics::Entity* _entity)
 {
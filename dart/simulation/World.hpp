@@ -41,6 +41,7 @@
 
 #include <dart/simulation/Recording.hpp>
 #include <dart/simulation/SmartPointer.hpp>
+#include <dart/simulation/StepStatistics.hpp>
 
 #include <dart/constraint/SmartPointer.hpp>
 
@@ -55,6 +56,7 @@
 
 #include <Eigen/Dense>
 
+#include <limits>
 #include <set>
 #include <string>
 #include <vector>
@@ -236,6 +238,75 @@ public:
   /// getSimpleFrame()
   int getSimFrames() const;
 
+  /// Returns the number of bytes that saveState() writes for the current
+  /// skeletons and cached contact impulses.
+  std::size_t getStateSize() const;
+
+  /// Saves the state of this world into one flat byte buffer: the time, the
+  /// number of simulated frames, the position, velocity, acceleration, force
+  /// and command of each DOF, the sleeping states of the skeletons, and the
+  /// contact impulses that warm start the next step. The buffer is only
+  /// resized when its size differs from getStateSize(), so saving again into
+  /// the same buffer does not allocate. External forces on BodyNodes are not
+  /// saved.
+  void saveState(std::vector<char>& buffer) const;
+
+  /// Restores a state that saveState() saved. Only values are written: names,
+  /// aspects and collision groups are left as they are, so the world must
+  /// have the same skeletons, with the same numbers of DOFs, as when the state
+  /// was saved. The state of a world can also be restored into its clones.
+  /// Returns false and leaves the world unchanged if the buffer does not match
+  /// the skeletons of this world.
+  bool restoreState(const std::vector<char>& buffer);
+
+  /// Sets whether to collect the statistics of step(), such as the time of
+  /// each phase, the number of contacts and the LCP dimensions. This also
+  /// enables the statistics of the constraint solver. Collecting them costs a
+  /// few clock reads per step. Disabled by default.
+  void setStepStatisticsEnabled(bool enabled);
+
+  /// Returns whether the statistics of step() are collected.
+  bool isStepStatisticsEnabled() const;
+
+  /// Returns the statistics of the last step. The statistics are zero unless
+  /// they are enabled with setStepStatisticsEnabled().
+  const StepStatistics& getStepStatistics() const;
+
+  /// Sets whether skeletons that come to rest are put to sleep. The skeletons
+  /// of an island, which are the skeletons connected by active constraints
+  /// such as contacts, fall asleep together once the kinetic energy per unit
+  /// mass of each of them has stayed below the sleep threshold for the given
+  /// number of steps. step() skips the dynamics, integration and constraints
+  /// of sleeping skeletons, and the collision checks between sleeping and
+  /// immobile skeletons. A sleeping island wakes up when a contact or another
+  /// constraint applies an impulse to one of its skeletons, in which case the
+  /// constraints of the step are solved again with the island awake, or when
+  /// a force, a command or a velocity is set on one of them. Disabling
+  /// sleeping wakes up all the skeletons. Disabled by default.
+  void setSleepingEnabled(bool enabled);
+
+  /// Returns whether skeletons that come to rest are put to sleep.
+  bool isSleepingEnabled() const;
+
+  /// Sets the kinetic energy per unit mass below which a skeleton is
+  /// considered at rest. Defaults to 1e-4.
+  void setSleepThreshold(double threshold);
+
+  /// Returns the kinetic energy per unit mass below which a skeleton is
+  /// considered at rest.
+  double getSleepThreshold() const;
+
+  /// Sets the number of steps that all the skeletons of an island have to be
+  /// at rest before the island falls asleep. Defaults to 60.
+  void setNumStepsToSleep(std::size_t numSteps);
+
+  /// Returns the number of steps that all the skeletons of an island have to
+  /// be at rest before the island falls asleep.
+  std::size_t getNumStepsToSleep() const;
+
+  /// Returns the number of sleeping skeletons.
+  std::size_t getNumSleepingSkeletons() const;
+
   //--------------------------------------------------------------------------
   // Constraint
   //--------------------------------------------------------------------------
@@ -258,6 +329,11 @@ public:
   /// Get recording
   Recording* getRecording();
 
+  /// Replace the recording that bake() stores the states into, for example
+  /// with a FileRecording that streams long runs to a file. Passing nullptr
+  /// restores an empty in-memory Recording.
+  void setRecording(std::unique_ptr<Recording> recording);
+
   /// \{ \name Iterations
 
   /// Iterates all the Skeletons and invokes the callback function.
@@ -330,6 +406,19 @@ protected:
   /// Register when a SimpleFrame's name is changed
   void handleSimpleFrameNameChange(const dynamics::Entity* _entity);
 
+  /// Wakes up the sleeping skeleton of the index and the other skeletons of
+  /// its island. If integrateVelocities is true, the skeletons that wake up
+  /// catch up on the velocity integration of the current step.
+  void wakeUpIsland(std::size_t index, bool integrateVelocities = false);
+
+  /// Wakes up the islands of the sleeping skeletons that the last constraint
+  /// solve touched, and returns true if any island woke up
+  bool wakeUpTouchedIslands();
+
+  /// Puts the islands whose skeletons have been at rest for long enough to
+  /// sleep
+  void updateSleepingIslands();
+
   /// Name of this World
   std::string mName;
 
@@ -384,6 +473,43 @@ protected:
   ///
   Recording* mRecording;
 
+  /// Whether to collect the statistics of step()
+  bool mStepStatisticsEnabled;
+
+  /// Statistics of the last step
+  StepStatistics mStepStatistics;
+
+  /// Whether skeletons that come to rest are put to sleep
+  bool mSleepingEnabled;
+
+  /// Kinetic energy per unit mass below which a skeleton is at rest
+  double mSleepThreshold;
+
+  /// Number of steps that the skeletons of an island have to be at rest
+  /// before it falls asleep
+  std::size_t mNumStepsToSleep;
+
+  /// Sleeping state of a skeleton
+  struct SleepState
+  {
+    /// Number of steps that the skeleton has been at rest
+    std::size_t mNumRestingSteps = 0u;
+
+    /// Island the skeleton fell asleep with, or
+    /// std::numeric_limits<std::size_t>::max() if it fell asleep alone
+    std::size_t mIsland = std::numeric_limits<std::size_t>::max();
+  };
+
+  /// Sleeping state of each skeleton in mSkeletons
+  std::vector<SleepState> mSleepStates;
+
+  /// Island label of the next islands that fall asleep
+  std::size_t mNextSleepIsland;
+
+  /// Whether each constrained group of the last step can fall asleep, reused
+  /// across steps
+  std::vector<bool> mIslandCanSleep;
+
   //--------------------------------------------------------------------------
   // Signals
   //--------------------------------------------------------------------------
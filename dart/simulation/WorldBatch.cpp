@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/simulation/WorldBatch.hpp"
+
+#include "dart/common/Console.hpp"
+#include "dart/common/Profile.hpp"
+#include "dart/common/ThreadPool.hpp"
+#include "dart/dynamics/Shape.hpp"
+#include "dart/dynamics/ShapeNode.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/simulation/World.hpp"
+
+#include <cassert>
+
+namespace dart {
+namespace simulation {
+
+//==============================================================================
+static void readStates(
+    const World& world,
+    Eigen::Ref<Eigen::RowVectorXd> positions,
+    Eigen::Ref<Eigen::RowVectorXd> velocities)
+{
+  Eigen::Index offset = 0;
+  world.eachSkeleton([&](const dynamics::Skeleton* skel) {
+    for (std::size_t i = 0; i < skel->getNumDofs(); ++i) {
+      positions[offset] = skel->getPosition(i);
+      velocities[offset] = skel->getVelocity(i);
+      ++offset;
+    }
+  });
+  assert(offset == positions.size());
+}
+
+//==============================================================================
+static void writeStates(
+    World& world,
+    const Eigen::Ref<const Eigen::RowVectorXd>& positions,
+    const Eigen::Ref<const Eigen::RowVectorXd>& velocities)
+{
+  Eigen::Index offset = 0;
+  world.eachSkeleton([&](dynamics::Skeleton* skel) {
+    for (std::size_t i = 0; i < skel->getNumDofs(); ++i) {
+      skel->setPosition(i, positions[offset]);
+      skel->setVelocity(i, velocities[offset]);
+      ++offset;
+    }
+  });
+  assert(offset == positions.size());
+}
+
+//==============================================================================
+static void writeCommands(
+    World& world, const Eigen::Ref<const Eigen::RowVectorXd>& commands)
+{
+  Eigen::Index offset = 0;
+  world.eachSkeleton([&](dynamics::Skeleton* skel) {
+    for (std::size_t i = 0; i < skel->getNumDofs(); ++i)
+      skel->setCommand(i, commands[offset++]);
+  });
+  assert(offset == commands.size());
+}
+
+//==============================================================================
+static void updateShapeCaches(const World& world)
+{
+  world.eachSkeleton([](const dynamics::Skeleton* skel) {
+    for (std::size_t i = 0; i < skel->getNumShapeNodes(); ++i) {
+      const auto& shape = skel->getShapeNode(i)->getShape();
+      if (!shape)
+        continue;
+
+      shape->getBoundingBox();
+      shape->getVolume();
+    }
+  });
+}
+
+//==============================================================================
+WorldBatch::WorldBatch(
+    const World& world, std::size_t numWorlds, std::size_t numThreads)
+  : mThreadPool(std::make_unique<common::ThreadPool>(numThreads)), mNumDofs(0)
+{
+  world.eachSkeleton([&](const dynamics::Skeleton* skel) {
+    mNumDofs += skel->getNumDofs();
+  });
+
+  mInitialPositions.resize(mNumDofs);
+  mInitialVelocities.resize(mNumDofs);
+  readStates(world, mInitialPositions, mInitialVelocities);
+
+  mWorlds.reserve(numWorlds);
+  for (std::size_t i = 0; i < numWorlds; ++i)
+    mWorlds.push_back(world.clone());
+
+  mPositions.resize(numWorlds, mNumDofs);
+  mVelocities.resize(numWorlds, mNumDofs);
+  mCommands.setZero(numWorlds, mNumDofs);
+  syncStates();
+}
+
+//==============================================================================
+WorldBatch::~WorldBatch()
+{
+  // Do nothing
+}
+
+//==============================================================================
+std::size_t WorldBatch::getNumWorlds() const
+{
+  return mWorlds.size();
+}
+
+//==============================================================================
+std::size_t WorldBatch::getNumDofs() const
+{
+  return mNumDofs;
+}
+
+//==============================================================================
+std::size_t WorldBatch::getNumThreads() const
+{
+  return mThreadPool->getNumThreads();
+}
+
+//==============================================================================
+WorldPtr WorldBatch::getWorld(std::size_t index) const
+{
+  if (index >= mWorlds.size()) {
+    dterr << "[WorldBatch::getWorld] Index (" << index
+          << ") is out of range. The number of worlds is " << mWorlds.size()
+          << ".\n";
+    return nullptr;
+  }
+
+  return mWorlds[index];
+}
+
+//==============================================================================
+const WorldBatch::Matrix& WorldBatch::getPositions() const
+{
+  return mPositions;
+}
+
+//==============================================================================
+const WorldBatch::Matrix& WorldBatch::getVelocities() const
+{
+  return mVelocities;
+}
+
+//==============================================================================
+WorldBatch::Matrix& WorldBatch::getCommands()
+{
+  return mCommands;
+}
+
+//==============================================================================
+const WorldBatch::Matrix& WorldBatch::getCommands() const
+{
+  return mCommands;
+}
+
+//==============================================================================
+void WorldBatch::setState(
+    std::size_t index,
+    const Eigen::VectorXd& positions,
+    const Eigen::VectorXd& velocities)
+{
+  if (index >= mWorlds.size()) {
+    dterr << "[WorldBatch::setState] Index (" << index
+          << ") is out of range. The number of worlds is " << mWorlds.size()
+          << ".\n";
+    return;
+  }
+
+  if (static_cast<std::size_t>(positions.size()) != mNumDofs
+      || static_cast<std::size_t>(velocities.size()) != mNumDofs) {
+    dterr << "[WorldBatch::setState] Mismatching sizes of positions ("
+          << positions.size() << ") and velocities (" << velocities.size()
+          << "). Both should be " << mNumDofs << ".\n";
+    return;
+  }
+
+  mPositions.row(index) = positions.transpose();
+  mVelocities.row(index) = velocities.transpose();
+
+  World& world = *mWorlds[index];
+  writeStates(world, mPositions.row(index), mVelocities.row(index));
+  world.reset();
+}
+
+//==============================================================================
+void WorldBatch::reset(std::size_t index)
+{
+  setState(
+      index, mInitialPositions.transpose(), mInitialVelocities.transpose());
+}
+
+//==============================================================================
+void WorldBatch::step(std::size_t numSteps)
+{
+  DART_PROFILE_SCOPED;
+
+  // The worlds share their shapes, which compute data such as bounding boxes
+  // lazily on first use. Computing it here, before the threads start, leaves
+  // the threads only reading it. This is cheap when nothing changed.
+  for (const auto& world : mWorlds)
+    updateShapeCaches(*world);
+
+  mThreadPool->parallelFor(
+      mWorlds.size(), [&](std::size_t index, std::size_t /*worker*/) {
+        World& world = *mWorlds[index];
+        for (std::size_t i = 0; i < numSteps; ++i) {
+          writeCommands(world, mCommands.row(index));
+          world.step();
+        }
+        readStates(world, mPositions.row(index), mVelocities.row(index));
+      });
+}
+
+//==============================================================================
+void WorldBatch::syncStates()
+{
+  for (std::size_t i = 0; i < mWorlds.size(); ++i)
+    readStates(*mWorlds[i], mPositions.row(i), mVelocities.row(i));
+}
+
+} // namespace simulation
+} // namespace dart
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_SIMULATION_WORLDBATCH_HPP_
+#define DART_SIMULATION_WORLDBATCH_HPP_
+
+#include <dart/simulation/SmartPointer.hpp>
+
+#include <Eigen/Core>
+
+#include <memory>
+#include <vector>
+
+#include <cstddef>
+
+namespace dart {
+
+namespace common {
+class ThreadPool;
+} // namespace common
+
+namespace simulation {
+
+class World;
+
+/// WorldBatch owns a fixed number of clones of a World and steps them in
+/// parallel, e.g., for policy rollouts.
+///
+/// The generalized positions, velocities, and commands of the worlds are kept
+/// in row-major matrices with one row per world, so that they can be handed
+/// to learning code without copies. The columns follow the order of the
+/// skeletons in the world and of the DOFs in each skeleton.
+///
+/// The worlds are created once and live as long as the batch, so their
+/// collision groups and constraint solver workspaces are reused across steps
+/// and rollouts.
+///
+/// The worlds share the shapes of the template world, so changing a shape
+/// changes it in every world. Shapes must not be changed during step().
+class WorldBatch
+{
+public:
+  /// Matrix with one row for each world
+  using Matrix
+      = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+  /// Constructor
+  ///
+  /// \param[in] world: Template world that is cloned numWorlds times. It is
+  /// not modified.
+  /// \param[in] numWorlds: Number of worlds.
+  /// \param[in] numThreads: Number of threads including the calling thread.
+  /// Zero means the number of hardware threads.
+  WorldBatch(
+      const World& world, std::size_t numWorlds, std::size_t numThreads = 0);
+
+  /// Destructor
+  ~WorldBatch();
+
+  /// Returns the number of worlds.
+  std::size_t getNumWorlds() const;
+
+  /// Returns the number of DOFs of each world, which is the number of columns
+  /// of the state and command matrices.
+  std::size_t getNumDofs() const;
+
+  /// Returns the number of threads including the calling thread.
+  std::size_t getNumThreads() const;
+
+  /// Returns a world. Call syncStates() after changing the states of its
+  /// skeletons directly.
+  WorldPtr getWorld(std::size_t index) const;
+
+  /// Returns the positions of all the worlds. Row i belongs to world i.
+  const Matrix& getPositions() const;
+
+  /// Returns the velocities of all the worlds. Row i belongs to world i.
+  const Matrix& getVelocities() const;
+
+  /// Returns the commands that step() applies to the worlds. Row i belongs to
+  /// world i. The commands are kept across steps until they are changed.
+  Matrix& getCommands();
+
+  /// Returns the commands that step() applies to the worlds.
+  const Matrix& getCommands() const;
+
+  /// Sets the state of a world and resets its time, e.g., to start a new
+  /// rollout.
+  void setState(
+      std::size_t index,
+      const Eigen::VectorXd& positions,
+      const Eigen::VectorXd& velocities);
+
+  /// Restores the state that the template world had when this batch was
+  /// created and resets the time of a world.
+  void reset(std::size_t index);
+
+  /// Steps every world numSteps times in parallel with the current commands,
+  /// and then updates the positions and velocities.
+  void step(std::size_t numSteps = 1u);
+
+  /// Copies the positions and velocities of the skeletons of every world into
+  /// the state matrices.
+  void syncStates();
+
+private:
+  // Deletes copy/move constructors and assign/move operators
+  WorldBatch(const WorldBatch&) = delete;
+  WorldBatch(WorldBatch&&) = delete;
+  WorldBatch& operator=(const WorldBatch&) = delete;
+  WorldBatch& operator=(WorldBatch&&) = delete;
+
+  /// Worlds cloned from the template world
+  std::vector<WorldPtr> mWorlds;
+
+  /// Pool that steps the worlds
+  std::unique_ptr<common::ThreadPool> mThreadPool;
+
+  /// Number of DOFs of each world
+  std::size_t mNumDofs;
+
+  /// Positions of the template world
+  Eigen::RowVectorXd mInitialPositions;
+
+  /// Velocities of the template world
+  Eigen::RowVectorXd mInitialVelocities;
+
+  /// Positions of all the worlds
+  Matrix mPositions;
+
+  /// Velocities of all the worlds
+  Matrix mVelocities;
+
+  /// Commands of all the worlds
+  Matrix mCommands;
+};
+
+} // namespace simulation
+} // namespace dart
+
+#endif // DART_SIMULATION_WORLDBATCH_HPP_
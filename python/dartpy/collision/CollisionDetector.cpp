@@ -32,6 +32,7 @@
 
 #include <dart/dart.hpp>
 
+#include <pybind11/eigen.h>
 #include <pybind11/pybind11.h>
 
 namespace py = pybind11;
@@ -61,6 +62,29 @@ void CollisionDetector(py::module& m)
           +[](dart::collision::CollisionDetector* self)
               -> std::shared_ptr<dart::collision::CollisionGroup> {
             return self->createCollisionGroupAsSharedPtr();
+          })
+      .def(
+          "raycastBatch",
+          +[](dart::collision::CollisionDetector* self,
+              dart::collision::CollisionGroup* group,
+              const Eigen::Ref<const Eigen::Matrix3Xd>& origins,
+              const Eigen::Ref<const Eigen::Matrix3Xd>& directions,
+              dart::collision::RaycastBatchResult* result) -> std::size_t {
+            return self->raycastBatch(group, origins, directions, *result);
+          },
+          ::py::arg("group"),
+          ::py::arg("origins"),
+          ::py::arg("directions"),
+          ::py::arg("result"))
+      .def(
+          "setNumThreads",
+          +[](dart::collision::CollisionDetector* self,
+              std::size_t numThreads) { self->setNumThreads(numThreads); },
+          ::py::arg("numThreads"))
+      .def(
+          "getNumThreads",
+          +[](const dart::collision::CollisionDetector* self) -> std::size_t {
+            return self->getNumThreads();
           });
 }
 
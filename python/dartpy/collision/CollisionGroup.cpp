@@ -248,6 +248,17 @@ void CollisionGroup(py::module& m)
           ::py::arg("to"),
           ::py::arg("option"),
           ::py::arg("result"))
+      .def(
+          "raycastBatch",
+          +[](dart::collision::CollisionGroup* self,
+              const Eigen::Ref<const Eigen::Matrix3Xd>& origins,
+              const Eigen::Ref<const Eigen::Matrix3Xd>& directions,
+              dart::collision::RaycastBatchResult* result) -> std::size_t {
+            return self->raycastBatch(origins, directions, *result);
+          },
+          ::py::arg("origins"),
+          ::py::arg("directions"),
+          ::py::arg("result"))
       .def(
           "setAutomaticUpdate",
           +[](dart::collision::CollisionGroup* self) {
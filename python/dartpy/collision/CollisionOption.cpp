@@ -62,7 +62,13 @@ void CollisionOption(py::module& m)
           "maxNumContacts", &dart::collision::CollisionOption::maxNumContacts)
       .def_readwrite(
           "collisionFilter",
-          &dart::collision::CollisionOption::collisionFilter);
+          &dart::collision::CollisionOption::collisionFilter)
+      .def_readwrite(
+          "skipDisabledSelfCollisions",
+          &dart::collision::CollisionOption::skipDisabledSelfCollisions)
+      .def_readwrite(
+          "skipSleepingPairs",
+          &dart::collision::CollisionOption::skipSleepingPairs);
 }
 
 } // namespace python
@@ -109,6 +109,9 @@ void FCLCollisionDetector(py::module& m)
           dart::collision::FCLCollisionDetector::PrimitiveShape::PRIMITIVE)
       .value(
           "MESH", dart::collision::FCLCollisionDetector::PrimitiveShape::MESH)
+      .value(
+          "ANALYTIC",
+          dart::collision::FCLCollisionDetector::PrimitiveShape::ANALYTIC)
       .export_values();
 
   ::py::enum_<
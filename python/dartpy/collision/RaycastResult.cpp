@@ -61,6 +61,29 @@ void RaycastResult(py::module& m)
             return self->hasHit();
           })
       .def_readwrite("mRayHits", &dart::collision::RaycastResult::mRayHits);
+
+  ::py::class_<dart::collision::RaycastBatchResult>(m, "RaycastBatchResult")
+      .def(::py::init<>())
+      .def(
+          "resize",
+          +[](dart::collision::RaycastBatchResult* self, std::size_t numRays) {
+            self->resize(numRays);
+          },
+          ::py::arg("numRays"))
+      .def(
+          "getNumRays",
+          +[](const dart::collision::RaycastBatchResult* self) -> std::size_t {
+            return self->getNumRays();
+          })
+      .def(
+          "clear",
+          +[](dart::collision::RaycastBatchResult* self) { self->clear(); })
+      .def_readwrite(
+          "mDistances", &dart::collision::RaycastBatchResult::mDistances)
+      .def_readwrite("mNormals", &dart::collision::RaycastBatchResult::mNormals)
+      .def_readwrite(
+          "mCollisionObjects",
+          &dart::collision::RaycastBatchResult::mCollisionObjects);
 }
 
 } // namespace python
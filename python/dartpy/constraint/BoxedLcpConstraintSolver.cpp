@@ -68,6 +68,17 @@ void BoxedLcpConstraintSolver(py::module& m)
           +[](const constraint::BoxedLcpConstraintSolver* self)
               -> constraint::ConstBoxedLcpSolverPtr {
             return self->getBoxedLcpSolver();
+          })
+      .def(
+          "setBlockSparseAssembly",
+          +[](constraint::BoxedLcpConstraintSolver* self, bool enabled) {
+            self->setBlockSparseAssembly(enabled);
+          },
+          ::py::arg("enabled"))
+      .def(
+          "isBlockSparseAssembly",
+          +[](const constraint::BoxedLcpConstraintSolver* self) -> bool {
+            return self->isBlockSparseAssembly();
           });
 }
 
@@ -49,6 +49,11 @@ void BoxedLcpSolver(py::module& m)
           +[](const dart::constraint::BoxedLcpSolver* self)
               -> const std::string& { return self->getType(); },
           ::py::return_value_policy::reference_internal)
+      .def(
+          "getLastNumIterations",
+          +[](const dart::constraint::BoxedLcpSolver* self) -> std::size_t {
+            return self->getLastNumIterations();
+          })
       .def(
           "solve",
           +[](dart::constraint::BoxedLcpSolver* self,
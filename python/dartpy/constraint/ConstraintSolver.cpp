@@ -137,6 +137,68 @@ void ConstraintSolver(py::module& m)
           +[](const dart::constraint::ConstraintSolver* self) -> double {
             return self->getTimeStep();
           })
+      .def(
+          "setNumThreads",
+          +[](dart::constraint::ConstraintSolver* self,
+              std::size_t numThreads) { self->setNumThreads(numThreads); },
+          ::py::arg("numThreads"))
+      .def(
+          "getNumThreads",
+          +[](const dart::constraint::ConstraintSolver* self) -> std::size_t {
+            return self->getNumThreads();
+          })
+      .def(
+          "setContactWarmStarting",
+          +[](dart::constraint::ConstraintSolver* self, bool enabled) {
+            self->setContactWarmStarting(enabled);
+          },
+          ::py::arg("enabled"))
+      .def(
+          "isContactWarmStarting",
+          +[](const dart::constraint::ConstraintSolver* self) -> bool {
+            return self->isContactWarmStarting();
+          })
+      .def(
+          "setContactWarmStartingDistance",
+          +[](dart::constraint::ConstraintSolver* self, double distance) {
+            self->setContactWarmStartingDistance(distance);
+          },
+          ::py::arg("distance"))
+      .def(
+          "getContactWarmStartingDistance",
+          +[](const dart::constraint::ConstraintSolver* self) -> double {
+            return self->getContactWarmStartingDistance();
+          })
+      .def(
+          "setStatisticsEnabled",
+          +[](dart::constraint::ConstraintSolver* self, bool enabled) {
+            self->setStatisticsEnabled(enabled);
+          },
+          ::py::arg("enabled"))
+      .def(
+          "isStatisticsEnabled",
+          +[](const dart::constraint::ConstraintSolver* self) -> bool {
+            return self->isStatisticsEnabled();
+          })
+      .def(
+          "getStatistics",
+          +[](const dart::constraint::ConstraintSolver* self)
+              -> const dart::constraint::ConstraintSolverStatistics& {
+            return self->getStatistics();
+          },
+          ::py::return_value_policy::reference_internal)
+      .def(
+          "getNumConstrainedGroups",
+          +[](const dart::constraint::ConstraintSolver* self) -> std::size_t {
+            return self->getNumConstrainedGroups();
+          })
+      .def(
+          "getConstrainedGroupIndex",
+          +[](const dart::constraint::ConstraintSolver* self,
+              const dart::dynamics::Skeleton& skeleton) -> std::size_t {
+            return self->getConstrainedGroupIndex(skeleton);
+          },
+          ::py::arg("skeleton"))
       .def(
           "setCollisionDetector",
           +[](dart::constraint::ConstraintSolver* self,
@@ -46,6 +46,7 @@ void BoxedLcpSolver(py::module& sm);
 void DantzigBoxedLcpSolver(py::module& sm);
 void PgsBoxedLcpSolver(py::module& sm);
 
+void ConstraintSolverStatistics(py::module& sm);
 void ConstraintSolver(py::module& sm);
 void BoxedLcpConstraintSolver(py::module& sm);
 
@@ -62,6 +63,7 @@ void dart_constraint(py::module& m)
   DantzigBoxedLcpSolver(sm);
   PgsBoxedLcpSolver(sm);
 
+  ConstraintSolverStatistics(sm);
   ConstraintSolver(sm);
   BoxedLcpConstraintSolver(sm);
 }
@@ -272,6 +272,28 @@ void ShapeFrame(py::module& m)
           "isCollidable",
           +[](const dart::dynamics::CollisionAspect* self) -> bool {
             return self->isCollidable();
+          })
+      .def(
+          "setCollisionCategories",
+          +[](dart::dynamics::CollisionAspect* self,
+              const std::uint32_t& value) {
+            self->setCollisionCategories(value);
+          },
+          ::py::arg("value"))
+      .def(
+          "getCollisionCategories",
+          +[](const dart::dynamics::CollisionAspect* self) -> std::uint32_t {
+            return self->getCollisionCategories();
+          })
+      .def(
+          "setCollisionMask",
+          +[](dart::dynamics::CollisionAspect* self,
+              const std::uint32_t& value) { self->setCollisionMask(value); },
+          ::py::arg("value"))
+      .def(
+          "getCollisionMask",
+          +[](const dart::dynamics::CollisionAspect* self) -> std::uint32_t {
+            return self->getCollisionMask();
           });
 
   ::py::class_<dart::dynamics::DynamicsAspect>(m, "DynamicsAspect")
@@ -307,6 +307,17 @@ void Skeleton(py::module& m)
           +[](const dart::dynamics::Skeleton* self) -> bool {
             return self->isMobile();
           })
+      .def(
+          "setSleeping",
+          +[](dart::dynamics::Skeleton* self, bool sleeping) -> void {
+            self->setSleeping(sleeping);
+          },
+          ::py::arg("sleeping"))
+      .def(
+          "isSleeping",
+          +[](const dart::dynamics::Skeleton* self) -> bool {
+            return self->isSleeping();
+          })
       .def(
           "setTimeStep",
           +[](dart::dynamics::Skeleton* self, double _timeStep) -> void {
@@ -720,6 +731,36 @@ void Skeleton(py::module& m)
           ::py::arg("withExternalForces"),
           ::py::arg("withDampingForces"),
           ::py::arg("withSpringForces"))
+      .def(
+          "computeInverseDynamicsDerivatives",
+          +[](const dart::dynamics::Skeleton* self,
+              bool withExternalForces,
+              bool withDampingForces,
+              bool withSpringForces)
+              -> std::tuple<Eigen::MatrixXd, Eigen::MatrixXd> {
+            Eigen::MatrixXd tauDq;
+            Eigen::MatrixXd tauDdq;
+            self->computeInverseDynamicsDerivatives(
+                tauDq,
+                tauDdq,
+                withExternalForces,
+                withDampingForces,
+                withSpringForces);
+            return std::make_tuple(tauDq, tauDdq);
+          },
+          ::py::arg("withExternalForces") = false,
+          ::py::arg("withDampingForces") = false,
+          ::py::arg("withSpringForces") = false)
+      .def(
+          "computeForwardDynamicsDerivatives",
+          +[](dart::dynamics::Skeleton* self)
+              -> std::tuple<Eigen::MatrixXd, Eigen::MatrixXd, Eigen::MatrixXd> {
+            Eigen::MatrixXd ddqDq;
+            Eigen::MatrixXd ddqDdq;
+            Eigen::MatrixXd ddqDtau;
+            self->computeForwardDynamicsDerivatives(ddqDq, ddqDdq, ddqDtau);
+            return std::make_tuple(ddqDq, ddqDdq, ddqDtau);
+          })
       .def(
           "clearConstraintImpulses",
           +[](dart::dynamics::Skeleton* self) -> void {
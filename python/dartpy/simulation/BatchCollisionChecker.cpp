@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <dart/simulation/BatchCollisionChecker.hpp>
+#include <dart/simulation/World.hpp>
+
+#include <pybind11/eigen.h>
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+namespace dart {
+namespace python {
+
+void BatchCollisionChecker(py::module& m)
+{
+  ::py::class_<
+      dart::simulation::BatchCollisionChecker,
+      std::shared_ptr<dart::simulation::BatchCollisionChecker>>(
+      m, "BatchCollisionChecker")
+      .def(
+          ::py::init<
+              const dart::simulation::World&,
+              std::size_t,
+              std::size_t>(),
+          ::py::arg("world"),
+          ::py::arg("skeletonIndex"),
+          ::py::arg("numThreads") = 0)
+      .def(
+          "getNumDofs",
+          +[](const dart::simulation::BatchCollisionChecker* self)
+              -> std::size_t { return self->getNumDofs(); })
+      .def(
+          "getNumThreads",
+          +[](const dart::simulation::BatchCollisionChecker* self)
+              -> std::size_t { return self->getNumThreads(); })
+      .def(
+          "checkValidity",
+          +[](dart::simulation::BatchCollisionChecker* self,
+              const Eigen::VectorXd& positions) -> bool {
+            return self->checkValidity(positions);
+          },
+          ::py::arg("positions"))
+      .def(
+          "checkValidityBatch",
+          +[](dart::simulation::BatchCollisionChecker* self,
+              const Eigen::Ref<
+                  const dart::simulation::BatchCollisionChecker::Matrix>&
+                  positions) {
+            // Unpack the bitmask into one boolean per configuration
+            std::vector<std::uint64_t> validity;
+            {
+              ::py::gil_scoped_release release;
+              self->checkValidity(positions, validity);
+            }
+
+            Eigen::Matrix<bool, Eigen::Dynamic, 1> valid(positions.rows());
+            for (Eigen::Index i = 0; i < valid.size(); ++i) {
+              valid[i] = dart::simulation::BatchCollisionChecker::isValid(
+                  validity, static_cast<std::size_t>(i));
+            }
+            return valid;
+          },
+          ::py::arg("positions"));
+}
+
+} // namespace python
+} // namespace dart
@@ -251,6 +251,82 @@ void World(py::module& m)
           +[](const dart::simulation::World* self) -> int {
             return self->getSimFrames();
           })
+      .def(
+          "getStateSize",
+          +[](const dart::simulation::World* self) -> std::size_t {
+            return self->getStateSize();
+          })
+      .def(
+          "saveState",
+          +[](const dart::simulation::World* self) -> ::py::bytes {
+            std::vector<char> buffer;
+            self->saveState(buffer);
+            return ::py::bytes(buffer.data(), buffer.size());
+          })
+      .def(
+          "restoreState",
+          +[](dart::simulation::World* self, const std::string& state)
+              -> bool {
+            return self->restoreState(
+                std::vector<char>(state.begin(), state.end()));
+          },
+          ::py::arg("state"))
+      .def(
+          "setStepStatisticsEnabled",
+          +[](dart::simulation::World* self, bool enabled) {
+            self->setStepStatisticsEnabled(enabled);
+          },
+          ::py::arg("enabled"))
+      .def(
+          "isStepStatisticsEnabled",
+          +[](const dart::simulation::World* self) -> bool {
+            return self->isStepStatisticsEnabled();
+          })
+      .def(
+          "getStepStatistics",
+          +[](const dart::simulation::World* self)
+              -> const dart::simulation::StepStatistics& {
+            return self->getStepStatistics();
+          },
+          ::py::return_value_policy::reference_internal)
+      .def(
+          "setSleepingEnabled",
+          +[](dart::simulation::World* self, bool enabled) {
+            self->setSleepingEnabled(enabled);
+          },
+          ::py::arg("enabled"))
+      .def(
+          "isSleepingEnabled",
+          +[](const dart::simulation::World* self) -> bool {
+            return self->isSleepingEnabled();
+          })
+      .def(
+          "setSleepThreshold",
+          +[](dart::simulation::World* self, double threshold) {
+            self->setSleepThreshold(threshold);
+          },
+          ::py::arg("threshold"))
+      .def(
+          "getSleepThreshold",
+          +[](const dart::simulation::World* self) -> double {
+            return self->getSleepThreshold();
+          })
+      .def(
+          "setNumStepsToSleep",
+          +[](dart::simulation::World* self, std::size_t numSteps) {
+            self->setNumStepsToSleep(numSteps);
+          },
+          ::py::arg("numSteps"))
+      .def(
+          "getNumStepsToSleep",
+          +[](const dart::simulation::World* self) -> std::size_t {
+            return self->getNumStepsToSleep();
+          })
+      .def(
+          "getNumSleepingSkeletons",
+          +[](const dart::simulation::World* self) -> std::size_t {
+            return self->getNumSleepingSkeletons();
+          })
       .def(
           "getConstraintSolver",
           +[](dart::simulation::World* self) -> constraint::ConstraintSolver* {
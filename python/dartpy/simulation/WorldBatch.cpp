@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <dart/simulation/World.hpp>
+#include <dart/simulation/WorldBatch.hpp>
+
+#include <pybind11/eigen.h>
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+namespace dart {
+namespace python {
+
+void WorldBatch(py::module& m)
+{
+  // The state and command matrices are returned as NumPy views that share
+  // memory with the batch, so they must not outlive it.
+  ::py::class_<
+      dart::simulation::WorldBatch,
+      std::shared_ptr<dart::simulation::WorldBatch>>(m, "WorldBatch")
+      .def(
+          ::py::init<
+              const dart::simulation::World&,
+              std::size_t,
+              std::size_t>(),
+          ::py::arg("world"),
+          ::py::arg("numWorlds"),
+          ::py::arg("numThreads") = 0)
+      .def(
+          "getNumWorlds",
+          +[](const dart::simulation::WorldBatch* self) -> std::size_t {
+            return self->getNumWorlds();
+          })
+      .def(
+          "getNumDofs",
+          +[](const dart::simulation::WorldBatch* self) -> std::size_t {
+            return self->getNumDofs();
+          })
+      .def(
+          "getNumThreads",
+          +[](const dart::simulation::WorldBatch* self) -> std::size_t {
+            return self->getNumThreads();
+          })
+      .def(
+          "getWorld",
+          +[](const dart::simulation::WorldBatch* self,
+              std::size_t index) -> dart::simulation::WorldPtr {
+            return self->getWorld(index);
+          },
+          ::py::arg("index"))
+      .def(
+          "getPositions",
+          +[](const dart::simulation::WorldBatch* self)
+              -> const dart::simulation::WorldBatch::Matrix& {
+            return self->getPositions();
+          },
+          ::py::return_value_policy::reference_internal)
+      .def(
+          "getVelocities",
+          +[](const dart::simulation::WorldBatch* self)
+              -> const dart::simulation::WorldBatch::Matrix& {
+            return self->getVelocities();
+          },
+          ::py::return_value_policy::reference_internal)
+      .def(
+          "getCommands",
+          +[](dart::simulation::WorldBatch* self)
+              -> dart::simulation::WorldBatch::Matrix& {
+            return self->getCommands();
+          },
+          ::py::return_value_policy::reference_internal)
+      .def(
+          "setState",
+          +[](dart::simulation::WorldBatch* self,
+              std::size_t index,
+              const Eigen::VectorXd& positions,
+              const Eigen::VectorXd& velocities) {
+            self->setState(index, positions, velocities);
+          },
+          ::py::arg("index"),
+          ::py::arg("positions"),
+          ::py::arg("velocities"))
+      .def(
+          "reset",
+          +[](dart::simulation::WorldBatch* self, std::size_t index) {
+            self->reset(index);
+          },
+          ::py::arg("index"))
+      .def(
+          "step",
+          +[](dart::simulation::WorldBatch* self, std::size_t numSteps) {
+            self->step(numSteps);
+          },
+          ::py::arg("numSteps") = 1,
+          ::py::call_guard<::py::gil_scoped_release>())
+      .def("syncStates", +[](dart::simulation::WorldBatch* self) {
+        self->syncStates();
+      });
+}
+
+} // namespace python
+} // namespace dart
@@ -37,13 +37,19 @@ namespace py = pybind11;
 namespace dart {
 namespace python {
 
+void BatchCollisionChecker(py::module& sm);
+void StepStatistics(py::module& sm);
 void World(py::module& sm);
+void WorldBatch(py::module& sm);
 
 void dart_simulation(py::module& m)
 {
   auto sm = m.def_submodule("simulation");
 
+  StepStatistics(sm);
   World(sm);
+  WorldBatch(sm);
+  BatchCollisionChecker(sm);
 }
 
 } // namespace python
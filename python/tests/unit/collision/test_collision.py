@@ -245,5 +245,29 @@ def test_raycast():
     assert ray_hit.mFraction == pytest.approx(0.5)
 
 
+def test_raycast_batch():
+    cd = dart.collision.DARTCollisionDetector()
+    cd.setNumThreads(2)
+
+    simple_frame = dart.dynamics.SimpleFrame()
+    simple_frame.setShape(dart.dynamics.SphereShape(1))
+
+    group = cd.createCollisionGroup()
+    group.addShapeFrame(simple_frame)
+
+    # One ray per column; the second ray is too short to reach the sphere
+    origins = np.array([[-2.0, 0.0, 0.0], [0.0, 3.0, 0.0]]).T
+    directions = np.array([[4.0, 0.0, 0.0], [0.0, -1.0, 0.0]]).T
+
+    result = dart.collision.RaycastBatchResult()
+    assert group.raycastBatch(origins, directions, result) == 1
+    assert result.getNumRays() == 2
+    assert result.mDistances[0] == pytest.approx(1.0)
+    assert np.isclose(result.mNormals[:, 0], [-1, 0, 0]).all()
+    assert result.mCollisionObjects[0] is not None
+    assert np.isinf(result.mDistances[1])
+    assert result.mCollisionObjects[1] is None
+
+
 if __name__ == "__main__":
     pytest.main()
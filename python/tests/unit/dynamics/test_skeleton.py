@@ -19,5 +19,24 @@ def test_basic():
     assert skel.getBodyNodes()[0].getName() == body1.getName()
 
 
+def test_forward_dynamics_derivatives():
+    skel = dart.dynamics.Skeleton()
+    joint, body = skel.createRevoluteJointAndBodyNodePair()
+    joint.setAxis([0, 1, 0])
+    joint.setDampingCoefficient(0, 0.5)
+    body.setMass(2.0)
+    skel.setPositions([0.3])
+    skel.setVelocities([-0.7])
+
+    ddq_dq, ddq_ddq, ddq_dtau = skel.computeForwardDynamicsDerivatives()
+    assert ddq_dq.shape == (1, 1)
+    assert ddq_ddq.shape == (1, 1)
+    assert ddq_dtau.shape == (1, 1)
+
+    inv_aug_mass = np.linalg.inv(skel.getAugMassMatrix())
+    assert np.allclose(ddq_dtau, inv_aug_mass)
+    assert np.allclose(ddq_ddq, -0.5 * inv_aug_mass)
+
+
 if __name__ == "__main__":
     pytest.main()
@@ -41,5 +41,117 @@ def test_collision_detector_change():
         )
 
 
+def test_step_statistics():
+    world = dart.simulation.World("world")
+    world.getConstraintSolver().setCollisionDetector(
+        dart.collision.DARTCollisionDetector()
+    )
+
+    ground = dart.dynamics.Skeleton("ground")
+    [_, ground_body] = ground.createWeldJointAndBodyNodePair()
+    ground_shape = dart.dynamics.BoxShape([10.0, 10.0, 0.1])
+    ground_shape_node = ground_body.createShapeNode(ground_shape)
+    ground_shape_node.createCollisionAspect()
+    ground_shape_node.createDynamicsAspect()
+    world.addSkeleton(ground)
+
+    box = dart.dynamics.Skeleton("box")
+    [_, box_body] = box.createFreeJointAndBodyNodePair()
+    box_shape = dart.dynamics.BoxShape([0.5, 0.5, 0.5])
+    box_shape_node = box_body.createShapeNode(box_shape)
+    box_shape_node.createCollisionAspect()
+    box_shape_node.createDynamicsAspect()
+    box.setPosition(5, 0.29)
+    world.addSkeleton(box)
+
+    assert not world.isStepStatisticsEnabled()
+    world.setStepStatisticsEnabled(True)
+    assert world.getConstraintSolver().isStatisticsEnabled()
+
+    world.step()
+    statistics = world.getStepStatistics()
+    assert statistics.stepTime > 0.0
+    assert statistics.constraintSolver.numContacts > 0
+    assert statistics.constraintSolver.numConstrainedGroups == 1
+    assert statistics.constraintSolver.numLcpSolves == 1
+    assert statistics.constraintSolver.numSecondaryLcpSolves == 0
+
+
+def test_sleeping():
+    world = dart.simulation.World("world")
+    world.getConstraintSolver().setCollisionDetector(
+        dart.collision.DARTCollisionDetector()
+    )
+
+    ground = dart.dynamics.Skeleton("ground")
+    [_, ground_body] = ground.createWeldJointAndBodyNodePair()
+    ground_shape = dart.dynamics.BoxShape([10.0, 10.0, 0.1])
+    ground_shape_node = ground_body.createShapeNode(ground_shape)
+    ground_shape_node.createCollisionAspect()
+    ground_shape_node.createDynamicsAspect()
+    world.addSkeleton(ground)
+
+    box = dart.dynamics.Skeleton("box")
+    [_, box_body] = box.createFreeJointAndBodyNodePair()
+    box_shape = dart.dynamics.BoxShape([0.5, 0.5, 0.5])
+    box_shape_node = box_body.createShapeNode(box_shape)
+    box_shape_node.createCollisionAspect()
+    box_shape_node.createDynamicsAspect()
+    box.setPosition(5, 0.299)
+    world.addSkeleton(box)
+
+    assert not world.isSleepingEnabled()
+    world.setSleepingEnabled(True)
+    world.setSleepThreshold(1e-3)
+    world.setNumStepsToSleep(10)
+    assert world.isSleepingEnabled()
+    assert world.getSleepThreshold() == pytest.approx(1e-3)
+    assert world.getNumStepsToSleep() == 10
+
+    for _ in range(2000):
+        world.step()
+        if box.isSleeping():
+            break
+    assert box.isSleeping()
+    assert world.getNumSleepingSkeletons() == 1
+
+    box.setSleeping(False)
+    assert world.getNumSleepingSkeletons() == 0
+
+
+def test_save_and_restore_state():
+    world = dart.simulation.World("world")
+    world.getConstraintSolver().setCollisionDetector(
+        dart.collision.DARTCollisionDetector()
+    )
+
+    box = dart.dynamics.Skeleton("box")
+    [_, box_body] = box.createFreeJointAndBodyNodePair()
+    box_shape = dart.dynamics.BoxShape([0.5, 0.5, 0.5])
+    box_shape_node = box_body.createShapeNode(box_shape)
+    box_shape_node.createCollisionAspect()
+    box_shape_node.createDynamicsAspect()
+    box.setVelocity(0, 1.0)
+    world.addSkeleton(box)
+
+    for _ in range(10):
+        world.step()
+
+    state = world.saveState()
+    assert len(state) == world.getStateSize()
+    time = world.getTime()
+    positions = box.getPositions()
+
+    for _ in range(10):
+        world.step()
+    assert world.getTime() != time
+
+    assert world.restoreState(state)
+    assert world.getTime() == time
+    assert box.getPositions() == pytest.approx(positions)
+
+    assert not world.restoreState(b"")
+
+
 if __name__ == "__main__":
     pytest.main()
@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+"""Compare Google Benchmark results against a stored baseline.
+
+Typical usage:
+
+    # Record a baseline from one or more benchmark runs
+    ./build/bin/BM_UNIT_dynamics --benchmark_out=dynamics.json
+    python3 scripts/compare_benchmarks.py --save baseline.json dynamics.json
+
+    # Compare a later run against the baseline
+    python3 scripts/compare_benchmarks.py baseline.json dynamics.json
+
+The inputs are the JSON files written by ``--benchmark_out``. Benchmarks are
+matched by name. When a run contains repetitions, the ``median`` aggregate is
+used instead of the individual repetitions. The script exits with a non-zero
+status when any benchmark is slower than the baseline by more than the given
+threshold.
+"""
+
+import argparse
+import json
+import sys
+
+# Conversion factors from Google Benchmark time units to nanoseconds
+TIME_UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_benchmarks(paths):
+    """Merges the benchmarks of several result files into one context."""
+    context = None
+    benchmarks = []
+    for path in paths:
+        with open(path) as f:
+            data = json.load(f)
+        if context is None:
+            context = data.get("context", {})
+        benchmarks.extend(data.get("benchmarks", []))
+    return {"context": context or {}, "benchmarks": benchmarks}
+
+
+def collect_times(benchmarks):
+    """Returns a map from benchmark name to CPU time in nanoseconds."""
+    times = {}
+    medians = {}
+    for entry in benchmarks:
+        if "error_occurred" in entry and entry["error_occurred"]:
+            continue
+        scale = TIME_UNITS[entry.get("time_unit", "ns")]
+        cpu_time = entry["cpu_time"] * scale
+        if entry.get("run_type") == "aggregate":
+            if entry.get("aggregate_name") == "median":
+                medians[entry["run_name"]] = cpu_time
+            continue
+        name = entry.get("run_name", entry["name"])
+        # Keep the fastest of the repetitions when no aggregate is available
+        times[name] = min(cpu_time, times.get(name, cpu_time))
+    times.update(medians)
+    return times
+
+
+# Context entries that must match for the timings to be comparable
+CONTEXT_KEYS = ("host_name", "num_cpus", "mhz_per_cpu", "dart_build_type")
+
+
+def check_context(baseline, current):
+    """Prints the context of both runs and warns about differences."""
+    for key in CONTEXT_KEYS + ("dart_commit",):
+        print(
+            "%-16s %-24s %s"
+            % (key, baseline.get(key, "unknown"), current.get(key, "unknown"))
+        )
+    print()
+
+    for key in CONTEXT_KEYS:
+        if baseline.get(key) != current.get(key):
+            print(
+                "Warning: %s differs from the baseline, so the timings may not "
+                "be comparable" % key,
+                file=sys.stderr,
+            )
+    if current.get("dart_build_type", "Release") != "Release":
+        print("Warning: the results are not from a Release build", file=sys.stderr)
+
+
+def format_time(nanoseconds):
+    for unit in ("s", "ms", "us"):
+        if nanoseconds >= TIME_UNITS[unit]:
+            return "%.3f %s" % (nanoseconds / TIME_UNITS[unit], unit)
+    return "%.1f ns" % nanoseconds
+
+
+def compare(baseline, current, threshold):
+    """Prints a comparison table and returns the names of the regressions."""
+    regressions = []
+    names = sorted(set(baseline) | set(current))
+    width = max([len(name) for name in names] + [len("Benchmark")])
+
+    print("%-*s %14s %14s %9s" % (width, "Benchmark", "Baseline", "Current", "Change"))
+    for name in names:
+        if name not in current:
+            print("%-*s %14s %14s %9s" % (width, name, "", "missing", ""))
+            continue
+        if name not in baseline:
+            print(
+                "%-*s %14s %14s %9s"
+                % (width, name, "new", format_time(current[name]), "")
+            )
+            continue
+
+        change = current[name] / baseline[name] - 1.0
+        status = ""
+        if change > threshold:
+            status = "  REGRESSION"
+            regressions.append(name)
+        elif change < -threshold:
+            status = "  improved"
+        print(
+            "%-*s %14s %14s %+8.1f%%%s"
+            % (
+                width,
+                name,
+                format_time(baseline[name]),
+                format_time(current[name]),
+                100.0 * change,
+                status,
+            )
+        )
+
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare Google Benchmark JSON results to a baseline."
+    )
+    parser.add_argument(
+        "baseline",
+        help="baseline JSON file, or the output file when --save is given",
+    )
+    parser.add_argument(
+        "results", nargs="+", help="JSON files written by --benchmark_out"
+    )
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.1,
+        help="relative slowdown reported as a regression (default: 0.1)",
+    )
+    parser.add_argument(
+        "--save",
+        action="store_true",
+        help="merge the results and write them as the new baseline",
+    )
+    args = parser.parse_args()
+
+    current = load_benchmarks(args.results)
+
+    if args.save:
+        # The remaining context describes the machine and the build the
+        # baseline was run on
+        current["context"].pop("executable", None)
+        with open(args.baseline, "w") as f:
+            json.dump(current, f, indent=2)
+            f.write("\n")
+        print("Saved %d benchmarks to %s" % (len(current["benchmarks"]), args.baseline))
+        return 0
+
+    baseline = load_benchmarks([args.baseline])
+    check_context(baseline["context"], current["context"])
+    regressions = compare(
+        collect_times(baseline["benchmarks"]),
+        collect_times(current["benchmarks"]),
+        args.threshold,
+    )
+
+    if regressions:
+        print(
+            "\n%d benchmark(s) regressed by more than %.0f%%"
+            % (len(regressions), 100.0 * args.threshold)
+        )
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,70 @@
+#!/usr/bin/env bash
+set -e
+
+# Runs the benchmark suite and writes one Google Benchmark JSON file per
+# executable into the output directory. The results can be saved as a baseline
+# or compared against one with scripts/compare_benchmarks.py.
+#
+# Baselines are machine specific, so none is checked in. Record one locally
+# from a Release build with every collision backend and parser enabled, e.g.
+# on the commit to compare against (or run "pixi run bm-baseline"):
+#
+#   scripts/run_benchmarks.sh build/bin build/benchmarks
+#   python3 scripts/compare_benchmarks.py --save build/benchmark_baseline.json \
+#     build/benchmarks/*.json
+#
+# and then compare the runs of later commits (or run "pixi run bm-compare"):
+#
+#   python3 scripts/compare_benchmarks.py build/benchmark_baseline.json \
+#     build/benchmarks/*.json
+#
+# Usage: ./run_benchmarks.sh <bin-dir> <output-dir> [<benchmark-args> ...]
+
+if [ "$#" -lt 2 ]; then
+  echo "Usage: ./run_benchmarks.sh <bin-dir> <output-dir> [<args> ...]" >&2
+  exit 1
+fi
+
+bin_dir=$1
+output_dir=$2
+shift 2
+
+benchmarks=(
+  BM_UNIT_dynamics
+  BM_UNIT_lcp
+  BM_INTEGRATION_constraint
+  BM_INTEGRATION_collision
+  BM_INTEGRATION_parsers
+)
+
+# Record the build of DART next to the machine that Google Benchmark
+# describes, since timings of other builds are not comparable
+build_type=unknown
+if [ -f "$bin_dir/../CMakeCache.txt" ]; then
+  build_type=$(sed -n 's/^CMAKE_BUILD_TYPE:[A-Z]*=//p' \
+    "$bin_dir/../CMakeCache.txt")
+fi
+if [ "$build_type" != "Release" ]; then
+  echo "Warning: benchmarking a ${build_type:-unknown} build;" \
+    "record baselines from a Release build" >&2
+fi
+commit=$(git rev-parse --short HEAD 2>/dev/null || echo unknown)
+
+mkdir -p "$output_dir"
+rm -f "$output_dir"/*.json
+
+for benchmark in "${benchmarks[@]}"; do
+  # Optional benchmarks are not built when their dependencies are missing
+  if [ ! -x "$bin_dir/$benchmark" ]; then
+    echo "Skipping $benchmark: not built"
+    continue
+  fi
+
+  "$bin_dir/$benchmark" \
+    --benchmark_repetitions=5 \
+    --benchmark_report_aggregates_only=true \
+    --benchmark_out_format=json \
+    --benchmark_out="$output_dir/$benchmark.json" \
+    --benchmark_context="dart_build_type=${build_type:-unknown},dart_commit=$commit" \
+    "$@"
+done
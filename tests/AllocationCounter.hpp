@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_UNITTESTS_ALLOCATIONCOUNTER_HPP_
+#define DART_UNITTESTS_ALLOCATIONCOUNTER_HPP_
+
+// Counts the heap allocations of the process, including the ones of Eigen,
+// which bypasses operator new, by interposing the malloc family of glibc.
+//
+// The functions are defined here rather than declared, so this header must be
+// included by exactly one translation unit of a test executable.
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+
+#if defined(__GLIBC__)
+  #define DART_TEST_CAN_COUNT_ALLOCATIONS 1
+#else
+  #define DART_TEST_CAN_COUNT_ALLOCATIONS 0
+#endif
+
+namespace dart {
+namespace test {
+
+/// Number of heap allocations made by the process so far
+inline std::atomic<std::size_t> gNumAllocations{0u};
+
+/// Returns the number of heap allocations made by the process so far, which is
+/// always zero when DART_TEST_CAN_COUNT_ALLOCATIONS is 0.
+inline std::size_t getNumAllocations()
+{
+  return gNumAllocations.load(std::memory_order_relaxed);
+}
+
+} // namespace test
+} // namespace dart
+
+#if DART_TEST_CAN_COUNT_ALLOCATIONS
+
+extern "C" {
+
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t num, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+
+//==============================================================================
+void* malloc(std::size_t size) noexcept
+{
+  dart::test::gNumAllocations.fetch_add(1u, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+
+//==============================================================================
+void* calloc(std::size_t num, std::size_t size) noexcept
+{
+  dart::test::gNumAllocations.fetch_add(1u, std::memory_order_relaxed);
+  return __libc_calloc(num, size);
+}
+
+//==============================================================================
+void* realloc(void* ptr, std::size_t size) noexcept
+{
+  dart::test::gNumAllocations.fetch_add(1u, std::memory_order_relaxed);
+  return __libc_realloc(ptr, size);
+}
+
+//==============================================================================
+void* aligned_alloc(std::size_t alignment, std::size_t size) noexcept
+{
+  dart::test::gNumAllocations.fetch_add(1u, std::memory_order_relaxed);
+  return __libc_memalign(alignment, size);
+}
+
+//==============================================================================
+int posix_memalign(void** ptr, std::size_t alignment, std::size_t size) noexcept
+{
+  dart::test::gNumAllocations.fetch_add(1u, std::memory_order_relaxed);
+  *ptr = __libc_memalign(alignment, size);
+  return *ptr ? 0 : ENOMEM;
+}
+
+} // extern "C"
+
+#endif // DART_TEST_CAN_COUNT_ALLOCATIONS
+
+#endif // DART_UNITTESTS_ALLOCATIONCOUNTER_HPP_
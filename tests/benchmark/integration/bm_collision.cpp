@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <dart/config.hpp>
+
+#include <dart/collision/collision.hpp>
+#include <dart/collision/dart/DARTCollisionDetector.hpp>
+#include <dart/collision/fcl/FCLCollisionDetector.hpp>
+#if HAVE_BULLET
+  #include <dart/collision/bullet/BulletCollisionDetector.hpp>
+#endif
+#if HAVE_ODE
+  #include <dart/collision/ode/OdeCollisionDetector.hpp>
+#endif
+
+#include <dart/dynamics/dynamics.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace dart;
+
+namespace {
+
+/// Creates dim x dim x dim alternating boxes and spheres whose neighbours
+/// overlap slightly, so every backend is given the same shapes and the same
+/// contacting pairs.
+[[nodiscard]] std::vector<dynamics::SkeletonPtr> createScene(std::size_t dim)
+{
+  std::vector<dynamics::SkeletonPtr> skeletons;
+
+  std::size_t index = 0u;
+  for (auto i = 0u; i < dim; ++i) {
+    for (auto j = 0u; j < dim; ++j) {
+      for (auto k = 0u; k < dim; ++k) {
+        auto skel = dynamics::Skeleton::create("body" + std::to_string(index));
+        auto body
+            = skel->createJointAndBodyNodePair<dynamics::FreeJoint>().second;
+
+        dynamics::ShapePtr shape;
+        if (index++ % 2u == 0u) {
+          shape = std::make_shared<dynamics::BoxShape>(
+              Eigen::Vector3d::Constant(1.05));
+        } else {
+          shape = std::make_shared<dynamics::SphereShape>(0.525);
+        }
+        body->createShapeNodeWith<dynamics::CollisionAspect>(shape);
+
+        Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+        tf.translation() = Eigen::Vector3d(i, j, k);
+        body->getParentJoint()->setTransformFromParentBodyNode(tf);
+
+        skeletons.push_back(skel);
+      }
+    }
+  }
+
+  return skeletons;
+}
+
+} // namespace
+
+template <typename Detector>
+static void BM_Collide(benchmark::State& state)
+{
+  const auto skeletons = createScene(state.range(0));
+  auto detector = Detector::create();
+  auto group = detector->createCollisionGroup();
+  for (const auto& skel : skeletons)
+    group->addShapeFramesOf(skel.get());
+
+  collision::CollisionOption option;
+  option.maxNumContacts = 10000u;
+  collision::CollisionResult result;
+
+  for (auto _ : state) {
+    result.clear();
+    group->collide(option, &result);
+  }
+
+  state.counters["contacts"] = result.getNumContacts();
+}
+
+BENCHMARK_TEMPLATE(BM_Collide, collision::DARTCollisionDetector)
+    ->ArgName("dim")
+    ->Arg(3)
+    ->Arg(6);
+BENCHMARK_TEMPLATE(BM_Collide, collision::FCLCollisionDetector)
+    ->ArgName("dim")
+    ->Arg(3)
+    ->Arg(6);
+#if HAVE_BULLET
+BENCHMARK_TEMPLATE(BM_Collide, collision::BulletCollisionDetector)
+    ->ArgName("dim")
+    ->Arg(3)
+    ->Arg(6);
+#endif
+#if HAVE_ODE
+BENCHMARK_TEMPLATE(BM_Collide, collision::OdeCollisionDetector)
+    ->ArgName("dim")
+    ->Arg(3)
+    ->Arg(6);
+#endif
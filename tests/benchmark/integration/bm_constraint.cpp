@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <dart/simulation/simulation.hpp>
+
+#include <dart/constraint/constraint.hpp>
+
+#include <dart/collision/dart/DARTCollisionDetector.hpp>
+
+#include <dart/dynamics/dynamics.hpp>
+
+#include <benchmark/benchmark.h>
+
+using namespace dart;
+
+namespace {
+
+/// Boxed LCP solver that leaves the solution untouched so that only the
+/// assembly of the LCP and the application of the impulses are measured
+class NullBoxedLcpSolver : public constraint::BoxedLcpSolver
+{
+public:
+  const std::string& getType() const override
+  {
+    static const std::string type = "NullBoxedLcpSolver";
+    return type;
+  }
+
+  bool solve(
+      int /*n*/,
+      double* /*A*/,
+      double* /*x*/,
+      double* /*b*/,
+      int /*nub*/,
+      double* /*lo*/,
+      double* /*hi*/,
+      int* /*findex*/,
+      bool /*earlyTermination*/) override
+  {
+    return true;
+  }
+
+#if DART_BUILD_MODE_DEBUG
+  bool canSolve(int /*n*/, const double* /*A*/) override
+  {
+    return true;
+  }
+#endif
+};
+
+/// Constraint solver that exposes the individual phases of solve()
+class PhaseConstraintSolver : public constraint::BoxedLcpConstraintSolver
+{
+public:
+  using constraint::BoxedLcpConstraintSolver::BoxedLcpConstraintSolver;
+  using constraint::ConstraintSolver::buildConstrainedGroups;
+  using constraint::ConstraintSolver::solveConstrainedGroups;
+  using constraint::ConstraintSolver::updateConstraints;
+};
+
+[[nodiscard]] dynamics::SkeletonPtr createBox(
+    const Eigen::Vector3d& position, std::size_t index)
+{
+  auto boxSkel = dynamics::Skeleton::create("box" + std::to_string(index));
+  auto boxBody
+      = boxSkel->createJointAndBodyNodePair<dynamics::FreeJoint>(nullptr)
+            .second;
+  boxBody->createShapeNodeWith<
+      dynamics::CollisionAspect,
+      dynamics::DynamicsAspect>(
+      std::make_shared<dynamics::BoxShape>(Eigen::Vector3d::Constant(0.9)));
+
+  Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+  tf.translation() = position;
+  boxBody->getParentJoint()->setTransformFromParentBodyNode(tf);
+
+  return boxSkel;
+}
+
+/// Creates dim x dim columns of dim boxes on a ground plate and steps the world
+/// until the boxes rest on each other, so that every benchmark iteration sees
+/// the same persistent set of contacts.
+[[nodiscard]] simulation::WorldPtr createSettledWorld(
+    std::size_t dim, PhaseConstraintSolver*& solver)
+{
+  auto world = simulation::World::create();
+
+  auto phaseSolver = std::make_unique<PhaseConstraintSolver>();
+  solver = phaseSolver.get();
+  world->setConstraintSolver(std::move(phaseSolver));
+  solver->setCollisionDetector(collision::DARTCollisionDetector::create());
+
+  std::size_t index = 0u;
+  for (auto i = 0u; i < dim; ++i) {
+    for (auto j = 0u; j < dim; ++j) {
+      for (auto k = 0u; k < dim; ++k) {
+        const Eigen::Vector3d position(
+            static_cast<double>(i) - 0.5 * dim,
+            static_cast<double>(j) - 0.5 * dim,
+            0.5 + static_cast<double>(k));
+        world->addSkeleton(createBox(position, index++));
+      }
+    }
+  }
+
+  auto ground = dynamics::Skeleton::create("ground");
+  auto groundBody
+      = ground->createJointAndBodyNodePair<dynamics::WeldJoint>().second;
+  groundBody->createShapeNodeWith<
+      dynamics::CollisionAspect,
+      dynamics::DynamicsAspect>(
+      std::make_shared<dynamics::BoxShape>(Eigen::Vector3d(20.0, 20.0, 0.1)));
+  Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+  tf.translation().z() = -0.05;
+  groundBody->getParentJoint()->setTransformFromParentBodyNode(tf);
+  world->addSkeleton(ground);
+
+  for (auto i = 0u; i < 200u; ++i)
+    world->step();
+
+  return world;
+}
+
+} // namespace
+
+static void BM_UpdateConstraints(benchmark::State& state)
+{
+  PhaseConstraintSolver* solver = nullptr;
+  auto world = createSettledWorld(state.range(0), solver);
+
+  for (auto _ : state) {
+    solver->updateConstraints();
+  }
+
+  state.counters["contacts"]
+      = solver->getLastCollisionResult().getNumContacts();
+}
+
+static void BM_LcpAssembly(benchmark::State& state)
+{
+  PhaseConstraintSolver* solver = nullptr;
+  auto world = createSettledWorld(state.range(0), solver);
+  solver->setBoxedLcpSolver(std::make_shared<NullBoxedLcpSolver>());
+  solver->setSecondaryBoxedLcpSolver(nullptr);
+  solver->updateConstraints();
+
+  for (auto _ : state) {
+    solver->buildConstrainedGroups();
+    solver->solveConstrainedGroups();
+  }
+
+  state.counters["contacts"]
+      = solver->getLastCollisionResult().getNumContacts();
+}
+
+static void BM_ConstraintSolve(benchmark::State& state)
+{
+  PhaseConstraintSolver* solver = nullptr;
+  auto world = createSettledWorld(state.range(0), solver);
+
+  for (auto _ : state) {
+    solver->solve();
+  }
+
+  state.counters["contacts"]
+      = solver->getLastCollisionResult().getNumContacts();
+}
+
+BENCHMARK(BM_UpdateConstraints)->ArgName("dim")->Arg(2)->Arg(4);
+BENCHMARK(BM_LcpAssembly)->ArgName("dim")->Arg(2)->Arg(4);
+BENCHMARK(BM_ConstraintSolve)->ArgName("dim")->Arg(2)->Arg(4);
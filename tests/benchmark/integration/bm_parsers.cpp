@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <dart/utils/urdf/urdf.hpp>
+#include <dart/utils/utils.hpp>
+
+#include <dart/simulation/simulation.hpp>
+
+#include <dart/dynamics/dynamics.hpp>
+
+#include <benchmark/benchmark.h>
+
+using namespace dart;
+
+static void BM_UrdfParser(benchmark::State& state, const std::string& uri)
+{
+  utils::DartLoader loader;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(loader.parseSkeleton(uri));
+  }
+}
+
+static void BM_SdfParser(benchmark::State& state, const std::string& uri)
+{
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utils::SdfParser::readWorld(uri));
+  }
+}
+
+static void BM_MjcfParser(benchmark::State& state, const std::string& uri)
+{
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utils::MjcfParser::readWorld(uri));
+  }
+}
+
+static void BM_SkelParser(benchmark::State& state, const std::string& uri)
+{
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utils::SkelParser::readWorld(uri));
+  }
+}
+
+BENCHMARK_CAPTURE(
+    BM_UrdfParser,
+    KR5,
+    std::string("dart://sample/urdf/KR5/KR5 sixx R650.urdf"))
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(
+    BM_UrdfParser, wam, std::string("dart://sample/urdf/wam/wam.urdf"))
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(
+    BM_SdfParser,
+    double_pendulum,
+    std::string("dart://sample/sdf/double_pendulum_with_base.world"))
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(
+    BM_MjcfParser, ant, std::string("dart://sample/mjcf/openai/ant.xml"))
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(
+    BM_SkelParser, fullbody1, std::string("dart://sample/skel/fullbody1.skel"))
+    ->Unit(benchmark::kMillisecond);
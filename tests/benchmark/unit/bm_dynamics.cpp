@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <dart/dynamics/dynamics.hpp>
+
+#include <dart/math/Random.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using namespace dart;
+
+namespace {
+
+/// Creates a tree of numBodies bodies connected by revolute joints with
+/// alternating axes, where each body gets numBranches children until the body
+/// count is reached. A branch count of one gives a serial chain.
+[[nodiscard]] dynamics::SkeletonPtr createTree(
+    std::size_t numBodies, std::size_t numBranches)
+{
+  auto skel = dynamics::Skeleton::create("tree");
+
+  std::vector<dynamics::BodyNode*> bodies;
+  bodies.reserve(numBodies);
+
+  for (auto i = 0u; i < numBodies; ++i) {
+    dynamics::BodyNode* parent
+        = bodies.empty() ? nullptr : bodies[(i - 1u) / numBranches];
+
+    dynamics::RevoluteJoint::Properties jointProperties;
+    jointProperties.mName = "joint" + std::to_string(i);
+    jointProperties.mAxis = (i % 2u == 0u) ? Eigen::Vector3d::UnitX()
+                                           : Eigen::Vector3d::UnitY();
+    jointProperties.mT_ParentBodyToJoint.translation()
+        = Eigen::Vector3d(0.0, 0.0, parent ? 0.5 : 0.0);
+
+    dynamics::BodyNode::Properties bodyProperties;
+    bodyProperties.mName = "body" + std::to_string(i);
+    bodyProperties.mInertia.setMass(1.0);
+    bodyProperties.mInertia.setLocalCOM(Eigen::Vector3d(0.0, 0.0, 0.25));
+
+    auto* body = skel->createJointAndBodyNodePair<dynamics::RevoluteJoint>(
+                         parent, jointProperties, bodyProperties)
+                     .second;
+    bodies.push_back(body);
+  }
+
+  return skel;
+}
+
+/// Random states to cycle through so that every iteration invalidates the
+/// cached dynamics quantities without paying for random number generation
+struct RandomStates
+{
+  explicit RandomStates(const dynamics::Skeleton& skel)
+  {
+    math::Random::setSeed(0u);
+    const auto numDofs = static_cast<int>(skel.getNumDofs());
+    for (auto i = 0u; i < mNumStates; ++i) {
+      mPositions.push_back(
+          math::Random::uniform<Eigen::VectorXd>(numDofs, -1.0, 1.0));
+      mVelocities.push_back(
+          math::Random::uniform<Eigen::VectorXd>(numDofs, -1.0, 1.0));
+    }
+  }
+
+  void setNext(dynamics::Skeleton& skel)
+  {
+    skel.setPositions(mPositions[mIndex]);
+    skel.setVelocities(mVelocities[mIndex]);
+    mIndex = (mIndex + 1u) % mNumStates;
+  }
+
+  static constexpr std::size_t mNumStates = 16u;
+  std::vector<Eigen::VectorXd> mPositions;
+  std::vector<Eigen::VectorXd> mVelocities;
+  std::size_t mIndex = 0u;
+};
+
+/// Arguments: number of bodies, number of children per body
+void treeArguments(benchmark::internal::Benchmark* benchmark)
+{
+  benchmark->ArgNames({"bodies", "branches"});
+  benchmark->Args({10, 1});
+  benchmark->Args({50, 1});
+  benchmark->Args({50, 3});
+  benchmark->Args({200, 3});
+}
+
+} // namespace
+
+static void BM_ForwardDynamics(benchmark::State& state)
+{
+  auto skel = createTree(state.range(0), state.range(1));
+  RandomStates states(*skel);
+
+  for (auto _ : state) {
+    states.setNext(*skel);
+    skel->computeForwardDynamics();
+    benchmark::DoNotOptimize(skel->getAccelerations().data());
+  }
+}
+
+static void BM_MassMatrix(benchmark::State& state)
+{
+  auto skel = createTree(state.range(0), state.range(1));
+  RandomStates states(*skel);
+
+  for (auto _ : state) {
+    states.setNext(*skel);
+    benchmark::DoNotOptimize(skel->getMassMatrix().data());
+  }
+}
+
+static void BM_InvMassMatrix(benchmark::State& state)
+{
+  auto skel = createTree(state.range(0), state.range(1));
+  RandomStates states(*skel);
+
+  for (auto _ : state) {
+    states.setNext(*skel);
+    benchmark::DoNotOptimize(skel->getInvMassMatrix().data());
+  }
+}
+
+BENCHMARK(BM_ForwardDynamics)->Apply(treeArguments);
+BENCHMARK(BM_MassMatrix)->Apply(treeArguments);
+BENCHMARK(BM_InvMassMatrix)->Apply(treeArguments);
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <dart/constraint/DantzigBoxedLcpSolver.hpp>
+#include <dart/constraint/PgsBoxedLcpSolver.hpp>
+
+#include <dart/math/Random.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <limits>
+#include <vector>
+
+using namespace dart;
+
+namespace {
+
+/// Boxed LCP with the layout the constraint solver produces for contacts:
+/// every contact contributes one normal row bounded below by zero followed by
+/// two friction rows whose bounds are scaled by the normal impulse.
+struct ContactLcp
+{
+  explicit ContactLcp(std::size_t numContacts)
+  {
+    math::Random::setSeed(0u);
+
+    n = static_cast<int>(3u * numContacts);
+
+    // Contact Jacobians of 6-dof bodies give a positive definite Delassus
+    // matrix once the constraint force mixing term is added to the diagonal.
+    const Eigen::MatrixXd J = math::Random::uniform<Eigen::MatrixXd>(
+        n, 6 * static_cast<int>(numContacts), -1.0, 1.0);
+    const Eigen::MatrixXd delassus
+        = J * J.transpose() + 1e-5 * Eigen::MatrixXd::Identity(n, n);
+
+    // The LCP solvers expect rows padded to a multiple of four (see dPAD)
+    nSkip = (n > 1) ? (((n - 1) | 3) + 1) : n;
+    A.setZero(n, nSkip);
+    A.leftCols(n) = delassus;
+
+    b = math::Random::uniform<Eigen::VectorXd>(n, -1.0, 0.0);
+    lo.resize(n);
+    hi.resize(n);
+    findex.resize(n);
+    for (auto i = 0; i < n; i += 3) {
+      lo[i] = 0.0;
+      hi[i] = std::numeric_limits<double>::infinity();
+      findex[i] = -1;
+      for (auto j = 1; j < 3; ++j) {
+        lo[i + j] = -1.0;
+        hi[i + j] = 1.0;
+        findex[i + j] = i;
+      }
+    }
+  }
+
+  int n;
+  int nSkip;
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> A;
+  Eigen::VectorXd b;
+  Eigen::VectorXd lo;
+  Eigen::VectorXd hi;
+  std::vector<int> findex;
+};
+
+} // namespace
+
+template <typename Solver>
+static void BM_BoxedLcp(benchmark::State& state)
+{
+  const ContactLcp lcp(state.range(0));
+  Solver solver;
+
+  // The solvers overwrite their inputs so every iteration starts from a copy
+  auto A = lcp.A;
+  Eigen::VectorXd x(lcp.n);
+  Eigen::VectorXd b(lcp.n);
+  Eigen::VectorXd lo(lcp.n);
+  Eigen::VectorXd hi(lcp.n);
+  std::vector<int> findex(lcp.findex.size());
+
+  for (auto _ : state) {
+    A = lcp.A;
+    x.setZero();
+    b = lcp.b;
+    lo = lcp.lo;
+    hi = lcp.hi;
+    findex = lcp.findex;
+
+    benchmark::DoNotOptimize(solver.solve(
+        lcp.n,
+        A.data(),
+        x.data(),
+        b.data(),
+        0,
+        lo.data(),
+        hi.data(),
+        findex.data(),
+        false));
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_BoxedLcp, constraint::DantzigBoxedLcpSolver)
+    ->ArgName("contacts")
+    ->Arg(4)
+    ->Arg(16)
+    ->Arg(64);
+BENCHMARK_TEMPLATE(BM_BoxedLcp, constraint::PgsBoxedLcpSolver)
+    ->ArgName("contacts")
+    ->Arg(4)
+    ->Arg(16)
+    ->Arg(64);
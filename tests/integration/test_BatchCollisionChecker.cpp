@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "TestHelpers.hpp"
+#include "dart/collision/CollisionFilter.hpp"
+#include "dart/collision/dart/DARTCollisionDetector.hpp"
+#include "dart/constraint/ConstraintSolver.hpp"
+#include "dart/simulation/BatchCollisionChecker.hpp"
+#include "dart/simulation/World.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace dart;
+
+//==============================================================================
+std::shared_ptr<simulation::World> createObstacleWorld()
+{
+  auto world = simulation::World::create();
+  world->getConstraintSolver()->setCollisionDetector(
+      collision::DARTCollisionDetector::create());
+
+  // The checked box starts at the origin, and the obstacle floats above the
+  // ground
+  world->addSkeleton(createGround(
+      Eigen::Vector3d(10.0, 10.0, 0.1), Eigen::Vector3d(0.0, 0.0, -0.05)));
+  world->addSkeleton(createBox(Eigen::Vector3d::Constant(0.2)));
+  world->addSkeleton(createBox(
+      Eigen::Vector3d::Constant(0.2), Eigen::Vector3d(1.0, 0.0, 1.0)));
+
+  return world;
+}
+
+//==============================================================================
+/// Returns a grid of translations of the checked box and whether each one is
+/// expected to be free of collisions
+simulation::BatchCollisionChecker::Matrix createConfigurations(
+    std::vector<bool>& expected)
+{
+  const std::vector<double> xs = {0.0, 0.5, 0.9, 1.0, 1.1, 1.5};
+  const std::vector<double> ys = {0.0, 0.15, 0.3};
+  const std::vector<double> zs = {0.05, 0.5, 0.95, 1.0};
+
+  simulation::BatchCollisionChecker::Matrix configs
+      = simulation::BatchCollisionChecker::Matrix::Zero(
+          xs.size() * ys.size() * zs.size(), 6);
+  expected.clear();
+
+  Eigen::Index row = 0;
+  for (const double x : xs) {
+    for (const double y : ys) {
+      for (const double z : zs) {
+        configs.row(row++).tail<3>() << x, y, z;
+
+        const bool hitsGround = z < 0.1;
+        const bool hitsObstacle = std::abs(x - 1.0) < 0.2
+                                  && std::abs(y) < 0.2
+                                  && std::abs(z - 1.0) < 0.2;
+        expected.push_back(!hitsGround && !hitsObstacle);
+      }
+    }
+  }
+
+  return configs;
+}
+
+//==============================================================================
+TEST(BatchCollisionChecker, MatchesExpectedCollisions)
+{
+  auto world = createObstacleWorld();
+  auto box = world->getSkeleton(1);
+  const Eigen::VectorXd positions = box->getPositions();
+
+  std::vector<bool> expected;
+  const auto configs = createConfigurations(expected);
+  ASSERT_GT(configs.rows(), 64);
+
+  const std::size_t numExpected
+      = std::count(expected.begin(), expected.end(), true);
+  ASSERT_GT(numExpected, 0u);
+  ASSERT_LT(numExpected, expected.size());
+
+  for (const std::size_t numThreads : {1u, 4u}) {
+    simulation::BatchCollisionChecker checker(*world, 1u, numThreads);
+    EXPECT_EQ(6u, checker.getNumDofs());
+    EXPECT_EQ(numThreads, checker.getNumThreads());
+
+    std::vector<std::uint64_t> validity;
+    EXPECT_EQ(numExpected, checker.checkValidity(configs, validity));
+    ASSERT_EQ(2u, validity.size());
+
+    for (auto i = 0u; i < expected.size(); ++i) {
+      EXPECT_EQ(
+          expected[i], simulation::BatchCollisionChecker::isValid(validity, i))
+          << "Configuration " << i;
+      EXPECT_EQ(
+          expected[i],
+          checker.checkValidity(Eigen::VectorXd(configs.row(i).transpose())))
+          << "Configuration " << i;
+    }
+
+    // The bits past the last configuration are cleared
+    EXPECT_EQ(0u, validity[1] >> (configs.rows() - 64));
+
+    // Checking again reuses the bitmask
+    const std::uint64_t* data = validity.data();
+    checker.checkValidity(configs, validity);
+    EXPECT_EQ(data, validity.data());
+  }
+
+  // The world is not modified
+  EXPECT_TRUE(box->getPositions() == positions);
+}
+
+//==============================================================================
+TEST(BatchCollisionChecker, IgnoresCollisionsOfTheEnvironment)
+{
+  auto world = createObstacleWorld();
+
+  // Drop the obstacle into the ground, which must not invalidate the box
+  world->getSkeleton(2)->setPosition(5, -1.0);
+
+  simulation::BatchCollisionChecker checker(*world, 1u, 2u);
+  EXPECT_TRUE(checker.checkValidity(
+      (Eigen::VectorXd(6) << 0.0, 0.0, 0.0, 0.0, 0.0, 0.5).finished()));
+  EXPECT_FALSE(checker.checkValidity(
+      (Eigen::VectorXd(6) << 0.0, 0.0, 0.0, 1.0, 0.0, 0.05).finished()));
+}
+
+//==============================================================================
+TEST(BatchCollisionChecker, UsesTheBlackListOfTheWorld)
+{
+  auto world = createObstacleWorld();
+  auto filter = std::dynamic_pointer_cast<collision::BodyNodeCollisionFilter>(
+      world->getConstraintSolver()->getCollisionOption().collisionFilter);
+  ASSERT_NE(nullptr, filter);
+  filter->addBodyNodePairToBlackList(
+      world->getSkeleton(1)->getBodyNode(0),
+      world->getSkeleton(2)->getBodyNode(0));
+
+  const Eigen::VectorXd atObstacle
+      = (Eigen::VectorXd(6) << 0.0, 0.0, 0.0, 1.0, 0.0, 1.0).finished();
+  const Eigen::VectorXd atGround
+      = (Eigen::VectorXd(6) << 0.0, 0.0, 0.0, 0.0, 0.0, 0.05).finished();
+
+  simulation::BatchCollisionChecker checker(*world, 1u, 2u);
+  EXPECT_TRUE(checker.checkValidity(atObstacle));
+  EXPECT_FALSE(checker.checkValidity(atGround));
+
+  // The checker keeps the blacklist until it is updated
+  filter->removeAllBodyNodePairsFromBlackList();
+  EXPECT_TRUE(checker.checkValidity(atObstacle));
+  checker.updateEnvironment(*world);
+  EXPECT_FALSE(checker.checkValidity(atObstacle));
+}
+
+//==============================================================================
+TEST(BatchCollisionChecker, UpdatesTheEnvironment)
+{
+  auto world = createObstacleWorld();
+  const Eigen::VectorXd atObstacle
+      = (Eigen::VectorXd(6) << 0.0, 0.0, 0.0, 1.0, 0.0, 1.0).finished();
+  const Eigen::VectorXd atOrigin
+      = (Eigen::VectorXd(6) << 0.0, 0.0, 0.0, 0.0, 0.0, 1.0).finished();
+
+  simulation::BatchCollisionChecker checker(*world, 1u, 2u);
+  EXPECT_FALSE(checker.checkValidity(atObstacle));
+  EXPECT_TRUE(checker.checkValidity(atOrigin));
+
+  // The checker is a snapshot of the world until it is updated
+  world->getSkeleton(2)->setPosition(3, 0.0);
+  EXPECT_FALSE(checker.checkValidity(atObstacle));
+  EXPECT_TRUE(checker.checkValidity(atOrigin));
+
+  checker.updateEnvironment(*world);
+  EXPECT_TRUE(checker.checkValidity(atObstacle));
+  EXPECT_FALSE(checker.checkValidity(atOrigin));
+
+  simulation::BatchCollisionChecker::Matrix configs(2, 6);
+  configs << atObstacle.transpose(), atOrigin.transpose();
+  std::vector<std::uint64_t> validity;
+  EXPECT_EQ(1u, checker.checkValidity(configs, validity));
+  EXPECT_TRUE(simulation::BatchCollisionChecker::isValid(validity, 0u));
+  EXPECT_FALSE(simulation::BatchCollisionChecker::isValid(validity, 1u));
+}
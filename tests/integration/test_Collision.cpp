@@ -474,7 +474,9 @@ void testSphereSphere(
   simpleFrame1->setTranslation(Eigen::Vector3d::Zero());
   simpleFrame2->setTranslation(Eigen::Vector3d::Zero());
   result.clear();
-  if (cd->getType() == FCLCollisionDetector::getStaticType()) {
+  if (cd->getType() == FCLCollisionDetector::getStaticType()
+      && static_cast<FCLCollisionDetector*>(cd.get())->getPrimitiveShapeType()
+             != FCLCollisionDetector::ANALYTIC) {
     EXPECT_FALSE(group->collide(option, &result));
     // FCL is not able to detect collisions when an object completely (strictly)
     // contains the other object (no collisions between the hulls)
@@ -508,6 +510,13 @@ TEST_F(Collision, SphereSphere)
     testSphereSphere(fcl_mesh_dart);
   }
 
+  {
+    SCOPED_TRACE("FCLCollisionDetector (analytic)");
+    auto fcl_analytic = FCLCollisionDetector::create();
+    fcl_analytic->setPrimitiveShapeType(FCLCollisionDetector::ANALYTIC);
+    testSphereSphere(fcl_analytic);
+  }
+
   // auto fcl_prim_fcl = FCLCollisionDetector::create();
   // fcl_prim_fcl->setPrimitiveShapeType(FCLCollisionDetector::MESH);
   // fcl_prim_fcl->setContactPointComputationMethod(FCLCollisionDetector::FCL);
@@ -626,6 +635,10 @@ TEST_F(Collision, BoxBox)
   fcl_mesh_dart->setContactPointComputationMethod(FCLCollisionDetector::DART);
   testBoxBox(fcl_mesh_dart);
 
+  auto fcl_analytic = FCLCollisionDetector::create();
+  fcl_analytic->setPrimitiveShapeType(FCLCollisionDetector::ANALYTIC);
+  testBoxBox(fcl_analytic);
+
   // auto fcl_prim_fcl = FCLCollisionDetector::create();
   // fcl_prim_fcl->setPrimitiveShapeType(FCLCollisionDetector::MESH);
   // fcl_prim_fcl->setContactPointComputationMethod(FCLCollisionDetector::FCL);
@@ -1593,6 +1606,130 @@ TEST_F(Collision, CollisionOfPrescribedJoints)
   }
 }
 
+//==============================================================================
+TEST_F(Collision, DARTBroadphase)
+{
+  auto cd = DARTCollisionDetector::create();
+
+  // A row of spheres where only the neighbors touch each other
+  const std::size_t numSpheres = 20u;
+  std::vector<SimpleFramePtr> frames;
+  auto group = cd->createCollisionGroup();
+  for (auto i = 0u; i < numSpheres; ++i) {
+    auto frame = SimpleFrame::createShared(Frame::World());
+    frame->setShape(std::make_shared<SphereShape>(0.5));
+    // Insert in reverse order so that the sweep list has to be sorted
+    frame->setTranslation(Eigen::Vector3d(0.9 * (numSpheres - i), 0.0, 0.0));
+    group->addShapeFrame(frame.get());
+    frames.push_back(frame);
+  }
+
+  collision::CollisionOption option;
+  option.maxNumContacts = 1000u;
+  collision::CollisionResult result;
+
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_EQ(result.getNumContacts(), numSpheres - 1u);
+
+  // Moving a sphere in the middle away breaks two contacts
+  frames[numSpheres / 2u]->setTranslation(Eigen::Vector3d(0.0, 10.0, 0.0));
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_EQ(result.getNumContacts(), numSpheres - 3u);
+
+  // Moving it back along the sweep axis requires re-sorting
+  frames[numSpheres / 2u]->setTranslation(Eigen::Vector3d(-0.9, 10.0, 0.0));
+  frames[0u]->setTranslation(Eigen::Vector3d(-0.9, 10.4, 0.0));
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_EQ(result.getNumContacts(), numSpheres - 3u);
+
+  // Group-to-group queries only report the pairs across the groups
+  auto other = cd->createCollisionGroup();
+  auto box = SimpleFrame::createShared(Frame::World());
+  box->setShape(std::make_shared<BoxShape>(Eigen::Vector3d(1.0, 1.0, 1.0)));
+  box->setTranslation(Eigen::Vector3d(0.9 * 3.0, 0.0, 0.6));
+  other->addShapeFrame(box.get());
+  EXPECT_TRUE(group->collide(other.get(), option, &result));
+  for (const auto& contact : result.getContacts()) {
+    EXPECT_TRUE(contact.collisionObject1->getShapeFrame() != box.get());
+    EXPECT_TRUE(contact.collisionObject2->getShapeFrame() == box.get());
+  }
+
+  box->setTranslation(Eigen::Vector3d(0.0, -10.0, 0.0));
+  EXPECT_FALSE(group->collide(other.get(), option, &result));
+  EXPECT_EQ(result.getNumContacts(), 0u);
+}
+
+//==============================================================================
+TEST_F(Collision, DARTRepeatedContactPoints)
+{
+  auto cd = DARTCollisionDetector::create();
+  auto group = cd->createCollisionGroup();
+
+  // Two coincident spheres touching a third one at the same point
+  auto sphere1 = SimpleFrame::createShared(Frame::World());
+  auto sphere2 = SimpleFrame::createShared(Frame::World());
+  auto sphere3 = SimpleFrame::createShared(Frame::World());
+  for (auto* frame : {sphere1.get(), sphere2.get(), sphere3.get()}) {
+    frame->setShape(std::make_shared<SphereShape>(0.5));
+    group->addShapeFrame(frame);
+  }
+  sphere1->setTranslation(Eigen::Vector3d(-0.45, 0.0, 0.0));
+  sphere2->setTranslation(Eigen::Vector3d(-0.45, 0.0, 0.0));
+  sphere3->setTranslation(Eigen::Vector3d(0.45, 0.0, 0.0));
+
+  struct CoincidentFilter : collision::CollisionFilter
+  {
+    const ShapeFrame* mFrame1;
+    const ShapeFrame* mFrame2;
+
+    bool ignoresCollision(
+        const collision::CollisionObject* object1,
+        const collision::CollisionObject* object2) const override
+    {
+      const auto* frame1 = object1->getShapeFrame();
+      const auto* frame2 = object2->getShapeFrame();
+      return (frame1 == mFrame1 && frame2 == mFrame2)
+             || (frame1 == mFrame2 && frame2 == mFrame1);
+    }
+  };
+  auto filter = std::make_shared<CoincidentFilter>();
+  filter->mFrame1 = sphere1.get();
+  filter->mFrame2 = sphere2.get();
+
+  collision::CollisionOption option;
+  option.collisionFilter = filter;
+  collision::CollisionResult result;
+
+  // The second contact at the same point is dropped along with its objects
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_EQ(result.getNumContacts(), 1u);
+  EXPECT_EQ(result.getCollidingShapeFrames().size(), 2u);
+  EXPECT_TRUE(result.inCollision(sphere3.get()));
+  EXPECT_NE(
+      result.inCollision(sphere1.get()), result.inCollision(sphere2.get()));
+
+  // Distinct contacts are all kept, however many there are
+  auto row = cd->createCollisionGroup();
+  const std::size_t numSpheres = 200u;
+  std::vector<SimpleFramePtr> frames;
+  for (auto i = 0u; i < numSpheres; ++i) {
+    auto frame = SimpleFrame::createShared(Frame::World());
+    frame->setShape(std::make_shared<SphereShape>(0.5));
+    frame->setTranslation(Eigen::Vector3d(0.9 * i, 0.0, 0.0));
+    row->addShapeFrame(frame.get());
+    frames.push_back(frame);
+  }
+
+  option.collisionFilter = nullptr;
+  EXPECT_TRUE(row->collide(option, &result));
+  EXPECT_EQ(result.getNumContacts(), numSpheres - 1u);
+  EXPECT_EQ(result.getCollidingShapeFrames().size(), numSpheres);
+
+  // Repeated queries reuse the buffers and give the same result
+  EXPECT_TRUE(row->collide(option, &result));
+  EXPECT_EQ(result.getNumContacts(), numSpheres - 1u);
+}
+
 //==============================================================================
 TEST_F(Collision, Factory)
 {
@@ -1612,6 +1749,61 @@ TEST_F(Collision, Factory)
 #endif
 }
 
+//==============================================================================
+TEST_F(Collision, ShapeTypeId)
+{
+  using TypeId = Shape::TypeId;
+
+  EXPECT_EQ(std::make_shared<SphereShape>(1.0)->getTypeId(), TypeId::Sphere);
+  EXPECT_EQ(
+      std::make_shared<BoxShape>(Eigen::Vector3d::Ones())->getTypeId(),
+      TypeId::Box);
+  EXPECT_EQ(
+      std::make_shared<EllipsoidShape>(Eigen::Vector3d::Ones())->getTypeId(),
+      TypeId::Ellipsoid);
+  EXPECT_EQ(
+      std::make_shared<CylinderShape>(1.0, 1.0)->getTypeId(),
+      TypeId::Cylinder);
+  EXPECT_EQ(
+      std::make_shared<CapsuleShape>(1.0, 1.0)->getTypeId(), TypeId::Capsule);
+  EXPECT_EQ(std::make_shared<ConeShape>(1.0, 1.0)->getTypeId(), TypeId::Cone);
+  EXPECT_EQ(
+      std::make_shared<PlaneShape>(Eigen::Vector3d::UnitZ(), 0.0)->getTypeId(),
+      TypeId::Plane);
+  EXPECT_EQ(
+      std::make_shared<HeightmapShapef>()->getTypeId(), TypeId::Heightmapf);
+  EXPECT_EQ(
+      std::make_shared<HeightmapShaped>()->getTypeId(), TypeId::Heightmapd);
+
+  // A subclass of a DART shape with its own type string keeps the ID of its
+  // base, so the collision detectors still recognize it.
+  struct TaggedSphereShape : SphereShape
+  {
+    TaggedSphereShape() : SphereShape(0.5) {}
+
+    const std::string& getType() const override
+    {
+      static const std::string type("TaggedSphereShape");
+      return type;
+    }
+  };
+
+  auto frame1 = SimpleFrame::createShared(Frame::World());
+  auto frame2 = SimpleFrame::createShared(Frame::World());
+  frame1->setShape(std::make_shared<TaggedSphereShape>());
+  frame2->setShape(std::make_shared<BoxShape>(Eigen::Vector3d::Ones()));
+  frame1->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.9));
+  EXPECT_EQ(frame1->getShape()->getTypeId(), TypeId::Sphere);
+
+  auto cd = DARTCollisionDetector::create();
+  auto group = cd->createCollisionGroup(frame1.get(), frame2.get());
+
+  collision::CollisionOption option;
+  collision::CollisionResult result;
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_GE(result.getNumContacts(), 1u);
+}
+
 //==============================================================================
 #if HAVE_OCTOMAP && FCL_HAVE_OCTOMAP
 TEST_F(Collision, VoxelGrid)
@@ -1647,3 +1839,48 @@ TEST_F(Collision, VoxelGrid)
   EXPECT_TRUE(result.getNumContacts() >= 1u);
 }
 #endif // HAVE_OCTOMAP && FCL_HAVE_OCTOMAP
+
+//==============================================================================
+TEST_F(Collision, ClonedMeshShapesShareGeometry)
+{
+  auto cd1 = FCLCollisionDetector::create();
+  auto cd2 = FCLCollisionDetector::create();
+
+  auto shape = std::make_shared<ArrowShape>(
+      Eigen::Vector3d::Zero(), Eigen::Vector3d::UnitZ());
+  auto clone = std::dynamic_pointer_cast<MeshShape>(shape->clone());
+  ASSERT_NE(clone, nullptr);
+
+  // Clones share the mesh, and every collision detector shares its BVH
+  const aiScene* mesh = shape->getMesh();
+  EXPECT_EQ(mesh, clone->getMesh());
+
+  auto geom1 = cd1->claimFCLCollisionGeometry(shape);
+  auto geom2 = cd2->claimFCLCollisionGeometry(clone);
+  EXPECT_EQ(geom1.get(), geom2.get());
+
+  // Modifying a shape copies its mesh and builds a new BVH
+  clone->getMutableMesh();
+  EXPECT_NE(mesh, clone->getMesh());
+  EXPECT_EQ(mesh, shape->getMesh());
+
+  auto geom3 = cd2->claimFCLCollisionGeometry(clone);
+  EXPECT_NE(geom1.get(), geom3.get());
+
+  // The mesh is also copied while only a BVH refers to it
+  shape->setPositions(Eigen::Vector3d::Zero(), Eigen::Vector3d::UnitX());
+  EXPECT_NE(mesh, shape->getMesh());
+
+  // The shared geometries collide like separate ones
+  auto simpleFrame1 = SimpleFrame::createShared(Frame::World());
+  auto simpleFrame2 = SimpleFrame::createShared(Frame::World());
+  simpleFrame1->setShape(clone->clone());
+  simpleFrame2->setShape(clone->clone());
+
+  auto group
+      = cd1->createCollisionGroup(simpleFrame1.get(), simpleFrame2.get());
+  EXPECT_TRUE(group->collide());
+
+  simpleFrame2->setTranslation(Eigen::Vector3d(1.0, 0.0, 0.0));
+  EXPECT_FALSE(group->collide());
+}
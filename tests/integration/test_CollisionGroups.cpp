@@ -34,6 +34,7 @@
 #include "dart/dynamics/BoxShape.hpp"
 #include "dart/dynamics/FreeJoint.hpp"
 #include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/WeldJoint.hpp"
 #include "dart/simulation/World.hpp"
 
 #include <dart/dynamics/SphereShape.hpp>
@@ -324,6 +325,156 @@ TEST_P(CollisionGroupsTest, RemovedSkeletonSubscription)
   EXPECT_FALSE(group->isSubscribedTo(skel_B_ptr));
 }
 
+TEST_P(CollisionGroupsTest, OnlyMovedObjectsUpdate)
+{
+  if (!dart::collision::CollisionDetector::getFactory()->canCreate(
+          GetParam())) {
+    std::cout << "Skipping test for [" << GetParam() << "], because it is not "
+              << "available" << std::endl;
+    return;
+  } else {
+    std::cout << "Running CollisionGroups test for [" << GetParam() << "]"
+              << std::endl;
+  }
+
+  auto cd
+      = dart::collision::CollisionDetector::getFactory()->create(GetParam());
+  auto group = cd->createCollisionGroup();
+
+  auto sphere = std::make_shared<dart::dynamics::SphereShape>(0.5);
+
+  auto ground = dart::dynamics::Skeleton::create("ground");
+  auto groundPair
+      = ground->createJointAndBodyNodePair<dart::dynamics::WeldJoint>();
+  auto groundShape
+      = groundPair.second
+            ->createShapeNodeWith<dart::dynamics::CollisionAspect>(sphere);
+
+  auto ball = dart::dynamics::Skeleton::create("ball");
+  auto ballPair = ball->createJointAndBodyNodePair<dart::dynamics::FreeJoint>();
+  auto ballShape
+      = ballPair.second->createShapeNodeWith<dart::dynamics::CollisionAspect>(
+          sphere);
+
+  group->subscribeTo(ground, ball);
+
+  Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+  tf.translation()[0] = 2.0;
+  dart::dynamics::FreeJoint::setTransformOf(ballPair.first, tf);
+  EXPECT_FALSE(group->collide());
+
+  // Querying again without motion leaves the world transforms untouched
+  const auto groundVersion = groundShape->getWorldTransformVersion();
+  const auto ballVersion = ballShape->getWorldTransformVersion();
+  EXPECT_FALSE(group->collide());
+  EXPECT_EQ(groundVersion, groundShape->getWorldTransformVersion());
+  EXPECT_EQ(ballVersion, ballShape->getWorldTransformVersion());
+
+  // Moving only the ball must still be seen by the engine
+  tf.translation()[0] = 0.5;
+  dart::dynamics::FreeJoint::setTransformOf(ballPair.first, tf);
+  EXPECT_EQ(groundVersion, groundShape->getWorldTransformVersion());
+  EXPECT_NE(ballVersion, ballShape->getWorldTransformVersion());
+  EXPECT_TRUE(group->collide());
+  EXPECT_TRUE(group->collide());
+
+  tf.translation()[0] = -2.0;
+  dart::dynamics::FreeJoint::setTransformOf(ballPair.first, tf);
+  EXPECT_FALSE(group->collide());
+
+  // Growing a static shape changes its geometry without moving its frame
+  sphere->setRadius(1.5);
+  EXPECT_TRUE(group->collide());
+}
+
+//==============================================================================
+TEST_P(CollisionGroupsTest, CollisionCategories)
+{
+  if (!dart::collision::CollisionDetector::getFactory()->canCreate(
+          GetParam())) {
+    std::cout << "Skipping test for [" << GetParam() << "], because it is not "
+              << "available" << std::endl;
+    return;
+  } else {
+    std::cout << "Running CollisionGroups test for [" << GetParam() << "]"
+              << std::endl;
+  }
+
+  auto cd
+      = dart::collision::CollisionDetector::getFactory()->create(GetParam());
+
+  auto sphere = std::make_shared<dart::dynamics::SphereShape>(0.5);
+
+  auto ground = dart::dynamics::Skeleton::create("ground");
+  auto groundShape
+      = ground->createJointAndBodyNodePair<dart::dynamics::WeldJoint>()
+            .second->createShapeNodeWith<dart::dynamics::CollisionAspect>(
+                sphere);
+
+  // Two overlapping bodies of the same skeleton
+  auto robot = dart::dynamics::Skeleton::create("robot");
+  auto pair1 = robot->createJointAndBodyNodePair<dart::dynamics::FreeJoint>();
+  auto shape1
+      = pair1.second->createShapeNodeWith<dart::dynamics::CollisionAspect>(
+          sphere);
+  auto pair2 = robot->createJointAndBodyNodePair<dart::dynamics::FreeJoint>(
+      pair1.second);
+  pair2.second->createShapeNodeWith<dart::dynamics::CollisionAspect>(sphere);
+
+  auto group = cd->createCollisionGroup();
+  group->subscribeTo(ground);
+  group->addShapeFrame(shape1);
+  EXPECT_TRUE(group->collide());
+
+  // The body leaves the categories that the ground collides with
+  auto groundAspect = groundShape->getCollisionAspect();
+  auto aspect1 = shape1->getCollisionAspect();
+  EXPECT_EQ(0x1u, aspect1->getCollisionCategories());
+  EXPECT_EQ(0xFFFFFFFFu, aspect1->getCollisionMask());
+  aspect1->setCollisionCategories(0x2u);
+  groundAspect->setCollisionMask(~0x2u);
+  EXPECT_FALSE(group->collide());
+
+  auto groundGroup = cd->createCollisionGroup(groundShape);
+  auto robotGroup = cd->createCollisionGroup(shape1);
+  EXPECT_FALSE(groundGroup->collide(robotGroup.get()));
+
+  groundAspect->setCollisionMask(0x2u);
+  EXPECT_TRUE(group->collide());
+  EXPECT_TRUE(groundGroup->collide(robotGroup.get()));
+
+  // Both objects must be in a category of the mask of the other
+  aspect1->setCollisionMask(0x2u);
+  EXPECT_FALSE(group->collide());
+  aspect1->setCollisionMask(0x1u);
+  EXPECT_TRUE(group->collide());
+
+  // Self collisions are only skipped on request
+  auto robotGroupAll = cd->createCollisionGroup();
+  robotGroupAll->subscribeTo(robot);
+  dart::collision::CollisionOption option;
+  robot->disableSelfCollisionCheck();
+  EXPECT_TRUE(robotGroupAll->collide(option));
+
+  option.skipDisabledSelfCollisions = true;
+  EXPECT_FALSE(robotGroupAll->collide(option));
+
+  robot->enableSelfCollisionCheck();
+  EXPECT_TRUE(robotGroupAll->collide(option));
+
+  // So are the pairs of a sleeping skeleton and another one at rest
+  dart::collision::CollisionOption sleepingOption;
+  sleepingOption.skipSleepingPairs = true;
+  EXPECT_TRUE(group->collide(sleepingOption));
+
+  robot->setSleeping(true);
+  EXPECT_TRUE(group->collide());
+  EXPECT_FALSE(group->collide(sleepingOption));
+
+  robot->setSleeping(false);
+  EXPECT_TRUE(group->collide(sleepingOption));
+}
+
 INSTANTIATE_TEST_SUITE_P(
     CollisionEngine,
     CollisionGroupsTest,
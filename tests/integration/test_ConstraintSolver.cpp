@@ -30,13 +30,22 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include "AllocationCounter.hpp"
 #include "TestHelpers.hpp"
+#include "dart/collision/dart/DARTCollisionDetector.hpp"
+#include "dart/constraint/BoxedLcpConstraintSolver.hpp"
 #include "dart/constraint/ConstraintSolver.hpp"
 #include "dart/constraint/ContactSurface.hpp"
+#include "dart/constraint/DantzigBoxedLcpSolver.hpp"
+#include "dart/constraint/PgsBoxedLcpSolver.hpp"
+#include "dart/constraint/WeldJointConstraint.hpp"
 #include "dart/simulation/World.hpp"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <limits>
+
 using namespace dart;
 
 //==============================================================================
@@ -254,3 +263,485 @@ TEST(ConstraintSolver, ConstactSurfaceHandlerIgnoreParent)
   EXPECT_TRUE(customHandler2->mCalled);
   EXPECT_EQ(2, params.mPrimaryFrictionCoeff);
 }
+
+//==============================================================================
+std::shared_ptr<World> createBoxPilesWorld()
+{
+  auto world = createWorld();
+  world->getConstraintSolver()->setCollisionDetector(
+      collision::DARTCollisionDetector::create());
+
+  world->addSkeleton(createGround(Eigen::Vector3d(20.0, 20.0, 0.1)));
+
+  // Piles far enough apart to end up in separate constrained groups
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      for (int k = 0; k < 3; ++k) {
+        world->addSkeleton(createBox(
+            Eigen::Vector3d::Constant(0.2),
+            Eigen::Vector3d(i * 1.0 - 1.5, j * 1.0 - 1.5, 0.12 + k * 0.21),
+            Eigen::Vector3d(0.0, 0.0, 0.1 * k)));
+      }
+    }
+  }
+
+  return world;
+}
+
+//==============================================================================
+TEST(ConstraintSolver, ParallelConstrainedGroups)
+{
+  auto serialWorld = createBoxPilesWorld();
+  auto parallelWorld = createBoxPilesWorld();
+
+  auto solver = parallelWorld->getConstraintSolver();
+  EXPECT_EQ(1u, solver->getNumThreads());
+  solver->setNumThreads(4u);
+  EXPECT_EQ(4u, solver->getNumThreads());
+
+  for (auto i = 0u; i < 200u; ++i) {
+    serialWorld->step();
+    parallelWorld->step();
+  }
+
+  // The boxes actually touched each other
+  EXPECT_GT(
+      parallelWorld->getLastCollisionResult().getNumContacts(),
+      parallelWorld->getNumSkeletons());
+
+  // Solving the groups in parallel gives bitwise identical results
+  ASSERT_EQ(serialWorld->getNumSkeletons(), parallelWorld->getNumSkeletons());
+  for (auto i = 0u; i < serialWorld->getNumSkeletons(); ++i) {
+    const auto skel1 = serialWorld->getSkeleton(i);
+    const auto skel2 = parallelWorld->getSkeleton(i);
+    EXPECT_TRUE(skel1->getPositions() == skel2->getPositions());
+    EXPECT_TRUE(skel1->getVelocities() == skel2->getVelocities());
+  }
+
+  solver->setNumThreads(1u);
+  EXPECT_EQ(1u, solver->getNumThreads());
+}
+
+//==============================================================================
+TEST(ConstraintSolver, ParallelSolverClones)
+{
+  // Dantzig solver with a settings version that counts its clones
+  class CountingBoxedLcpSolver : public constraint::DantzigBoxedLcpSolver
+  {
+  public:
+    explicit CountingBoxedLcpSolver(std::shared_ptr<std::size_t> numClones)
+      : mNumClones(std::move(numClones))
+    {
+      // Do nothing
+    }
+
+    std::shared_ptr<constraint::BoxedLcpSolver> clone() const override
+    {
+      ++*mNumClones;
+      return std::make_shared<CountingBoxedLcpSolver>(mNumClones);
+    }
+
+    std::size_t getSettingsVersion() const override
+    {
+      return mVersion;
+    }
+
+    std::shared_ptr<std::size_t> mNumClones;
+    std::size_t mVersion = 0u;
+  };
+
+  // Exposes the LCP terms of the serial solve to subclasses
+  class ExposedSolver : public constraint::BoxedLcpConstraintSolver
+  {
+  public:
+    using BoxedLcpConstraintSolver::BoxedLcpConstraintSolver;
+    using BoxedLcpConstraintSolver::mX;
+  };
+
+  auto numClones = std::make_shared<std::size_t>(0u);
+  auto primary = std::make_shared<CountingBoxedLcpSolver>(numClones);
+  auto world = createBoxPilesWorld();
+  world->setConstraintSolver(std::make_unique<ExposedSolver>(
+      primary, std::make_shared<constraint::PgsBoxedLcpSolver>()));
+  auto solver = static_cast<ExposedSolver*>(world->getConstraintSolver());
+
+  // The serial solve keeps its terms in the members of the solver
+  for (auto i = 0u; i < 20u; ++i)
+    world->step();
+  EXPECT_EQ(0u, *numClones);
+  EXPECT_GT(solver->mX.size(), 0);
+
+  // Each of the other workers clones the solver once
+  solver->setNumThreads(4u);
+  for (auto i = 0u; i < 20u; ++i)
+    world->step();
+  EXPECT_EQ(3u, *numClones);
+
+  // Changing the settings of the solver clones it again
+  ++primary->mVersion;
+  for (auto i = 0u; i < 20u; ++i)
+    world->step();
+  EXPECT_EQ(6u, *numClones);
+
+  // So does replacing it
+  solver->setBoxedLcpSolver(
+      std::make_shared<CountingBoxedLcpSolver>(numClones));
+  for (auto i = 0u; i < 20u; ++i)
+    world->step();
+  EXPECT_EQ(9u, *numClones);
+}
+
+//==============================================================================
+TEST(ConstraintSolver, SteadyStateStepWithDARTDetectorDoesNotAllocate)
+{
+#if !DART_TEST_CAN_COUNT_ALLOCATIONS
+  GTEST_SKIP() << "Allocations can't be counted on this platform";
+#endif
+
+  // Only the pipeline of DARTCollisionDetector is free of allocations. FCL,
+  // the default collision detector, still allocates in every query.
+  auto world = createBoxPilesWorld();
+
+  // A joint constraint that lives across steps next to the per-step contacts
+  auto weld = std::make_shared<constraint::WeldJointConstraint>(
+      world->getSkeleton(1)->getBodyNode(0),
+      world->getSkeleton(2)->getBodyNode(0));
+  world->getConstraintSolver()->addConstraint(weld);
+
+  // Let the piles settle so that the number of contacts, and with it the size
+  // of the caches, stops growing
+  for (auto i = 0u; i < 300u; ++i)
+    world->step();
+  EXPECT_GT(
+      world->getLastCollisionResult().getNumContacts(),
+      world->getNumSkeletons());
+
+  const std::size_t numAllocations = test::getNumAllocations();
+  for (auto i = 0u; i < 50u; ++i)
+    world->step();
+  EXPECT_EQ(numAllocations, test::getNumAllocations());
+}
+
+//==============================================================================
+TEST(ConstraintSolver, ConstrainedGroupIndices)
+{
+  constexpr auto noGroup = std::numeric_limits<std::size_t>::max();
+
+  auto world = createBoxPilesWorld();
+  auto solver = world->getConstraintSolver();
+  for (auto i = 0u; i < 100u; ++i)
+    world->step();
+
+  // Returns the group of a box, where the boxes of a pile are consecutive
+  // skeletons after the ground
+  const auto getGroup = [&](std::size_t pile, std::size_t box) {
+    return solver->getConstrainedGroupIndex(
+        *world->getSkeleton(1u + 3u * pile + box));
+  };
+
+  // The ground is not reactive, so every pile is a separate group
+  EXPECT_EQ(16u, solver->getNumConstrainedGroups());
+  EXPECT_EQ(noGroup, solver->getConstrainedGroupIndex(*world->getSkeleton(0)));
+  std::vector<bool> isUsed(solver->getNumConstrainedGroups(), false);
+  for (auto pile = 0u; pile < 16u; ++pile) {
+    const auto group = getGroup(pile, 0u);
+    ASSERT_LT(group, solver->getNumConstrainedGroups());
+    EXPECT_FALSE(isUsed[group]);
+    isUsed[group] = true;
+    EXPECT_EQ(group, getGroup(pile, 1u));
+    EXPECT_EQ(group, getGroup(pile, 2u));
+  }
+
+  // A constraint that doesn't report its skeletons still merges the groups of
+  // the skeletons it unites
+  solver->addConstraint(std::make_shared<constraint::WeldJointConstraint>(
+      world->getSkeleton(3)->getBodyNode(0),
+      world->getSkeleton(6)->getBodyNode(0)));
+  world->step();
+
+  EXPECT_EQ(15u, solver->getNumConstrainedGroups());
+  EXPECT_EQ(getGroup(0u, 0u), getGroup(1u, 0u));
+  EXPECT_NE(getGroup(0u, 0u), getGroup(2u, 0u));
+}
+
+//==============================================================================
+TEST(ConstraintSolver, ContactWarmStarting)
+{
+  // PGS solver that records the initial guess and the solution of each solve
+  class RecordingPgsSolver : public constraint::PgsBoxedLcpSolver
+  {
+  public:
+    bool solve(
+        int n,
+        double* A,
+        double* x,
+        double* b,
+        int nub,
+        double* lo,
+        double* hi,
+        int* findex,
+        bool earlyTermination) override
+    {
+      mInitialX = Eigen::Map<Eigen::VectorXd>(x, n);
+      const bool success = PgsBoxedLcpSolver::solve(
+          n, A, x, b, nub, lo, hi, findex, earlyTermination);
+      mSolution = Eigen::Map<Eigen::VectorXd>(x, n);
+      return success;
+    }
+
+    Eigen::VectorXd mInitialX;
+    Eigen::VectorXd mSolution;
+  };
+
+  auto lcpSolver = std::make_shared<RecordingPgsSolver>();
+
+  auto world = createWorld();
+  world->setConstraintSolver(
+      std::make_unique<constraint::BoxedLcpConstraintSolver>(
+          lcpSolver, nullptr));
+  auto solver = world->getConstraintSolver();
+  solver->setCollisionDetector(collision::DARTCollisionDetector::create());
+
+  world->addSkeleton(createGround(Eigen::Vector3d(10.0, 10.0, 0.1)));
+  world->addSkeleton(createBox(
+      Eigen::Vector3d::Constant(0.2), Eigen::Vector3d(0.0, 0.0, 0.149)));
+
+  // Without warm starting, every solve starts from zero
+  EXPECT_FALSE(solver->isContactWarmStarting());
+  for (auto i = 0u; i < 10u; ++i) {
+    world->step();
+    ASSERT_GT(lcpSolver->mInitialX.size(), 0);
+    EXPECT_TRUE(lcpSolver->mInitialX.isZero(0.0));
+  }
+
+  // With warm starting, the resting contacts start from the impulses of the
+  // previous step
+  solver->setContactWarmStarting(true);
+  EXPECT_TRUE(solver->isContactWarmStarting());
+  world->step();
+  for (auto i = 0u; i < 10u; ++i) {
+    const Eigen::VectorXd previousSolution = lcpSolver->mSolution;
+    world->step();
+    ASSERT_EQ(previousSolution.size(), lcpSolver->mInitialX.size());
+    EXPECT_FALSE(lcpSolver->mInitialX.isZero(0.0));
+    EXPECT_NEAR(previousSolution.sum(), lcpSolver->mInitialX.sum(), 1e-6);
+  }
+
+  // Matching contacts are too far apart with a zero distance
+  solver->setContactWarmStartingDistance(0.0);
+  EXPECT_DOUBLE_EQ(0.0, solver->getContactWarmStartingDistance());
+  world->step();
+  world->step();
+  EXPECT_TRUE(lcpSolver->mInitialX.isZero(0.0));
+}
+
+//==============================================================================
+TEST(ConstraintSolver, BlockSparseAssembly)
+{
+  // PGS solver that records the size of the sparse LCPs it solves
+  class RecordingPgsSolver : public constraint::PgsBoxedLcpSolver
+  {
+  public:
+    bool solveSparse(
+        int n,
+        SparseMatrix& A,
+        double* x,
+        double* b,
+        int nub,
+        double* lo,
+        double* hi,
+        int* findex,
+        bool earlyTermination) override
+    {
+      mMaxDimension = std::max(mMaxDimension, n);
+      if (A.nonZeros() < n * n)
+        ++mNumSparseSolves;
+      return PgsBoxedLcpSolver::solveSparse(
+          n, A, x, b, nub, lo, hi, findex, earlyTermination);
+    }
+
+    int mMaxDimension = 0;
+    int mNumSparseSolves = 0;
+  };
+
+  auto denseWorld = createBoxPilesWorld();
+  denseWorld->setConstraintSolver(
+      std::make_unique<constraint::BoxedLcpConstraintSolver>(
+          std::make_shared<constraint::PgsBoxedLcpSolver>()));
+  denseWorld->getConstraintSolver()->setCollisionDetector(
+      collision::DARTCollisionDetector::create());
+
+  auto lcpSolver = std::make_shared<RecordingPgsSolver>();
+  auto sparseWorld = createBoxPilesWorld();
+  auto sparseSolver
+      = std::make_unique<constraint::BoxedLcpConstraintSolver>(lcpSolver);
+  EXPECT_FALSE(sparseSolver->isBlockSparseAssembly());
+  sparseSolver->setBlockSparseAssembly(true);
+  EXPECT_TRUE(sparseSolver->isBlockSparseAssembly());
+  sparseWorld->setConstraintSolver(std::move(sparseSolver));
+  sparseWorld->getConstraintSolver()->setCollisionDetector(
+      collision::DARTCollisionDetector::create());
+
+  for (auto i = 0u; i < 200u; ++i) {
+    denseWorld->step();
+    sparseWorld->step();
+  }
+
+  // The contacts between the ground and the bottom box of a pile don't
+  // couple with the contacts between the upper boxes
+  EXPECT_GT(lcpSolver->mMaxDimension, 0);
+  EXPECT_GT(lcpSolver->mNumSparseSolves, 0);
+
+  // The blocks that are skipped are zero, so both assemblies give bitwise
+  // identical results
+  ASSERT_EQ(denseWorld->getNumSkeletons(), sparseWorld->getNumSkeletons());
+  for (auto i = 0u; i < denseWorld->getNumSkeletons(); ++i) {
+    const auto skel1 = denseWorld->getSkeleton(i);
+    const auto skel2 = sparseWorld->getSkeleton(i);
+    EXPECT_TRUE(skel1->getPositions() == skel2->getPositions());
+    EXPECT_TRUE(skel1->getVelocities() == skel2->getVelocities());
+  }
+}
+
+//==============================================================================
+TEST(ConstraintSolver, ContactManifoldReduction)
+{
+  // Handler that records the contacts it creates contact constraints for
+  class RecordingHandler : public constraint::DefaultContactSurfaceHandler
+  {
+  public:
+    constraint::ContactConstraintPtr createConstraint(
+        collision::Contact& contact,
+        size_t numContactsOnCollisionObject,
+        double timeStep) const override
+    {
+      mContacts.push_back(contact);
+      mNumContactsOnCollisionObject.push_back(numContactsOnCollisionObject);
+      return DefaultContactSurfaceHandler::createConstraint(
+          contact, numContactsOnCollisionObject, timeStep);
+    }
+
+    mutable std::vector<collision::Contact> mContacts;
+    mutable std::vector<std::size_t> mNumContactsOnCollisionObject;
+  };
+
+  auto world = createWorld();
+  auto solver = world->getConstraintSolver();
+  solver->setCollisionDetector(collision::DARTCollisionDetector::create());
+  auto defaultHandler = solver->getLastContactSurfaceHandler();
+  auto handler = std::make_shared<RecordingHandler>();
+  solver->addContactSurfaceHandler(handler);
+
+  // A slightly tilted box, so that two of its corners penetrate deeper
+  world->addSkeleton(createGround(Eigen::Vector3d(10.0, 10.0, 0.1)));
+  auto box = createBox(
+      Eigen::Vector3d::Constant(0.2),
+      Eigen::Vector3d(0.0, 0.0, 0.147),
+      Eigen::Vector3d(0.02, 0.0, 0.0));
+  world->addSkeleton(box);
+  const Eigen::VectorXd positions = box->getPositions();
+
+  // Steps the world from the same state, so that the contacts are the same
+  const auto step = [&]() {
+    box->setPositions(positions);
+    box->setVelocities(Eigen::VectorXd::Zero(box->getNumDofs()));
+    handler->mContacts.clear();
+    handler->mNumContactsOnCollisionObject.clear();
+    world->step();
+  };
+
+  // All the contacts are kept by default
+  EXPECT_EQ(0u, handler->getMaxNumContactsPerPair(nullptr, nullptr));
+  step();
+  const auto contacts = world->getLastCollisionResult().getContacts();
+  ASSERT_EQ(4u, contacts.size());
+  EXPECT_EQ(contacts.size(), handler->mContacts.size());
+
+  auto maxDepth = 0.0;
+  for (const auto& contact : contacts)
+    maxDepth = std::max(maxDepth, contact.penetrationDepth);
+
+  // The limit of the parent handler applies unless the handler sets its own
+  for (auto maxNumContacts = 1u; maxNumContacts < 4u; ++maxNumContacts) {
+    defaultHandler->setMaxNumContactsPerPair(maxNumContacts);
+    EXPECT_EQ(
+        maxNumContacts, handler->getMaxNumContactsPerPair(nullptr, nullptr));
+    step();
+    EXPECT_EQ(4u, world->getLastCollisionResult().getNumContacts());
+    ASSERT_EQ(maxNumContacts, handler->mContacts.size());
+
+    // The deepest contact is always kept
+    auto keptMaxDepth = 0.0;
+    for (auto i = 0u; i < maxNumContacts; ++i) {
+      EXPECT_EQ(maxNumContacts, handler->mNumContactsOnCollisionObject[i]);
+      keptMaxDepth
+          = std::max(keptMaxDepth, handler->mContacts[i].penetrationDepth);
+    }
+    EXPECT_DOUBLE_EQ(maxDepth, keptMaxDepth);
+
+    // The second contact is the opposite corner of the face
+    if (maxNumContacts == 2u) {
+      EXPECT_NEAR(
+          0.2 * std::sqrt(2.0),
+          (handler->mContacts[0].point - handler->mContacts[1].point).norm(),
+          1e-2);
+    }
+  }
+
+  handler->setMaxNumContactsPerPair(0u);
+  EXPECT_EQ(0u, handler->getMaxNumContactsPerPair(nullptr, nullptr));
+  step();
+  EXPECT_EQ(4u, handler->mContacts.size());
+}
+
+//==============================================================================
+TEST(ConstraintSolver, PersistentJointConstraints)
+{
+  // Pendulum that gravity swings toward the upper limit of its joint
+  auto world = simulation::World::create();
+  world->setGravity(Eigen::Vector3d(-9.81, 0.0, 0.0));
+
+  auto skel = dynamics::Skeleton::create("pendulum");
+  auto pair = skel->createJointAndBodyNodePair<dynamics::RevoluteJoint>();
+  auto joint = pair.first;
+  joint->setAxis(Eigen::Vector3d::UnitY());
+  joint->setPositionUpperLimit(0, 0.2);
+  joint->setLimitEnforcement(true);
+  pair.second->setMass(1.0);
+  pair.second->setLocalCOM(Eigen::Vector3d(0.0, 0.0, -0.5));
+  world->addSkeleton(skel);
+
+  const auto stepAndGetMaxPosition = [&]() {
+    auto maxPosition = -std::numeric_limits<double>::infinity();
+    for (auto i = 0u; i < 500u; ++i) {
+      world->step();
+      maxPosition = std::max(maxPosition, joint->getPosition(0));
+    }
+    return maxPosition;
+  };
+
+  const double tolerance = 1e-2;
+  EXPECT_NEAR(0.2, stepAndGetMaxPosition(), tolerance);
+
+  // Changing a limit of the joint recreates its constraint
+  joint->setPositionUpperLimit(0, 0.5);
+  EXPECT_NEAR(0.5, stepAndGetMaxPosition(), tolerance);
+
+  // So does disabling the limits
+  joint->setLimitEnforcement(false);
+  EXPECT_GT(stepAndGetMaxPosition(), 0.5 + tolerance);
+
+  // A servo motor is updated every step, and holds the joint in place
+  joint->setPositionUpperLimit(0, std::numeric_limits<double>::infinity());
+  joint->setActuatorType(dynamics::Joint::SERVO);
+  joint->setForceLowerLimit(0, -1e4);
+  joint->setForceUpperLimit(0, 1e4);
+  joint->setCommand(0, 0.0);
+  world->step();
+  const double position = joint->getPosition(0);
+  for (auto i = 0u; i < 100u; ++i) {
+    joint->setCommand(0, 0.0);
+    world->step();
+  }
+  EXPECT_NEAR(position, joint->getPosition(0), 1e-6);
+}
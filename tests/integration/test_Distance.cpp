@@ -304,3 +304,243 @@ TEST(Distance, SphereSphere)
   auto dart = DARTCollisionDetector::create();
   testSphereSphere(dart);
 }
+
+//==============================================================================
+/// Returns the unclamped signed distance between the shapes of two frames
+/// computed by the DART collision detector
+double computeDARTDistance(
+    const std::shared_ptr<CollisionDetector>& cd,
+    SimpleFrame* frame1,
+    SimpleFrame* frame2,
+    collision::DistanceResult& result)
+{
+  auto group1 = cd->createCollisionGroup(frame1);
+  auto group2 = cd->createCollisionGroup(frame2);
+
+  collision::DistanceOption option;
+  option.enableNearestPoints = true;
+  option.distanceLowerBound = -std::numeric_limits<double>::infinity();
+
+  cd->distance(group1.get(), group2.get(), option, &result);
+  EXPECT_TRUE(result.found());
+  EXPECT_EQ(result.shapeFrame1, frame1);
+  EXPECT_EQ(result.shapeFrame2, frame2);
+
+  // The nearest points are always |distance| apart
+  EXPECT_NEAR(
+      (result.nearestPoint2 - result.nearestPoint1).norm(),
+      std::abs(result.unclampedMinDistance),
+      1e-6);
+
+  return result.unclampedMinDistance;
+}
+
+//==============================================================================
+TEST(Distance, DARTPrimitivePairs)
+{
+  auto cd = DARTCollisionDetector::create();
+  collision::DistanceResult result;
+
+  auto frame1 = SimpleFrame::createShared(Frame::World());
+  auto frame2 = SimpleFrame::createShared(Frame::World());
+
+  // Sphere - sphere
+  frame1->setShape(std::make_shared<SphereShape>(1.0));
+  frame2->setShape(std::make_shared<SphereShape>(0.5));
+  frame2->setTranslation(Eigen::Vector3d(2.0, 0.0, 0.0));
+  EXPECT_NEAR(
+      computeDARTDistance(cd, frame1.get(), frame2.get(), result), 0.5, 1e-12);
+  EXPECT_TRUE(result.nearestPoint1.isApprox(Eigen::Vector3d(1.0, 0.0, 0.0)));
+  EXPECT_TRUE(result.nearestPoint2.isApprox(Eigen::Vector3d(1.5, 0.0, 0.0)));
+
+  frame2->setTranslation(Eigen::Vector3d(0.75, 0.0, 0.0));
+  EXPECT_NEAR(
+      computeDARTDistance(cd, frame1.get(), frame2.get(), result),
+      -0.75,
+      1e-12);
+
+  // Sphere - box
+  frame1->setShape(std::make_shared<SphereShape>(0.25));
+  frame1->setTranslation(Eigen::Vector3d(1.0, 0.2, 0.0));
+  frame2->setShape(std::make_shared<BoxShape>(Eigen::Vector3d::Ones()));
+  frame2->setTranslation(Eigen::Vector3d::Zero());
+  EXPECT_NEAR(
+      computeDARTDistance(cd, frame1.get(), frame2.get(), result), 0.25, 1e-12);
+  EXPECT_TRUE(result.nearestPoint1.isApprox(Eigen::Vector3d(0.75, 0.2, 0.0)));
+  EXPECT_TRUE(result.nearestPoint2.isApprox(Eigen::Vector3d(0.5, 0.2, 0.0)));
+
+  frame1->setTranslation(Eigen::Vector3d(0.4, 0.0, 0.1));
+  EXPECT_NEAR(
+      computeDARTDistance(cd, frame1.get(), frame2.get(), result),
+      -0.35,
+      1e-12);
+
+  // Box - box, apart and rotated
+  frame1->setShape(std::make_shared<BoxShape>(Eigen::Vector3d::Ones()));
+  frame1->setTranslation(Eigen::Vector3d::Zero());
+  Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+  tf.linear() = Eigen::AngleAxisd(
+                    0.25 * math::constantsd::pi(), Eigen::Vector3d::UnitZ())
+                    .toRotationMatrix();
+  tf.translation() = Eigen::Vector3d(2.0, 0.0, 0.0);
+  frame2->setRelativeTransform(tf);
+  EXPECT_NEAR(
+      computeDARTDistance(cd, frame1.get(), frame2.get(), result),
+      1.5 - 0.5 * std::sqrt(2.0),
+      1e-9);
+  EXPECT_NEAR(result.nearestPoint1[0], 0.5, 1e-9);
+  EXPECT_NEAR(result.nearestPoint2[0], 2.0 - 0.5 * std::sqrt(2.0), 1e-9);
+
+  // Box - box, penetrating
+  frame2->setTransform(Eigen::Isometry3d::Identity());
+  frame2->setTranslation(Eigen::Vector3d(0.8, 0.1, 0.0));
+  EXPECT_NEAR(
+      computeDARTDistance(cd, frame1.get(), frame2.get(), result), -0.2, 1e-9);
+  EXPECT_NEAR(result.nearestPoint1[0], 0.5, 1e-9);
+  EXPECT_NEAR(result.nearestPoint2[0], 0.3, 1e-9);
+
+  // Non-uniform ellipsoid - sphere
+  frame1->setShape(
+      std::make_shared<EllipsoidShape>(Eigen::Vector3d(2.0, 1.0, 1.0)));
+  frame2->setShape(std::make_shared<SphereShape>(0.5));
+  frame2->setTranslation(Eigen::Vector3d(3.0, 0.0, 0.0));
+  EXPECT_NEAR(
+      computeDARTDistance(cd, frame1.get(), frame2.get(), result), 1.5, 1e-6);
+
+  frame2->setTranslation(Eigen::Vector3d(0.0, 0.75, 0.0));
+  EXPECT_NEAR(
+      computeDARTDistance(cd, frame1.get(), frame2.get(), result),
+      -0.25,
+      1e-6);
+
+  // Non-uniform ellipsoid - box, penetrating along the x-axis
+  frame2->setShape(std::make_shared<BoxShape>(Eigen::Vector3d::Ones()));
+  frame2->setTranslation(Eigen::Vector3d(1.25, 0.0, 0.0));
+  EXPECT_NEAR(
+      computeDARTDistance(cd, frame1.get(), frame2.get(), result),
+      -0.25,
+      1e-6);
+
+  // Unsupported shapes are skipped
+  frame2->setShape(std::make_shared<CylinderShape>(0.5, 1.0));
+  auto group1 = cd->createCollisionGroup(frame1.get());
+  auto group2 = cd->createCollisionGroup(frame2.get());
+  EXPECT_EQ(cd->distance(group1.get(), group2.get()), 0.0);
+}
+
+//==============================================================================
+TEST(Distance, DARTBroadphase)
+{
+  auto cd = DARTCollisionDetector::create();
+  auto group = cd->createCollisionGroup();
+
+  math::Random::setSeed(0u);
+
+  std::vector<SimpleFramePtr> frames;
+  for (auto i = 0u; i < 40u; ++i) {
+    auto frame = SimpleFrame::createShared(Frame::World());
+    if (i % 2u == 0u) {
+      frame->setShape(std::make_shared<SphereShape>(
+          math::Random::uniform<double>(0.1, 0.3)));
+    } else {
+      frame->setShape(std::make_shared<BoxShape>(
+          math::Random::uniform<Eigen::Vector3d>(0.1, 0.5)));
+    }
+    frame->setTranslation(math::Random::uniform<Eigen::Vector3d>(-5.0, 5.0));
+    group->addShapeFrame(frame.get());
+    frames.push_back(frame);
+  }
+
+  // Brute force over every pair
+  auto minDistance = std::numeric_limits<double>::infinity();
+  std::pair<const ShapeFrame*, const ShapeFrame*> nearest;
+  for (auto i = 0u; i < frames.size(); ++i) {
+    for (auto j = i + 1u; j < frames.size(); ++j) {
+      auto group1 = cd->createCollisionGroup(frames[i].get());
+      auto group2 = cd->createCollisionGroup(frames[j].get());
+      const double distance = cd->distance(
+          group1.get(),
+          group2.get(),
+          collision::DistanceOption(
+              false, -std::numeric_limits<double>::infinity()));
+      if (distance < minDistance) {
+        minDistance = distance;
+        nearest = {frames[i].get(), frames[j].get()};
+      }
+    }
+  }
+  ASSERT_GT(minDistance, 0.0);
+
+  collision::DistanceOption option(
+      false, -std::numeric_limits<double>::infinity());
+  collision::DistanceResult result;
+  EXPECT_DOUBLE_EQ(group->distance(option, &result), minDistance);
+  EXPECT_DOUBLE_EQ(result.minDistance, minDistance);
+  EXPECT_TRUE(
+      (result.shapeFrame1 == nearest.first
+       && result.shapeFrame2 == nearest.second)
+      || (result.shapeFrame1 == nearest.second
+          && result.shapeFrame2 == nearest.first));
+
+  // The query stops at the first pair closer than the lower bound
+  option.distanceLowerBound = 1e3;
+  EXPECT_DOUBLE_EQ(group->distance(option, &result), 1e3);
+  EXPECT_DOUBLE_EQ(result.minDistance, 1e3);
+  EXPECT_LE(result.unclampedMinDistance, 1e3);
+
+  // Excluding the nearest pair gives the next nearest one
+  struct ExcludePair : collision::DistanceFilter
+  {
+    std::pair<const ShapeFrame*, const ShapeFrame*> mPair;
+
+    bool needDistance(
+        const CollisionObject* object1,
+        const CollisionObject* object2) const override
+    {
+      const auto* frame1 = object1->getShapeFrame();
+      const auto* frame2 = object2->getShapeFrame();
+      return !(frame1 == mPair.first && frame2 == mPair.second)
+             && !(frame1 == mPair.second && frame2 == mPair.first);
+    }
+  };
+  auto filter = std::make_shared<ExcludePair>();
+  filter->mPair = nearest;
+  option.distanceLowerBound = -std::numeric_limits<double>::infinity();
+  option.distanceFilter = filter;
+  EXPECT_GE(group->distance(option, &result), minDistance);
+  EXPECT_NE(result.shapeFrame1, result.shapeFrame2);
+  EXPECT_FALSE(
+      result.shapeFrame1 == nearest.first
+      && result.shapeFrame2 == nearest.second);
+
+  // Between two groups, only the pairs with one object from each count
+  auto evenGroup = cd->createCollisionGroup();
+  auto oddGroup = cd->createCollisionGroup();
+  for (auto i = 0u; i < frames.size(); ++i) {
+    if (i % 2u == 0u)
+      evenGroup->addShapeFrame(frames[i].get());
+    else
+      oddGroup->addShapeFrame(frames[i].get());
+  }
+
+  auto minGroupDistance = std::numeric_limits<double>::infinity();
+  for (auto i = 0u; i < frames.size(); i += 2u) {
+    for (auto j = 1u; j < frames.size(); j += 2u) {
+      auto group1 = cd->createCollisionGroup(frames[i].get());
+      auto group2 = cd->createCollisionGroup(frames[j].get());
+      minGroupDistance = std::min(
+          minGroupDistance,
+          cd->distance(
+              group1.get(),
+              group2.get(),
+              collision::DistanceOption(
+                  false, -std::numeric_limits<double>::infinity())));
+    }
+  }
+
+  option.distanceFilter = nullptr;
+  EXPECT_DOUBLE_EQ(
+      evenGroup->distance(oddGroup.get(), option, &result), minGroupDistance);
+  EXPECT_DOUBLE_EQ(
+      oddGroup->distance(evenGroup.get(), option, &result), minGroupDistance);
+}
@@ -30,6 +30,7 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include "AllocationCounter.hpp"
 #include "TestHelpers.hpp"
 #include "dart/common/Console.hpp"
 #include "dart/dynamics/BodyNode.hpp"
@@ -2544,3 +2545,388 @@ TEST_F(DynamicsTest, OffsetCOM)
         << "\nActual: " << linAccel.transpose();
   }
 }
+
+//==============================================================================
+template <class JointType>
+BodyNode* addDerivativesTestBody(
+    const SkeletonPtr& skel, BodyNode* parent, const int index)
+{
+  typename JointType::Properties jointProps;
+  jointProps.mT_ParentBodyToJoint.translation()
+      = Vector3d(0.1 * index, -0.2, 0.3);
+  jointProps.mT_ParentBodyToJoint.linear()
+      = math::expMapRot(Vector3d(0.2, -0.1 * index, 0.3));
+  jointProps.mT_ChildBodyToJoint.translation() = Vector3d(0.0, 0.05, -0.1);
+  auto* bodyNode
+      = skel->createJointAndBodyNodePair<JointType>(parent, jointProps).second;
+
+  dynamics::Inertia inertia;
+  inertia.setMass(1.0 + 0.5 * index);
+  inertia.setLocalCOM(Vector3d(0.05, 0.1 * index, -0.02));
+  inertia.setMoment(0.1, 0.2 + 0.01 * index, 0.15, 0.01, -0.02, 0.005);
+  bodyNode->setInertia(inertia);
+
+  return bodyNode;
+}
+
+//==============================================================================
+TEST_F(DynamicsTest, ForwardDynamicsDerivatives)
+{
+  auto skel = Skeleton::create("derivatives");
+  skel->setGravity(Vector3d(0.3, -0.5, -9.81));
+  skel->setTimeStep(1e-3);
+
+  auto* root = addDerivativesTestBody<FreeJoint>(skel, nullptr, 0);
+  auto* link1 = addDerivativesTestBody<RevoluteJoint>(skel, root, 1);
+  auto* link2 = addDerivativesTestBody<BallJoint>(skel, link1, 2);
+  auto* link3 = addDerivativesTestBody<EulerJoint>(skel, link2, 3);
+  auto* link4 = addDerivativesTestBody<UniversalJoint>(skel, link1, 4);
+  link3->setGravityMode(false);
+  link2->addExtForce(Vector3d(1.0, -2.0, 0.5), Vector3d(0.1, 0.0, 0.0));
+  link4->addExtTorque(Vector3d(-0.3, 0.2, 0.1), true);
+
+  const std::size_t numDofs = skel->getNumDofs();
+  for (std::size_t i = 0; i < numDofs; ++i) {
+    skel->getDof(i)->setDampingCoefficient(0.1 * (i % 3));
+    skel->getDof(i)->setSpringStiffness(2.0 * (i % 2));
+    skel->getDof(i)->setRestPosition(0.1);
+  }
+
+  skel->setPositions(math::Random::uniform<VectorXd>(numDofs, -1.0, 1.0));
+  skel->setVelocities(math::Random::uniform<VectorXd>(numDofs, -2.0, 2.0));
+  skel->setForces(math::Random::uniform<VectorXd>(numDofs, -5.0, 5.0));
+
+  MatrixXd ddqDq;
+  MatrixXd ddqDdq;
+  MatrixXd ddqDtau;
+  skel->computeForwardDynamicsDerivatives(ddqDq, ddqDdq, ddqDtau);
+  ASSERT_EQ(ddqDq.rows(), static_cast<int>(numDofs));
+  ASSERT_EQ(ddqDq.cols(), static_cast<int>(numDofs));
+
+  // Finite differences of forward dynamics, with the positions perturbed
+  // along the tangent space of each joint
+  const VectorXd q = skel->getPositions();
+  const VectorXd dq = skel->getVelocities();
+  const VectorXd tau = skel->getForces();
+  const auto computeAccelerations = [&]() -> VectorXd {
+    skel->computeForwardDynamics();
+    return skel->getAccelerations();
+  };
+
+  const double h = 1e-6;
+  MatrixXd fdDq(numDofs, numDofs);
+  MatrixXd fdDdq(numDofs, numDofs);
+  MatrixXd fdDtau(numDofs, numDofs);
+  for (std::size_t k = 0; k < numDofs; ++k) {
+    VectorXd ddqPlus;
+    VectorXd ddqMinus;
+    for (const double sign : {1.0, -1.0}) {
+      skel->setPositions(q);
+      skel->setVelocities(VectorXd::Unit(numDofs, k));
+      skel->integratePositions(sign * h);
+      skel->setVelocities(dq);
+      (sign > 0.0 ? ddqPlus : ddqMinus) = computeAccelerations();
+    }
+    fdDq.col(k) = (ddqPlus - ddqMinus) / (2.0 * h);
+    skel->setPositions(q);
+
+    skel->setVelocities(dq + h * VectorXd::Unit(numDofs, k));
+    ddqPlus = computeAccelerations();
+    skel->setVelocities(dq - h * VectorXd::Unit(numDofs, k));
+    ddqMinus = computeAccelerations();
+    fdDdq.col(k) = (ddqPlus - ddqMinus) / (2.0 * h);
+    skel->setVelocities(dq);
+
+    skel->setForces(tau + h * VectorXd::Unit(numDofs, k));
+    ddqPlus = computeAccelerations();
+    skel->setForces(tau - h * VectorXd::Unit(numDofs, k));
+    ddqMinus = computeAccelerations();
+    fdDtau.col(k) = (ddqPlus - ddqMinus) / (2.0 * h);
+    skel->setForces(tau);
+  }
+
+  const double tol = 1e-5;
+  EXPECT_TRUE(equals(ddqDq, fdDq, tol))
+      << "analytic:\n" << ddqDq << "\nnumeric:\n" << fdDq;
+  EXPECT_TRUE(equals(ddqDdq, fdDdq, tol))
+      << "analytic:\n" << ddqDdq << "\nnumeric:\n" << fdDdq;
+  EXPECT_TRUE(equals(ddqDtau, fdDtau, tol))
+      << "analytic:\n" << ddqDtau << "\nnumeric:\n" << fdDtau;
+}
+
+//==============================================================================
+TEST_F(DynamicsTest, InverseDynamicsDerivativesDoNotAllocate)
+{
+#if !DART_TEST_CAN_COUNT_ALLOCATIONS
+  GTEST_SKIP() << "Heap allocations can't be counted on this platform";
+#endif
+
+  auto skel = Skeleton::create("derivatives");
+  auto* root = addDerivativesTestBody<FreeJoint>(skel, nullptr, 0);
+  auto* link1 = addDerivativesTestBody<RevoluteJoint>(skel, root, 1);
+  auto* link2 = addDerivativesTestBody<BallJoint>(skel, link1, 2);
+  auto* link3 = addDerivativesTestBody<EulerJoint>(skel, link2, 3);
+  addDerivativesTestBody<UniversalJoint>(skel, link1, 4);
+  addDerivativesTestBody<PlanarJoint>(skel, link3, 1);
+  auto* link6 = addDerivativesTestBody<PrismaticJoint>(skel, root, 2);
+  addDerivativesTestBody<ScrewJoint>(skel, link6, 3);
+
+  // The springs of multi-DOF joints are differentiated along the tangent
+  // space of the joint, which allocates, so only the single-DOF joints have
+  // springs here
+  const std::size_t numDofs = skel->getNumDofs();
+  for (std::size_t i = 0; i < numDofs; ++i) {
+    skel->getDof(i)->setDampingCoefficient(0.1 * (i % 3));
+    if (skel->getDof(i)->getJoint()->getNumDofs() == 1u)
+      skel->getDof(i)->setSpringStiffness(2.0 * (i % 2));
+  }
+
+  const VectorXd q = math::Random::uniform<VectorXd>(numDofs, -1.0, 1.0);
+  skel->setPositions(q);
+  skel->setVelocities(math::Random::uniform<VectorXd>(numDofs, -2.0, 2.0));
+  skel->setAccelerations(math::Random::uniform<VectorXd>(numDofs, -3.0, 3.0));
+
+  MatrixXd tauDq;
+  MatrixXd tauDdq;
+  skel->computeInverseDynamicsDerivatives(tauDq, tauDdq, true, true, true);
+  const MatrixXd expectedDq = tauDq;
+  const MatrixXd expectedDdq = tauDdq;
+
+  // Each cycle of a control loop changes the state and queries the
+  // derivatives again
+  const std::size_t numAllocations = test::getNumAllocations();
+  for (std::size_t i = 0; i < 10; ++i) {
+    skel->setPosition(i % numDofs, q[i % numDofs] + 0.1);
+    skel->computeInverseDynamicsDerivatives(tauDq, tauDdq, true, true, true);
+  }
+  EXPECT_EQ(numAllocations, test::getNumAllocations());
+
+  // Reusing the scratch data doesn't change the derivatives
+  skel->setPositions(q);
+  skel->computeInverseDynamicsDerivatives(tauDq, tauDdq, true, true, true);
+  EXPECT_EQ(expectedDq, tauDq);
+  EXPECT_EQ(expectedDdq, tauDdq);
+}
+
+//==============================================================================
+/// Adds numBodyNodes BodyNodes with random joints to random parents in skel,
+/// starting a new tree with a FreeJoint
+void addRandomTree(const SkeletonPtr& skel, std::size_t numBodyNodes)
+{
+  std::vector<BodyNode*> bodyNodes;
+  bodyNodes.push_back(addDerivativesTestBody<FreeJoint>(skel, nullptr, 0));
+
+  for (std::size_t i = 1; i < numBodyNodes; ++i) {
+    BodyNode* parent = bodyNodes[math::Random::uniform<std::size_t>(
+        0u, bodyNodes.size() - 1u)];
+    const int index = static_cast<int>(i % 5);
+
+    BodyNode* bodyNode = nullptr;
+    switch (math::Random::uniform<int>(0, 4)) {
+      case 0:
+        bodyNode = addDerivativesTestBody<RevoluteJoint>(skel, parent, index);
+        break;
+      case 1:
+        bodyNode = addDerivativesTestBody<PrismaticJoint>(skel, parent, index);
+        break;
+      case 2:
+        bodyNode = addDerivativesTestBody<BallJoint>(skel, parent, index);
+        break;
+      case 3:
+        bodyNode = addDerivativesTestBody<UniversalJoint>(skel, parent, index);
+        break;
+      default:
+        bodyNode = addDerivativesTestBody<WeldJoint>(skel, parent, index);
+        break;
+    }
+    bodyNodes.push_back(bodyNode);
+  }
+}
+
+//==============================================================================
+/// Compares the mass matrices of skel and their inverses to the recursive
+/// algorithms. Column k of the mass matrix is the inverse dynamics of a unit
+/// acceleration of DOF k, and column k of the inverse of the (augmented) mass
+/// matrix is the forward dynamics, i.e., the articulated body algorithm, of a
+/// unit force on DOF k.
+void compareMassMatricesToRecursiveDynamics(const SkeletonPtr& skel)
+{
+  // Changing the damping, the stiffness or the actuator type of a joint does
+  // not dirty the cached dynamics
+  const auto dirtyDynamics = [&]() {
+    for (std::size_t i = 0; i < skel->getNumTrees(); ++i)
+      skel->dirtyArticulatedInertia(i);
+  };
+  dirtyDynamics();
+
+  const std::size_t numDofs = skel->getNumDofs();
+  const double dt = skel->getTimeStep();
+  const MatrixXd M = skel->getMassMatrix();
+  const MatrixXd AugM = skel->getAugMassMatrix();
+  const MatrixXd InvM = skel->getInvMassMatrix();
+  const MatrixXd InvAugM = skel->getInvAugMassMatrix();
+
+  const VectorXd velocities = skel->getVelocities();
+  const Vector3d gravity = skel->getGravity();
+  VectorXd restPositions(numDofs);
+  VectorXd damping(numDofs);
+  VectorXd stiffness(numDofs);
+  for (std::size_t i = 0; i < numDofs; ++i) {
+    const DegreeOfFreedom* dof = skel->getDof(i);
+    restPositions[i] = dof->getRestPosition();
+    damping[i] = dof->getDampingCoefficient();
+    stiffness[i] = dof->getSpringStiffness();
+  }
+
+  // Remove the velocity, gravity and spring forces
+  skel->setVelocities(VectorXd::Zero(numDofs));
+  skel->setGravity(Vector3d::Zero());
+  for (std::size_t i = 0; i < numDofs; ++i)
+    skel->getDof(i)->setRestPosition(skel->getPosition(i));
+
+  MatrixXd expectedM(numDofs, numDofs);
+  MatrixXd expectedInvAugM(numDofs, numDofs);
+  for (std::size_t k = 0; k < numDofs; ++k) {
+    skel->setAccelerations(VectorXd::Unit(numDofs, k));
+    skel->computeInverseDynamics();
+    expectedM.col(k) = skel->getForces();
+
+    skel->setForces(VectorXd::Unit(numDofs, k));
+    skel->computeForwardDynamics();
+    expectedInvAugM.col(k) = skel->getAccelerations();
+  }
+
+  // Without damping and springs the augmented mass matrix is the mass matrix
+  for (std::size_t i = 0; i < numDofs; ++i) {
+    skel->getDof(i)->setDampingCoefficient(0.0);
+    skel->getDof(i)->setSpringStiffness(0.0);
+  }
+  dirtyDynamics();
+
+  MatrixXd expectedInvM(numDofs, numDofs);
+  for (std::size_t k = 0; k < numDofs; ++k) {
+    skel->setForces(VectorXd::Unit(numDofs, k));
+    skel->computeForwardDynamics();
+    expectedInvM.col(k) = skel->getAccelerations();
+  }
+
+  skel->setVelocities(velocities);
+  skel->setGravity(gravity);
+  skel->setForces(VectorXd::Zero(numDofs));
+  for (std::size_t i = 0; i < numDofs; ++i) {
+    DegreeOfFreedom* dof = skel->getDof(i);
+    dof->setRestPosition(restPositions[i]);
+    dof->setDampingCoefficient(damping[i]);
+    dof->setSpringStiffness(stiffness[i]);
+  }
+  dirtyDynamics();
+
+  MatrixXd expectedAugM = expectedM;
+  expectedAugM.diagonal() += dt * damping + dt * dt * stiffness;
+
+  const double tol = 1e-8;
+  EXPECT_TRUE(equals(expectedM, M, tol))
+      << "expected:\n" << expectedM << "\nactual:\n" << M;
+  EXPECT_TRUE(equals(expectedAugM, AugM, tol))
+      << "expected:\n" << expectedAugM << "\nactual:\n" << AugM;
+  EXPECT_TRUE(equals(expectedInvM, InvM, tol))
+      << "expected:\n" << expectedInvM << "\nactual:\n" << InvM;
+  EXPECT_TRUE(equals(expectedInvAugM, InvAugM, tol))
+      << "expected:\n" << expectedInvAugM << "\nactual:\n" << InvAugM;
+}
+
+//==============================================================================
+TEST_F(DynamicsTest, MassMatricesOfBranchedTrees)
+{
+#if DART_BUILD_MODE_DEBUG
+  const std::size_t numSkeletons = 3;
+#else
+  const std::size_t numSkeletons = 30;
+#endif
+
+  for (std::size_t i = 0; i < numSkeletons; ++i) {
+    auto skel = Skeleton::create("branched");
+    skel->setTimeStep(1e-3);
+    addRandomTree(skel, math::Random::uniform<std::size_t>(2u, 12u));
+    addRandomTree(skel, math::Random::uniform<std::size_t>(1u, 6u));
+
+    const std::size_t numDofs = skel->getNumDofs();
+    for (std::size_t j = 0; j < numDofs; ++j) {
+      skel->getDof(j)->setDampingCoefficient(math::Random::uniform(0.0, 10.0));
+      skel->getDof(j)->setSpringStiffness(math::Random::uniform(0.0, 10.0));
+      skel->getDof(j)->setRestPosition(math::Random::uniform(-1.0, 1.0));
+    }
+    skel->setPositions(math::Random::uniform<VectorXd>(numDofs, -1.0, 1.0));
+    skel->setVelocities(math::Random::uniform<VectorXd>(numDofs, -2.0, 2.0));
+
+    {
+      SCOPED_TRACE("rigid trees");
+      compareMassMatricesToRecursiveDynamics(skel);
+    }
+
+    // The forward dynamics does not accelerate the DOFs of kinematic joints
+    Joint* kinematicJoint = nullptr;
+    while (!kinematicJoint || kinematicJoint->getNumDofs() == 0u) {
+      kinematicJoint = skel->getBodyNode(math::Random::uniform<std::size_t>(
+                                             0u, skel->getNumBodyNodes() - 1u))
+                           ->getParentJoint();
+    }
+    kinematicJoint->setActuatorType(Joint::LOCKED);
+    {
+      SCOPED_TRACE("kinematic joint");
+      compareMassMatricesToRecursiveDynamics(skel);
+      const MatrixXd& InvM = skel->getInvMassMatrix();
+      for (std::size_t j = 0; j < kinematicJoint->getNumDofs(); ++j) {
+        const std::size_t index = kinematicJoint->getIndexInSkeleton(j);
+        EXPECT_TRUE(InvM.row(index).isZero(0.0));
+        EXPECT_TRUE(InvM.col(index).isZero(0.0));
+      }
+    }
+    kinematicJoint->setActuatorType(Joint::FORCE);
+
+    // The mass matrices of a tree with a SoftBodyNode come from the recursive
+    // algorithms, which account for the point masses only partially, and the
+    // augmented mass matrix is not implemented for SoftBodyNodes. The point
+    // masses of a SoftBodyNode in its own tree and without springs do not
+    // contribute, so its inverse mass matrix agrees with the forward dynamics.
+    SoftBodyNode::Properties softProperties(
+        BodyNode::AspectProperties("soft"),
+        SoftBodyNodeHelper::makeBoxProperties(
+            Vector3d::Constant(0.2),
+            Eigen::Isometry3d::Identity(),
+            Eigen::Vector3i(3, 3, 3),
+            1.0,
+            0.0,
+            0.0,
+            0.0));
+    skel->createJointAndBodyNodePair<RevoluteJoint, SoftBodyNode>(
+        nullptr,
+        RevoluteJoint::Properties(),
+        softProperties);
+    {
+      SCOPED_TRACE("soft body");
+      const std::size_t numSoftDofs = skel->getNumDofs();
+      for (std::size_t j = 0; j < numSoftDofs; ++j) {
+        skel->getDof(j)->setDampingCoefficient(0.0);
+        skel->getDof(j)->setSpringStiffness(0.0);
+      }
+      for (std::size_t j = 0; j < skel->getNumTrees(); ++j)
+        skel->dirtyArticulatedInertia(j);
+
+      const MatrixXd M = skel->getMassMatrix();
+      const MatrixXd InvM = skel->getInvMassMatrix();
+      EXPECT_TRUE(equals(getMassMatrix(skel), M, 1e-8));
+
+      skel->setVelocities(VectorXd::Zero(numSoftDofs));
+      skel->setGravity(Vector3d::Zero());
+      MatrixXd expectedInvM(numSoftDofs, numSoftDofs);
+      for (std::size_t k = 0; k < numSoftDofs; ++k) {
+        skel->setForces(VectorXd::Unit(numSoftDofs, k));
+        skel->computeForwardDynamics();
+        expectedInvM.col(k) = skel->getAccelerations();
+      }
+      EXPECT_TRUE(equals(expectedInvM, InvM, 1e-8))
+          << "expected:\n" << expectedInvM << "\nactual:\n" << InvM;
+    }
+  }
+}
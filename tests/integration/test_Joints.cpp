@@ -352,6 +352,86 @@ TEST_F(JOINTS, PLANAR_JOINT)
 // we now use spatial velocity and spatial accertions as FreeJoint's generalized
 // velocities and accelerations, repectively.
 
+//==============================================================================
+/// Compares Joint::computeRelativeJacobianDerivatives() to central differences
+/// of the relative Jacobian and of its time derivative
+template <typename JointType>
+void testRelativeJacobianDerivatives(
+    const typename JointType::Properties& properties
+    = typename JointType::Properties())
+{
+  SkeletonPtr skeleton = Skeleton::create();
+  Joint* joint
+      = skeleton->createJointAndBodyNodePair<JointType>(nullptr, properties)
+            .first;
+  joint->setTransformFromChildBodyNode(math::expMap(Eigen::Vector6d::Random()));
+  joint->setTransformFromParentBodyNode(
+      math::expMap(Eigen::Vector6d::Random()));
+
+  const std::size_t numDofs = joint->getNumDofs();
+  const VectorXd q = Random::uniform<VectorXd>(numDofs, -1.0, 1.0);
+  joint->setPositions(q);
+  joint->setVelocities(Random::uniform<VectorXd>(numDofs, -2.0, 2.0));
+
+  std::vector<Jacobian> dS;
+  std::vector<Jacobian> dSdot;
+  joint->computeRelativeJacobianDerivatives(dS, dSdot);
+  ASSERT_EQ(numDofs, dS.size());
+  ASSERT_EQ(numDofs, dSdot.size());
+
+  const double h = 1e-6;
+  for (std::size_t k = 0; k < numDofs; ++k) {
+    VectorXd qk = q;
+    qk[k] = q[k] + h;
+    joint->setPositions(qk);
+    const Jacobian SPlus = joint->getRelativeJacobian();
+    const Jacobian dSdtPlus = joint->getRelativeJacobianTimeDeriv();
+
+    qk[k] = q[k] - h;
+    joint->setPositions(qk);
+    const Jacobian SMinus = joint->getRelativeJacobian();
+    const Jacobian dSdtMinus = joint->getRelativeJacobianTimeDeriv();
+
+    const Jacobian expectedDS = (SPlus - SMinus) / (2.0 * h);
+    const Jacobian expectedDSdot = (dSdtPlus - dSdtMinus) / (2.0 * h);
+    EXPECT_TRUE(equals(expectedDS, dS[k], 1e-6))
+        << joint->getType() << ", position " << k << "\nexpected:\n"
+        << expectedDS << "\nactual:\n"
+        << dS[k];
+    EXPECT_TRUE(equals(expectedDSdot, dSdot[k], 1e-6))
+        << joint->getType() << ", position " << k << "\nexpected:\n"
+        << expectedDSdot << "\nactual:\n"
+        << dSdot[k];
+  }
+}
+
+//==============================================================================
+TEST_F(JOINTS, RelativeJacobianDerivatives)
+{
+  testRelativeJacobianDerivatives<WeldJoint>();
+  testRelativeJacobianDerivatives<RevoluteJoint>();
+  testRelativeJacobianDerivatives<PrismaticJoint>();
+  testRelativeJacobianDerivatives<ScrewJoint>();
+  testRelativeJacobianDerivatives<UniversalJoint>();
+  testRelativeJacobianDerivatives<TranslationalJoint2D>();
+  testRelativeJacobianDerivatives<BallJoint>();
+  testRelativeJacobianDerivatives<TranslationalJoint>();
+  testRelativeJacobianDerivatives<FreeJoint>();
+
+  EulerJoint::Properties eulerProperties;
+  eulerProperties.mAxisOrder = EulerJoint::AxisOrder::XYZ;
+  testRelativeJacobianDerivatives<EulerJoint>(eulerProperties);
+  eulerProperties.mAxisOrder = EulerJoint::AxisOrder::ZYX;
+  testRelativeJacobianDerivatives<EulerJoint>(eulerProperties);
+
+  PlanarJoint::Properties planarProperties;
+  testRelativeJacobianDerivatives<PlanarJoint>(planarProperties);
+  planarProperties.setArbitraryPlane(
+      Eigen::Vector3d(1.0, 2.0, 0.5).normalized(),
+      Eigen::Vector3d(-2.0, 1.0, 0.0).normalized());
+  testRelativeJacobianDerivatives<PlanarJoint>(planarProperties);
+}
+
 //==============================================================================
 template <
     void (Joint::*setX)(std::size_t, double),
@@ -34,6 +34,8 @@
 #include "dart/dart.hpp"
 
 #include <gtest/gtest.h>
+
+#include <thread>
 #if HAVE_BULLET
   #include "dart/collision/bullet/bullet.hpp"
 #endif
@@ -61,9 +63,9 @@ TEST(Raycast, RaycastResultDefaultConstructor)
 //==============================================================================
 void testBasicInterface(const std::shared_ptr<CollisionDetector>& cd)
 {
-  if (cd->getType() != "bullet") {
-    dtwarn << "Aborting test: distance check is not supported by "
-           << cd->getType() << ".\n";
+  if (cd->getType() != "bullet" && cd->getType() != "dart") {
+    dtwarn << "Aborting test: raycast is not supported by " << cd->getType()
+           << ".\n";
     return;
   }
 
@@ -159,9 +161,9 @@ TEST(Raycast, testBasicInterface)
 //==============================================================================
 void testOptions(const std::shared_ptr<CollisionDetector>& cd)
 {
-  if (cd->getType() != "bullet") {
-    dtwarn << "Aborting test: distance check is not supported by "
-           << cd->getType() << ".\n";
+  if (cd->getType() != "bullet" && cd->getType() != "dart") {
+    dtwarn << "Aborting test: raycast is not supported by " << cd->getType()
+           << ".\n";
     return;
   }
 
@@ -238,3 +240,206 @@ TEST(Raycast, testOptions)
   auto dart = DARTCollisionDetector::create();
   testOptions(dart);
 }
+
+//==============================================================================
+void testBatch(const std::shared_ptr<CollisionDetector>& cd)
+{
+  auto group = cd->createCollisionGroup();
+
+  // Spheres, ellipsoids, and rotated boxes on a grid
+  std::vector<SimpleFramePtr> frames;
+  for (auto i = 0; i < 5; ++i) {
+    for (auto j = 0; j < 5; ++j) {
+      auto frame = SimpleFrame::createShared(Frame::World());
+      switch ((i + j) % 3) {
+        case 0:
+          frame->setShape(std::make_shared<SphereShape>(0.3));
+          break;
+        case 1:
+          frame->setShape(
+              std::make_shared<EllipsoidShape>(Eigen::Vector3d(0.8, 0.4, 0.6)));
+          break;
+        default:
+          frame->setShape(
+              std::make_shared<BoxShape>(Eigen::Vector3d(0.5, 0.3, 0.4)));
+          break;
+      }
+
+      Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+      const Eigen::Vector3d axis = Eigen::Vector3d(1.0, 2.0, 3.0).normalized();
+      tf.linear() = Eigen::AngleAxisd(0.3 * (i + j), axis).toRotationMatrix();
+      tf.translation() = Eigen::Vector3d(i - 2.0, j - 2.0, 0.0);
+      frame->setRelativeTransform(tf);
+
+      group->addShapeFrame(frame.get());
+      frames.push_back(frame);
+    }
+  }
+
+  // Rays of a lidar spinning above the grid
+  const auto numRays = 2000;
+  Eigen::Matrix3Xd origins(3, numRays);
+  Eigen::Matrix3Xd directions(3, numRays);
+  for (auto i = 0; i < numRays; ++i) {
+    const double yaw = 2.0 * math::constantsd::pi() * i / numRays;
+    const double pitch = -0.2 - 0.6 * (i % 16) / 15.0;
+    origins.col(i) = Eigen::Vector3d(0.1, 0.2, 1.5);
+    directions.col(i) = 6.0
+                        * Eigen::Vector3d(
+                            std::cos(pitch) * std::cos(yaw),
+                            std::cos(pitch) * std::sin(yaw),
+                            std::sin(pitch));
+  }
+
+  collision::RaycastBatchResult result;
+  const auto numHits = group->raycastBatch(origins, directions, result);
+  EXPECT_EQ(result.getNumRays(), static_cast<std::size_t>(numRays));
+  EXPECT_GT(numHits, 0u);
+
+  // Every ray agrees with the single raycast
+  collision::RaycastResult rayResult;
+  auto numSingleHits = 0u;
+  for (auto i = 0; i < numRays; ++i) {
+    const Eigen::Vector3d from = origins.col(i);
+    const Eigen::Vector3d to = from + directions.col(i);
+    if (!group->raycast(from, to, collision::RaycastOption(), &rayResult)) {
+      EXPECT_EQ(result.mCollisionObjects[i], nullptr);
+      EXPECT_TRUE(std::isinf(result.mDistances[i]));
+      continue;
+    }
+
+    ++numSingleHits;
+    const auto& rayHit = rayResult.mRayHits[0];
+    EXPECT_EQ(result.mCollisionObjects[i], rayHit.mCollisionObject);
+    const double distance = rayHit.mFraction * directions.col(i).norm();
+    EXPECT_NEAR(result.mDistances[i], distance, 1e-9);
+    EXPECT_TRUE(result.mNormals.col(i).isApprox(rayHit.mNormal, 1e-9));
+  }
+  EXPECT_EQ(numHits, numSingleHits);
+
+  // Threads don't change the hits
+  cd->setNumThreads(4u);
+  EXPECT_EQ(cd->getNumThreads(), 4u);
+  collision::RaycastBatchResult parallelResult;
+  EXPECT_EQ(group->raycastBatch(origins, directions, parallelResult), numHits);
+  EXPECT_EQ(parallelResult.mCollisionObjects, result.mCollisionObjects);
+  EXPECT_EQ(parallelResult.mDistances, result.mDistances);
+  EXPECT_EQ(parallelResult.mNormals, result.mNormals);
+  cd->setNumThreads(1u);
+}
+
+//==============================================================================
+TEST(Raycast, Batch)
+{
+#if HAVE_BULLET
+  auto bullet = BulletCollisionDetector::create();
+  testBatch(bullet);
+#endif
+
+  auto dart = DARTCollisionDetector::create();
+  testBatch(dart);
+}
+
+//==============================================================================
+TEST(Raycast, DARTBatchHits)
+{
+  auto cd = DARTCollisionDetector::create();
+
+  auto sphereFrame = SimpleFrame::createShared(Frame::World());
+  sphereFrame->setShape(std::make_shared<SphereShape>(1.0));
+  sphereFrame->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.0));
+
+  auto boxFrame = SimpleFrame::createShared(Frame::World());
+  boxFrame->setShape(std::make_shared<BoxShape>(Eigen::Vector3d(1, 2, 2)));
+  boxFrame->setTranslation(Eigen::Vector3d(3.0, 0.0, 0.0));
+
+  auto group = cd->createCollisionGroup(sphereFrame.get(), boxFrame.get());
+
+  Eigen::Matrix3Xd origins(3, 4);
+  Eigen::Matrix3Xd directions(3, 4);
+  // Hits the sphere in front of the box
+  origins.col(0) = Eigen::Vector3d(-3.0, 0.0, 0.0);
+  directions.col(0) = Eigen::Vector3d(10.0, 0.0, 0.0);
+  // Hits the box from the other side
+  origins.col(1) = Eigen::Vector3d(6.0, 0.5, 0.5);
+  directions.col(1) = Eigen::Vector3d(-10.0, 0.0, 0.0);
+  // Too short to reach the box
+  origins.col(2) = Eigen::Vector3d(6.0, 0.5, 0.5);
+  directions.col(2) = Eigen::Vector3d(-2.0, 0.0, 0.0);
+  // Starts inside the sphere
+  origins.col(3) = Eigen::Vector3d(0.0, 0.0, 0.0);
+  directions.col(3) = Eigen::Vector3d(0.0, 0.0, 5.0);
+
+  collision::RaycastBatchResult result;
+  EXPECT_EQ(group->raycastBatch(origins, directions, result), 2u);
+
+  EXPECT_DOUBLE_EQ(result.mDistances[0], 2.0);
+  EXPECT_TRUE(result.mNormals.col(0).isApprox(-Eigen::Vector3d::UnitX()));
+  EXPECT_EQ(
+      result.mCollisionObjects[0]->getShapeFrame(),
+      static_cast<const ShapeFrame*>(sphereFrame.get()));
+
+  EXPECT_DOUBLE_EQ(result.mDistances[1], 2.5);
+  EXPECT_TRUE(result.mNormals.col(1).isApprox(Eigen::Vector3d::UnitX()));
+  EXPECT_EQ(
+      result.mCollisionObjects[1]->getShapeFrame(),
+      static_cast<const ShapeFrame*>(boxFrame.get()));
+
+  EXPECT_TRUE(std::isinf(result.mDistances[2]));
+  EXPECT_EQ(result.mCollisionObjects[2], nullptr);
+  EXPECT_EQ(result.mNormals.col(2), Eigen::Vector3d::Zero());
+
+  EXPECT_TRUE(std::isinf(result.mDistances[3]));
+  EXPECT_EQ(result.mCollisionObjects[3], nullptr);
+}
+
+//==============================================================================
+TEST(Raycast, DARTConcurrentBatches)
+{
+  auto cd = DARTCollisionDetector::create();
+  cd->setNumThreads(4u);
+
+  // Each batch casts onto its own group of frames
+  const auto numBatches = 4;
+  std::vector<SimpleFramePtr> frames;
+  std::vector<std::unique_ptr<CollisionGroup>> groups;
+  for (auto i = 0; i < numBatches; ++i) {
+    auto frame = SimpleFrame::createShared(Frame::World());
+    frame->setShape(std::make_shared<SphereShape>(1.0 + 0.1 * i));
+    groups.push_back(cd->createCollisionGroup(frame.get()));
+    frames.push_back(frame);
+  }
+
+  const auto numRays = 1000;
+  Eigen::Matrix3Xd origins(3, numRays);
+  Eigen::Matrix3Xd directions(3, numRays);
+  for (auto i = 0; i < numRays; ++i) {
+    const double yaw = 2.0 * math::constantsd::pi() * i / numRays;
+    origins.col(i) = Eigen::Vector3d(0.0, 0.0, 3.0);
+    directions.col(i)
+        = 5.0 * Eigen::Vector3d(std::cos(yaw), std::sin(yaw), -3.0);
+  }
+
+  std::vector<collision::RaycastBatchResult> expected(numBatches);
+  for (auto i = 0; i < numBatches; ++i)
+    groups[i]->raycastBatch(origins, directions, expected[i]);
+
+  // Batches that find the pool busy run on their calling threads
+  for (auto repeat = 0; repeat < 10; ++repeat) {
+    std::vector<collision::RaycastBatchResult> results(numBatches);
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < numBatches; ++i) {
+      threads.emplace_back([&, i]() {
+        groups[i]->raycastBatch(origins, directions, results[i]);
+      });
+    }
+    for (auto& thread : threads)
+      thread.join();
+
+    for (auto i = 0; i < numBatches; ++i) {
+      EXPECT_EQ(results[i].mCollisionObjects, expected[i].mCollisionObjects);
+      EXPECT_EQ(results[i].mDistances, expected[i].mDistances);
+      EXPECT_EQ(results[i].mNormals, expected[i].mNormals);
+    }
+  }
+}
@@ -30,6 +30,7 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include "AllocationCounter.hpp"
 #include "TestHelpers.hpp"
 #include "dart/common/sub_ptr.hpp"
 #include "dart/dynamics/BodyNode.hpp"
@@ -850,6 +851,312 @@ TEST(Skeleton, LinearJacobianDerivOverload)
   linkage->getLinearJacobianDeriv(linkage->getBodyNode(0));
 }
 
+template <typename JacobianType, typename Getter>
+void expectJacobianInBlock(
+    const JacobianType& expected, Eigen::MatrixXd& storage, Getter get)
+{
+  constexpr int rows = JacobianType::RowsAtCompileTime;
+
+  // Fill the storage with a sentinel value to check that the whole block, and
+  // nothing but the block, gets written.
+  const double sentinel = 1e3;
+  storage.setConstant(sentinel);
+  auto J = storage.block<rows, Eigen::Dynamic>(1, 2, rows, expected.cols());
+  get(J);
+
+  EXPECT_TRUE(equals(expected, JacobianType(J)));
+  EXPECT_EQ(storage.size() - J.size(), (storage.array() == sentinel).count());
+}
+
+template <typename JacobianType>
+JacobianType scatterJacobian(
+    const MetaSkeleton* metaSkel,
+    const JacobianNode* node,
+    const JacobianType& JNode)
+{
+  JacobianType J = JacobianType::Zero(JNode.rows(), metaSkel->getNumDofs());
+  const auto& dofs = node->getDependentDofs();
+  for (std::size_t i = 0; i < dofs.size(); ++i) {
+    const std::size_t index = metaSkel->getIndexOf(dofs[i], false);
+    if (INVALID_INDEX != index)
+      J.col(index) = JNode.col(i);
+  }
+
+  return J;
+}
+
+void checkJacobianOutputArguments(
+    const JacobianNode* node,
+    const Frame* frame,
+    const Eigen::Vector3d& offset,
+    Eigen::MatrixXd& storage)
+{
+  expectJacobianInBlock(node->getJacobian(frame), storage, [&](auto J) {
+    node->getJacobian(frame, J);
+  });
+  expectJacobianInBlock(
+      node->getJacobian(offset, frame), storage, [&](auto J) {
+        node->getJacobian(offset, frame, J);
+      });
+  expectJacobianInBlock(
+      node->getWorldJacobian(offset), storage, [&](auto J) {
+        node->getWorldJacobian(offset, J);
+      });
+  expectJacobianInBlock(node->getLinearJacobian(frame), storage, [&](auto J) {
+    node->getLinearJacobian(frame, J);
+  });
+  expectJacobianInBlock(
+      node->getLinearJacobian(offset, frame), storage, [&](auto J) {
+        node->getLinearJacobian(offset, frame, J);
+      });
+  expectJacobianInBlock(
+      node->getAngularJacobian(frame), storage, [&](auto J) {
+        node->getAngularJacobian(frame, J);
+      });
+  expectJacobianInBlock(
+      node->getJacobianSpatialDeriv(frame), storage, [&](auto J) {
+        node->getJacobianSpatialDeriv(frame, J);
+      });
+  expectJacobianInBlock(
+      node->getJacobianSpatialDeriv(offset, frame), storage, [&](auto J) {
+        node->getJacobianSpatialDeriv(offset, frame, J);
+      });
+  expectJacobianInBlock(
+      node->getJacobianClassicDeriv(frame), storage, [&](auto J) {
+        node->getJacobianClassicDeriv(frame, J);
+      });
+  expectJacobianInBlock(
+      node->getJacobianClassicDeriv(offset, frame), storage, [&](auto J) {
+        node->getJacobianClassicDeriv(offset, frame, J);
+      });
+  expectJacobianInBlock(
+      node->getLinearJacobianDeriv(frame), storage, [&](auto J) {
+        node->getLinearJacobianDeriv(frame, J);
+      });
+  expectJacobianInBlock(
+      node->getLinearJacobianDeriv(offset, frame), storage, [&](auto J) {
+        node->getLinearJacobianDeriv(offset, frame, J);
+      });
+  expectJacobianInBlock(
+      node->getAngularJacobianDeriv(frame), storage, [&](auto J) {
+        node->getAngularJacobianDeriv(frame, J);
+      });
+}
+
+void checkJacobianOutputArguments(
+    const MetaSkeleton* metaSkel,
+    const JacobianNode* node,
+    const Frame* frame,
+    const Eigen::Vector3d& offset,
+    Eigen::MatrixXd& storage)
+{
+  // Compare with the Jacobians of the JacobianNode rather than with the
+  // versions of the MetaSkeleton that return by value, since those are
+  // implemented with the versions that take output arguments.
+  const auto scatter = [&](const auto& JNode) {
+    return scatterJacobian(metaSkel, node, JNode);
+  };
+
+  expectJacobianInBlock(
+      scatter(node->getJacobian(frame)), storage, [&](auto J) {
+        metaSkel->getJacobian(node, frame, J);
+      });
+  expectJacobianInBlock(
+      scatter(node->getJacobian(offset, frame)), storage, [&](auto J) {
+        metaSkel->getJacobian(node, offset, frame, J);
+      });
+  expectJacobianInBlock(
+      scatter(node->getWorldJacobian(offset)), storage, [&](auto J) {
+        metaSkel->getWorldJacobian(node, offset, J);
+      });
+  expectJacobianInBlock(
+      scatter(node->getLinearJacobian(frame)), storage, [&](auto J) {
+        metaSkel->getLinearJacobian(node, frame, J);
+      });
+  expectJacobianInBlock(
+      scatter(node->getLinearJacobian(offset, frame)), storage, [&](auto J) {
+        metaSkel->getLinearJacobian(node, offset, frame, J);
+      });
+  expectJacobianInBlock(
+      scatter(node->getAngularJacobian(frame)), storage, [&](auto J) {
+        metaSkel->getAngularJacobian(node, frame, J);
+      });
+  expectJacobianInBlock(
+      scatter(node->getJacobianSpatialDeriv(frame)), storage, [&](auto J) {
+        metaSkel->getJacobianSpatialDeriv(node, frame, J);
+      });
+  expectJacobianInBlock(
+      scatter(node->getJacobianSpatialDeriv(offset, frame)),
+      storage,
+      [&](auto J) {
+        metaSkel->getJacobianSpatialDeriv(node, offset, frame, J);
+      });
+  expectJacobianInBlock(
+      scatter(node->getJacobianClassicDeriv(frame)), storage, [&](auto J) {
+        metaSkel->getJacobianClassicDeriv(node, frame, J);
+      });
+  expectJacobianInBlock(
+      scatter(node->getJacobianClassicDeriv(offset, frame)),
+      storage,
+      [&](auto J) {
+        metaSkel->getJacobianClassicDeriv(node, offset, frame, J);
+      });
+  expectJacobianInBlock(
+      scatter(node->getLinearJacobianDeriv(frame)), storage, [&](auto J) {
+        metaSkel->getLinearJacobianDeriv(node, frame, J);
+      });
+  expectJacobianInBlock(
+      scatter(node->getLinearJacobianDeriv(offset, frame)),
+      storage,
+      [&](auto J) {
+        metaSkel->getLinearJacobianDeriv(node, offset, frame, J);
+      });
+  expectJacobianInBlock(
+      scatter(node->getAngularJacobianDeriv(frame)), storage, [&](auto J) {
+        metaSkel->getAngularJacobianDeriv(node, frame, J);
+      });
+}
+
+TEST(Skeleton, JacobianOutputArguments)
+{
+  // Build a tree so that the dependent DOFs of some BodyNodes are not the
+  // leading DOFs of the Skeleton
+  SkeletonPtr skel = Skeleton::create();
+  BodyNode* root = skel->createJointAndBodyNodePair<FreeJoint>().second;
+  BodyNode* left = skel->createJointAndBodyNodePair<BallJoint>(root).second;
+  BodyNode* leftTip
+      = skel->createJointAndBodyNodePair<RevoluteJoint>(left).second;
+  BodyNode* right
+      = skel->createJointAndBodyNodePair<RevoluteJoint>(root).second;
+  BodyNode* rightTip
+      = skel->createJointAndBodyNodePair<BallJoint>(right).second;
+  EndEffector* ee = rightTip->createEndEffector("ee");
+
+  for (std::size_t i = 1; i < skel->getNumJoints(); ++i) {
+    Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+    tf.translation() = Eigen::Vector3d::Random();
+    skel->getJoint(i)->setTransformFromParentBodyNode(tf);
+  }
+  Eigen::Isometry3d eeTf = Eigen::Isometry3d::Identity();
+  eeTf.translation() = Eigen::Vector3d::Random();
+  eeTf.linear() = math::expMapRot(Eigen::Vector3d::Random());
+  ee->setDefaultRelativeTransform(eeTf, true);
+
+  skel->setPositions(Eigen::VectorXd::Random(skel->getNumDofs()));
+  skel->setVelocities(Eigen::VectorXd::Random(skel->getNumDofs()));
+
+  // A Group whose DOFs are reordered and miss some of the dependent DOFs of
+  // its BodyNodes, and a Chain that excludes the root
+  GroupPtr group = Group::create("group", {rightTip, left, leftTip});
+  ChainPtr chain = Chain::create(root, rightTip);
+
+  const std::vector<const MetaSkeleton*> metaSkels
+      = {skel.get(), group.get(), chain.get()};
+  const std::vector<const JacobianNode*> nodes
+      = {root, left, leftTip, right, rightTip, ee};
+  const std::vector<const Frame*> frames = {Frame::World(), left, ee};
+  const Eigen::Vector3d offset = Eigen::Vector3d::Random();
+
+  Eigen::MatrixXd storage(10, skel->getNumDofs() + 4);
+  for (const JacobianNode* node : nodes) {
+    std::vector<const Frame*> nodeFrames = frames;
+    nodeFrames.push_back(node);
+
+    for (const Frame* frame : nodeFrames) {
+      checkJacobianOutputArguments(node, frame, offset, storage);
+
+      for (const MetaSkeleton* metaSkel : metaSkels)
+        checkJacobianOutputArguments(metaSkel, node, frame, offset, storage);
+    }
+  }
+}
+
+void queryJacobianOutputArguments(
+    const MetaSkeleton* metaSkel,
+    const JacobianNode* node,
+    const Frame* frame,
+    const Eigen::Vector3d& offset,
+    Eigen::MatrixXd& storage)
+{
+  const auto numDofs = static_cast<int>(metaSkel->getNumDofs());
+  auto J = storage.topLeftCorner(6, numDofs);
+  auto JLinear = storage.topLeftCorner<3, Eigen::Dynamic>(3, numDofs);
+  auto JAngular = storage.bottomLeftCorner<3, Eigen::Dynamic>(3, numDofs);
+
+  metaSkel->getJacobian(node, frame, J);
+  metaSkel->getJacobian(node, offset, frame, J);
+  metaSkel->getWorldJacobian(node, offset, J);
+  metaSkel->getLinearJacobian(node, frame, JLinear);
+  metaSkel->getLinearJacobian(node, offset, frame, JLinear);
+  metaSkel->getAngularJacobian(node, frame, JAngular);
+  metaSkel->getJacobianSpatialDeriv(node, frame, J);
+  metaSkel->getJacobianSpatialDeriv(node, offset, frame, J);
+  metaSkel->getJacobianClassicDeriv(node, frame, J);
+  metaSkel->getJacobianClassicDeriv(node, offset, frame, J);
+  metaSkel->getLinearJacobianDeriv(node, frame, JLinear);
+  metaSkel->getLinearJacobianDeriv(node, offset, frame, JLinear);
+  metaSkel->getAngularJacobianDeriv(node, frame, JAngular);
+}
+
+TEST(Skeleton, JacobianOutputArgumentsDoNotAllocate)
+{
+#if !DART_TEST_CAN_COUNT_ALLOCATIONS
+  GTEST_SKIP() << "Heap allocations can't be counted on this platform";
+#endif
+
+  SkeletonPtr skel = Skeleton::create();
+  BodyNode* root = skel->createJointAndBodyNodePair<FreeJoint>().second;
+  BodyNode* left = skel->createJointAndBodyNodePair<BallJoint>(root).second;
+  BodyNode* leftTip
+      = skel->createJointAndBodyNodePair<RevoluteJoint>(left).second;
+  BodyNode* right
+      = skel->createJointAndBodyNodePair<RevoluteJoint>(root).second;
+  BodyNode* rightTip
+      = skel->createJointAndBodyNodePair<BallJoint>(right).second;
+
+  for (std::size_t i = 1; i < skel->getNumJoints(); ++i) {
+    Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+    tf.translation() = Eigen::Vector3d::Random();
+    skel->getJoint(i)->setTransformFromParentBodyNode(tf);
+  }
+
+  GroupPtr group = Group::create("group", {rightTip, left, leftTip});
+
+  const std::vector<const MetaSkeleton*> metaSkels = {skel.get(), group.get()};
+  const std::vector<const JacobianNode*> nodes = {leftTip, rightTip};
+  const Eigen::Vector3d offset = Eigen::Vector3d::Random();
+  Eigen::MatrixXd storage(6, skel->getNumDofs());
+
+  // Let the scratch buffers reach their final sizes
+  for (const MetaSkeleton* metaSkel : metaSkels) {
+    for (const JacobianNode* node : nodes) {
+      queryJacobianOutputArguments(
+          metaSkel, node, Frame::World(), offset, storage);
+      queryJacobianOutputArguments(metaSkel, node, left, offset, storage);
+    }
+  }
+
+  // Each cycle of a control loop changes the state, which dirties the cached
+  // Jacobians, and queries them again
+  const Eigen::VectorXd positions = Eigen::VectorXd::Random(skel->getNumDofs());
+  const Eigen::VectorXd velocities
+      = Eigen::VectorXd::Random(skel->getNumDofs());
+  for (int i = 0; i < 10; ++i) {
+    skel->setPositions(positions * (0.1 * i));
+    skel->setVelocities(velocities * (0.1 * i));
+
+    const auto numAllocations = test::getNumAllocations();
+    for (const MetaSkeleton* metaSkel : metaSkels) {
+      for (const JacobianNode* node : nodes) {
+        queryJacobianOutputArguments(
+            metaSkel, node, Frame::World(), offset, storage);
+        queryJacobianOutputArguments(metaSkel, node, left, offset, storage);
+      }
+    }
+    EXPECT_EQ(test::getNumAllocations(), numAllocations);
+  }
+}
+
 TEST(Skeleton, Updating)
 {
   // Make sure that structural properties get automatically updated correctly
@@ -40,6 +40,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #if HAVE_BULLET
   #include "dart/collision/bullet/bullet.hpp"
@@ -48,6 +50,7 @@
 #include "dart/constraint/BoxedLcpConstraintSolver.hpp"
 #include "dart/constraint/DantzigBoxedLcpSolver.hpp"
 #include "dart/constraint/PgsBoxedLcpSolver.hpp"
+#include "dart/simulation/FileRecording.hpp"
 #include "dart/simulation/World.hpp"
 
 using namespace dart;
@@ -388,3 +391,407 @@ TEST(World, SetNewConstraintSolver)
   EXPECT_TRUE(world->getConstraintSolver()->getSkeletons().size() == 1);
   EXPECT_TRUE(world->getConstraintSolver()->getNumConstraints() == 1);
 }
+
+//==============================================================================
+/// Boxed LCP solver that always fails, to exercise the secondary solver
+class FailingBoxedLcpSolver : public constraint::BoxedLcpSolver
+{
+public:
+  const std::string& getType() const override
+  {
+    static const std::string type = "FailingBoxedLcpSolver";
+    return type;
+  }
+
+  bool solve(
+      int /*n*/,
+      double* /*A*/,
+      double* /*x*/,
+      double* /*b*/,
+      int /*nub*/,
+      double* /*lo*/,
+      double* /*hi*/,
+      int* /*findex*/,
+      bool /*earlyTermination*/) override
+  {
+    return false;
+  }
+
+#if DART_BUILD_MODE_DEBUG
+  bool canSolve(int /*n*/, const double* /*A*/) override
+  {
+    return true;
+  }
+#endif
+};
+
+//==============================================================================
+simulation::WorldPtr createBoxStackWorld()
+{
+  auto world = simulation::World::create();
+  world->getConstraintSolver()->setCollisionDetector(
+      collision::DARTCollisionDetector::create());
+
+  auto ground = Skeleton::create("ground");
+  auto groundBody = ground->createJointAndBodyNodePair<WeldJoint>().second;
+  groundBody->createShapeNodeWith<CollisionAspect, DynamicsAspect>(
+      std::make_shared<BoxShape>(Eigen::Vector3d(10.0, 10.0, 0.1)));
+  Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+  tf.translation().z() = -0.05;
+  groundBody->getParentJoint()->setTransformFromParentBodyNode(tf);
+  world->addSkeleton(ground);
+
+  for (auto i = 0; i < 2; ++i) {
+    auto box = Skeleton::create("box" + std::to_string(i));
+    auto boxBody = box->createJointAndBodyNodePair<FreeJoint>().second;
+    boxBody->createShapeNodeWith<CollisionAspect, DynamicsAspect>(
+        std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.5)));
+    tf.translation().z() = 0.249 + 0.499 * i;
+    boxBody->getParentJoint()->setTransformFromParentBodyNode(tf);
+    world->addSkeleton(box);
+  }
+
+  return world;
+}
+
+//==============================================================================
+TEST(World, StepStatistics)
+{
+  auto world = createBoxStackWorld();
+
+  // Disabled by default
+  EXPECT_FALSE(world->isStepStatisticsEnabled());
+  world->step();
+  EXPECT_EQ(world->getStepStatistics().mStepTime, 0.0);
+  EXPECT_EQ(world->getStepStatistics().mConstraintSolver.mNumContacts, 0u);
+
+  world->setStepStatisticsEnabled(true);
+  EXPECT_TRUE(world->isStepStatisticsEnabled());
+  EXPECT_TRUE(world->getConstraintSolver()->isStatisticsEnabled());
+  world->step();
+
+  const auto& statistics = world->getStepStatistics();
+  EXPECT_GT(statistics.mStepTime, 0.0);
+  // The phases are laps of the same stopwatch, so their sum may only exceed
+  // the step time by rounding
+  EXPECT_GE(
+      statistics.mStepTime * (1.0 + 1e-12),
+      statistics.mIntegrateVelocitiesTime + statistics.mSolveConstraintsTime
+          + statistics.mIntegratePositionsTime);
+
+  const auto& solverStatistics = statistics.mConstraintSolver;
+  const auto numContacts = world->getLastCollisionResult().getNumContacts();
+  EXPECT_GT(numContacts, 0u);
+  EXPECT_EQ(solverStatistics.mNumContacts, numContacts);
+  EXPECT_EQ(solverStatistics.mNumActiveConstraints, numContacts);
+  EXPECT_EQ(solverStatistics.mNumConstrainedGroups, 1u);
+  EXPECT_EQ(solverStatistics.mMaxConstrainedGroupSize, numContacts);
+  EXPECT_EQ(solverStatistics.mNumLcpSolves, 1u);
+  EXPECT_GE(solverStatistics.mTotalLcpDimension, numContacts);
+  EXPECT_EQ(
+      solverStatistics.mMaxLcpDimension, solverStatistics.mTotalLcpDimension);
+  EXPECT_EQ(solverStatistics.mNumPrimaryLcpFailures, 0u);
+  EXPECT_EQ(solverStatistics.mNumSecondaryLcpSolves, 0u);
+  EXPECT_GE(
+      statistics.mSolveConstraintsTime,
+      solverStatistics.mCollisionTime
+          + solverStatistics.mBuildConstrainedGroupsTime
+          + solverStatistics.mSolveConstrainedGroupsTime);
+
+  // The statistics stay enabled when the constraint solver is replaced, and
+  // the fallback to the secondary solver is counted along with the iterations
+  // of PGS
+  world->setConstraintSolver(
+      std::make_unique<constraint::BoxedLcpConstraintSolver>(
+          std::make_shared<FailingBoxedLcpSolver>(),
+          std::make_shared<constraint::PgsBoxedLcpSolver>()));
+  world->getConstraintSolver()->setCollisionDetector(
+      collision::DARTCollisionDetector::create());
+  EXPECT_TRUE(world->getConstraintSolver()->isStatisticsEnabled());
+  world->step();
+  EXPECT_EQ(statistics.mConstraintSolver.mNumLcpSolves, 1u);
+  EXPECT_EQ(statistics.mConstraintSolver.mNumPrimaryLcpFailures, 1u);
+  EXPECT_EQ(statistics.mConstraintSolver.mNumSecondaryLcpSolves, 1u);
+  EXPECT_GT(statistics.mConstraintSolver.mNumLcpIterations, 0u);
+
+  world->setStepStatisticsEnabled(false);
+  EXPECT_FALSE(world->getConstraintSolver()->isStatisticsEnabled());
+  world->step();
+  EXPECT_EQ(statistics.mStepTime, 0.0);
+  EXPECT_EQ(statistics.mConstraintSolver.mNumLcpSolves, 0u);
+}
+
+//==============================================================================
+TEST(World, Sleeping)
+{
+  auto world = createBoxStackWorld();
+  auto bottomBox = world->getSkeleton("box0");
+  auto topBox = world->getSkeleton("box1");
+
+  // Steps the world until any skeleton falls asleep
+  const auto stepUntilSleeping = [&]() {
+    for (auto i = 0u; i < 5000u; ++i) {
+      world->step();
+      if (world->getNumSleepingSkeletons() > 0u)
+        return true;
+    }
+    return false;
+  };
+
+  // Disabled by default
+  EXPECT_FALSE(world->isSleepingEnabled());
+  EXPECT_DOUBLE_EQ(1e-4, world->getSleepThreshold());
+  EXPECT_EQ(60u, world->getNumStepsToSleep());
+  EXPECT_FALSE(stepUntilSleeping());
+
+  // The boxes of the stack are an island, so they fall asleep together
+  world->setSleepingEnabled(true);
+  EXPECT_TRUE(world->isSleepingEnabled());
+  ASSERT_TRUE(stepUntilSleeping());
+  EXPECT_TRUE(bottomBox->isSleeping());
+  EXPECT_TRUE(topBox->isSleeping());
+  EXPECT_FALSE(world->getSkeleton("ground")->isSleeping());
+  EXPECT_TRUE(topBox->getVelocities().isZero(0.0));
+
+  // Sleeping skeletons stay in place without being checked for collision
+  const Eigen::VectorXd positions = topBox->getPositions();
+  for (auto i = 0u; i < 100u; ++i)
+    world->step();
+  EXPECT_TRUE(topBox->getPositions() == positions);
+  EXPECT_EQ(0u, world->getLastCollisionResult().getNumContacts());
+
+  // An external force on the top box wakes up the whole stack
+  topBox->getBodyNode(0)->addExtForce(Eigen::Vector3d(0.0, 0.0, 1.0));
+  world->step();
+  EXPECT_EQ(0u, world->getNumSleepingSkeletons());
+  EXPECT_GT(world->getLastCollisionResult().getNumContacts(), 0u);
+
+  // A box that falls onto the sleeping stack wakes it up
+  world->setNumStepsToSleep(10u);
+  EXPECT_EQ(10u, world->getNumStepsToSleep());
+  ASSERT_TRUE(stepUntilSleeping());
+  EXPECT_EQ(2u, world->getNumSleepingSkeletons());
+
+  auto fallingBox = Skeleton::create("falling box");
+  auto fallingBody = fallingBox->createJointAndBodyNodePair<FreeJoint>().second;
+  fallingBody->createShapeNodeWith<CollisionAspect, DynamicsAspect>(
+      std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.5)));
+  fallingBox->setPosition(5, 1.5);
+  world->addSkeleton(fallingBox);
+
+  for (auto i = 0u; i < 1000u && world->getNumSleepingSkeletons() > 0u; ++i)
+    world->step();
+  EXPECT_FALSE(bottomBox->isSleeping());
+  EXPECT_FALSE(topBox->isSleeping());
+  EXPECT_GT(fallingBox->getPosition(5), 0.9);
+
+  // The step that woke up the stack also solved the contacts that were
+  // skipped while it was asleep, so the bottom box didn't lose its support
+  const auto& result = world->getLastCollisionResult();
+  EXPECT_TRUE(result.inCollision(world->getSkeleton("ground")->getBodyNode(0)));
+  EXPECT_TRUE(result.inCollision(bottomBox->getBodyNode(0)));
+
+  // Disabling sleeping wakes up all the skeletons
+  world->setSleepThreshold(1e-2);
+  EXPECT_DOUBLE_EQ(1e-2, world->getSleepThreshold());
+  ASSERT_TRUE(stepUntilSleeping());
+  world->setSleepingEnabled(false);
+  EXPECT_EQ(0u, world->getNumSleepingSkeletons());
+}
+
+//==============================================================================
+TEST(World, SavingAndRestoringState)
+{
+  // PGS starts from the cached impulses, so the rollouts only match if they
+  // are restored as well
+  const auto usePgs = [](simulation::World& world) {
+    auto solver = static_cast<constraint::BoxedLcpConstraintSolver*>(
+        world.getConstraintSolver());
+    solver->setBoxedLcpSolver(
+        std::make_shared<constraint::PgsBoxedLcpSolver>());
+    solver->setContactWarmStarting(true);
+  };
+
+  auto world = createBoxStackWorld();
+  usePgs(*world);
+  auto topBox = world->getSkeleton("box1");
+  topBox->setVelocity(2, 0.5);
+  for (auto i = 0u; i < 20u; ++i)
+    world->step();
+
+  std::vector<char> buffer;
+  world->saveState(buffer);
+  EXPECT_EQ(world->getStateSize(), buffer.size());
+  const std::size_t cacheSize
+      = world->getConstraintSolver()->getContactImpulseCacheSize();
+  EXPECT_GT(cacheSize, 0u);
+
+  // Saving the same state again reuses the buffer
+  const char* data = buffer.data();
+  world->saveState(buffer);
+  EXPECT_EQ(data, buffer.data());
+
+  const double time = world->getTime();
+  const int frames = world->getSimFrames();
+
+  // Steps the world and returns the positions of the top box
+  const auto rollout = [&]() {
+    std::vector<Eigen::VectorXd> positions;
+    for (auto i = 0u; i < 50u; ++i) {
+      world->step();
+      positions.push_back(topBox->getPositions());
+    }
+    return positions;
+  };
+
+  // Restoring the state replays the same rollout
+  const auto expected = rollout();
+  EXPECT_NE(time, world->getTime());
+  ASSERT_TRUE(world->restoreState(buffer));
+  EXPECT_EQ(time, world->getTime());
+  EXPECT_EQ(frames, world->getSimFrames());
+
+  const auto actual = rollout();
+  ASSERT_EQ(expected.size(), actual.size());
+  for (auto i = 0u; i < expected.size(); ++i)
+    EXPECT_TRUE(equals(expected[i], actual[i], 1e-10));
+
+  // A clone restores the state, including the cached contact impulses, and
+  // replays the same rollout
+  auto clone = world->clone();
+  usePgs(*clone);
+  ASSERT_TRUE(clone->restoreState(buffer));
+  EXPECT_EQ(
+      cacheSize, clone->getConstraintSolver()->getContactImpulseCacheSize());
+
+  auto cloneTopBox = clone->getSkeleton("box1");
+  for (auto i = 0u; i < expected.size(); ++i) {
+    clone->step();
+    EXPECT_TRUE(equals(expected[i], cloneTopBox->getPositions(), 1e-10));
+  }
+
+  // The state of a world with other skeletons is rejected
+  auto otherWorld = createBoxStackWorld();
+  otherWorld->removeSkeleton(otherWorld->getSkeleton("box1"));
+  std::vector<char> otherBuffer;
+  otherWorld->saveState(otherBuffer);
+
+  const Eigen::VectorXd positions = topBox->getPositions();
+  EXPECT_FALSE(world->restoreState(otherBuffer));
+  EXPECT_FALSE(world->restoreState(std::vector<char>()));
+  EXPECT_TRUE(topBox->getPositions() == positions);
+  EXPECT_EQ(frames + 50, world->getSimFrames());
+}
+
+//==============================================================================
+TEST(World, FileRecording)
+{
+  const std::string path = "testFileRecording.bin";
+
+  auto world = createBoxStackWorld();
+  std::vector<SkeletonPtr> skeletons;
+  for (auto i = 0u; i < world->getNumSkeletons(); ++i)
+    skeletons.push_back(world->getSkeleton(i));
+  world->setRecording(std::make_unique<FileRecording>(path, skeletons, 8u));
+  auto recording = static_cast<FileRecording*>(world->getRecording());
+
+  // Bakes frames and returns what is expected to be recorded for them
+  std::vector<std::vector<Eigen::VectorXd>> configs;
+  std::vector<std::vector<Eigen::Vector6d>> contacts;
+  const auto bake = [&](std::size_t numFrames) {
+    for (auto i = 0u; i < numFrames; ++i) {
+      world->step();
+      world->bake();
+
+      configs.emplace_back();
+      for (auto j = 0u; j < world->getNumSkeletons(); ++j)
+        configs.back().push_back(world->getSkeleton(j)->getPositions());
+
+      const auto& result
+          = world->getConstraintSolver()->getLastCollisionResult();
+      contacts.emplace_back();
+      for (auto j = 0u; j < result.getNumContacts(); ++j) {
+        Eigen::Vector6d contact;
+        contact << result.getContact(j).point, result.getContact(j).force;
+        contacts.back().push_back(contact);
+      }
+    }
+  };
+
+  // Checks the recorded frames against the expected ones
+  const auto check = [&](const Recording& rec, std::size_t numFrames) {
+    ASSERT_EQ(static_cast<int>(numFrames), rec.getNumFrames());
+    for (auto i = 0u; i < numFrames; ++i) {
+      for (auto j = 0u; j < configs[i].size(); ++j) {
+        EXPECT_TRUE(rec.getConfig(i, j) == configs[i][j]);
+        for (auto k = 0; k < configs[i][j].size(); ++k)
+          EXPECT_EQ(configs[i][j][k], rec.getGenCoord(i, j, k));
+      }
+      ASSERT_EQ(static_cast<int>(contacts[i].size()), rec.getNumContacts(i));
+      for (auto j = 0u; j < contacts[i].size(); ++j) {
+        EXPECT_TRUE(rec.getContactPoint(i, j) == contacts[i][j].head<3>());
+        EXPECT_TRUE(rec.getContactForce(i, j) == contacts[i][j].tail<3>());
+      }
+    }
+  };
+
+  // Chunks are written as they fill up, and the last frames stay in memory
+  bake(30u);
+  check(*recording, 30u);
+  EXPECT_GT(recording->getNumContacts(29), 0);
+
+  // Changing the skeletons closes the chunk early
+  world->removeSkeleton(world->getSkeleton("box1"));
+  bake(13u);
+  check(*recording, 43u);
+  EXPECT_EQ(2, recording->getNumSkeletons());
+
+  // The maps point into the recording
+  EXPECT_TRUE(recording->getConfigMap(40, 1) == configs[40][1]);
+  EXPECT_EQ(
+      recording->getNumContacts(40),
+      static_cast<int>(recording->getContactsMap(40).cols()));
+
+  // Only the flushed frames can be read back from the file
+  auto reader = FileRecording::open(path);
+  ASSERT_NE(nullptr, reader);
+  EXPECT_LT(reader->getNumFrames(), 43);
+
+  recording->flush();
+  reader = FileRecording::open(path);
+  ASSERT_NE(nullptr, reader);
+  EXPECT_TRUE(reader->isReadOnly());
+  EXPECT_EQ(2, reader->getNumSkeletons());
+  check(*reader, 43u);
+
+  // A chunk that was cut short is ignored
+  std::string bytes;
+  {
+    std::ifstream file(path, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(file), {});
+  }
+  const std::string truncatedPath = "testFileRecordingTruncated.bin";
+  {
+    std::ofstream file(truncatedPath, std::ios::binary);
+    file.write(bytes.data(), bytes.size() - 8u);
+  }
+  auto truncated = FileRecording::open(truncatedPath);
+  ASSERT_NE(nullptr, truncated);
+  EXPECT_GT(truncated->getNumFrames(), 0);
+  EXPECT_LT(truncated->getNumFrames(), 43);
+  check(*truncated, truncated->getNumFrames());
+
+  // Other files are rejected
+  EXPECT_EQ(nullptr, FileRecording::open("testFileRecordingMissing.bin"));
+
+  // Clearing truncates the file
+  recording->clear();
+  EXPECT_EQ(0, recording->getNumFrames());
+  reader = FileRecording::open(path);
+  ASSERT_NE(nullptr, reader);
+  EXPECT_EQ(0, reader->getNumFrames());
+
+  world->setRecording(nullptr);
+  std::remove(path.c_str());
+  std::remove(truncatedPath.c_str());
+}
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TestHelpers.hpp"
+#include "dart/collision/dart/DARTCollisionDetector.hpp"
+#include "dart/constraint/ConstraintSolver.hpp"
+#include "dart/simulation/World.hpp"
+#include "dart/simulation/WorldBatch.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace dart;
+
+//==============================================================================
+std::shared_ptr<simulation::World> createTemplateWorld()
+{
+  auto world = simulation::World::create();
+  world->getConstraintSolver()->setCollisionDetector(
+      collision::DARTCollisionDetector::create());
+
+  world->addSkeleton(createGround(Eigen::Vector3d(10.0, 10.0, 0.1)));
+  world->addSkeleton(createBox(
+      Eigen::Vector3d::Constant(0.2), Eigen::Vector3d(0.0, 0.0, 0.15)));
+  world->addSkeleton(createBox(
+      Eigen::Vector3d::Constant(0.2), Eigen::Vector3d(0.0, 0.0, 0.36)));
+
+  return world;
+}
+
+//==============================================================================
+TEST(WorldBatch, Basics)
+{
+  auto world = createTemplateWorld();
+  simulation::WorldBatch batch(*world, 5u, 2u);
+
+  EXPECT_EQ(5u, batch.getNumWorlds());
+  EXPECT_EQ(12u, batch.getNumDofs());
+  EXPECT_EQ(2u, batch.getNumThreads());
+  EXPECT_EQ(nullptr, batch.getWorld(5u));
+
+  ASSERT_EQ(5, batch.getPositions().rows());
+  ASSERT_EQ(12, batch.getPositions().cols());
+  ASSERT_EQ(5, batch.getCommands().rows());
+  EXPECT_TRUE(batch.getCommands().isZero(0.0));
+
+  // The worlds start from the state of the template world
+  Eigen::VectorXd positions(12);
+  positions << world->getSkeleton(1)->getPositions(),
+      world->getSkeleton(2)->getPositions();
+  for (auto i = 0u; i < batch.getNumWorlds(); ++i) {
+    EXPECT_NE(world, batch.getWorld(i));
+    EXPECT_TRUE(batch.getPositions().row(i) == positions.transpose());
+    EXPECT_TRUE(batch.getVelocities().row(i).isZero(0.0));
+  }
+}
+
+//==============================================================================
+TEST(WorldBatch, StepMatchesSerialWorlds)
+{
+  auto world = createTemplateWorld();
+  const std::size_t numWorlds = 6u;
+  simulation::WorldBatch batch(*world, numWorlds, 3u);
+
+  std::vector<std::shared_ptr<simulation::World>> worlds;
+  for (auto i = 0u; i < numWorlds; ++i)
+    worlds.push_back(world->clone());
+
+  // Push the upper box sideways with a different force in each world
+  for (auto i = 0u; i < numWorlds; ++i)
+    batch.getCommands()(i, 9) = 0.5 * i;
+
+  for (auto step = 0u; step < 50u; ++step) {
+    batch.step();
+
+    for (auto i = 0u; i < numWorlds; ++i) {
+      worlds[i]->getSkeleton(2)->setCommand(3, 0.5 * i);
+      worlds[i]->step();
+    }
+  }
+
+  for (auto i = 0u; i < numWorlds; ++i) {
+    Eigen::VectorXd positions(12);
+    positions << worlds[i]->getSkeleton(1)->getPositions(),
+        worlds[i]->getSkeleton(2)->getPositions();
+    Eigen::VectorXd velocities(12);
+    velocities << worlds[i]->getSkeleton(1)->getVelocities(),
+        worlds[i]->getSkeleton(2)->getVelocities();
+
+    EXPECT_TRUE(batch.getPositions().row(i) == positions.transpose());
+    EXPECT_TRUE(batch.getVelocities().row(i) == velocities.transpose());
+    EXPECT_DOUBLE_EQ(worlds[i]->getTime(), batch.getWorld(i)->getTime());
+  }
+
+  // Different commands lead to different states
+  EXPECT_NE(batch.getPositions()(0, 9), batch.getPositions()(5, 9));
+
+  // Several steps at once
+  simulation::WorldBatch batch2(*world, 2u, 2u);
+  batch2.getCommands().col(9).setConstant(1.0);
+  batch2.step(50u);
+  EXPECT_TRUE(batch2.getPositions().row(1) == batch.getPositions().row(2));
+}
+
+//==============================================================================
+TEST(WorldBatch, SetStateAndReset)
+{
+  auto world = createTemplateWorld();
+  simulation::WorldBatch batch(*world, 3u);
+
+  const Eigen::RowVectorXd initialPositions = batch.getPositions().row(1);
+
+  batch.getCommands().setConstant(0.1);
+  batch.step(10u);
+  EXPECT_FALSE(batch.getPositions().row(1) == initialPositions);
+  EXPECT_GT(batch.getWorld(1)->getTime(), 0.0);
+
+  batch.reset(1u);
+  EXPECT_TRUE(batch.getPositions().row(1) == initialPositions);
+  EXPECT_TRUE(batch.getVelocities().row(1).isZero(0.0));
+  EXPECT_DOUBLE_EQ(0.0, batch.getWorld(1)->getTime());
+  EXPECT_FALSE(batch.getPositions().row(0) == initialPositions);
+
+  Eigen::VectorXd positions = initialPositions.transpose();
+  positions[11] += 1.0;
+  const Eigen::VectorXd velocities = Eigen::VectorXd::Constant(12, 0.5);
+  batch.setState(2u, positions, velocities);
+  EXPECT_TRUE(batch.getPositions().row(2) == positions.transpose());
+  EXPECT_TRUE(batch.getVelocities().row(2) == velocities.transpose());
+  EXPECT_TRUE(batch.getWorld(2)->getSkeleton(2)->getVelocities()
+              == velocities.tail(6));
+
+  // Changes made directly to a world show up after syncing
+  batch.getWorld(0)->getSkeleton(1)->setPosition(5, 2.0);
+  batch.syncStates();
+  EXPECT_EQ(2.0, batch.getPositions()(0, 5));
+}
+
+//==============================================================================
+TEST(WorldBatch, SharedShapesAfterChanges)
+{
+  // The worlds share their shapes. Changing a shape marks its lazily computed
+  // data dirty, which the parallel step must not compute concurrently. This
+  // test is meant to be run with ThreadSanitizer as well.
+  auto world = createTemplateWorld();
+  const std::size_t numWorlds = 64u;
+  simulation::WorldBatch batch(*world, numWorlds, 4u);
+
+  auto shape = std::dynamic_pointer_cast<dynamics::BoxShape>(
+      world->getSkeleton(2)->getShapeNode(0)->getShape());
+  ASSERT_NE(nullptr, shape);
+  for (auto i = 0u; i < numWorlds; ++i) {
+    EXPECT_EQ(
+        shape, batch.getWorld(i)->getSkeleton(2)->getShapeNode(0)->getShape());
+  }
+
+  std::vector<std::shared_ptr<simulation::World>> worlds;
+  for (auto i = 0u; i < numWorlds; ++i)
+    worlds.push_back(world->clone());
+
+  for (auto i = 0u; i < numWorlds; ++i)
+    batch.getCommands()(i, 9) = 0.5 * i;
+
+  for (auto step = 0u; step < 20u; ++step) {
+    // Grow the upper box every few steps
+    if (step % 5u == 0u)
+      shape->setSize(shape->getSize() * 1.01);
+
+    batch.step();
+
+    for (auto i = 0u; i < numWorlds; ++i) {
+      worlds[i]->getSkeleton(2)->setCommand(3, 0.5 * i);
+      worlds[i]->step();
+    }
+  }
+
+  for (auto i = 0u; i < numWorlds; ++i) {
+    Eigen::VectorXd positions(12);
+    positions << worlds[i]->getSkeleton(1)->getPositions(),
+        worlds[i]->getSkeleton(2)->getPositions();
+    EXPECT_TRUE(batch.getPositions().row(i) == positions.transpose());
+  }
+}
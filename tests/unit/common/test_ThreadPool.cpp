@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2011-2024, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/main/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <dart/common/ThreadPool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace dart;
+using namespace common;
+
+//==============================================================================
+TEST(ThreadPoolTest, NumThreads)
+{
+  EXPECT_EQ(1u, ThreadPool(1u).getNumThreads());
+  EXPECT_EQ(3u, ThreadPool(3u).getNumThreads());
+  EXPECT_GE(ThreadPool().getNumThreads(), 1u);
+}
+
+//==============================================================================
+TEST(ThreadPoolTest, ParallelFor)
+{
+  ThreadPool pool(4u);
+
+  // Every index is visited exactly once, by a valid worker
+  for (std::size_t count : {0u, 1u, 3u, 1000u}) {
+    std::vector<int> visits(count, 0);
+    std::vector<std::size_t> workers(count, 0u);
+    pool.parallelFor(count, [&](std::size_t index, std::size_t worker) {
+      ++visits[index];
+      workers[index] = worker;
+    });
+
+    for (std::size_t i = 0u; i < count; ++i) {
+      EXPECT_EQ(1, visits[i]);
+      EXPECT_LT(workers[i], pool.getNumThreads());
+    }
+  }
+}
+
+//==============================================================================
+TEST(ThreadPoolTest, Exception)
+{
+  ThreadPool pool(2u);
+
+  EXPECT_THROW(
+      pool.parallelFor(
+          10u,
+          [](std::size_t index, std::size_t) {
+            if (index == 5u)
+              throw std::runtime_error("error");
+          }),
+      std::runtime_error);
+
+  // The pool is still usable after an exception
+  std::vector<int> visits(10u, 0);
+  pool.parallelFor(
+      10u, [&](std::size_t index, std::size_t) { ++visits[index]; });
+  for (const auto visit : visits)
+    EXPECT_EQ(1, visit);
+}